@@ -94,16 +94,65 @@ typedef int16_t lv_coord_t;
 
 /* Automatically defrag. on free. Defrag. means joining the adjacent free cells. */
 #  define LV_MEM_AUTO_DEFRAG  1
+
+/* 1: Use a TLSF (Two-Level Segregated Fit) allocator in the work memory instead of first-fit.
+ * Allocation and free take constant time regardless of the number of blocks and the fragmentation.
+ * The free blocks are always joined immediately so `LV_MEM_AUTO_DEFRAG` is not used.*/
+#  define LV_MEM_TLSF         0
 #else       /*LV_MEM_CUSTOM*/
 #  define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
 #  define LV_MEM_CUSTOM_ALLOC   malloc       /*Wrapper to malloc*/
 #  define LV_MEM_CUSTOM_FREE    free         /*Wrapper to free*/
 #endif     /*LV_MEM_CUSTOM*/
 
+/* 1: Collect a histogram of the `lv_mem_alloc` latencies. Read it with `lv_mem_monitor()`.
+ * `LV_MEM_LATENCY_TIME_EXPR` should give a high resolution time stamp in any unit (e.g. CPU cycles or ns)*/
+#define LV_MEM_LATENCY_HIST     0
+#if LV_MEM_LATENCY_HIST
+#  define LV_MEM_LATENCY_TIME_INCLUDE  "something.h"   /*Header for the time stamp function*/
+#  define LV_MEM_LATENCY_TIME_EXPR     (cycle_cnt())   /*Expression evaluating to a 32 bit time stamp*/
+#endif
+
+/* 1: Keep the temporary buffers of the drawing (`_lv_mem_buf_get()`) in power of 2 size classes.
+ * Getting and releasing a buffer takes constant time and the buffers are not freed after every refresh
+ * but kept up to the most used at the same time in the last `LV_MEM_BUF_POOL_KEEP` refreshes.
+ * `LV_MEM_BUF_POOL_ATTR` can be set to e.g. `__thread` to give every rendering thread its own pool.
+ * (`lv_mem_alloc` needs to be thread safe for that, e.g. `LV_MEM_CUSTOM` with a thread safe `malloc`)
+ * The pools are trimmed only by their own thread, call `lv_mem_buf_flush()` before a rendering thread exits.*/
+#define LV_MEM_BUF_POOL         0
+#if LV_MEM_BUF_POOL
+#  define LV_MEM_BUF_POOL_KEEP  64
+#  define LV_MEM_BUF_POOL_ATTR
+#endif
+
 /* Use the standard memcpy and memset instead of LVGL's own functions.
  * The standard functions might or might not be faster depending on their implementation. */
 #define LV_MEMCPY_MEMSET_STD    0
 
+/* 1: Allocate the objects from per widget type slabs.
+ * The object, its ext. data and its first few style pointers are allocated in one block
+ * and the blocks of the deleted objects are kept for reuse. Not supported with `LV_ENABLE_GC`*/
+#define LV_OBJ_SLAB             0
+#if LV_OBJ_SLAB
+#  define LV_OBJ_SLAB_CLASS_CNT   32  /*Number of slabs (widget types with different ext. data size)*/
+#  define LV_OBJ_SLAB_STYLE_CNT   2   /*Number of style pointers allocated together with the object*/
+#  define LV_OBJ_SLAB_CACHE_CNT   16  /*Max. number of free blocks kept in a slab for reuse*/
+#endif
+
+/* 1: Cache the resolved style properties of the objects' parts.
+ * A resolved value (after checking the state, the styles of the part and the inherited ones)
+ * is stored in a small hash table of the style list and reused until the styles or states change.
+ * Costs (LV_STYLE_RES_CACHE_MAX * 16) bytes per style list in the worst case (64 bit).
+ * Call `lv_obj_report_style_mod()` after modifying an already added style.*/
+#define LV_STYLE_RES_CACHE      0
+#if LV_STYLE_RES_CACHE
+#  define LV_STYLE_RES_CACHE_MAX  64  /*Max. number of slots in the table of a style list. Must be a power of 2*/
+#endif
+
+/* 1: Enable `lv_style_freeze()` to index the properties of a style with a hash table.
+ * It makes the look up in styles with many properties faster. The material theme freezes its large styles.*/
+#define LV_STYLE_INDEX          0
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #define LV_ENABLE_GC 0
@@ -143,6 +192,14 @@ typedef int16_t lv_coord_t;
 /* Gesture min velocity at release before swipe (pixels)*/
 #define LV_INDEV_DEF_GESTURE_MIN_VELOCITY 3
 
+/* 1: Index the children of the objects with many children in a grid to find the pressed object faster.
+ * An object is indexed after at least `LV_INDEV_HIT_INDEX_MIN_CHILD` children were checked in one search.
+ * The index follows the moved children and it needs no update when the parent is scrolled.*/
+#define LV_INDEV_HIT_INDEX      0
+#if LV_INDEV_HIT_INDEX
+#  define LV_INDEV_HIT_INDEX_MIN_CHILD  32   /*Min. number of children to index*/
+#endif
+
 /*==================
  * Feature usage
  *==================*/
@@ -154,6 +211,12 @@ typedef int16_t lv_coord_t;
 /*Declare the type of the user data of animations (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_anim_user_data_t;
 
+/* 1: Sample the animations exactly once per display refresh instead of in a separate task.
+ * The refresh task of the default display drives the animation clock
+ * (or the vsync if the display driver calls `lv_anim_frame_vsync()`).
+ * This way no intermediate animation steps are applied between two refreshes.*/
+#define LV_ANIM_FRAME_SYNC      0
+
 #endif
 
 /* 1: Enable shadow drawing on rectangles*/
@@ -166,6 +229,15 @@ typedef void * lv_anim_user_data_t;
 #define LV_SHADOW_CACHE_SIZE    0
 #endif
 
+/* Cache the colors of rectangle gradients to reuse them in the next display buffer bands and refreshes.
+ * The size of the cache in bytes. A gradient needs `size * sizeof(lv_color_t)` bytes.
+ * 0: compute the colors in every draw*/
+#define LV_GRAD_CACHE_SIZE      0
+
+/* 1: Use ordered dithering on rectangle gradients to avoid banding with `LV_COLOR_DEPTH  16`.
+ * With a gradient cache dithered gradients need 4 times more space.*/
+#define LV_DITHER_GRADIENT      0
+
 /*1: enable outline drawing on rectangles*/
 #define LV_USE_OUTLINE  1
 
@@ -215,6 +287,16 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #if LV_USE_FILESYSTEM
 /*Declare the type of the user data of file system drivers (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_fs_drv_user_data_t;
+
+/*Number of blocks in the read cache shared by all the open files (0: disable).
+ *A read which misses the cache reads the whole block from the driver (read-ahead)
+ *into the place of the least recently used block.
+ *It also counts the I/O of the drivers (see `lv_fs_get_stat()`).
+ *The cache and the counters are not locked: use `lv_fs` only from the thread running `lv_task_handler()`*/
+#define LV_FS_CACHE_BLOCK_CNT   0
+
+/*Size of a cache block in bytes, i.e. the size of the read-ahead*/
+#define LV_FS_CACHE_BLOCK_SIZE  512
 #endif
 
 /*1: Add a `user_data` to drivers and objects*/
@@ -223,6 +305,14 @@ typedef void * lv_fs_drv_user_data_t;
 /*1: Show CPU usage and FPS count in the right bottom corner*/
 #define LV_USE_PERF_MONITOR     0
 
+/*1: Enable a queue to post UI updates from other threads (e.g. `lv_cmdq_set_text()`).
+ * The commands are executed in `lv_task_handler()`. Requires GCC or Clang atomic built-ins*/
+#define LV_USE_CMDQ             0
+#if LV_USE_CMDQ
+#  define LV_CMDQ_SIZE          32      /*Number of commands the queue can hold. Must be a power of 2*/
+#  define LV_CMDQ_TEXT_MAX      128     /*Max. length of a text or file name in a command (with the terminating zero)*/
+#endif
+
 /*1: Use the functions and types from the older API if possible */
 #define LV_USE_API_EXTENSION_V6  1
 #define LV_USE_API_EXTENSION_V7  1
@@ -245,6 +335,12 @@ typedef void * lv_fs_drv_user_data_t;
  * Set it to 0 to disable caching */
 #define LV_IMG_CACHE_DEF_SIZE       1
 
+/* Memory in bytes to cache rotated and zoomed images as ready-to-draw ARGB buffers.
+ * An image is cached only if it's drawn with the same angle and zoom for longer than a refresh period
+ * so animated images are still transformed on the fly.
+ * 0: disable the cache (requires `LV_USE_IMG_TRANSFORM 1`)*/
+#define LV_IMG_CACHE_TRANSFORM_SIZE 0
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_img_decoder_user_data_t;
 
@@ -595,6 +691,11 @@ typedef void * lv_obj_user_data_t;
 
 /*Canvas (dependencies: lv_img)*/
 #define LV_USE_CANVAS   1
+#if LV_USE_CANVAS
+/*1: Invalidate only the drawn area of the canvas and enable `lv_canvas_draw_begin/end()`
+ *   to draw many primitives with one dummy display*/
+#  define LV_CANVAS_DIRTY_AREA   0
+#endif
 
 /*Check box (dependencies: lv_btn, lv_label)*/
 #define LV_USE_CHECKBOX       1
@@ -603,10 +704,19 @@ typedef void * lv_obj_user_data_t;
 #define LV_USE_CHART    1
 #if LV_USE_CHART
 #  define LV_CHART_AXIS_TICK_LABEL_MAX_LEN    256
+/*1: Decimate the lines with more points than pixel columns, redraw only the series on shift
+ *   and enable `lv_chart_set_next_array()` to add many points at once*/
+#  define LV_CHART_STREAM     0
 #endif
 
 /*Container (dependencies: -*/
 #define LV_USE_CONT     1
+#if LV_USE_CONT
+/* 1: Don't refresh the layout and fit of the containers right away when their children change
+ * but mark them and refresh them once before the next frame is drawn (deepest first).
+ * Reading the coordinates of an object (e.g. `lv_obj_get_width()`) refreshes the pending containers.*/
+#  define LV_CONT_LAYOUT_DEFER    0
+#endif
 
 /*Color picker (dependencies: -*/
 #define LV_USE_CPICKER   1
@@ -648,6 +758,10 @@ typedef void * lv_obj_user_data_t;
 
 /*Store extra some info in labels (12 bytes) to speed up drawing of very long texts*/
 #  define LV_LABEL_LONG_TXT_HINT          0
+
+/*Enable `lv_label_set_cell_width()` to draw every character in a fixed width cell.
+ *Changing some characters then redraws only their cells (e.g. for clocks and counters)*/
+#  define LV_LABEL_CELL_MODE              0
 #endif
 
 /*LED (dependencies: -)*/
@@ -665,6 +779,8 @@ typedef void * lv_obj_user_data_t;
 #if LV_USE_LIST != 0
 /*Default animation time of focusing to a list element [ms] (0: no animation)  */
 #  define LV_LIST_DEF_ANIM_TIME  100
+/*1: Enable `lv_list_set_virtual()` to show many items on a few recycled buttons*/
+#  define LV_LIST_VIRTUAL        0
 #endif
 
 /*Line meter (dependencies: *;)*/
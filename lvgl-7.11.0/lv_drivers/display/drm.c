@@ -701,6 +701,11 @@ void drm_wait_vsync(lv_disp_drv_t *disp_drv)
 	if (FD_ISSET(drm_dev.fd, &fds))
 		drmHandleEvent(drm_dev.fd, &drm_dev.drm_event_ctx);
 
+#if LV_USE_ANIMATION && LV_ANIM_FRAME_SYNC
+	/* Let the animation clock follow the vsync */
+	lv_anim_frame_vsync();
+#endif
+
 	drmModeAtomicFree(drm_dev.req);
 	drm_dev.req = NULL;
 }
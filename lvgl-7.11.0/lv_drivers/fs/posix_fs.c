@@ -0,0 +1,686 @@
+/**
+ * @file posix_fs.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "posix_fs.h"
+#if USE_POSIX_FS || USE_MMAP_FS
+#if LV_USE_FILESYSTEM
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if USE_MMAP_FS
+typedef struct {
+    const uint8_t * data;   /*The mapped content. NULL if the file is empty*/
+    uint32_t size;
+    uint32_t pos;
+} mmap_fs_file_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_fs_res_t errno_to_res(int e);
+static bool make_path(char * buf, const char * root, const char * path);
+static lv_fs_res_t dir_open(void * rddir_p, const char * root, const char * path);
+static lv_fs_res_t dir_read(lv_fs_drv_t * drv, void * rddir_p, char * fn);
+static lv_fs_res_t dir_close(lv_fs_drv_t * drv, void * rddir_p);
+
+#if USE_POSIX_FS
+static lv_fs_res_t posix_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t posix_close(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t posix_remove(lv_fs_drv_t * drv, const char * path);
+static lv_fs_res_t posix_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t posix_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
+static lv_fs_res_t posix_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos);
+static lv_fs_res_t posix_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t posix_trunc(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t posix_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+static lv_fs_res_t posix_rename(lv_fs_drv_t * drv, const char * oldname, const char * newname);
+static lv_fs_res_t posix_free_space(lv_fs_drv_t * drv, uint32_t * total_p, uint32_t * free_p);
+static lv_fs_res_t posix_dir_open(lv_fs_drv_t * drv, void * rddir_p, const char * path);
+#endif
+
+#if USE_MMAP_FS
+static lv_fs_res_t mmap_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t mmap_close(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t mmap_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t mmap_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos);
+static lv_fs_res_t mmap_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t mmap_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+static lv_fs_res_t mmap_direct(lv_fs_drv_t * drv, void * file_p, const void ** data_p, uint32_t * size_p);
+static lv_fs_res_t mmap_dir_open(lv_fs_drv_t * drv, void * rddir_p, const char * path);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if USE_POSIX_FS
+/**
+ * Register a file system driver which uses the POSIX file functions (open, read, etc.)
+ * Its letter is POSIX_FS_LETTER.
+ */
+void posix_fs_init(void)
+{
+    lv_fs_drv_t drv;
+    lv_fs_drv_init(&drv);
+
+    drv.letter = POSIX_FS_LETTER;
+    drv.file_size = sizeof(int);
+    drv.rddir_size = sizeof(DIR *);
+    drv.open_cb = posix_open;
+    drv.close_cb = posix_close;
+    drv.remove_cb = posix_remove;
+    drv.read_cb = posix_read;
+    drv.write_cb = posix_write;
+    drv.seek_cb = posix_seek;
+    drv.tell_cb = posix_tell;
+    drv.trunc_cb = posix_trunc;
+    drv.size_cb = posix_size;
+    drv.rename_cb = posix_rename;
+    drv.free_space_cb = posix_free_space;
+    drv.dir_open_cb = posix_dir_open;
+    drv.dir_read_cb = dir_read;
+    drv.dir_close_cb = dir_close;
+
+    lv_fs_drv_register(&drv);
+}
+#endif
+
+#if USE_MMAP_FS
+/**
+ * Register a read only file system driver which maps the files into the memory.
+ * Its letter is MMAP_FS_LETTER.
+ * The reads are simple copies and `lv_fs_get_direct()` gives the content of the files in place,
+ * so the decoders can use it without reading it into a buffer.
+ */
+void mmap_fs_init(void)
+{
+    lv_fs_drv_t drv;
+    lv_fs_drv_init(&drv);
+
+    drv.letter = MMAP_FS_LETTER;
+    drv.file_size = sizeof(mmap_fs_file_t);
+    drv.rddir_size = sizeof(DIR *);
+    drv.open_cb = mmap_open;
+    drv.close_cb = mmap_close;
+    drv.read_cb = mmap_read;
+    drv.seek_cb = mmap_seek;
+    drv.tell_cb = mmap_tell;
+    drv.size_cb = mmap_size;
+    drv.direct_cb = mmap_direct;
+    drv.dir_open_cb = mmap_dir_open;
+    drv.dir_read_cb = dir_read;
+    drv.dir_close_cb = dir_close;
+
+    lv_fs_drv_register(&drv);
+}
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Convert an `errno` value to an lv_fs result
+ * @param e the `errno` value
+ * @return the matching lv_fs_res_t
+ */
+static lv_fs_res_t errno_to_res(int e)
+{
+    switch(e) {
+        case ENOENT:
+        case ENOTDIR:
+            return LV_FS_RES_NOT_EX;
+        case EACCES:
+        case EPERM:
+        case EROFS:
+            return LV_FS_RES_DENIED;
+        case ENOSPC:
+            return LV_FS_RES_FULL;
+        case ENOMEM:
+            return LV_FS_RES_OUT_OF_MEM;
+        case EBUSY:
+        case EAGAIN:
+            return LV_FS_RES_BUSY;
+        case EIO:
+            return LV_FS_RES_HW_ERR;
+        case EINVAL:
+        case ENAMETOOLONG:
+            return LV_FS_RES_INV_PARAM;
+        default:
+            return LV_FS_RES_FS_ERR;
+    }
+}
+
+/**
+ * Prepend the root of the driver to a path
+ * @param buf store the path here. It should be `LV_FS_MAX_PATH_LENGTH` long.
+ * @param root the root of the driver
+ * @param path the path without the driver letter
+ * @return true: ok; false: the path is too long
+ */
+static bool make_path(char * buf, const char * root, const char * path)
+{
+    int len = snprintf(buf, LV_FS_MAX_PATH_LENGTH, "%s%s", root, path);
+    return len >= 0 && len < LV_FS_MAX_PATH_LENGTH;
+}
+
+/**
+ * Open a directory
+ * @param rddir_p pointer to a `DIR *` variable
+ * @param root the root of the driver
+ * @param path path to the directory
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t dir_open(void * rddir_p, const char * root, const char * path)
+{
+    char buf[LV_FS_MAX_PATH_LENGTH];
+    if(!make_path(buf, root, path)) return LV_FS_RES_INV_PARAM;
+
+    DIR * dir = opendir(buf);
+    if(dir == NULL) return errno_to_res(errno);
+
+    *(DIR **)rddir_p = dir;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Read the next entry of a directory. The name of the directories begins with '/'.
+ * @param drv pointer to a driver where this function belongs
+ * @param rddir_p pointer to a `DIR *` variable
+ * @param fn store the name here or an empty string if there are no more entries
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t dir_read(lv_fs_drv_t * drv, void * rddir_p, char * fn)
+{
+    (void) drv;     /*Unused*/
+
+    DIR * dir = *(DIR **)rddir_p;
+    while(1) {
+        errno = 0;
+        struct dirent * entry = readdir(dir);
+        if(entry == NULL) {
+            fn[0] = '\0';
+            return errno ? errno_to_res(errno) : LV_FS_RES_OK;
+        }
+
+        if(strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+
+        bool is_dir = entry->d_type == DT_DIR;
+        if(entry->d_type == DT_UNKNOWN) {
+            struct stat st;
+            is_dir = fstatat(dirfd(dir), entry->d_name, &st, 0) == 0 && S_ISDIR(st.st_mode);
+        }
+
+        /*Skip the names which don't fit, they couldn't be opened anyway*/
+        size_t len = strlen(entry->d_name);
+        if(len + is_dir >= LV_FS_MAX_FN_LENGTH) continue;
+
+        if(is_dir) fn[0] = '/';
+        memcpy(&fn[is_dir], entry->d_name, len + 1);
+        break;
+    }
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Close a directory
+ * @param drv pointer to a driver where this function belongs
+ * @param rddir_p pointer to a `DIR *` variable
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t dir_close(lv_fs_drv_t * drv, void * rddir_p)
+{
+    (void) drv;     /*Unused*/
+
+    if(closedir(*(DIR **)rddir_p) != 0) return errno_to_res(errno);
+    return LV_FS_RES_OK;
+}
+
+#if USE_POSIX_FS
+/**
+ * Open a file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to an `int` to store the file descriptor
+ * @param path path to the file (without the driver letter)
+ * @param mode read: LV_FS_MODE_RD, write: LV_FS_MODE_WR, both: LV_FS_MODE_RD | LV_FS_MODE_WR
+ *             (LV_FS_MODE_WR alone truncates the file, like `fopen(path, "wb")`)
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t posix_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode)
+{
+    (void) drv;     /*Unused*/
+
+    char buf[LV_FS_MAX_PATH_LENGTH];
+    if(!make_path(buf, POSIX_FS_ROOT, path)) return LV_FS_RES_INV_PARAM;
+
+    int flags;
+    if(mode == (LV_FS_MODE_WR | LV_FS_MODE_RD)) flags = O_RDWR | O_CREAT;
+    else if(mode == LV_FS_MODE_WR) flags = O_WRONLY | O_CREAT | O_TRUNC;
+    else flags = O_RDONLY;
+
+    int fd = open(buf, flags | O_CLOEXEC, 0644);
+    if(fd < 0) return errno_to_res(errno);
+
+    *(int *)file_p = fd;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Close a file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to the file descriptor
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t posix_close(lv_fs_drv_t * drv, void * file_p)
+{
+    (void) drv;     /*Unused*/
+
+    if(close(*(int *)file_p) != 0) return errno_to_res(errno);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Delete a file
+ * @param drv pointer to a driver where this function belongs
+ * @param path path of the file to delete (without the driver letter)
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t posix_remove(lv_fs_drv_t * drv, const char * path)
+{
+    (void) drv;     /*Unused*/
+
+    char buf[LV_FS_MAX_PATH_LENGTH];
+    if(!make_path(buf, POSIX_FS_ROOT, path)) return LV_FS_RES_INV_PARAM;
+
+    if(unlink(buf) != 0) return errno_to_res(errno);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Read from a file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to the file descriptor
+ * @param buf pointer to a buffer where the read bytes are stored
+ * @param btr Bytes To Read
+ * @param br the number of real read bytes (Bytes Read)
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t posix_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    (void) drv;     /*Unused*/
+
+    ssize_t n;
+    do {
+        n = read(*(int *)file_p, buf, btr);
+    } while(n < 0 && errno == EINTR);
+
+    if(n < 0) {
+        *br = 0;
+        return errno_to_res(errno);
+    }
+
+    *br = (uint32_t)n;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Write into a file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to the file descriptor
+ * @param buf pointer to a buffer with the bytes to write
+ * @param btw Bytes To Write
+ * @param bw the number of real written bytes (Bytes Written)
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t posix_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw)
+{
+    (void) drv;     /*Unused*/
+
+    ssize_t n;
+    do {
+        n = write(*(int *)file_p, buf, btw);
+    } while(n < 0 && errno == EINTR);
+
+    if(n < 0) {
+        *bw = 0;
+        return errno_to_res(errno);
+    }
+
+    *bw = (uint32_t)n;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Set the read write pointer
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to the file descriptor
+ * @param pos the new position from the beginning of the file
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t posix_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos)
+{
+    (void) drv;     /*Unused*/
+
+    if(lseek(*(int *)file_p, pos, SEEK_SET) < 0) return errno_to_res(errno);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the position of the read write pointer
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to the file descriptor
+ * @param pos_p store the position here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t posix_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    (void) drv;     /*Unused*/
+
+    off_t pos = lseek(*(int *)file_p, 0, SEEK_CUR);
+    if(pos < 0) return errno_to_res(errno);
+
+    *pos_p = (uint32_t)pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Truncate the file to the position of the read write pointer
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to the file descriptor
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t posix_trunc(lv_fs_drv_t * drv, void * file_p)
+{
+    (void) drv;     /*Unused*/
+
+    int fd = *(int *)file_p;
+    off_t pos = lseek(fd, 0, SEEK_CUR);
+    if(pos < 0 || ftruncate(fd, pos) != 0) return errno_to_res(errno);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the size of a file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to the file descriptor
+ * @param size_p store the size here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t posix_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p)
+{
+    (void) drv;     /*Unused*/
+
+    struct stat st;
+    if(fstat(*(int *)file_p, &st) != 0) return errno_to_res(errno);
+
+    *size_p = (uint32_t)st.st_size;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Rename a file
+ * @param drv pointer to a driver where this function belongs
+ * @param oldname path to the file (without the driver letter)
+ * @param newname the new path (without the driver letter)
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t posix_rename(lv_fs_drv_t * drv, const char * oldname, const char * newname)
+{
+    (void) drv;     /*Unused*/
+
+    char old_buf[LV_FS_MAX_PATH_LENGTH];
+    char new_buf[LV_FS_MAX_PATH_LENGTH];
+    if(!make_path(old_buf, POSIX_FS_ROOT, oldname)) return LV_FS_RES_INV_PARAM;
+    if(!make_path(new_buf, POSIX_FS_ROOT, newname)) return LV_FS_RES_INV_PARAM;
+
+    if(rename(old_buf, new_buf) != 0) return errno_to_res(errno);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Get the total and free size of the file system of the root
+ * @param drv pointer to a driver where this function belongs
+ * @param total_p store the total size here [kB]
+ * @param free_p store the size available for the application here [kB]
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t posix_free_space(lv_fs_drv_t * drv, uint32_t * total_p, uint32_t * free_p)
+{
+    (void) drv;     /*Unused*/
+
+    struct statvfs st;
+    if(statvfs(POSIX_FS_ROOT[0] ? POSIX_FS_ROOT : ".", &st) != 0) return errno_to_res(errno);
+
+    *total_p = (uint32_t)(((uint64_t)st.f_blocks * st.f_frsize) >> 10);
+    *free_p = (uint32_t)(((uint64_t)st.f_bavail * st.f_frsize) >> 10);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Open a directory
+ * @param drv pointer to a driver where this function belongs
+ * @param rddir_p pointer to a `DIR *` variable
+ * @param path path to the directory (without the driver letter)
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t posix_dir_open(lv_fs_drv_t * drv, void * rddir_p, const char * path)
+{
+    (void) drv;     /*Unused*/
+
+    return dir_open(rddir_p, POSIX_FS_ROOT, path);
+}
+#endif /*USE_POSIX_FS*/
+
+#if USE_MMAP_FS
+/**
+ * Open a file and map it into the memory. Only reading is supported.
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `mmap_fs_file_t` variable
+ * @param path path to the file (without the driver letter)
+ * @param mode only LV_FS_MODE_RD
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t mmap_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode)
+{
+    (void) drv;     /*Unused*/
+
+    if(mode & LV_FS_MODE_WR) return LV_FS_RES_DENIED;
+
+    char buf[LV_FS_MAX_PATH_LENGTH];
+    if(!make_path(buf, MMAP_FS_ROOT, path)) return LV_FS_RES_INV_PARAM;
+
+    int fd = open(buf, O_RDONLY | O_CLOEXEC);
+    if(fd < 0) return errno_to_res(errno);
+
+    struct stat st;
+    if(fstat(fd, &st) != 0) {
+        lv_fs_res_t res = errno_to_res(errno);
+        close(fd);
+        return res;
+    }
+
+    if(!S_ISREG(st.st_mode) || (uint64_t)st.st_size > UINT32_MAX) {
+        close(fd);
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    mmap_fs_file_t * file = file_p;
+    file->data = NULL;
+    file->size = (uint32_t)st.st_size;
+    file->pos = 0;
+
+    /*Empty files can't be mapped*/
+    if(file->size > 0) {
+        void * data = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED) {
+            lv_fs_res_t res = errno_to_res(errno);
+            close(fd);
+            return res;
+        }
+
+        /*The files are usually read to the end (images, fonts) so let the kernel read ahead*/
+        madvise(data, file->size, MADV_WILLNEED);
+        file->data = data;
+    }
+
+    /*The mapping remains valid without the descriptor*/
+    close(fd);
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Unmap a file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `mmap_fs_file_t` variable
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t mmap_close(lv_fs_drv_t * drv, void * file_p)
+{
+    (void) drv;     /*Unused*/
+
+    mmap_fs_file_t * file = file_p;
+    if(file->data && munmap((void *)file->data, file->size) != 0) return errno_to_res(errno);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Copy from a mapped file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `mmap_fs_file_t` variable
+ * @param buf pointer to a buffer where the read bytes are stored
+ * @param btr Bytes To Read
+ * @param br the number of real read bytes (Bytes Read)
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t mmap_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    (void) drv;     /*Unused*/
+
+    mmap_fs_file_t * file = file_p;
+    uint32_t n = 0;
+    if(file->pos < file->size) {
+        n = LV_MATH_MIN(btr, file->size - file->pos);
+        memcpy(buf, file->data + file->pos, n);
+        file->pos += n;
+    }
+
+    *br = n;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Set the read pointer
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `mmap_fs_file_t` variable
+ * @param pos the new position from the beginning of the file
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t mmap_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos)
+{
+    (void) drv;     /*Unused*/
+
+    mmap_fs_file_t * file = file_p;
+    file->pos = pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the position of the read pointer
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `mmap_fs_file_t` variable
+ * @param pos_p store the position here
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t mmap_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    (void) drv;     /*Unused*/
+
+    mmap_fs_file_t * file = file_p;
+    *pos_p = file->pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the size of a mapped file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `mmap_fs_file_t` variable
+ * @param size_p store the size here
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t mmap_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p)
+{
+    (void) drv;     /*Unused*/
+
+    mmap_fs_file_t * file = file_p;
+    *size_p = file->size;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the content of a mapped file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `mmap_fs_file_t` variable
+ * @param data_p store the pointer to the first byte here. It's valid until the file is closed.
+ * @param size_p store the size here
+ * @return LV_FS_RES_OK or LV_FS_RES_NOT_EX if the file is empty
+ */
+static lv_fs_res_t mmap_direct(lv_fs_drv_t * drv, void * file_p, const void ** data_p, uint32_t * size_p)
+{
+    (void) drv;     /*Unused*/
+
+    mmap_fs_file_t * file = file_p;
+    if(file->data == NULL) return LV_FS_RES_NOT_EX;
+
+    *data_p = file->data;
+    *size_p = file->size;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Open a directory
+ * @param drv pointer to a driver where this function belongs
+ * @param rddir_p pointer to a `DIR *` variable
+ * @param path path to the directory (without the driver letter)
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t mmap_dir_open(lv_fs_drv_t * drv, void * rddir_p, const char * path)
+{
+    (void) drv;     /*Unused*/
+
+    return dir_open(rddir_p, MMAP_FS_ROOT, path);
+}
+#endif /*USE_MMAP_FS*/
+
+#endif /*LV_USE_FILESYSTEM*/
+#endif /*USE_POSIX_FS || USE_MMAP_FS*/
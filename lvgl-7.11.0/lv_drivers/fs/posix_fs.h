@@ -0,0 +1,76 @@
+/**
+ * @file posix_fs.h
+ *
+ */
+
+#ifndef POSIX_FS_H
+#define POSIX_FS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifndef LV_DRV_NO_CONF
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_drv_conf.h"
+#else
+#include "../../lv_drv_conf.h"
+#endif
+#endif
+
+#if USE_POSIX_FS || USE_MMAP_FS
+
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+#if LV_USE_FILESYSTEM
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if USE_POSIX_FS
+/**
+ * Register a file system driver which uses the POSIX file functions (open, read, etc.)
+ * Its letter is POSIX_FS_LETTER.
+ */
+void posix_fs_init(void);
+#endif
+
+#if USE_MMAP_FS
+/**
+ * Register a read only file system driver which maps the files into the memory.
+ * Its letter is MMAP_FS_LETTER.
+ * The reads are simple copies and `lv_fs_get_direct()` gives the content of the files in place,
+ * so the decoders can use it without reading it into a buffer.
+ */
+void mmap_fs_init(void);
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_FILESYSTEM */
+
+#endif /* USE_POSIX_FS || USE_MMAP_FS */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* POSIX_FS_H */
@@ -400,6 +400,43 @@
 /*No settings*/
 #endif
 
+/*********************
+ *  FILE SYSTEMS
+ *********************/
+
+/*-----------------------------------------
+ *  POSIX file system (open, read, etc.)
+ *-----------------------------------------*/
+#ifdef __linux__
+# ifndef USE_POSIX_FS
+#  define USE_POSIX_FS        1
+# endif
+#else /* __linux__ */
+# define USE_POSIX_FS         0
+#endif /* __linux__ */
+
+#if USE_POSIX_FS
+#  define POSIX_FS_LETTER     'P'       /*Drive letter of the file system*/
+#  define POSIX_FS_ROOT       ""        /*Prepended to the paths. E.g. "/" to use absolute paths*/
+#endif
+
+/*-----------------------------------------
+ *  Memory mapped, read only files (mmap)
+ *  Decoders can use the content in place
+ *-----------------------------------------*/
+#ifdef __linux__
+# ifndef USE_MMAP_FS
+#  define USE_MMAP_FS         1
+# endif
+#else /* __linux__ */
+# define USE_MMAP_FS          0
+#endif /* __linux__ */
+
+#if USE_MMAP_FS
+#  define MMAP_FS_LETTER      'M'       /*Drive letter of the file system*/
+#  define MMAP_FS_ROOT        ""        /*Prepended to the paths. E.g. "/" to use absolute paths*/
+#endif
+
 #endif  /*LV_DRV_CONF_H*/
 
 #endif /*End of "Content enable"*/
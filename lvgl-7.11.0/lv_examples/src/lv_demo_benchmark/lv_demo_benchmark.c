@@ -41,6 +41,8 @@
 #define LINE_POINT_NUM  16
 #define LINE_POINT_DIFF_MIN (LV_DPI / 10)
 #define LINE_POINT_DIFF_MAX LV_MATH_MAX(LV_HOR_RES / (LINE_POINT_NUM + 2), LINE_POINT_DIFF_MIN * 2)
+#define LINE_MANY_OBJ_NUM   2
+#define LINE_MANY_POINT_NUM 2000
 #define ARC_WIDTH_THIN LV_MATH_MAX(LV_DPI / 50, 2)
 #define ARC_WIDTH_THICK LV_MATH_MAX(LV_DPI / 10, 5)
 /**********************
@@ -82,6 +84,7 @@ static void rect_create(lv_style_t * style);
 static void img_create(lv_style_t * style, const void * src, bool rotate, bool zoom, bool aa);
 static void txt_create(lv_style_t * style);
 static void line_create(lv_style_t * style);
+static void line_many_create(lv_style_t * style);
 static void arc_create(lv_style_t * style);
 static void fall_anim(lv_obj_t * obj);
 static void rnd_reset(void);
@@ -435,6 +438,14 @@ static void line_cb(void)
 
 }
 
+static void line_many_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_line_width(&style_common, LV_STATE_DEFAULT, LINE_WIDTH);
+    lv_style_set_line_opa(&style_common, LV_STATE_DEFAULT, opa_mode ? LV_OPA_50 : LV_OPA_COVER);
+    line_many_create(&style_common);
+}
+
 static void arc_think_cb(void)
 {
 
@@ -590,6 +601,7 @@ static scene_dsc_t scenes[] = {
         {.name = "Text large compressed",       .weight = 10, .create_cb = txt_large_compr_cb},
 
         {.name = "Line",                        .weight = 10, .create_cb = line_cb},
+        {.name = "Line many points",            .weight = 10, .create_cb = line_many_cb},
 
         {.name = "Arc think",                   .weight = 10, .create_cb = arc_think_cb},
         {.name = "Arc thick",                   .weight = 10, .create_cb = arc_thick_cb},
@@ -957,6 +969,30 @@ static void line_create(lv_style_t * style)
     }
 }
 
+static void line_many_create(lv_style_t * style)
+{
+    static lv_point_t points[LINE_MANY_OBJ_NUM][LINE_MANY_POINT_NUM];
+
+    uint32_t i;
+    for(i = 0; i < LINE_MANY_OBJ_NUM; i++) {
+        /*Many points across the screen like a chart of a long signal*/
+        uint32_t j;
+        for(j = 0; j < LINE_MANY_POINT_NUM; j++) {
+            points[i][j].x = (lv_coord_t)((j * LV_HOR_RES) / LINE_MANY_POINT_NUM);
+            points[i][j].y = rnd_next(0, LV_VER_RES / 3);
+        }
+
+        lv_obj_t * obj = lv_line_create(scene_bg, NULL);
+        lv_obj_reset_style_list(obj, LV_OBJ_PART_MAIN);
+        lv_obj_add_style(obj, LV_OBJ_PART_MAIN, style);
+        lv_obj_set_style_local_line_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, lv_color_hex(rnd_next(0, 0xFFFFF0)));
+
+        lv_line_set_points(obj, points[i], LINE_MANY_POINT_NUM);
+        lv_line_set_auto_size(obj, true);
+
+        fall_anim(obj);
+    }
+}
 
 static void arc_create(lv_style_t * style)
 {
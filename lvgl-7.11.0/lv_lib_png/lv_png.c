@@ -88,8 +88,8 @@ static lv_res_t decoder_info(struct _lv_img_decoder * decoder, const void * src,
              lv_fs_seek(&f, 16);
              uint32_t rn;
              lv_fs_read(&f, &size, 8, &rn);
-             if(rn != 8) return LV_RES_INV;
              lv_fs_close(&f);
+             if(rn != 8) return LV_RES_INV;
 #else
              FILE* file;
              file = fopen(fn, "rb" );
@@ -143,6 +143,35 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
 
         if(!strcmp(&fn[strlen(fn) - 3], "png")) {              /*Check the extension*/
 
+            /*Decode the PNG image*/
+            uint32_t png_width;             /*Will be the width of the decoded image*/
+            uint32_t png_height;            /*Will be the width of the decoded image*/
+
+#if LV_PNG_USE_LV_FILESYSTEM
+            lv_fs_file_t f;
+            if(lv_fs_open(&f, fn, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RES_INV;
+
+            /*Decode the file in place if the driver has it in memory (e.g. mmap), else load it*/
+            const void * map;
+            uint32_t map_size;
+            if(lv_fs_get_direct(&f, &map, &map_size) == LV_FS_RES_OK) {
+                error = lodepng_decode32(&img_data, &png_width, &png_height, map, map_size);
+            }
+            else {
+                unsigned char * png_data = NULL;
+                uint32_t png_data_size = 0;
+                error = 78;     /*lodepng's "failed to open file for reading"*/
+                if(lv_fs_size(&f, &png_data_size) == LV_FS_RES_OK) {
+                    png_data = malloc(png_data_size);
+                    uint32_t br = 0;
+                    if(png_data && lv_fs_read(&f, png_data, png_data_size, &br) == LV_FS_RES_OK && br == png_data_size) {
+                        error = lodepng_decode32(&img_data, &png_width, &png_height, png_data, png_data_size);
+                    }
+                }
+                free(png_data);
+            }
+            lv_fs_close(&f);
+#else
             /*Load the PNG file into buffer. It's still compressed (not decoded)*/
             unsigned char * png_data;      /*Pointer to the loaded data. Same as the original file just loaded into the RAM*/
             size_t png_data_size;          /*Size of `png_data` in bytes*/
@@ -153,13 +182,10 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 return LV_RES_INV;
             }
 
-            /*Decode the PNG image*/
-            uint32_t png_width;             /*Will be the width of the decoded image*/
-            uint32_t png_height;            /*Will be the width of the decoded image*/
-
             /*Decode the loaded image in ARGB8888 */
             error = lodepng_decode32(&img_data, &png_width, &png_height, png_data, png_data_size);
             free(png_data); /*Free the loaded file*/
+#endif
             if(error) {
                 printf("error %u: %s\n", error, lodepng_error_text(error));
                 return LV_RES_INV;
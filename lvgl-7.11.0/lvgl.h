@@ -35,6 +35,8 @@ extern "C" {
 
 #include "src/lv_core/lv_refr.h"
 #include "src/lv_core/lv_disp.h"
+#include "src/lv_core/lv_cmdq.h"
+#include "src/lv_core/lv_hit_index.h"
 
 #include "src/lv_themes/lv_theme.h"
 
@@ -231,6 +231,17 @@
 #    define  LV_MEM_AUTO_DEFRAG  1
 #  endif
 #endif
+
+/* 1: Use a TLSF (Two-Level Segregated Fit) allocator in the work memory instead of first-fit.
+ * Allocation and free take constant time regardless of the number of blocks and the fragmentation.
+ * The free blocks are always joined immediately so `LV_MEM_AUTO_DEFRAG` is not used.*/
+#ifndef LV_MEM_TLSF
+#  ifdef CONFIG_LV_MEM_TLSF
+#    define LV_MEM_TLSF CONFIG_LV_MEM_TLSF
+#  else
+#    define  LV_MEM_TLSF         0
+#  endif
+#endif
 #else       /*LV_MEM_CUSTOM*/
 #ifndef LV_MEM_CUSTOM_INCLUDE
 #  ifdef CONFIG_LV_MEM_CUSTOM_INCLUDE
@@ -255,6 +266,61 @@
 #endif
 #endif     /*LV_MEM_CUSTOM*/
 
+/* 1: Collect a histogram of the `lv_mem_alloc` latencies. Read it with `lv_mem_monitor()`.
+ * `LV_MEM_LATENCY_TIME_EXPR` should give a high resolution time stamp in any unit (e.g. CPU cycles or ns)*/
+#ifndef LV_MEM_LATENCY_HIST
+#  ifdef CONFIG_LV_MEM_LATENCY_HIST
+#    define LV_MEM_LATENCY_HIST CONFIG_LV_MEM_LATENCY_HIST
+#  else
+#    define  LV_MEM_LATENCY_HIST     0
+#  endif
+#endif
+#if LV_MEM_LATENCY_HIST
+#ifndef LV_MEM_LATENCY_TIME_INCLUDE
+#  ifdef CONFIG_LV_MEM_LATENCY_TIME_INCLUDE
+#    define LV_MEM_LATENCY_TIME_INCLUDE CONFIG_LV_MEM_LATENCY_TIME_INCLUDE
+#  else
+#    define  LV_MEM_LATENCY_TIME_INCLUDE  "something.h"   /*Header for the time stamp function*/
+#  endif
+#endif
+#ifndef LV_MEM_LATENCY_TIME_EXPR
+#  ifdef CONFIG_LV_MEM_LATENCY_TIME_EXPR
+#    define LV_MEM_LATENCY_TIME_EXPR CONFIG_LV_MEM_LATENCY_TIME_EXPR
+#  else
+#    define  LV_MEM_LATENCY_TIME_EXPR     (cycle_cnt())   /*Expression evaluating to a 32 bit time stamp*/
+#  endif
+#endif
+#endif
+
+/* 1: Keep the temporary buffers of the drawing (`_lv_mem_buf_get()`) in power of 2 size classes.
+ * Getting and releasing a buffer takes constant time and the buffers are not freed after every refresh
+ * but kept up to the most used at the same time in the last `LV_MEM_BUF_POOL_KEEP` refreshes.
+ * `LV_MEM_BUF_POOL_ATTR` can be set to e.g. `__thread` to give every rendering thread its own pool.
+ * (`lv_mem_alloc` needs to be thread safe for that, e.g. `LV_MEM_CUSTOM` with a thread safe `malloc`)*/
+#ifndef LV_MEM_BUF_POOL
+#  ifdef CONFIG_LV_MEM_BUF_POOL
+#    define LV_MEM_BUF_POOL CONFIG_LV_MEM_BUF_POOL
+#  else
+#    define  LV_MEM_BUF_POOL         0
+#  endif
+#endif
+#if LV_MEM_BUF_POOL
+#ifndef LV_MEM_BUF_POOL_KEEP
+#  ifdef CONFIG_LV_MEM_BUF_POOL_KEEP
+#    define LV_MEM_BUF_POOL_KEEP CONFIG_LV_MEM_BUF_POOL_KEEP
+#  else
+#    define  LV_MEM_BUF_POOL_KEEP  64
+#  endif
+#endif
+#ifndef LV_MEM_BUF_POOL_ATTR
+#  ifdef CONFIG_LV_MEM_BUF_POOL_ATTR
+#    define LV_MEM_BUF_POOL_ATTR CONFIG_LV_MEM_BUF_POOL_ATTR
+#  else
+#    define  LV_MEM_BUF_POOL_ATTR
+#  endif
+#endif
+#endif
+
 /* Use the standard memcpy and memset instead of LVGL's own functions.
  * The standard functions might or might not be faster depending on their implementation. */
 #ifndef LV_MEMCPY_MEMSET_STD
@@ -265,6 +331,72 @@
 #  endif
 #endif
 
+/* 1: Allocate the objects from per widget type slabs.
+ * The object, its ext. data and its first few style pointers are allocated in one block
+ * and the blocks of the deleted objects are kept for reuse. Not supported with `LV_ENABLE_GC`*/
+#ifndef LV_OBJ_SLAB
+#  ifdef CONFIG_LV_OBJ_SLAB
+#    define LV_OBJ_SLAB CONFIG_LV_OBJ_SLAB
+#  else
+#    define  LV_OBJ_SLAB             0
+#  endif
+#endif
+#if LV_OBJ_SLAB
+#ifndef LV_OBJ_SLAB_CLASS_CNT
+#  ifdef CONFIG_LV_OBJ_SLAB_CLASS_CNT
+#    define LV_OBJ_SLAB_CLASS_CNT CONFIG_LV_OBJ_SLAB_CLASS_CNT
+#  else
+#    define  LV_OBJ_SLAB_CLASS_CNT   32  /*Number of slabs (widget types with different ext. data size)*/
+#  endif
+#endif
+#ifndef LV_OBJ_SLAB_STYLE_CNT
+#  ifdef CONFIG_LV_OBJ_SLAB_STYLE_CNT
+#    define LV_OBJ_SLAB_STYLE_CNT CONFIG_LV_OBJ_SLAB_STYLE_CNT
+#  else
+#    define  LV_OBJ_SLAB_STYLE_CNT   2   /*Number of style pointers allocated together with the object*/
+#  endif
+#endif
+#ifndef LV_OBJ_SLAB_CACHE_CNT
+#  ifdef CONFIG_LV_OBJ_SLAB_CACHE_CNT
+#    define LV_OBJ_SLAB_CACHE_CNT CONFIG_LV_OBJ_SLAB_CACHE_CNT
+#  else
+#    define  LV_OBJ_SLAB_CACHE_CNT   16  /*Max. number of free blocks kept in a slab for reuse*/
+#  endif
+#endif
+#endif
+
+/* 1: Cache the resolved style properties of the objects' parts.
+ * A resolved value (after checking the state, the styles of the part and the inherited ones)
+ * is stored in a small hash table of the style list and reused until the styles or states change.
+ * Costs (LV_STYLE_RES_CACHE_MAX * 16) bytes per style list in the worst case (64 bit).
+ * Call `lv_obj_report_style_mod()` after modifying an already added style.*/
+#ifndef LV_STYLE_RES_CACHE
+#  ifdef CONFIG_LV_STYLE_RES_CACHE
+#    define LV_STYLE_RES_CACHE CONFIG_LV_STYLE_RES_CACHE
+#  else
+#    define  LV_STYLE_RES_CACHE      0
+#  endif
+#endif
+#if LV_STYLE_RES_CACHE
+#ifndef LV_STYLE_RES_CACHE_MAX
+#  ifdef CONFIG_LV_STYLE_RES_CACHE_MAX
+#    define LV_STYLE_RES_CACHE_MAX CONFIG_LV_STYLE_RES_CACHE_MAX
+#  else
+#    define  LV_STYLE_RES_CACHE_MAX  64  /*Max. number of slots in the table of a style list. Must be a power of 2*/
+#  endif
+#endif
+#endif
+
+/* 1: Enable `lv_style_freeze()` to index the properties of a style with a hash table.
+ * It makes the look up in styles with many properties faster. The material theme freezes its large styles.*/
+#ifndef LV_STYLE_INDEX
+#  ifdef CONFIG_LV_STYLE_INDEX
+#    define LV_STYLE_INDEX CONFIG_LV_STYLE_INDEX
+#  else
+#    define  LV_STYLE_INDEX          0
+#  endif
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #ifndef LV_ENABLE_GC
@@ -370,6 +502,26 @@
 #  endif
 #endif
 
+/* 1: Index the children of the objects with many children in a grid to find the pressed object faster.
+ * An object is indexed after at least `LV_INDEV_HIT_INDEX_MIN_CHILD` children were checked in one search.
+ * The index follows the moved children and it needs no update when the parent is scrolled.*/
+#ifndef LV_INDEV_HIT_INDEX
+#  ifdef CONFIG_LV_INDEV_HIT_INDEX
+#    define LV_INDEV_HIT_INDEX CONFIG_LV_INDEV_HIT_INDEX
+#  else
+#    define  LV_INDEV_HIT_INDEX      0
+#  endif
+#endif
+#if LV_INDEV_HIT_INDEX
+#ifndef LV_INDEV_HIT_INDEX_MIN_CHILD
+#  ifdef CONFIG_LV_INDEV_HIT_INDEX_MIN_CHILD
+#    define LV_INDEV_HIT_INDEX_MIN_CHILD CONFIG_LV_INDEV_HIT_INDEX_MIN_CHILD
+#  else
+#    define  LV_INDEV_HIT_INDEX_MIN_CHILD  32   /*Min. number of children to index*/
+#  endif
+#endif
+#endif
+
 /*==================
  * Feature usage
  *==================*/
@@ -386,6 +538,18 @@
 
 /*Declare the type of the user data of animations (can be e.g. `void *`, `int`, `struct`)*/
 
+/* 1: Sample the animations exactly once per display refresh instead of in a separate task.
+ * The refresh task of the default display drives the animation clock
+ * (or the vsync if the display driver calls `lv_anim_frame_vsync()`).
+ * This way no intermediate animation steps are applied between two refreshes.*/
+#ifndef LV_ANIM_FRAME_SYNC
+#  ifdef CONFIG_LV_ANIM_FRAME_SYNC
+#    define LV_ANIM_FRAME_SYNC CONFIG_LV_ANIM_FRAME_SYNC
+#  else
+#    define  LV_ANIM_FRAME_SYNC      0
+#  endif
+#endif
+
 #endif
 
 /* 1: Enable shadow drawing on rectangles*/
@@ -410,6 +574,27 @@
 #endif
 #endif
 
+/* Cache the colors of rectangle gradients to reuse them in the next display buffer bands and refreshes.
+ * The size of the cache in bytes. A gradient needs `size * sizeof(lv_color_t)` bytes.
+ * 0: compute the colors in every draw*/
+#ifndef LV_GRAD_CACHE_SIZE
+#  ifdef CONFIG_LV_GRAD_CACHE_SIZE
+#    define LV_GRAD_CACHE_SIZE CONFIG_LV_GRAD_CACHE_SIZE
+#  else
+#    define  LV_GRAD_CACHE_SIZE      0
+#  endif
+#endif
+
+/* 1: Use ordered dithering on rectangle gradients to avoid banding with `LV_COLOR_DEPTH  16`.
+ * With a gradient cache dithered gradients need 4 times more space.*/
+#ifndef LV_DITHER_GRADIENT
+#  ifdef CONFIG_LV_DITHER_GRADIENT
+#    define LV_DITHER_GRADIENT CONFIG_LV_DITHER_GRADIENT
+#  else
+#    define  LV_DITHER_GRADIENT      0
+#  endif
+#endif
+
 /*1: enable outline drawing on rectangles*/
 #ifndef LV_USE_OUTLINE
 #  ifdef CONFIG_LV_USE_OUTLINE
@@ -541,6 +726,27 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #endif
 #if LV_USE_FILESYSTEM
 /*Declare the type of the user data of file system drivers (can be e.g. `void *`, `int`, `struct`)*/
+
+/*Number of blocks in the read cache shared by all the open files (0: disable).
+ *A read which misses the cache reads the whole block from the driver (read-ahead)
+ *into the place of the least recently used block.
+ *It also counts the I/O of the drivers (see `lv_fs_get_stat()`)*/
+#ifndef LV_FS_CACHE_BLOCK_CNT
+#  ifdef CONFIG_LV_FS_CACHE_BLOCK_CNT
+#    define LV_FS_CACHE_BLOCK_CNT CONFIG_LV_FS_CACHE_BLOCK_CNT
+#  else
+#    define  LV_FS_CACHE_BLOCK_CNT   0
+#  endif
+#endif
+
+/*Size of a cache block in bytes, i.e. the size of the read-ahead*/
+#ifndef LV_FS_CACHE_BLOCK_SIZE
+#  ifdef CONFIG_LV_FS_CACHE_BLOCK_SIZE
+#    define LV_FS_CACHE_BLOCK_SIZE CONFIG_LV_FS_CACHE_BLOCK_SIZE
+#  else
+#    define  LV_FS_CACHE_BLOCK_SIZE  512
+#  endif
+#endif
 #endif
 
 /*1: Add a `user_data` to drivers and objects*/
@@ -561,6 +767,32 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/*1: Enable a queue to post UI updates from other threads (e.g. `lv_cmdq_set_text()`).
+ * The commands are executed in `lv_task_handler()`. Requires GCC or Clang atomic built-ins*/
+#ifndef LV_USE_CMDQ
+#  ifdef CONFIG_LV_USE_CMDQ
+#    define LV_USE_CMDQ CONFIG_LV_USE_CMDQ
+#  else
+#    define  LV_USE_CMDQ             0
+#  endif
+#endif
+#if LV_USE_CMDQ
+#ifndef LV_CMDQ_SIZE
+#  ifdef CONFIG_LV_CMDQ_SIZE
+#    define LV_CMDQ_SIZE CONFIG_LV_CMDQ_SIZE
+#  else
+#    define  LV_CMDQ_SIZE          32      /*Number of commands the queue can hold. Must be a power of 2*/
+#  endif
+#endif
+#ifndef LV_CMDQ_TEXT_MAX
+#  ifdef CONFIG_LV_CMDQ_TEXT_MAX
+#    define LV_CMDQ_TEXT_MAX CONFIG_LV_CMDQ_TEXT_MAX
+#  else
+#    define  LV_CMDQ_TEXT_MAX      128     /*Max. length of a text or file name in a command (with the terminating zero)*/
+#  endif
+#endif
+#endif
+
 /*1: Use the functions and types from the older API if possible */
 #ifndef LV_USE_API_EXTENSION_V6
 #  ifdef CONFIG_LV_USE_API_EXTENSION_V6
@@ -613,6 +845,18 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* Memory in bytes to cache rotated and zoomed images as ready-to-draw ARGB buffers.
+ * An image is cached only if it's drawn with the same angle and zoom for longer than a refresh period
+ * so animated images are still transformed on the fly.
+ * 0: disable the cache (requires `LV_USE_IMG_TRANSFORM 1`)*/
+#ifndef LV_IMG_CACHE_TRANSFORM_SIZE
+#  ifdef CONFIG_LV_IMG_CACHE_TRANSFORM_SIZE
+#    define LV_IMG_CACHE_TRANSFORM_SIZE CONFIG_LV_IMG_CACHE_TRANSFORM_SIZE
+#  else
+#    define  LV_IMG_CACHE_TRANSFORM_SIZE 0
+#  endif
+#endif
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 
 /*=====================
@@ -1522,6 +1766,17 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_USE_CANVAS   1
 #  endif
 #endif
+#if LV_USE_CANVAS
+/*1: Invalidate only the drawn area of the canvas and enable `lv_canvas_draw_begin/end()`
+ *   to draw many primitives with one dummy display*/
+#ifndef LV_CANVAS_DIRTY_AREA
+#  ifdef CONFIG_LV_CANVAS_DIRTY_AREA
+#    define LV_CANVAS_DIRTY_AREA CONFIG_LV_CANVAS_DIRTY_AREA
+#  else
+#    define  LV_CANVAS_DIRTY_AREA   0
+#  endif
+#endif
+#endif
 
 /*Check box (dependencies: lv_btn, lv_label)*/
 #ifndef LV_USE_CHECKBOX
@@ -1548,6 +1803,15 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_CHART_AXIS_TICK_LABEL_MAX_LEN    256
 #  endif
 #endif
+/*1: Decimate the lines with more points than pixel columns, redraw only the series on shift
+ *   and enable `lv_chart_set_next_array()` to add many points at once*/
+#ifndef LV_CHART_STREAM
+#  ifdef CONFIG_LV_CHART_STREAM
+#    define LV_CHART_STREAM CONFIG_LV_CHART_STREAM
+#  else
+#    define  LV_CHART_STREAM     0
+#  endif
+#endif
 #endif
 
 /*Container (dependencies: -*/
@@ -1558,6 +1822,18 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_USE_CONT     1
 #  endif
 #endif
+#if LV_USE_CONT
+/* 1: Don't refresh the layout and fit of the containers right away when their children change
+ * but mark them and refresh them once before the next frame is drawn (deepest first).
+ * Reading the coordinates of an object (e.g. `lv_obj_get_width()`) refreshes the pending containers.*/
+#ifndef LV_CONT_LAYOUT_DEFER
+#  ifdef CONFIG_LV_CONT_LAYOUT_DEFER
+#    define LV_CONT_LAYOUT_DEFER CONFIG_LV_CONT_LAYOUT_DEFER
+#  else
+#    define  LV_CONT_LAYOUT_DEFER    0
+#  endif
+#endif
+#endif
 
 /*Color picker (dependencies: -*/
 #ifndef LV_USE_CPICKER
@@ -1677,6 +1953,16 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_LABEL_LONG_TXT_HINT          0
 #  endif
 #endif
+
+/*Enable `lv_label_set_cell_width()` to draw every character in a fixed width cell.
+ *Changing some characters then redraws only their cells (e.g. for clocks and counters)*/
+#ifndef LV_LABEL_CELL_MODE
+#  ifdef CONFIG_LV_LABEL_CELL_MODE
+#    define LV_LABEL_CELL_MODE CONFIG_LV_LABEL_CELL_MODE
+#  else
+#    define  LV_LABEL_CELL_MODE              0
+#  endif
+#endif
 #endif
 
 /*LED (dependencies: -)*/
@@ -1730,6 +2016,14 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_LIST_DEF_ANIM_TIME  100
 #  endif
 #endif
+/*1: Enable `lv_list_set_virtual()` to show many items on a few recycled buttons*/
+#ifndef LV_LIST_VIRTUAL
+#  ifdef CONFIG_LV_LIST_VIRTUAL
+#    define LV_LIST_VIRTUAL CONFIG_LV_LIST_VIRTUAL
+#  else
+#    define  LV_LIST_VIRTUAL        0
+#  endif
+#endif
 #endif
 
 /*Line meter (dependencies: *;)*/
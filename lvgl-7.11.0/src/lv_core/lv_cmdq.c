@@ -0,0 +1,288 @@
+/**
+ * @file lv_cmdq.c
+ * Bounded multi producer, single consumer queue.
+ * Every cell has a sequence number telling whether it's free for the producer of a given position
+ * (`seq == pos`) or ready for the consumer (`seq == pos + 1`). The producers reserve a position
+ * with compare-and-swap on `tail`, the consumer (`lv_task_handler()`) owns `head`.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_cmdq.h"
+
+#if LV_USE_CMDQ
+
+#include <string.h>
+#include "../lv_misc/lv_mem.h"
+#include "../lv_widgets/lv_label.h"
+#include "../lv_widgets/lv_img.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#if (LV_CMDQ_SIZE & (LV_CMDQ_SIZE - 1)) != 0
+    #error "LV_CMDQ_SIZE must be a power of 2"
+#endif
+
+#if defined(__GNUC__)
+    #define CMDQ_LOAD(p)            __atomic_load_n(p, __ATOMIC_ACQUIRE)
+    #define CMDQ_LOAD_RELAXED(p)    __atomic_load_n(p, __ATOMIC_RELAXED)
+    #define CMDQ_STORE(p, v)        __atomic_store_n(p, v, __ATOMIC_RELEASE)
+    #define CMDQ_CAS(p, exp_p, v)   __atomic_compare_exchange_n(p, exp_p, v, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+    #define CMDQ_INC(p)             __atomic_fetch_add(p, 1, __ATOMIC_RELAXED)
+#else
+    #error "LV_USE_CMDQ requires GCC or Clang atomic built-ins"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    CMDQ_SET_TEXT,
+    CMDQ_SET_IMG_SRC,
+    CMDQ_INVALIDATE,
+    CMDQ_CALL,
+} cmdq_type_t;
+
+typedef struct {
+    uint32_t seq;
+    uint8_t type;
+    lv_obj_t * obj;
+    lv_cmdq_cb_t cb;
+    void * user_data;
+    char text[LV_CMDQ_TEXT_MAX];
+} cmdq_cell_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool cmdq_post(cmdq_type_t type, lv_obj_t * obj, const char * text, lv_cmdq_cb_t cb, void * user_data);
+static void cmdq_exec(cmdq_cell_t * cell);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static cmdq_cell_t cells[LV_CMDQ_SIZE];
+static uint32_t head;
+static uint32_t tail;
+static lv_cmdq_wakeup_cb_t wakeup_cb;
+static lv_cmdq_stat_t cmdq_stat;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the command queue. Called by `lv_init()`.
+ */
+void _lv_cmdq_init(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_CMDQ_SIZE; i++) cells[i].seq = i;
+    head = 0;
+    tail = 0;
+    wakeup_cb = NULL;
+    _lv_memset_00(&cmdq_stat, sizeof(cmdq_stat));
+}
+
+/**
+ * Post a new text for a label. The text is copied.
+ * Can be called from any thread. The label must not be deleted before `lv_task_handler()` runs.
+ * @param label pointer to a label object
+ * @param text the new text (at most `LV_CMDQ_TEXT_MAX - 1` characters)
+ * @return true: the command was added; false: the queue was full or the text was too long
+ */
+bool lv_cmdq_set_text(lv_obj_t * label, const char * text)
+{
+    return cmdq_post(CMDQ_SET_TEXT, label, text, NULL, NULL);
+}
+
+/**
+ * Post a new source for an image. The file name is copied.
+ * Can be called from any thread. The image must not be deleted before `lv_task_handler()` runs.
+ * @param img pointer to an image object
+ * @param src a file name or a symbol (at most `LV_CMDQ_TEXT_MAX - 1` characters)
+ * @return true: the command was added; false: the queue was full or the file name was too long
+ */
+bool lv_cmdq_set_img_src(lv_obj_t * img, const char * src)
+{
+    return cmdq_post(CMDQ_SET_IMG_SRC, img, src, NULL, NULL);
+}
+
+/**
+ * Post the invalidation of an object.
+ * Can be called from any thread. The object must not be deleted before `lv_task_handler()` runs.
+ * @param obj pointer to an object
+ * @return true: the command was added; false: the queue was full
+ */
+bool lv_cmdq_invalidate(lv_obj_t * obj)
+{
+    return cmdq_post(CMDQ_INVALIDATE, obj, NULL, NULL, NULL);
+}
+
+/**
+ * Post a function to be called in `lv_task_handler()`.
+ * Can be called from any thread.
+ * @param cb the function to call
+ * @param user_data parameter of `cb`
+ * @return true: the command was added; false: the queue was full or `cb` was NULL
+ */
+bool lv_cmdq_call(lv_cmdq_cb_t cb, void * user_data)
+{
+    /*Fail in the posting thread instead of calling NULL later in `lv_task_handler()`*/
+    if(cb == NULL) {
+        LV_LOG_WARN("lv_cmdq_call: cb is NULL");
+        CMDQ_INC(&cmdq_stat.drop_cnt);
+        return false;
+    }
+
+    return cmdq_post(CMDQ_CALL, NULL, NULL, cb, user_data);
+}
+
+/**
+ * Set a function to call after a command was posted. It can wake up the event loop
+ * (e.g. write to a pipe or eventfd the loop waits on) to call `lv_task_handler()` sooner.
+ * Should be set before the other threads start to post commands.
+ * @param cb the wakeup function or NULL
+ */
+void lv_cmdq_set_wakeup_cb(lv_cmdq_wakeup_cb_t cb)
+{
+    CMDQ_STORE(&wakeup_cb, cb);
+}
+
+/**
+ * Get the statistics of the command queue
+ * @param stat pointer to a variable to fill
+ */
+void lv_cmdq_get_stat(lv_cmdq_stat_t * stat)
+{
+    stat->post_cnt = CMDQ_LOAD_RELAXED(&cmdq_stat.post_cnt);
+    stat->exec_cnt = CMDQ_LOAD_RELAXED(&cmdq_stat.exec_cnt);
+    stat->drop_cnt = CMDQ_LOAD_RELAXED(&cmdq_stat.drop_cnt);
+}
+
+/**
+ * Execute the posted commands. Called by `lv_task_handler()`.
+ * @return number of executed commands
+ */
+uint32_t _lv_cmdq_drain(void)
+{
+    uint32_t cnt = 0;
+
+    /*Execute at most one queue worth of commands to not starve the tasks if the producers are fast*/
+    while(cnt < LV_CMDQ_SIZE) {
+        cmdq_cell_t * cell = &cells[head & (LV_CMDQ_SIZE - 1)];
+        if(CMDQ_LOAD(&cell->seq) != head + 1) break;   /*Not written yet*/
+
+        /*Copy the command to free the cell before executing it. The command might post new commands*/
+        cmdq_cell_t cmd;
+        cmd.type = cell->type;
+        cmd.obj = cell->obj;
+        cmd.cb = cell->cb;
+        cmd.user_data = cell->user_data;
+        if(cmd.type == CMDQ_SET_TEXT || cmd.type == CMDQ_SET_IMG_SRC) {
+            _lv_memcpy(cmd.text, cell->text, LV_CMDQ_TEXT_MAX);
+        }
+
+        CMDQ_STORE(&cell->seq, head + LV_CMDQ_SIZE);
+        head++;
+
+        cmdq_exec(&cmd);
+        CMDQ_INC(&cmdq_stat.exec_cnt);
+        cnt++;
+    }
+
+    return cnt;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Add a command to the queue
+ * @param type type of the command
+ * @param obj the target object or NULL
+ * @param text text to copy to the command or NULL
+ * @param cb callback for `CMDQ_CALL`
+ * @param user_data parameter of `cb`
+ * @return true: the command was added; false: the queue was full or the text was too long
+ */
+static bool cmdq_post(cmdq_type_t type, lv_obj_t * obj, const char * text, lv_cmdq_cb_t cb, void * user_data)
+{
+    uint32_t len = 0;
+    if(text) {
+        len = (uint32_t)strlen(text) + 1;
+        if(len > LV_CMDQ_TEXT_MAX) {
+            CMDQ_INC(&cmdq_stat.drop_cnt);
+            return false;
+        }
+    }
+
+    /*Reserve a cell*/
+    cmdq_cell_t * cell;
+    uint32_t pos = CMDQ_LOAD_RELAXED(&tail);
+    while(1) {
+        cell = &cells[pos & (LV_CMDQ_SIZE - 1)];
+        int32_t diff = (int32_t)(CMDQ_LOAD(&cell->seq) - pos);
+        if(diff == 0) {
+            if(CMDQ_CAS(&tail, &pos, pos + 1)) break;   /*`pos` is updated on failure*/
+        }
+        else if(diff < 0) {
+            /*The consumer hasn't freed the cell of the previous round: the queue is full*/
+            CMDQ_INC(&cmdq_stat.drop_cnt);
+            return false;
+        }
+        else {
+            pos = CMDQ_LOAD_RELAXED(&tail);   /*An other producer took this position*/
+        }
+    }
+
+    cell->type = type;
+    cell->obj = obj;
+    cell->cb = cb;
+    cell->user_data = user_data;
+    if(text) _lv_memcpy(cell->text, text, len);
+
+    /*Publish the command*/
+    CMDQ_STORE(&cell->seq, pos + 1);
+    CMDQ_INC(&cmdq_stat.post_cnt);
+
+    lv_cmdq_wakeup_cb_t wcb = CMDQ_LOAD(&wakeup_cb);
+    if(wcb) wcb();
+
+    return true;
+}
+
+/**
+ * Execute a command
+ * @param cmd pointer to a command
+ */
+static void cmdq_exec(cmdq_cell_t * cmd)
+{
+    switch(cmd->type) {
+        case CMDQ_SET_TEXT:
+#if LV_USE_LABEL
+            lv_label_set_text(cmd->obj, cmd->text);
+#endif
+            break;
+        case CMDQ_SET_IMG_SRC:
+#if LV_USE_IMG
+            lv_img_set_src(cmd->obj, cmd->text);
+#endif
+            break;
+        case CMDQ_INVALIDATE:
+            lv_obj_invalidate(cmd->obj);
+            break;
+        case CMDQ_CALL:
+            cmd->cb(cmd->user_data);
+            break;
+    }
+}
+
+#endif /*LV_USE_CMDQ*/
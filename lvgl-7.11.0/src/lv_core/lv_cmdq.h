@@ -0,0 +1,127 @@
+/**
+ * @file lv_cmdq.h
+ * Queue to post UI updates from other threads.
+ * Any thread can add commands to the queue without locking
+ * and they are executed in `lv_task_handler()`.
+ */
+
+#ifndef LV_CMDQ_H
+#define LV_CMDQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_CMDQ
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Type of the callbacks called by `lv_cmdq_call()`
+ */
+typedef void (*lv_cmdq_cb_t)(void *);
+
+/**
+ * Type of the wakeup callback. It's called in the posting thread after a command was added.
+ */
+typedef void (*lv_cmdq_wakeup_cb_t)(void);
+
+/**
+ * Statistics of the command queue
+ */
+typedef struct {
+    uint32_t post_cnt;      /**< Number of posted commands*/
+    uint32_t exec_cnt;      /**< Number of executed commands*/
+    uint32_t drop_cnt;      /**< Number of commands dropped because the queue was full or the text was too long*/
+} lv_cmdq_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the command queue. Called by `lv_init()`.
+ */
+void _lv_cmdq_init(void);
+
+/**
+ * Post a new text for a label. The text is copied.
+ * Can be called from any thread. The label must not be deleted before `lv_task_handler()` runs.
+ * @param label pointer to a label object
+ * @param text the new text (at most `LV_CMDQ_TEXT_MAX - 1` characters)
+ * @return true: the command was added; false: the queue was full or the text was too long
+ */
+bool lv_cmdq_set_text(lv_obj_t * label, const char * text);
+
+/**
+ * Post a new source for an image. The file name is copied.
+ * Can be called from any thread. The image must not be deleted before `lv_task_handler()` runs.
+ * @param img pointer to an image object
+ * @param src a file name or a symbol (at most `LV_CMDQ_TEXT_MAX - 1` characters)
+ * @return true: the command was added; false: the queue was full or the file name was too long
+ */
+bool lv_cmdq_set_img_src(lv_obj_t * img, const char * src);
+
+/**
+ * Post the invalidation of an object.
+ * Can be called from any thread. The object must not be deleted before `lv_task_handler()` runs.
+ * @param obj pointer to an object
+ * @return true: the command was added; false: the queue was full
+ */
+bool lv_cmdq_invalidate(lv_obj_t * obj);
+
+/**
+ * Post a function to be called in `lv_task_handler()`.
+ * Can be called from any thread.
+ * @param cb the function to call
+ * @param user_data parameter of `cb`
+ * @return true: the command was added; false: the queue was full or `cb` was NULL
+ */
+bool lv_cmdq_call(lv_cmdq_cb_t cb, void * user_data);
+
+/**
+ * Set a function to call after a command was posted. It can wake up the event loop
+ * (e.g. write to a pipe or eventfd the loop waits on) to call `lv_task_handler()` sooner.
+ * Should be set before the other threads start to post commands.
+ * @param cb the wakeup function or NULL
+ */
+void lv_cmdq_set_wakeup_cb(lv_cmdq_wakeup_cb_t cb);
+
+/**
+ * Get the statistics of the command queue
+ * @param stat pointer to a variable to fill
+ */
+void lv_cmdq_get_stat(lv_cmdq_stat_t * stat);
+
+/**
+ * Execute the posted commands. Called by `lv_task_handler()`.
+ * @return number of executed commands
+ */
+uint32_t _lv_cmdq_drain(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_CMDQ*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_CMDQ_H*/
@@ -4,6 +4,8 @@ CSRCS += lv_disp.c
 CSRCS += lv_obj.c
 CSRCS += lv_refr.c
 CSRCS += lv_style.c
+CSRCS += lv_cmdq.c
+CSRCS += lv_hit_index.c
 
 DEPPATH += --dep-path $(LVGL_DIR)/$(LVGL_DIR_NAME)/src/lv_core
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/lv_core
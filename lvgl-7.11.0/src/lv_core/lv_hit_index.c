@@ -0,0 +1,507 @@
+/**
+ * @file lv_hit_index.c
+ * The area of the indexed object is divided into a grid and every cell stores the children
+ * whose clickable area overlaps the cell, ordered from the top most child.
+ * The cells are stored relative to the origin of the object, so moving (e.g. scrolling) the object
+ * together with its children needs no update. Only the moved children are updated
+ * and the index is rebuilt if the children are added, deleted or reordered.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_hit_index.h"
+
+#if LV_INDEV_HIT_INDEX
+
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_ll.h"
+#include "../lv_misc/lv_math.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CELL_MAX        1024    /*Max. number of cells in an index*/
+#define CELL_MIN_SIZE   8       /*Min. width and height of the cells*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    lv_obj_t * obj;
+    uint32_t rank;      /*Position in the list of children. 0: the top most child*/
+} hit_entry_t;
+
+typedef struct {
+    hit_entry_t * entries;
+    uint32_t cnt;
+    uint32_t size;
+} hit_cell_t;
+
+typedef struct {
+    lv_obj_t * obj;             /*The indexed object*/
+    hit_cell_t * cells;
+    hit_cell_t loose;           /*Children with advanced hit-testing. They are checked in every search*/
+    lv_point_t ori;             /*Absolute position of the first cell*/
+    lv_coord_t cell_w;
+    lv_coord_t cell_h;
+    uint16_t col_cnt;
+    uint16_t row_cnt;
+    uint8_t dirty : 1;          /*1: rebuild before the next search*/
+} hit_index_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static hit_index_t * index_find(const lv_obj_t * obj);
+static bool index_build(hit_index_t * idx);
+static void index_clear(hit_index_t * idx);
+static void get_hit_area(const hit_index_t * idx, const lv_obj_t * child, const lv_area_t * coords,
+                         lv_area_t * area);
+static void get_cell_range(const hit_index_t * idx, const lv_area_t * area, lv_area_t * range);
+static uint16_t get_col(const hit_index_t * idx, lv_coord_t x);
+static uint16_t get_row(const hit_index_t * idx, lv_coord_t y);
+static bool cell_add(hit_cell_t * cell, lv_obj_t * obj, uint32_t rank);
+static bool cell_remove(hit_cell_t * cell, const lv_obj_t * obj, uint32_t * rank);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_ll_t index_ll;
+static lv_hit_index_monitor_t monitor;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the hit-test indexes. Called by `lv_init()`.
+ */
+void _lv_hit_index_init(void)
+{
+    _lv_ll_init(&index_ll, sizeof(hit_index_t));
+    _lv_memset_00(&monitor, sizeof(monitor));
+}
+
+/**
+ * Create an index for the children of an object. It's built when it's used first.
+ * @param obj pointer to an object
+ */
+void _lv_hit_index_create(lv_obj_t * obj)
+{
+    if(obj->hit_index) return;
+
+    hit_index_t * idx = _lv_ll_ins_head(&index_ll);
+    if(idx == NULL) return;     /*Work without index*/
+
+    _lv_memset_00(idx, sizeof(hit_index_t));
+    idx->obj = obj;
+    idx->dirty = 1;
+    obj->hit_index = 1;
+    monitor.index_cnt++;
+}
+
+/**
+ * Delete the index of an object. Called when the object is deleted.
+ * @param obj pointer to an object
+ */
+void _lv_hit_index_del(lv_obj_t * obj)
+{
+    hit_index_t * idx = index_find(obj);
+    if(idx == NULL) return;
+
+    index_clear(idx);
+    _lv_ll_remove(&index_ll, idx);
+    lv_mem_free(idx);
+    obj->hit_index = 0;
+    monitor.index_cnt--;
+}
+
+/**
+ * Tell that the children of an object are added, removed or reordered.
+ * The index will be rebuilt on the next search.
+ * @param obj pointer to an object. Nothing happens if it has no index.
+ */
+void _lv_hit_index_invalidate(lv_obj_t * obj)
+{
+    if(obj == NULL) return;
+
+    hit_index_t * idx = index_find(obj);
+    if(idx) idx->dirty = 1;
+}
+
+/**
+ * Tell that an object moved together with its children. Called when the children are repositioned.
+ * @param obj pointer to an object. Nothing happens if it has no index.
+ * @param x_diff the horizontal movement
+ * @param y_diff the vertical movement
+ */
+void _lv_hit_index_shift(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff)
+{
+    hit_index_t * idx = index_find(obj);
+    if(idx == NULL) return;
+
+    idx->ori.x += x_diff;
+    idx->ori.y += y_diff;
+}
+
+/**
+ * Update the index of the parent after an object moved or resized.
+ * Called on `LV_SIGNAL_COORD_CHG`.
+ * @param obj pointer to the moved object
+ * @param ori the previous coordinates of the object
+ */
+void _lv_hit_index_obj_move(lv_obj_t * obj, const lv_area_t * ori)
+{
+    lv_obj_t * par = obj->parent;
+    if(par == NULL || par->hit_index == 0 || obj->adv_hittest) return;
+
+    hit_index_t * idx = index_find(par);
+    if(idx == NULL || idx->dirty) return;
+
+    lv_area_t area;
+    lv_area_t range_old;
+    lv_area_t range_new;
+    get_hit_area(idx, obj, ori, &area);
+    get_cell_range(idx, &area, &range_old);
+    get_hit_area(idx, obj, &obj->coords, &area);
+    get_cell_range(idx, &area, &range_new);
+
+    /*Small movements usually stay in the same cells*/
+    if(range_old.x1 == range_new.x1 && range_old.y1 == range_new.y1 &&
+       range_old.x2 == range_new.x2 && range_old.y2 == range_new.y2) return;
+
+    bool found = false;
+    uint32_t rank = 0;
+    lv_coord_t row;
+    lv_coord_t col;
+    for(row = range_old.y1; row <= range_old.y2; row++) {
+        for(col = range_old.x1; col <= range_old.x2; col++) {
+            if(cell_remove(&idx->cells[row * idx->col_cnt + col], obj, &rank)) found = true;
+        }
+    }
+
+    /*Shouldn't happen but the index can be rebuilt anyway*/
+    if(!found) {
+        idx->dirty = 1;
+        return;
+    }
+
+    for(row = range_new.y1; row <= range_new.y2; row++) {
+        for(col = range_new.x1; col <= range_new.x2; col++) {
+            if(!cell_add(&idx->cells[row * idx->col_cnt + col], obj, rank)) {
+                idx->dirty = 1;
+                return;
+            }
+        }
+    }
+
+    monitor.update_cnt++;
+}
+
+/**
+ * Call `cb` for the children of an object which might be on a point, from the top to the bottom,
+ * until it returns non-NULL.
+ * @param obj pointer to an object
+ * @param point the point to search
+ * @param cb the function to call for the children
+ * @param found the first non-NULL return value of `cb` or NULL
+ * @return true: the search was done with the index; false: the object has no index, check every child
+ */
+bool _lv_hit_index_search(lv_obj_t * obj, lv_point_t * point, lv_hit_index_search_cb_t cb, lv_obj_t ** found)
+{
+    hit_index_t * idx = index_find(obj);
+    if(idx == NULL) return false;
+
+    if(idx->dirty) {
+        if(index_build(idx) == false) {
+            /*Not enough memory: search without index*/
+            _lv_hit_index_del(obj);
+            return false;
+        }
+    }
+
+    monitor.search_cnt++;
+
+    uint16_t col = get_col(idx, point->x - idx->ori.x);
+    uint16_t row = get_row(idx, point->y - idx->ori.y);
+    hit_cell_t * cell = &idx->cells[row * idx->col_cnt + col];
+    hit_cell_t * loose = &idx->loose;
+
+    /*Merge the children of the cell and the loose children in z-order*/
+    uint32_t i = 0;
+    uint32_t j = 0;
+    *found = NULL;
+    while(i < cell->cnt || j < loose->cnt) {
+        lv_obj_t * child;
+        if(j >= loose->cnt || (i < cell->cnt && cell->entries[i].rank < loose->entries[j].rank)) {
+            child = cell->entries[i].obj;
+            i++;
+        }
+        else {
+            child = loose->entries[j].obj;
+            j++;
+        }
+
+        monitor.cand_cnt++;
+        *found = cb(child, point);
+        if(*found != NULL) break;
+    }
+
+    return true;
+}
+
+/**
+ * Get the statistics of the hit-test indexes
+ * @param mon pointer to a variable to fill
+ */
+void lv_hit_index_monitor(lv_hit_index_monitor_t * mon)
+{
+    _lv_memcpy(mon, &monitor, sizeof(lv_hit_index_monitor_t));
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Find the index of an object
+ * @param obj pointer to an object
+ * @return pointer to the index or NULL if the object has no index
+ */
+static hit_index_t * index_find(const lv_obj_t * obj)
+{
+    if(obj->hit_index == 0) return NULL;
+
+    hit_index_t * idx;
+    _LV_LL_READ(index_ll, idx) {
+        if(idx->obj == obj) return idx;
+    }
+
+    return NULL;
+}
+
+/**
+ * Build an index from the current children of its object
+ * @param idx pointer to an index
+ * @return true: ready; false: out of memory
+ */
+static bool index_build(hit_index_t * idx)
+{
+    index_clear(idx);
+
+    lv_obj_t * obj = idx->obj;
+    lv_obj_t * child;
+    uint32_t child_cnt = 0;
+    _LV_LL_READ(obj->child_ll, child) child_cnt++;
+
+    /*About 2 children per cell with roughly square cells*/
+    uint32_t w = LV_MATH_MAX(lv_area_get_width(&obj->coords), 1);
+    uint32_t h = LV_MATH_MAX(lv_area_get_height(&obj->coords), 1);
+    uint32_t cell_cnt = LV_MATH_MIN(child_cnt / 2 + 1, CELL_MAX);
+
+    lv_sqrt_res_t q;
+    _lv_sqrt((cell_cnt * w) / h, &q, 0x8000);
+    uint32_t col_cnt = LV_MATH_MIN(q.i, w / CELL_MIN_SIZE);
+    col_cnt = LV_MATH_MIN(col_cnt, cell_cnt);
+    col_cnt = LV_MATH_MAX(col_cnt, 1);
+    uint32_t row_cnt = LV_MATH_MIN(cell_cnt / col_cnt, h / CELL_MIN_SIZE);
+    row_cnt = LV_MATH_MAX(row_cnt, 1);
+
+    idx->col_cnt = col_cnt;
+    idx->row_cnt = row_cnt;
+    idx->cell_w = (w + col_cnt - 1) / col_cnt;
+    idx->cell_h = (h + row_cnt - 1) / row_cnt;
+    idx->ori.x = obj->coords.x1;
+    idx->ori.y = obj->coords.y1;
+
+    uint32_t size = sizeof(hit_cell_t) * col_cnt * row_cnt;
+    idx->cells = lv_mem_alloc(size);
+    if(idx->cells == NULL) return false;
+    _lv_memset_00(idx->cells, size);
+
+    /*The children are listed from the top most so the cells will be ordered too*/
+    uint32_t rank = 0;
+    _LV_LL_READ(obj->child_ll, child) {
+        if(child->adv_hittest) {
+            if(!cell_add(&idx->loose, child, rank)) return false;
+        }
+        else {
+            lv_area_t area;
+            lv_area_t range;
+            get_hit_area(idx, child, &child->coords, &area);
+            get_cell_range(idx, &area, &range);
+
+            lv_coord_t row;
+            lv_coord_t col;
+            for(row = range.y1; row <= range.y2; row++) {
+                for(col = range.x1; col <= range.x2; col++) {
+                    if(!cell_add(&idx->cells[row * col_cnt + col], child, rank)) return false;
+                }
+            }
+        }
+        rank++;
+    }
+
+    idx->dirty = 0;
+    monitor.build_cnt++;
+
+    return true;
+}
+
+/**
+ * Free the cells of an index
+ * @param idx pointer to an index
+ */
+static void index_clear(hit_index_t * idx)
+{
+    if(idx->cells) {
+        uint32_t i;
+        for(i = 0; i < (uint32_t)idx->col_cnt * idx->row_cnt; i++) {
+            if(idx->cells[i].entries) lv_mem_free(idx->cells[i].entries);
+        }
+        lv_mem_free(idx->cells);
+        idx->cells = NULL;
+    }
+
+    if(idx->loose.entries) lv_mem_free(idx->loose.entries);
+    _lv_memset_00(&idx->loose, sizeof(hit_cell_t));
+    idx->dirty = 1;
+}
+
+/**
+ * Get the clickable area of a child relative to the first cell of the index
+ * @param idx pointer to the index of the parent
+ * @param child pointer to a child
+ * @param coords coordinates of the child
+ * @param area store the result here
+ */
+static void get_hit_area(const hit_index_t * idx, const lv_obj_t * child, const lv_area_t * coords,
+                         lv_area_t * area)
+{
+#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
+    area->x1 = coords->x1 - child->ext_click_pad_hor;
+    area->x2 = coords->x2 + child->ext_click_pad_hor;
+    area->y1 = coords->y1 - child->ext_click_pad_ver;
+    area->y2 = coords->y2 + child->ext_click_pad_ver;
+#elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
+    area->x1 = coords->x1 - child->ext_click_pad.x1;
+    area->x2 = coords->x2 + child->ext_click_pad.x2;
+    area->y1 = coords->y1 - child->ext_click_pad.y1;
+    area->y2 = coords->y2 + child->ext_click_pad.y2;
+#else
+    LV_UNUSED(child);
+    lv_area_copy(area, coords);
+#endif
+
+    area->x1 -= idx->ori.x;
+    area->x2 -= idx->ori.x;
+    area->y1 -= idx->ori.y;
+    area->y2 -= idx->ori.y;
+}
+
+/**
+ * Get the cells covered by an area
+ * @param idx pointer to an index
+ * @param area an area relative to the first cell
+ * @param range store the first and last column in `x1` and `x2`, the first and last row in `y1` and `y2`
+ */
+static void get_cell_range(const hit_index_t * idx, const lv_area_t * area, lv_area_t * range)
+{
+    range->x1 = get_col(idx, area->x1);
+    range->x2 = get_col(idx, area->x2);
+    range->y1 = get_row(idx, area->y1);
+    range->y2 = get_row(idx, area->y2);
+}
+
+/**
+ * Get the column of an x coordinate. The coordinates out of the grid belong to the nearest column.
+ * @param idx pointer to an index
+ * @param x an x coordinate relative to the first cell
+ * @return the column
+ */
+static uint16_t get_col(const hit_index_t * idx, lv_coord_t x)
+{
+    if(x < 0) return 0;
+    uint32_t col = x / idx->cell_w;
+    if(col >= idx->col_cnt) col = idx->col_cnt - 1;
+    return col;
+}
+
+/**
+ * Get the row of an y coordinate. The coordinates out of the grid belong to the nearest row.
+ * @param idx pointer to an index
+ * @param y an y coordinate relative to the first cell
+ * @return the row
+ */
+static uint16_t get_row(const hit_index_t * idx, lv_coord_t y)
+{
+    if(y < 0) return 0;
+    uint32_t row = y / idx->cell_h;
+    if(row >= idx->row_cnt) row = idx->row_cnt - 1;
+    return row;
+}
+
+/**
+ * Add a child to a cell keeping the z-order
+ * @param cell pointer to a cell
+ * @param obj pointer to the child
+ * @param rank the child's position among its siblings
+ * @return true: added; false: out of memory
+ */
+static bool cell_add(hit_cell_t * cell, lv_obj_t * obj, uint32_t rank)
+{
+    if(cell->cnt == cell->size) {
+        uint32_t new_size = cell->size ? cell->size * 2 : 4;
+        hit_entry_t * entries = lv_mem_realloc(cell->entries, new_size * sizeof(hit_entry_t));
+        if(entries == NULL) return false;
+        cell->entries = entries;
+        cell->size = new_size;
+    }
+
+    /*Find the first entry below the child*/
+    uint32_t min = 0;
+    uint32_t max = cell->cnt;
+    while(min < max) {
+        uint32_t mid = (min + max) / 2;
+        if(cell->entries[mid].rank < rank) min = mid + 1;
+        else max = mid;
+    }
+
+    uint32_t i;
+    for(i = cell->cnt; i > min; i--) cell->entries[i] = cell->entries[i - 1];
+
+    cell->entries[min].obj = obj;
+    cell->entries[min].rank = rank;
+    cell->cnt++;
+
+    return true;
+}
+
+/**
+ * Remove a child from a cell
+ * @param cell pointer to a cell
+ * @param obj pointer to the child
+ * @param rank store the rank of the child here if it was found
+ * @return true: removed; false: the child wasn't in the cell
+ */
+static bool cell_remove(hit_cell_t * cell, const lv_obj_t * obj, uint32_t * rank)
+{
+    uint32_t i;
+    for(i = 0; i < cell->cnt; i++) {
+        if(cell->entries[i].obj == obj) break;
+    }
+    if(i == cell->cnt) return false;
+
+    *rank = cell->entries[i].rank;
+    cell->cnt--;
+    for(; i < cell->cnt; i++) cell->entries[i] = cell->entries[i + 1];
+
+    return true;
+}
+
+#endif /*LV_INDEV_HIT_INDEX*/
@@ -0,0 +1,121 @@
+/**
+ * @file lv_hit_index.h
+ * Grid index of the children of objects with many children.
+ * It's used by `lv_indev_search_obj()` to check only the children near the pressed point.
+ */
+
+#ifndef LV_HIT_INDEX_H
+#define LV_HIT_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_INDEV_HIT_INDEX
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Type of the function called for the children found by `_lv_hit_index_search()`.
+ * Returns the found object or NULL to continue with the next child.
+ */
+typedef lv_obj_t * (*lv_hit_index_search_cb_t)(lv_obj_t * obj, lv_point_t * point);
+
+/**
+ * Statistics of the hit-test indexes
+ */
+typedef struct {
+    uint32_t index_cnt;     /**< Number of objects with an index*/
+    uint32_t build_cnt;     /**< Number of index (re)builds*/
+    uint32_t update_cnt;    /**< Number of incremental updates after a child moved*/
+    uint32_t search_cnt;    /**< Number of searches with an index*/
+    uint32_t cand_cnt;      /**< Number of children checked by the searches*/
+} lv_hit_index_monitor_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the hit-test indexes. Called by `lv_init()`.
+ */
+void _lv_hit_index_init(void);
+
+/**
+ * Create an index for the children of an object. It's built when it's used first.
+ * @param obj pointer to an object
+ */
+void _lv_hit_index_create(lv_obj_t * obj);
+
+/**
+ * Delete the index of an object. Called when the object is deleted.
+ * @param obj pointer to an object
+ */
+void _lv_hit_index_del(lv_obj_t * obj);
+
+/**
+ * Tell that the children of an object are added, removed or reordered.
+ * The index will be rebuilt on the next search.
+ * @param obj pointer to an object. Nothing happens if it has no index.
+ */
+void _lv_hit_index_invalidate(lv_obj_t * obj);
+
+/**
+ * Tell that an object moved together with its children. Called when the children are repositioned.
+ * @param obj pointer to an object. Nothing happens if it has no index.
+ * @param x_diff the horizontal movement
+ * @param y_diff the vertical movement
+ */
+void _lv_hit_index_shift(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff);
+
+/**
+ * Update the index of the parent after an object moved or resized.
+ * Called on `LV_SIGNAL_COORD_CHG`.
+ * @param obj pointer to the moved object
+ * @param ori the previous coordinates of the object
+ */
+void _lv_hit_index_obj_move(lv_obj_t * obj, const lv_area_t * ori);
+
+/**
+ * Call `cb` for the children of an object which might be on a point, from the top to the bottom,
+ * until it returns non-NULL.
+ * @param obj pointer to an object
+ * @param point the point to search
+ * @param cb the function to call for the children
+ * @param found the first non-NULL return value of `cb` or NULL
+ * @return true: the search was done with the index; false: the object has no index, check every child
+ */
+bool _lv_hit_index_search(lv_obj_t * obj, lv_point_t * point, lv_hit_index_search_cb_t cb, lv_obj_t ** found);
+
+/**
+ * Get the statistics of the hit-test indexes
+ * @param mon pointer to a variable to fill
+ */
+void lv_hit_index_monitor(lv_hit_index_monitor_t * mon);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_INDEV_HIT_INDEX*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_HIT_INDEX_H*/
@@ -13,6 +13,7 @@
 #include "../lv_hal/lv_hal_tick.h"
 #include "../lv_core/lv_group.h"
 #include "../lv_core/lv_refr.h"
+#include "../lv_core/lv_hit_index.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_math.h"
 
@@ -1152,6 +1153,24 @@ lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
     if(lv_obj_hittest(obj, point)) {
         lv_obj_t * i;
 
+#if LV_INDEV_HIT_INDEX
+        /*Check only the children near the point if they are indexed*/
+        if(_lv_hit_index_search(obj, point, lv_indev_search_obj, &found_p) == false) {
+            uint32_t child_cnt = 0;
+            _LV_LL_READ(obj->child_ll, i) {
+                child_cnt++;
+                found_p = lv_indev_search_obj(i, point);
+
+                /*If a child was found then break*/
+                if(found_p != NULL) {
+                    break;
+                }
+            }
+
+            /*Index the children if many of them had to be checked*/
+            if(child_cnt >= LV_INDEV_HIT_INDEX_MIN_CHILD) _lv_hit_index_create(obj);
+        }
+#else
         _LV_LL_READ(obj->child_ll, i) {
             found_p = lv_indev_search_obj(i, point);
 
@@ -1160,6 +1179,7 @@ lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
                 break;
             }
         }
+#endif
 
         /*If then the children was not ok, and this obj is clickable
          * and it or its parent is not hidden then save this object*/
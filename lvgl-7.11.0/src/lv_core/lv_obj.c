@@ -11,6 +11,9 @@
 #include "lv_refr.h"
 #include "lv_group.h"
 #include "lv_disp.h"
+#include "lv_cmdq.h"
+#include "lv_hit_index.h"
+#include "../lv_widgets/lv_cont.h"
 #include "../lv_misc/lv_debug.h"
 #include "../lv_themes/lv_theme.h"
 #include "../lv_draw/lv_draw.h"
@@ -47,6 +50,13 @@
 #define LV_OBJ_DEF_WIDTH    (LV_DPX(100))
 #define LV_OBJ_DEF_HEIGHT   (LV_DPX(50))
 
+/*Number of areas collected by `lv_obj_begin_update()` before joining them*/
+#define UPDATE_AREA_MAX     8
+
+#if LV_OBJ_SLAB && LV_ENABLE_GC
+    #error "LV_OBJ_SLAB can't be used with LV_ENABLE_GC"
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -110,12 +120,31 @@ typedef enum {
     STYLE_COMPARE_DIFF,
 } style_snapshot_res_t;
 
+/*The state of an `lv_obj_begin_update()` - `lv_obj_end_update()` transaction*/
+typedef struct {
+    lv_obj_t * root;        /*Collect the invalidations of this object and its children. NULL: the whole display*/
+    lv_disp_t * disp;
+    uint16_t nest_cnt;
+    uint16_t area_cnt;
+    lv_area_t areas[UPDATE_AREA_MAX];
+} obj_update_t;
+
+#if LV_OBJ_SLAB
+typedef struct {
+    void * free_head;       /*Cached free blocks linked through their first word*/
+    uint32_t block_size;    /*Size of the blocks (object + style pointers + ext. data). 0: unused slab*/
+    uint16_t free_cnt;      /*Number of cached free blocks*/
+} lv_obj_slab_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_design_res_t lv_obj_design(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode);
 static lv_res_t lv_obj_signal(lv_obj_t * obj, lv_signal_t sign, void * param);
 static void refresh_children_position(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff);
+static inline void layout_flush(void);
+static bool update_add_area(const lv_obj_t * obj, const lv_area_t * area);
 static void report_style_mod_core(void * style_p, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
 static void base_dir_refr_children(lv_obj_t * obj);
@@ -137,6 +166,19 @@ static void lv_event_mark_deleted(lv_obj_t * obj);
 static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_find);
 static void lv_obj_del_async_cb(void * obj);
 static void obj_del_core(lv_obj_t * obj);
+static lv_obj_t * obj_alloc(lv_ll_t * ll_p);
+static void obj_free(lv_obj_t * obj);
+#if LV_OBJ_SLAB
+static lv_style_t ** slab_get_styles(lv_obj_t * obj);
+static void * slab_get_ext(lv_obj_t * obj);
+#endif
+static lv_style_int_t style_resolve_int(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static lv_color_t style_resolve_color(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static lv_opa_t style_resolve_opa(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static const void * style_resolve_ptr(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+#if LV_STYLE_RES_CACHE
+static void style_res_clear(lv_obj_t * obj, bool children);
+#endif
 static void update_style_cache(lv_obj_t * obj, uint8_t part, uint16_t prop);
 static void update_style_cache_children(lv_obj_t * obj);
 static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
@@ -149,6 +191,13 @@ static style_snapshot_res_t style_snapshot_compare(style_snapshot_t * shot1, sty
 static bool lv_initialized = false;
 static lv_event_temp_data_t * event_temp_data_head;
 static const void * event_act_data;
+static uint16_t ext_reserve;
+static obj_update_t update;
+#if LV_OBJ_SLAB
+static lv_obj_slab_t slabs[LV_OBJ_SLAB_CLASS_CNT];
+static uint32_t slab_alloc_cnt;
+static uint32_t slab_reuse_cnt;
+#endif
 
 /**********************
  *      MACROS
@@ -187,6 +236,14 @@ void lv_init(void)
     _lv_group_init();
 #endif
 
+#if LV_USE_CMDQ
+    _lv_cmdq_init();
+#endif
+
+#if LV_INDEV_HIT_INDEX
+    _lv_hit_index_init();
+#endif
+
 #if LV_USE_GPU_STM32_DMA2D
     /*Initialize DMA2D GPU*/
     lv_gpu_stm32_dma2d_init();
@@ -216,6 +273,9 @@ void lv_init(void)
     _lv_indev_init();
 
     _lv_img_decoder_init();
+#if LV_USE_IMG_TRANSFORM && LV_IMG_CACHE_TRANSFORM_SIZE
+    _lv_ll_init(&LV_GC_ROOT(_lv_img_cache_transform_ll), sizeof(lv_img_cache_transform_t));
+#endif
 #if LV_IMG_CACHE_DEF_SIZE
     lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
 #endif
@@ -239,6 +299,10 @@ void lv_init(void)
  */
 void lv_deinit(void)
 {
+#if LV_OBJ_SLAB
+    lv_obj_slab_flush();
+    _lv_memset_00(slabs, sizeof(slabs));
+#endif
     _lv_gc_clear_roots();
 
     lv_disp_set_default(NULL);
@@ -277,12 +341,10 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
             return NULL;
         }
 
-        new_obj = _lv_ll_ins_head(&disp->scr_ll);
+        new_obj = obj_alloc(&disp->scr_ll);
         LV_ASSERT_MEM(new_obj);
         if(new_obj == NULL) return NULL;
 
-        _lv_memset_00(new_obj, sizeof(lv_obj_t));
-
 #if LV_USE_BIDI
         new_obj->base_dir     = LV_BIDI_BASE_DIR_DEF;
 #else
@@ -305,13 +367,14 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         LV_LOG_TRACE("Object create started");
         LV_ASSERT_OBJ(parent, LV_OBJX_NAME);
 
-        new_obj = _lv_ll_ins_head(&parent->child_ll);
+        new_obj = obj_alloc(&parent->child_ll);
         LV_ASSERT_MEM(new_obj);
         if(new_obj == NULL) return NULL;
 
-        _lv_memset_00(new_obj, sizeof(lv_obj_t));
-
         new_obj->parent = parent;
+#if LV_INDEV_HIT_INDEX
+        _lv_hit_index_invalidate(parent);
+#endif
 
 #if LV_USE_BIDI
         new_obj->base_dir     = LV_BIDI_DIR_INHERIT;
@@ -367,6 +430,9 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
 
     /*Set attributes*/
     new_obj->adv_hittest  = 0;
+#if LV_INDEV_HIT_INDEX
+    new_obj->hit_index    = 0;
+#endif
     new_obj->click        = 1;
     new_obj->drag         = 0;
     new_obj->drag_throw   = 0;
@@ -383,6 +449,13 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
     new_obj->ext_attr = NULL;
 
     lv_style_list_init(&new_obj->style_list);
+#if LV_OBJ_SLAB
+    if(new_obj->slab_id) {
+        /*Use the style pointers allocated together with the object*/
+        new_obj->style_list.style_list = slab_get_styles(new_obj);
+        new_obj->style_list.inline_list = 1;
+    }
+#endif
     if(copy == NULL) {
         if(parent != NULL) lv_theme_apply(new_obj, LV_THEME_OBJ);
         else lv_theme_apply(new_obj, LV_THEME_SCR);
@@ -548,7 +621,74 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
     lv_area_copy(&area_tmp, area);
     bool visible = lv_obj_area_is_visible(obj, &area_tmp);
 
-    if(visible) _lv_inv_area(lv_obj_get_disp(obj), &area_tmp);
+    if(!visible) return;
+
+    /*Collect the area if there is an update transaction on the object*/
+    if(update.nest_cnt > 0 && update_add_area(obj, &area_tmp)) return;
+
+    _lv_inv_area(lv_obj_get_disp(obj), &area_tmp);
+}
+
+/**
+ * Start to update the properties of an object and its children.
+ * Until `lv_obj_end_update()` the invalidated areas are only collected and joined,
+ * then the containers' layouts are refreshed and the collected areas are invalidated once.
+ * Can be nested. The transaction then covers the common ancestor of the objects.
+ * @param obj pointer to an object
+ */
+void lv_obj_begin_update(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
+
+    if(update.nest_cnt == 0) {
+        update.root = obj;
+        update.disp = lv_obj_get_disp(obj);
+        update.area_cnt = 0;
+    }
+    else if(update.root) {
+        /*Find the common ancestor. NULL if they are on different screens*/
+        lv_obj_t * root = update.root;
+        while(root) {
+            lv_obj_t * i = obj;
+            while(i && i != root) i = lv_obj_get_parent(i);
+            if(i) break;
+            root = lv_obj_get_parent(root);
+        }
+        update.root = root;
+    }
+
+    update.nest_cnt++;
+}
+
+/**
+ * Finish the update started with `lv_obj_begin_update()`.
+ * The outermost call refreshes the pending layouts and invalidates the collected areas.
+ * @param obj pointer to the object passed to `lv_obj_begin_update()`
+ */
+void lv_obj_end_update(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
+    LV_UNUSED(obj); /*The transactions are nested so only the counter matters*/
+
+    if(update.nest_cnt == 0) {
+        LV_LOG_WARN("lv_obj_end_update: no update was started");
+        return;
+    }
+
+    /*Refresh the layouts while the transaction is open to collect their areas too*/
+    if(update.nest_cnt == 1) layout_flush();
+
+    update.nest_cnt--;
+    if(update.nest_cnt > 0) return;
+
+    uint16_t i;
+    for(i = 0; i < update.area_cnt; i++) {
+        _lv_inv_area(update.disp, &update.areas[i]);
+    }
+
+    update.area_cnt = 0;
+    update.root = NULL;
+    update.disp = NULL;
 }
 
 /**
@@ -685,6 +825,16 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     _lv_ll_chg_list(&obj->parent->child_ll, &parent->child_ll, obj, true);
     obj->parent = parent;
 
+#if LV_INDEV_HIT_INDEX
+    _lv_hit_index_invalidate(old_par);
+    _lv_hit_index_invalidate(parent);
+#endif
+
+#if LV_STYLE_RES_CACHE
+    /*The inherited properties might come from the new parent*/
+    style_res_clear(obj, true);
+#endif
+
     if(new_base_dir != LV_BIDI_DIR_RTL) {
         lv_obj_set_pos(obj, old_pos.x, old_pos.y);
     }
@@ -719,6 +869,9 @@ void lv_obj_move_foreground(lv_obj_t * obj)
     lv_obj_invalidate(parent);
 
     _lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, true);
+#if LV_INDEV_HIT_INDEX
+    _lv_hit_index_invalidate(parent);
+#endif
 
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
@@ -742,6 +895,9 @@ void lv_obj_move_background(lv_obj_t * obj)
     lv_obj_invalidate(parent);
 
     _lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, false);
+#if LV_INDEV_HIT_INDEX
+    _lv_hit_index_invalidate(parent);
+#endif
 
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
@@ -786,13 +942,16 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
 
     /*Save the original coordinates*/
     lv_area_t ori;
-    lv_obj_get_coords(obj, &ori);
+    lv_area_copy(&ori, &obj->coords);
 
     obj->coords.x1 += diff.x;
     obj->coords.y1 += diff.y;
     obj->coords.x2 += diff.x;
     obj->coords.y2 += diff.y;
 
+#if LV_INDEV_HIT_INDEX
+    if(obj->hit_index) _lv_hit_index_shift(obj, diff.x, diff.y);
+#endif
     refresh_children_position(obj, diff.x, diff.y);
 
     /*Inform the object about its new coordinates*/
@@ -842,7 +1001,7 @@ void lv_obj_set_size(lv_obj_t * obj, lv_coord_t w, lv_coord_t h)
     /* Do nothing if the size is not changed */
     /* It is very important else recursive resizing can
      * occur without size change*/
-    if(lv_obj_get_width(obj) == w && lv_obj_get_height(obj) == h) {
+    if(lv_area_get_width(&obj->coords) == w && lv_area_get_height(&obj->coords) == h) {
         return;
     }
 
@@ -851,7 +1010,7 @@ void lv_obj_set_size(lv_obj_t * obj, lv_coord_t w, lv_coord_t h)
 
     /*Save the original coordinates*/
     lv_area_t ori;
-    lv_obj_get_coords(obj, &ori);
+    lv_area_copy(&ori, &obj->coords);
 
     /*Set the length and height*/
     obj->coords.y2 = obj->coords.y1 + h - 1;
@@ -893,7 +1052,7 @@ void lv_obj_set_width(lv_obj_t * obj, lv_coord_t w)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
-    lv_obj_set_size(obj, w, lv_obj_get_height(obj));
+    lv_obj_set_size(obj, w, lv_area_get_height(&obj->coords));
 }
 
 /**
@@ -905,7 +1064,7 @@ void lv_obj_set_height(lv_obj_t * obj, lv_coord_t h)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
-    lv_obj_set_size(obj, lv_obj_get_width(obj), h);
+    lv_obj_set_size(obj, lv_area_get_width(&obj->coords), h);
 }
 
 /**
@@ -1163,6 +1322,11 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, lv_coord_t left, lv_coord_t right
     (void)top;    /*Unused*/
     (void)bottom; /*Unused*/
 #endif
+
+#if LV_INDEV_HIT_INDEX && LV_USE_EXT_CLICK_AREA != LV_EXT_CLICK_AREA_OFF
+    /*The clickable area of the object is changed*/
+    _lv_hit_index_invalidate(obj->parent);
+#endif
 }
 
 /*---------------------
@@ -1357,8 +1521,13 @@ bool lv_obj_remove_style_local_prop(lv_obj_t * obj, uint8_t part, lv_style_prope
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
     lv_style_t * style = lv_obj_get_local_style(obj, part);
-    if(style) return lv_style_remove_prop(style, prop);
-    else return false;
+    if(style == NULL) return false;
+
+    bool res = lv_style_remove_prop(style, prop);
+#if LV_STYLE_RES_CACHE
+    if(res) style_res_clear(obj, (prop & LV_STYLE_INHERIT_MASK) ? true : false);
+#endif
+    return res;
 }
 
 /**
@@ -1513,6 +1682,11 @@ void lv_obj_set_adv_hittest(lv_obj_t * obj, bool en)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
     obj->adv_hittest = en == false ? 0 : 1;
+
+#if LV_INDEV_HIT_INDEX
+    /*The children with advanced hit-testing are indexed separately*/
+    _lv_hit_index_invalidate(obj->parent);
+#endif
 }
 
 /**
@@ -1726,6 +1900,11 @@ void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
 
     obj->state = new_state;
 
+#if LV_STYLE_RES_CACHE
+    /*The children might inherit properties from the new state*/
+    style_res_clear(obj, true);
+#endif
+
     if(cmp_res == STYLE_COMPARE_SAME) {
         return;
     }
@@ -2054,6 +2233,27 @@ void * lv_obj_allocate_ext_attr(lv_obj_t * obj, uint16_t ext_size)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
+#if LV_OBJ_SLAB
+    if(obj->slab_id) {
+        uint8_t * slab_ext = slab_get_ext(obj);
+        uint32_t slab_ext_size = slabs[obj->slab_id - 1].block_size - (uint32_t)(slab_ext - (uint8_t *)obj);
+        if(obj->ext_attr == NULL || obj->ext_attr == slab_ext) {
+            if(ext_size <= slab_ext_size) {
+                obj->ext_attr = slab_ext;
+                return (void *)obj->ext_attr;
+            }
+
+            /*Doesn't fit into the object's block. Move it to a new memory*/
+            void * new_ext = lv_mem_alloc(ext_size);
+            if(new_ext == NULL) return NULL;
+            if(obj->ext_attr) _lv_memcpy(new_ext, obj->ext_attr, slab_ext_size);
+
+            obj->ext_attr = new_ext;
+            return (void *)obj->ext_attr;
+        }
+    }
+#endif
+
     void * new_ext = lv_mem_realloc(obj->ext_attr, ext_size);
     if(new_ext == NULL) return NULL;
 
@@ -2061,6 +2261,55 @@ void * lv_obj_allocate_ext_attr(lv_obj_t * obj, uint16_t ext_size)
     return (void *)obj->ext_attr;
 }
 
+/**
+ * Tell the size of the ext. data the next created object will allocate.
+ * Used in the `create` functions of the widgets before creating the ancestor object.
+ * If `LV_OBJ_SLAB` is enabled the ext. data is allocated together with the object.
+ * @param ext_size size of the ext. data. If called multiple times the largest is used.
+ */
+void _lv_obj_reserve_ext_attr(uint16_t ext_size)
+{
+    if(ext_size > ext_reserve) ext_reserve = ext_size;
+}
+
+#if LV_OBJ_SLAB
+/**
+ * Get statistics about the object slabs
+ * @param mon_p pointer to a monitor variable to fill
+ */
+void lv_obj_slab_monitor(lv_obj_slab_monitor_t * mon_p)
+{
+    _lv_memset_00(mon_p, sizeof(lv_obj_slab_monitor_t));
+
+    mon_p->alloc_cnt = slab_alloc_cnt;
+    mon_p->reuse_cnt = slab_reuse_cnt;
+
+    uint32_t i;
+    for(i = 0; i < LV_OBJ_SLAB_CLASS_CNT; i++) {
+        if(slabs[i].block_size == 0) break;
+        mon_p->slab_cnt++;
+        mon_p->cached_cnt += slabs[i].free_cnt;
+        mon_p->cached_size += slabs[i].free_cnt * slabs[i].block_size;
+    }
+}
+
+/**
+ * Free the cached free blocks of the object slabs
+ */
+void lv_obj_slab_flush(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_OBJ_SLAB_CLASS_CNT; i++) {
+        while(slabs[i].free_head) {
+            void * block = slabs[i].free_head;
+            slabs[i].free_head = *((void **)block);
+            lv_mem_free(block);
+        }
+        slabs[i].free_cnt = 0;
+    }
+}
+#endif
+
 /**
  * Send a 'LV_SIGNAL_REFR_EXT_SIZE' signal to the object to refresh the extended draw area.
  * he object needs to be invalidated by `lv_obj_invalidate(obj)` manually after this function.
@@ -2238,6 +2487,8 @@ void lv_obj_get_coords(const lv_obj_t * obj, lv_area_t * cords_p)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
+    layout_flush();
+
     lv_area_copy(cords_p, &obj->coords);
 }
 
@@ -2271,6 +2522,8 @@ lv_coord_t lv_obj_get_x(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
+    layout_flush();
+
     lv_coord_t rel_x;
     lv_obj_t * parent = lv_obj_get_parent(obj);
     if(parent) {
@@ -2291,6 +2544,8 @@ lv_coord_t lv_obj_get_y(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
+    layout_flush();
+
     lv_coord_t rel_y;
     lv_obj_t * parent = lv_obj_get_parent(obj);
     if(parent) {
@@ -2311,6 +2566,8 @@ lv_coord_t lv_obj_get_width(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
+    layout_flush();
+
     return lv_area_get_width(&obj->coords);
 }
 
@@ -2323,6 +2580,8 @@ lv_coord_t lv_obj_get_height(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
+    layout_flush();
+
     return lv_area_get_height(&obj->coords);
 }
 
@@ -2567,119 +2826,18 @@ lv_style_list_t * lv_obj_get_style_list(const lv_obj_t * obj, uint8_t part)
  */
 lv_style_int_t _lv_obj_get_style_int(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
-
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    lv_style_int_t value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-        if(!list->ignore_cache && list->style_cnt > 0) {
-            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
-
-            bool def = false;
-            switch(prop  & (~LV_STYLE_STATE_MASK)) {
-                case LV_STYLE_CLIP_CORNER:
-                    if(list->clip_corner_off) def = true;
-                    break;
-                case LV_STYLE_TEXT_LETTER_SPACE:
-                case LV_STYLE_TEXT_LINE_SPACE:
-                    if(list->text_space_zero) def = true;
-                    break;
-                case LV_STYLE_TRANSFORM_ANGLE:
-                case LV_STYLE_TRANSFORM_WIDTH:
-                case LV_STYLE_TRANSFORM_HEIGHT:
-                case LV_STYLE_TRANSFORM_ZOOM:
-                    if(list->transform_all_zero) def = true;
-                    break;
-                case LV_STYLE_BORDER_WIDTH:
-                    if(list->border_width_zero) def = true;
-                    break;
-                case LV_STYLE_BORDER_SIDE:
-                    if(list->border_side_full) def = true;
-                    break;
-                case LV_STYLE_BORDER_POST:
-                    if(list->border_post_off) def = true;
-                    break;
-                case LV_STYLE_OUTLINE_WIDTH:
-                    if(list->outline_width_zero) def = true;
-                    break;
-                case LV_STYLE_RADIUS:
-                    if(list->radius_zero) def = true;
-                    break;
-                case LV_STYLE_SHADOW_WIDTH:
-                    if(list->shadow_width_zero) def = true;
-                    break;
-                case LV_STYLE_PAD_TOP:
-                case LV_STYLE_PAD_BOTTOM:
-                case LV_STYLE_PAD_LEFT:
-                case LV_STYLE_PAD_RIGHT:
-                    if(list->pad_all_zero) def = true;
-                    break;
-                case LV_STYLE_MARGIN_TOP:
-                case LV_STYLE_MARGIN_BOTTOM:
-                case LV_STYLE_MARGIN_LEFT:
-                case LV_STYLE_MARGIN_RIGHT:
-                    if(list->margin_all_zero) def = true;
-                    break;
-                case LV_STYLE_BG_BLEND_MODE:
-                case LV_STYLE_BORDER_BLEND_MODE:
-                case LV_STYLE_IMAGE_BLEND_MODE:
-                case LV_STYLE_LINE_BLEND_MODE:
-                case LV_STYLE_OUTLINE_BLEND_MODE:
-                case LV_STYLE_PATTERN_BLEND_MODE:
-                case LV_STYLE_SHADOW_BLEND_MODE:
-                case LV_STYLE_TEXT_BLEND_MODE:
-                case LV_STYLE_VALUE_BLEND_MODE:
-                    if(list->blend_mode_all_normal) def = true;
-                    break;
-                case LV_STYLE_TEXT_DECOR:
-                    if(list->text_decor_none) def = true;
-                    break;
-            }
-
-            if(def) {
-                break;
-            }
-        }
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_int(list, prop, &value_act);
-        if(res == LV_RES_OK) return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
-        }
-
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
-    }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_BORDER_SIDE:
-            return LV_BORDER_SIDE_FULL;
-        case LV_STYLE_SIZE:
-            return LV_DPI / 20;
-        case LV_STYLE_SCALE_WIDTH:
-            return LV_DPI / 8;
-        case LV_STYLE_BG_GRAD_STOP:
-            return 255;
-        case LV_STYLE_TRANSFORM_ZOOM:
-            return LV_IMG_ZOOM_NONE;
-    }
+#if LV_STYLE_RES_CACHE
+    lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+    lv_style_property_t prop_state = prop + ((uint16_t)lv_obj_get_state(obj, part) << LV_STYLE_STATE_POS);
+    lv_style_res_value_t v;
+    if(_lv_style_list_res_get(list, prop_state, &v)) return v._int;
 
-    return 0;
+    v._int = style_resolve_int(obj, part, prop);
+    _lv_style_list_res_set(list, prop_state, &v);
+    return v._int;
+#else
+    return style_resolve_int(obj, part, prop);
+#endif
 }
 
 /**
@@ -2698,44 +2856,18 @@ lv_style_int_t _lv_obj_get_style_int(const lv_obj_t * obj, uint8_t part, lv_styl
  */
 lv_color_t _lv_obj_get_style_color(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
-
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    lv_color_t value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_color(list, prop, &value_act);
-        if(res == LV_RES_OK) return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
-        }
-
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
-    }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_BG_COLOR:
-        case LV_STYLE_BG_GRAD_COLOR:
-            return LV_COLOR_WHITE;
-    }
+#if LV_STYLE_RES_CACHE
+    lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+    lv_style_property_t prop_state = prop + ((uint16_t)lv_obj_get_state(obj, part) << LV_STYLE_STATE_POS);
+    lv_style_res_value_t v;
+    if(_lv_style_list_res_get(list, prop_state, &v)) return v._color;
 
-    return LV_COLOR_BLACK;
+    v._color = style_resolve_color(obj, part, prop);
+    _lv_style_list_res_set(list, prop_state, &v);
+    return v._color;
+#else
+    return style_resolve_color(obj, part, prop);
+#endif
 }
 
 /**
@@ -2754,66 +2886,18 @@ lv_color_t _lv_obj_get_style_color(const lv_obj_t * obj, uint8_t part, lv_style_
  */
 lv_opa_t _lv_obj_get_style_opa(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
+#if LV_STYLE_RES_CACHE
+    lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+    lv_style_property_t prop_state = prop + ((uint16_t)lv_obj_get_state(obj, part) << LV_STYLE_STATE_POS);
+    lv_style_res_value_t v;
+    if(_lv_style_list_res_get(list, prop_state, &v)) return v._opa;
 
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    lv_opa_t value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-
-        if(!list->ignore_cache && list->style_cnt > 0) {
-            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
-            bool def = false;
-            switch(prop & (~LV_STYLE_STATE_MASK)) {
-                case LV_STYLE_OPA_SCALE:
-                    if(list->opa_scale_cover) def = true;
-                    break;
-                case LV_STYLE_BG_OPA:
-                    if(list->bg_opa_cover) return LV_OPA_COVER;     /*Special case, not the default value is used*/
-                    if(list->bg_opa_transp) def = true;
-                    break;
-                case LV_STYLE_IMAGE_RECOLOR_OPA:
-                    if(list->img_recolor_opa_transp) def = true;
-                    break;
-            }
-
-            if(def) {
-                break;
-            }
-        }
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_opa(list, prop, &value_act);
-        if(res == LV_RES_OK) return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
-        }
-
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
-    }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_BG_OPA:
-        case LV_STYLE_IMAGE_RECOLOR_OPA:
-        case LV_STYLE_PATTERN_RECOLOR_OPA:
-            return LV_OPA_TRANSP;
-    }
-
-    return LV_OPA_COVER;
+    v._opa = style_resolve_opa(obj, part, prop);
+    _lv_style_list_res_set(list, prop_state, &v);
+    return v._opa;
+#else
+    return style_resolve_opa(obj, part, prop);
+#endif
 }
 
 /**
@@ -2832,68 +2916,18 @@ lv_opa_t _lv_obj_get_style_opa(const lv_obj_t * obj, uint8_t part, lv_style_prop
  */
 const void * _lv_obj_get_style_ptr(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
-
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    const void * value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-
-        if(!list->ignore_cache && list->style_cnt > 0) {
-            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
-            bool def = false;
-            switch(prop  & (~LV_STYLE_STATE_MASK)) {
-                case LV_STYLE_VALUE_STR:
-                    if(list->value_txt_str) def = true;
-                    break;
-                case LV_STYLE_PATTERN_IMAGE:
-                    if(list->pattern_img_null) def = true;
-                    break;
-                case LV_STYLE_TEXT_FONT:
-                    if(list->text_font_normal) def = true;
-                    break;
-            }
-
-            if(def) {
-                break;
-            }
-        }
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_ptr(list, prop, &value_act);
-        if(res == LV_RES_OK)  return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
-        }
-
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
-    }
+#if LV_STYLE_RES_CACHE
+    lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+    lv_style_property_t prop_state = prop + ((uint16_t)lv_obj_get_state(obj, part) << LV_STYLE_STATE_POS);
+    lv_style_res_value_t v;
+    if(_lv_style_list_res_get(list, prop_state, &v)) return v._ptr;
 
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_TEXT_FONT:
-        case LV_STYLE_VALUE_FONT:
-            return lv_theme_get_font_normal();
-#if LV_USE_ANIMATION
-        case LV_STYLE_TRANSITION_PATH:
-            return &lv_anim_path_def;
+    v._ptr = style_resolve_ptr(obj, part, prop);
+    _lv_style_list_res_set(list, prop_state, &v);
+    return v._ptr;
+#else
+    return style_resolve_ptr(obj, part, prop);
 #endif
-    }
-
-    return NULL;
 }
 
 /**
@@ -3791,6 +3825,9 @@ static void obj_del_core(lv_obj_t * obj)
 
     lv_event_mark_deleted(obj);
 
+    /*Collect the areas of the whole display if the root of an update transaction is deleted*/
+    if(update.root == obj) update.root = NULL;
+
     /* Reset all input devices if the object to delete is used*/
     lv_indev_t * indev = lv_indev_get_next(NULL);
     while(indev) {
@@ -3815,6 +3852,10 @@ static void obj_del_core(lv_obj_t * obj)
 
     /*Remove the object from parent's children list*/
     lv_obj_t * par = lv_obj_get_parent(obj);
+#if LV_INDEV_HIT_INDEX
+    _lv_hit_index_del(obj);
+    _lv_hit_index_invalidate(par);
+#endif
     if(par == NULL) { /*It is a screen*/
         lv_disp_t * d = lv_obj_get_disp(obj);
         _lv_ll_remove(&d->scr_ll, obj);
@@ -3824,9 +3865,108 @@ static void obj_del_core(lv_obj_t * obj)
     }
 
     /*Delete the base objects*/
+#if LV_OBJ_SLAB
+    if(obj->slab_id && obj->ext_attr == slab_get_ext(obj)) obj->ext_attr = NULL;
+#endif
     if(obj->ext_attr != NULL) lv_mem_free(obj->ext_attr);
-    lv_mem_free(obj); /*Free the object itself*/
+    obj_free(obj); /*Free the object itself*/
+}
+
+/**
+ * Allocate a new object as the head of a list and clear it.
+ * Use the ext. data size reserved by `_lv_obj_reserve_ext_attr()` to find the object's slab.
+ * @param ll_p pointer to the linked list of the new object (screens or children of a parent)
+ * @return pointer to the new object or NULL if out of memory
+ */
+static lv_obj_t * obj_alloc(lv_ll_t * ll_p)
+{
+    lv_obj_t * obj = NULL;
+    uint16_t ext_size = ext_reserve;
+    ext_reserve = 0;
+
+#if LV_OBJ_SLAB
+    uint32_t block_size = _lv_ll_get_node_size(ll_p) + LV_OBJ_SLAB_STYLE_CNT * sizeof(lv_style_t *) + ext_size;
+    block_size = (block_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+
+    /*Find the slab with this block size or take the first unused*/
+    uint32_t id;
+    for(id = 0; id < LV_OBJ_SLAB_CLASS_CNT; id++) {
+        if(slabs[id].block_size == block_size || slabs[id].block_size == 0) break;
+    }
+
+    if(id < LV_OBJ_SLAB_CLASS_CNT) {
+        lv_obj_slab_t * slab = &slabs[id];
+        slab->block_size = block_size;
+        if(slab->free_head) {
+            obj = slab->free_head;
+            slab->free_head = *((void **)obj);
+            slab->free_cnt--;
+            slab_reuse_cnt++;
+        }
+        else {
+            obj = lv_mem_alloc(block_size);
+            if(obj == NULL) return NULL;
+        }
+        slab_alloc_cnt++;
+
+        _lv_ll_link_head(ll_p, obj);
+        _lv_memset_00(obj, sizeof(lv_obj_t));
+        obj->slab_id = id + 1;
+        return obj;
+    }
+#else
+    LV_UNUSED(ext_size);
+#endif
+
+    obj = _lv_ll_ins_head(ll_p);
+    if(obj == NULL) return NULL;
+
+    _lv_memset_00(obj, sizeof(lv_obj_t));
+    return obj;
+}
+
+/**
+ * Free an object allocated by `obj_alloc()`. It should be already removed from its list.
+ * @param obj pointer to an object
+ */
+static void obj_free(lv_obj_t * obj)
+{
+#if LV_OBJ_SLAB
+    if(obj->slab_id) {
+        lv_obj_slab_t * slab = &slabs[obj->slab_id - 1];
+        if(slab->free_cnt < LV_OBJ_SLAB_CACHE_CNT) {
+            *((void **)obj) = slab->free_head;
+            slab->free_head = obj;
+            slab->free_cnt++;
+            return;
+        }
+    }
+#endif
+
+    lv_mem_free(obj);
+}
+
+#if LV_OBJ_SLAB
+/**
+ * Get the style pointers allocated together with an object
+ * @param obj pointer to an object allocated from a slab
+ * @return pointer to `LV_OBJ_SLAB_STYLE_CNT` style pointers
+ */
+static lv_style_t ** slab_get_styles(lv_obj_t * obj)
+{
+    return (lv_style_t **)((uint8_t *)obj + _lv_ll_get_node_size(&obj->child_ll));
+}
+
+/**
+ * Get the ext. data allocated together with an object
+ * @param obj pointer to an object allocated from a slab
+ * @return pointer to the ext. data area
+ */
+static void * slab_get_ext(lv_obj_t * obj)
+{
+    return slab_get_styles(obj) + LV_OBJ_SLAB_STYLE_CNT;
 }
+#endif
 
 /**
  * Handle the drawing related tasks of the base objects.
@@ -3992,6 +4132,11 @@ static lv_res_t lv_obj_signal(lv_obj_t * obj, lv_signal_t sign, void * param)
     else if(sign == LV_SIGNAL_STYLE_CHG) {
         lv_obj_refresh_ext_draw_pad(obj);
     }
+#if LV_INDEV_HIT_INDEX
+    else if(sign == LV_SIGNAL_COORD_CHG) {
+        _lv_hit_index_obj_move(obj, param);
+    }
+#endif
     else if(sign == LV_SIGNAL_PRESSED) {
         lv_obj_add_state(obj, LV_STATE_PRESSED);
     }
@@ -4050,6 +4195,9 @@ static void refresh_children_position(lv_obj_t * obj, lv_coord_t x_diff, lv_coor
         i->coords.x2 += x_diff;
         i->coords.y2 += y_diff;
 
+#if LV_INDEV_HIT_INDEX
+        if(i->hit_index) _lv_hit_index_shift(i, x_diff, y_diff);
+#endif
         refresh_children_position(i, x_diff, y_diff);
     }
 }
@@ -4121,6 +4269,8 @@ static void base_dir_refr_children(lv_obj_t * obj)
 static void obj_align_core(lv_obj_t * obj, const lv_obj_t * base, lv_align_t align, bool x_set, bool y_set,
                            lv_coord_t x_ofs, lv_coord_t y_ofs)
 {
+    layout_flush();
+
     lv_point_t new_pos;
     _lv_area_align(&base->coords, &obj->coords, align, &new_pos);
 
@@ -4418,6 +4568,9 @@ static void trans_del(lv_obj_t * obj, uint8_t part, lv_style_property_t prop, lv
             lv_style_list_t * list = lv_obj_get_style_list(tr->obj, tr->part);
             lv_style_t * style_trans = _lv_style_list_get_transition_style(list);
             lv_style_remove_prop(style_trans, tr->prop);
+#if LV_STYLE_RES_CACHE
+            style_res_clear(tr->obj, (tr->prop & LV_STYLE_INHERIT_MASK) ? true : false);
+#endif
 
             lv_anim_del(tr, NULL);
             _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_trans_ll), tr);
@@ -4512,6 +4665,9 @@ static void trans_anim_ready_cb(lv_anim_t * a)
         lv_style_list_t * list = lv_obj_get_style_list(tr->obj, tr->part);
         lv_style_t * style_trans = _lv_style_list_get_transition_style(list);
         lv_style_remove_prop(style_trans, tr->prop);
+#if LV_STYLE_RES_CACHE
+        style_res_clear(tr->obj, (tr->prop & LV_STYLE_INHERIT_MASK) ? true : false);
+#endif
     }
 
     _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_trans_ll), tr);
@@ -4733,6 +4889,11 @@ static void update_style_cache_children(lv_obj_t * obj)
  */
 static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
+#if LV_STYLE_RES_CACHE
+    /*Only the inherited properties can affect the children*/
+    style_res_clear(obj, (prop == LV_STYLE_PROP_ALL || (prop & LV_STYLE_INHERIT_MASK)) ? true : false);
+#endif
+
     if(style_prop_is_cacheble(prop) == false) return;
 
     for(part = 0; part < _LV_OBJ_PART_REAL_FIRST; part++) {
@@ -4754,6 +4915,37 @@ static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_proper
     }
 }
 
+#if LV_STYLE_RES_CACHE
+/**
+ * Remove the resolved style properties from the caches of all parts of an object
+ * @param obj pointer to an object
+ * @param children true: clear the caches of the children too (recursively)
+ */
+static void style_res_clear(lv_obj_t * obj, bool children)
+{
+    uint8_t part;
+    for(part = 0; part < _LV_OBJ_PART_REAL_FIRST; part++) {
+        lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+        if(list == NULL) break;
+        _lv_style_list_res_clear(list);
+    }
+
+    for(part = _LV_OBJ_PART_REAL_FIRST; part < 0xFF; part++) {
+        lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+        if(list == NULL) break;
+        _lv_style_list_res_clear(list);
+    }
+
+    if(children == false) return;
+
+    lv_obj_t * child = lv_obj_get_child(obj, NULL);
+    while(child) {
+        style_res_clear(child, true);
+        child = lv_obj_get_child(obj, child);
+    }
+}
+#endif
+
 static void style_snapshot(lv_obj_t * obj, uint8_t part, style_snapshot_t * shot)
 {
     _lv_obj_disable_style_caching(obj, true);
@@ -4832,3 +5024,388 @@ static style_snapshot_res_t style_snapshot_compare(style_snapshot_t * shot1, sty
     /*If not returned earlier its just a visual difference, a simple redraw is enough*/
     return STYLE_COMPARE_VISUAL_DIFF;
 }
+
+/**
+ * Resolve an integer style property of a part of an object from its styles in the object's current state.
+ * If not found, checks the `MAIN` part and the parents for inherited properties and returns the default value.
+ * @param obj pointer to an object
+ * @param part the part of the object which style property should be get.
+ * @param prop the property to get. The state of the object will be added internally
+ * @return the value of the property
+ */
+static lv_style_int_t style_resolve_int(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    lv_style_int_t value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+        if(!list->ignore_cache && list->style_cnt > 0) {
+            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
+
+            bool def = false;
+            switch(prop  & (~LV_STYLE_STATE_MASK)) {
+                case LV_STYLE_CLIP_CORNER:
+                    if(list->clip_corner_off) def = true;
+                    break;
+                case LV_STYLE_TEXT_LETTER_SPACE:
+                case LV_STYLE_TEXT_LINE_SPACE:
+                    if(list->text_space_zero) def = true;
+                    break;
+                case LV_STYLE_TRANSFORM_ANGLE:
+                case LV_STYLE_TRANSFORM_WIDTH:
+                case LV_STYLE_TRANSFORM_HEIGHT:
+                case LV_STYLE_TRANSFORM_ZOOM:
+                    if(list->transform_all_zero) def = true;
+                    break;
+                case LV_STYLE_BORDER_WIDTH:
+                    if(list->border_width_zero) def = true;
+                    break;
+                case LV_STYLE_BORDER_SIDE:
+                    if(list->border_side_full) def = true;
+                    break;
+                case LV_STYLE_BORDER_POST:
+                    if(list->border_post_off) def = true;
+                    break;
+                case LV_STYLE_OUTLINE_WIDTH:
+                    if(list->outline_width_zero) def = true;
+                    break;
+                case LV_STYLE_RADIUS:
+                    if(list->radius_zero) def = true;
+                    break;
+                case LV_STYLE_SHADOW_WIDTH:
+                    if(list->shadow_width_zero) def = true;
+                    break;
+                case LV_STYLE_PAD_TOP:
+                case LV_STYLE_PAD_BOTTOM:
+                case LV_STYLE_PAD_LEFT:
+                case LV_STYLE_PAD_RIGHT:
+                    if(list->pad_all_zero) def = true;
+                    break;
+                case LV_STYLE_MARGIN_TOP:
+                case LV_STYLE_MARGIN_BOTTOM:
+                case LV_STYLE_MARGIN_LEFT:
+                case LV_STYLE_MARGIN_RIGHT:
+                    if(list->margin_all_zero) def = true;
+                    break;
+                case LV_STYLE_BG_BLEND_MODE:
+                case LV_STYLE_BORDER_BLEND_MODE:
+                case LV_STYLE_IMAGE_BLEND_MODE:
+                case LV_STYLE_LINE_BLEND_MODE:
+                case LV_STYLE_OUTLINE_BLEND_MODE:
+                case LV_STYLE_PATTERN_BLEND_MODE:
+                case LV_STYLE_SHADOW_BLEND_MODE:
+                case LV_STYLE_TEXT_BLEND_MODE:
+                case LV_STYLE_VALUE_BLEND_MODE:
+                    if(list->blend_mode_all_normal) def = true;
+                    break;
+                case LV_STYLE_TEXT_DECOR:
+                    if(list->text_decor_none) def = true;
+                    break;
+            }
+
+            if(def) {
+                break;
+            }
+        }
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_int(list, prop, &value_act);
+        if(res == LV_RES_OK) return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_BORDER_SIDE:
+            return LV_BORDER_SIDE_FULL;
+        case LV_STYLE_SIZE:
+            return LV_DPI / 20;
+        case LV_STYLE_SCALE_WIDTH:
+            return LV_DPI / 8;
+        case LV_STYLE_BG_GRAD_STOP:
+            return 255;
+        case LV_STYLE_TRANSFORM_ZOOM:
+            return LV_IMG_ZOOM_NONE;
+    }
+
+    return 0;
+}
+
+/**
+ * Resolve a color style property of a part of an object from its styles in the object's current state.
+ * If not found, checks the `MAIN` part and the parents for inherited properties and returns the default value.
+ * @param obj pointer to an object
+ * @param part the part of the object which style property should be get.
+ * @param prop the property to get. The state of the object will be added internally
+ * @return the value of the property
+ */
+static lv_color_t style_resolve_color(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    lv_color_t value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_color(list, prop, &value_act);
+        if(res == LV_RES_OK) return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_BG_COLOR:
+        case LV_STYLE_BG_GRAD_COLOR:
+            return LV_COLOR_WHITE;
+    }
+
+    return LV_COLOR_BLACK;
+}
+
+/**
+ * Resolve an opacity style property of a part of an object from its styles in the object's current state.
+ * If not found, checks the `MAIN` part and the parents for inherited properties and returns the default value.
+ * @param obj pointer to an object
+ * @param part the part of the object which style property should be get.
+ * @param prop the property to get. The state of the object will be added internally
+ * @return the value of the property
+ */
+static lv_opa_t style_resolve_opa(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    lv_opa_t value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+
+        if(!list->ignore_cache && list->style_cnt > 0) {
+            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
+            bool def = false;
+            switch(prop & (~LV_STYLE_STATE_MASK)) {
+                case LV_STYLE_OPA_SCALE:
+                    if(list->opa_scale_cover) def = true;
+                    break;
+                case LV_STYLE_BG_OPA:
+                    if(list->bg_opa_cover) return LV_OPA_COVER;     /*Special case, not the default value is used*/
+                    if(list->bg_opa_transp) def = true;
+                    break;
+                case LV_STYLE_IMAGE_RECOLOR_OPA:
+                    if(list->img_recolor_opa_transp) def = true;
+                    break;
+            }
+
+            if(def) {
+                break;
+            }
+        }
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_opa(list, prop, &value_act);
+        if(res == LV_RES_OK) return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_BG_OPA:
+        case LV_STYLE_IMAGE_RECOLOR_OPA:
+        case LV_STYLE_PATTERN_RECOLOR_OPA:
+            return LV_OPA_TRANSP;
+    }
+
+    return LV_OPA_COVER;
+}
+
+/**
+ * Resolve a pointer style property of a part of an object from its styles in the object's current state.
+ * If not found, checks the `MAIN` part and the parents for inherited properties and returns the default value.
+ * @param obj pointer to an object
+ * @param part the part of the object which style property should be get.
+ * @param prop the property to get. The state of the object will be added internally
+ * @return the value of the property
+ */
+static const void * style_resolve_ptr(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    const void * value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+
+        if(!list->ignore_cache && list->style_cnt > 0) {
+            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
+            bool def = false;
+            switch(prop  & (~LV_STYLE_STATE_MASK)) {
+                case LV_STYLE_VALUE_STR:
+                    if(list->value_txt_str) def = true;
+                    break;
+                case LV_STYLE_PATTERN_IMAGE:
+                    if(list->pattern_img_null) def = true;
+                    break;
+                case LV_STYLE_TEXT_FONT:
+                    if(list->text_font_normal) def = true;
+                    break;
+            }
+
+            if(def) {
+                break;
+            }
+        }
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_ptr(list, prop, &value_act);
+        if(res == LV_RES_OK)  return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_TEXT_FONT:
+        case LV_STYLE_VALUE_FONT:
+            return lv_theme_get_font_normal();
+#if LV_USE_ANIMATION
+        case LV_STYLE_TRANSITION_PATH:
+            return &lv_anim_path_def;
+#endif
+    }
+
+    return NULL;
+}
+
+/**
+ * Refresh the containers waiting for a layout refresh before reading coordinates
+ */
+static inline void layout_flush(void)
+{
+#if LV_USE_CONT && LV_CONT_LAYOUT_DEFER
+    _lv_cont_layout_flush();
+#endif
+}
+
+/**
+ * Collect an invalidated area in the update transaction
+ * @param obj pointer to the invalidated object
+ * @param area the visible area to invalidate
+ * @return true: the area was collected; false: the object is not in the transaction
+ */
+static bool update_add_area(const lv_obj_t * obj, const lv_area_t * area)
+{
+    if(update.root) {
+        const lv_obj_t * i = obj;
+        while(i && i != update.root) i = lv_obj_get_parent(i);
+        if(i == NULL) return false;
+    }
+    else if(lv_obj_get_disp(obj) != update.disp) {
+        return false;
+    }
+
+    uint16_t i;
+    for(i = 0; i < update.area_cnt; i++) {
+        if(_lv_area_is_in(area, &update.areas[i], 0)) return true;
+    }
+
+    /*Join with an area if the result is not larger than the two areas separately (overlapping or neighbors)*/
+    lv_area_t joined;
+    for(i = 0; i < update.area_cnt; i++) {
+        _lv_area_join(&joined, area, &update.areas[i]);
+        if(lv_area_get_size(&joined) <= lv_area_get_size(area) + lv_area_get_size(&update.areas[i])) {
+            lv_area_copy(&update.areas[i], &joined);
+            return true;
+        }
+    }
+
+    if(update.area_cnt < UPDATE_AREA_MAX) {
+        lv_area_copy(&update.areas[update.area_cnt], area);
+        update.area_cnt++;
+        return true;
+    }
+
+    /*No free place: join with the area which grows the least*/
+    uint16_t best = 0;
+    uint32_t best_grow = UINT32_MAX;
+    for(i = 0; i < update.area_cnt; i++) {
+        _lv_area_join(&joined, area, &update.areas[i]);
+        uint32_t grow = lv_area_get_size(&joined) - lv_area_get_size(&update.areas[i]);
+        if(grow < best_grow) {
+            best_grow = grow;
+            best = i;
+        }
+    }
+    _lv_area_join(&update.areas[best], area, &update.areas[best]);
+
+    return true;
+}
@@ -229,6 +229,9 @@ typedef struct _lv_obj_t {
 
     lv_drag_dir_t drag_dir  : 3; /**<  Which directions the object can be dragged in */
     lv_bidi_dir_t base_dir  : 2; /**< Base direction of texts related to this object */
+#if LV_INDEV_HIT_INDEX
+    uint8_t hit_index       : 1; /**< 1: The children are indexed for hit-testing*/
+#endif
 
 #if LV_USE_GROUP != 0
     void * group_p;
@@ -238,6 +241,10 @@ typedef struct _lv_obj_t {
                                      'OR'ed values from `lv_protect_t`*/
     lv_state_t state;
 
+#if LV_OBJ_SLAB
+    uint8_t slab_id;            /**< 1 + index of the slab the object is allocated from. 0: not from a slab*/
+#endif
+
 #if LV_USE_OBJ_REALIGN
     lv_realign_t realign;       /**< Information about the last call to ::lv_obj_align. */
 #endif
@@ -248,6 +255,17 @@ typedef struct _lv_obj_t {
 
 } lv_obj_t;
 
+#if LV_OBJ_SLAB
+/** Statistics of the object slabs. See `lv_obj_slab_monitor()`*/
+typedef struct {
+    uint32_t alloc_cnt;     /**< Number of objects allocated from the slabs so far*/
+    uint32_t reuse_cnt;     /**< Number of objects allocated from a cached free block*/
+    uint32_t cached_cnt;    /**< Number of free blocks cached now*/
+    uint32_t cached_size;   /**< Total size of the cached free blocks*/
+    uint8_t slab_cnt;       /**< Number of slabs in use*/
+} lv_obj_slab_monitor_t;
+#endif
+
 enum {
     LV_OBJ_PART_MAIN,
     _LV_OBJ_PART_VIRTUAL_LAST = _LV_OBJ_PART_VIRTUAL_FIRST,
@@ -351,6 +369,22 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area);
  */
 void lv_obj_invalidate(const lv_obj_t * obj);
 
+/**
+ * Start to update the properties of an object and its children.
+ * Until `lv_obj_end_update()` the invalidated areas are only collected and joined,
+ * then the containers' layouts are refreshed and the collected areas are invalidated once.
+ * Can be nested. The transaction then covers the common ancestor of the objects.
+ * @param obj pointer to an object
+ */
+void lv_obj_begin_update(lv_obj_t * obj);
+
+/**
+ * Finish the update started with `lv_obj_begin_update()`.
+ * The outermost call refreshes the pending layouts and invalidates the collected areas.
+ * @param obj pointer to the object passed to `lv_obj_begin_update()`
+ */
+void lv_obj_end_update(lv_obj_t * obj);
+
 /**
  * Tell whether an area of an object is visible (even partially) now or not
  * @param obj pointer to an object
@@ -909,6 +943,27 @@ void lv_obj_set_design_cb(lv_obj_t * obj, lv_design_cb_t design_cb);
  */
 void * lv_obj_allocate_ext_attr(lv_obj_t * obj, uint16_t ext_size);
 
+/**
+ * Tell the size of the ext. data the next created object will allocate.
+ * Used in the `create` functions of the widgets before creating the ancestor object.
+ * If `LV_OBJ_SLAB` is enabled the ext. data is allocated together with the object.
+ * @param ext_size size of the ext. data. If called multiple times the largest is used.
+ */
+void _lv_obj_reserve_ext_attr(uint16_t ext_size);
+
+#if LV_OBJ_SLAB
+/**
+ * Get statistics about the object slabs
+ * @param mon_p pointer to a monitor variable to fill
+ */
+void lv_obj_slab_monitor(lv_obj_slab_monitor_t * mon_p);
+
+/**
+ * Free the cached free blocks of the object slabs
+ */
+void lv_obj_slab_flush(void);
+#endif
+
 /**
  * Send a 'LV_SIGNAL_REFR_EXT_SIZE' signal to the object to refresh the extended draw area.
  * he object needs to be invalidated by `lv_obj_invalidate(obj)` manually after this function.
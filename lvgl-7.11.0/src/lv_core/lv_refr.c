@@ -18,6 +18,7 @@
 #include "../lv_draw/lv_draw.h"
 #include "../lv_font/lv_font_fmt_txt.h"
 #include "../lv_gpu/lv_gpu_stm32_dma2d.h"
+#include "../lv_widgets/lv_cont.h"
 
 #if LV_USE_PERF_MONITOR
     #include "../lv_widgets/lv_label.h"
@@ -80,7 +81,8 @@ void _lv_refr_init(void)
  */
 void lv_refr_now(lv_disp_t * disp)
 {
-#if LV_USE_ANIMATION
+    /*With `LV_ANIM_FRAME_SYNC` the refresh task steps the animations*/
+#if LV_USE_ANIMATION && LV_ANIM_FRAME_SYNC == 0
     lv_anim_refr_now();
 #endif
 
@@ -188,6 +190,19 @@ void _lv_disp_refr_task(lv_task_t * task)
     lv_task_set_prio(task, LV_TASK_PRIO_OFF);
 #endif
 
+#if LV_USE_ANIMATION && LV_ANIM_FRAME_SYNC
+    /* Step the animations exactly once per frame. The areas they invalidate are refreshed right now.
+     * Keep the task running while there are animations to step*/
+    if(disp_refr == lv_disp_get_default()) {
+        if(_lv_anim_refr_frame(task->period)) lv_task_set_prio(task, LV_REFR_TASK_PRIO);
+    }
+#endif
+
+#if LV_USE_CONT
+    /*Refresh the layouts changed since the last frame. They might invalidate areas too*/
+    if(disp_refr == lv_disp_get_default()) _lv_cont_refr_frame();
+#endif
+
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
@@ -12,22 +12,75 @@
 /*********************
  *      DEFINES
  *********************/
+#if LV_STYLE_RES_CACHE
+#if (LV_STYLE_RES_CACHE_MAX & (LV_STYLE_RES_CACHE_MAX - 1)) != 0
+    #error "LV_STYLE_RES_CACHE_MAX must be a power of 2"
+#endif
+
+/*Number of slots allocated first*/
+#if LV_STYLE_RES_CACHE_MAX < 16
+    #define STYLE_RES_SIZE_MIN  LV_STYLE_RES_CACHE_MAX
+#else
+    #define STYLE_RES_SIZE_MIN  16
+#endif
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_STYLE_RES_CACHE
+typedef struct {
+    lv_style_property_t prop;       /*The property with the state. 0: free slot*/
+    lv_style_res_value_t value;
+} style_res_slot_t;
+
+/*Open addressing hash table with linear probing. Filled to 3/4 at most*/
+typedef struct _lv_style_res_t {
+    uint16_t size;                  /*Number of slots, power of 2*/
+    uint16_t cnt;                   /*Number of used slots*/
+    style_res_slot_t slot[];
+} style_res_t;
+#endif
+
+#if LV_STYLE_INDEX
+typedef struct {
+    uint16_t key;                   /*ID and state of the property (without the inherit flag). 0xFFFF: free slot*/
+    uint16_t idx;                   /*Byte index of the property in the map*/
+} style_index_slot_t;
+
+/*Open addressing hash table with linear probing. Filled to 1/2 at most*/
+typedef struct _lv_style_index_t {
+    uint16_t size;                  /*Number of slots, power of 2*/
+    uint8_t states;                 /*OR-ed states of all properties*/
+    style_index_slot_t slot[];
+} style_index_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 LV_ATTRIBUTE_FAST_MEM static inline int32_t get_property_index(const lv_style_t * style, lv_style_property_t prop);
 static lv_style_t * get_alloc_local_style(lv_style_list_t * list);
+static lv_style_t ** style_list_alloc(lv_style_list_t * list, uint8_t cnt);
+static lv_style_t ** style_list_realloc(lv_style_list_t * list, uint8_t cnt);
+static void style_list_free(lv_style_list_t * list);
 static inline bool style_resize(lv_style_t * style, size_t sz);
 static inline lv_style_property_t get_style_prop(const lv_style_t * style, size_t idx);
 static inline uint8_t get_style_prop_id(const lv_style_t * style, size_t idx);
 static inline uint8_t get_style_prop_attr(const lv_style_t * style, size_t idx);
 static inline size_t get_prop_size(uint8_t prop_id);
 static inline size_t get_next_prop_index(uint8_t prop_id, size_t id);
+#if LV_STYLE_RES_CACHE || LV_STYLE_INDEX
+static inline uint32_t style_prop_hash(lv_style_property_t prop);
+#endif
+#if LV_STYLE_RES_CACHE
+static bool style_res_resize(lv_style_list_t * list, uint16_t size);
+static void style_res_free(lv_style_list_t * list);
+#endif
+#if LV_STYLE_INDEX
+static inline int32_t style_index_find(const lv_style_t * style, lv_style_property_t prop);
+static void style_index_free(lv_style_t * style);
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -36,6 +89,9 @@ static inline size_t get_next_prop_index(uint8_t prop_id, size_t id);
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_STYLE_RES_CACHE
+static lv_style_res_monitor_t res_mon;
+#endif
 
 /**********************
  *      MACROS
@@ -66,6 +122,10 @@ void lv_style_copy(lv_style_t * style_dest, const lv_style_t * style_src)
 {
     LV_ASSERT_STYLE(style_dest);
 
+#if LV_STYLE_INDEX
+    style_index_free(style_dest);
+#endif
+
     uint16_t size = _lv_style_get_mem_size(style_src);
     if(size == 0) return;
 
@@ -96,6 +156,9 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_property_t prop)
             uint32_t map_size = _lv_style_get_mem_size(style);
             uint8_t prop_size = get_prop_size(prop);
 
+#if LV_STYLE_INDEX
+            style_index_free(style);
+#endif
             /*Move the props to fill the space of the property to delete*/
             uint32_t i;
             for(i = id; i < map_size - prop_size; i++) {
@@ -135,19 +198,19 @@ void lv_style_list_copy(lv_style_list_t * list_dest, const lv_style_list_t * lis
 
     _lv_style_list_reset(list_dest);
 
-    if(list_src == NULL || list_src->style_list == NULL) return;
+    if(list_src == NULL || list_src->style_cnt == 0) return;
 
     /*Copy the styles but skip the transitions*/
     if(list_src->has_local == 0) {
         if(list_src->has_trans) {
-            list_dest->style_list = lv_mem_alloc((list_src->style_cnt - 1) * sizeof(lv_style_t *));
+            list_dest->style_list = style_list_alloc(list_dest, (list_src->style_cnt - 1));
             if(list_dest->style_list) {
                 _lv_memcpy(list_dest->style_list, list_src->style_list + 1, (list_src->style_cnt - 1) * sizeof(lv_style_t *));
                 list_dest->style_cnt = list_src->style_cnt - 1;
             }
         }
         else {
-            list_dest->style_list = lv_mem_alloc(list_src->style_cnt * sizeof(lv_style_t *));
+            list_dest->style_list = style_list_alloc(list_dest, list_src->style_cnt);
             if(list_dest->style_list) {
                 _lv_memcpy(list_dest->style_list, list_src->style_list, list_src->style_cnt * sizeof(lv_style_t *));
                 list_dest->style_cnt = list_src->style_cnt;
@@ -156,14 +219,14 @@ void lv_style_list_copy(lv_style_list_t * list_dest, const lv_style_list_t * lis
     }
     else {
         if(list_src->has_trans) {
-            list_dest->style_list = lv_mem_alloc((list_src->style_cnt - 2) * sizeof(lv_style_t *));
+            list_dest->style_list = style_list_alloc(list_dest, (list_src->style_cnt - 2));
             if(list_dest->style_list) {
                 _lv_memcpy(list_dest->style_list, list_src->style_list + 2, (list_src->style_cnt - 2) * sizeof(lv_style_t *));
                 list_dest->style_cnt = list_src->style_cnt - 2;
             }
         }
         else {
-            list_dest->style_list = lv_mem_alloc((list_src->style_cnt - 1) * sizeof(lv_style_t *));
+            list_dest->style_list = style_list_alloc(list_dest, (list_src->style_cnt - 1));
             if(list_dest->style_list) {
                 _lv_memcpy(list_dest->style_list, list_src->style_list + 1, (list_src->style_cnt - 1) * sizeof(lv_style_t *));
                 list_dest->style_cnt = list_src->style_cnt - 1;
@@ -194,8 +257,8 @@ void _lv_style_list_add_style(lv_style_list_t * list, lv_style_t * style)
     _lv_style_list_remove_style(list, style);
 
     lv_style_t ** new_styles;
-    if(list->style_cnt == 0) new_styles = lv_mem_alloc(sizeof(lv_style_t *));
-    else new_styles = lv_mem_realloc(list->style_list, sizeof(lv_style_t *) * (list->style_cnt + 1));
+    if(list->style_cnt == 0) new_styles = style_list_alloc(list, 1);
+    else new_styles = style_list_realloc(list, list->style_cnt + 1);
     LV_ASSERT_MEM(new_styles);
     if(new_styles == NULL) {
         LV_LOG_WARN("lv_style_list_add_style: couldn't add the style");
@@ -240,14 +303,13 @@ void _lv_style_list_remove_style(lv_style_list_t * list, lv_style_t * style)
     if(found == false) return;
 
     if(list->style_cnt == 1) {
-        lv_mem_free(list->style_list);
-        list->style_list = NULL;
+        style_list_free(list);
         list->style_cnt = 0;
         list->has_local = 0;
         return;
     }
 
-    lv_style_t ** new_styles = lv_mem_alloc(sizeof(lv_style_t *) * (list->style_cnt - 1));
+    lv_style_t ** new_styles = style_list_alloc(list, list->style_cnt - 1);
     LV_ASSERT_MEM(new_styles);
     if(new_styles == NULL) {
         LV_LOG_WARN("lv_style_list_remove_style: couldn't reallocate style list");
@@ -259,7 +321,7 @@ void _lv_style_list_remove_style(lv_style_list_t * list, lv_style_t * style)
         new_styles[j++] = list->style_list[i];
     }
 
-    lv_mem_free(list->style_list);
+    if(new_styles != list->style_list) lv_mem_free(list->style_list);
 
     list->style_cnt--;
     list->style_list = new_styles;
@@ -292,8 +354,10 @@ void _lv_style_list_reset(lv_style_list_t * list)
         }
     }
 
-    if(list->style_cnt > 0) lv_mem_free(list->style_list);
-    list->style_list = NULL;
+    if(list->style_cnt > 0) style_list_free(list);
+#if LV_STYLE_RES_CACHE
+    style_res_free(list);
+#endif
     list->style_cnt = 0;
     list->has_local = 0;
     list->has_trans = 0;
@@ -309,10 +373,98 @@ void _lv_style_list_reset(lv_style_list_t * list)
  */
 void lv_style_reset(lv_style_t * style)
 {
+#if LV_STYLE_INDEX
+    style_index_free(style);
+#endif
     lv_mem_free(style->map);
     lv_style_init(style);
 }
 
+#if LV_STYLE_INDEX
+/**
+ * Build a hash table to find the properties of a style quickly.
+ * Useful for large styles which don't change anymore, e.g. the styles of a theme.
+ * The values of the existing properties still can be changed,
+ * but adding or removing a property drops the table (the style works as before).
+ * @param style pointer to a style
+ */
+void lv_style_freeze(lv_style_t * style)
+{
+    LV_ASSERT_STYLE(style);
+
+    style_index_free(style);
+
+    uint16_t prop_cnt = _lv_style_get_prop_cnt(style);
+    if(prop_cnt == 0) return;
+
+    uint16_t size = 4;
+    while(size < prop_cnt * 2) size = size << 1;
+
+    uint32_t byte_size = sizeof(style_index_t) + size * sizeof(style_index_slot_t);
+    style_index_t * index = lv_mem_alloc(byte_size);
+    LV_ASSERT_MEM(index);
+    if(index == NULL) return;
+
+    _lv_memset_ff(index->slot, size * sizeof(style_index_slot_t));
+    index->size = size;
+    index->states = 0;
+
+    uint32_t mask = size - 1;
+    size_t i = 0;
+    uint8_t prop_id;
+    while((prop_id = get_style_prop_id(style, i)) != _LV_STYLE_CLOSING_PROP) {
+        uint8_t state = LV_STYLE_ATTR_GET_STATE(get_style_prop_attr(style, i));
+        uint16_t key = prop_id | (state << 8);
+        index->states |= state;
+
+        uint32_t h = style_prop_hash(key) & mask;
+        while(index->slot[h].key != 0xFFFF && index->slot[h].key != key) h = (h + 1) & mask;
+
+        /*Keep the first one if a property is added twice as the linear search would find it first*/
+        if(index->slot[h].key == 0xFFFF) {
+            index->slot[h].key = key;
+            index->slot[h].idx = i;
+        }
+
+        i = get_next_prop_index(prop_id, i);
+    }
+
+    style->index = index;
+}
+
+/**
+ * Check whether a style has a hash table
+ * @param style pointer to a style
+ * @return true: the style is frozen
+ */
+bool lv_style_is_frozen(const lv_style_t * style)
+{
+    return style->index ? true : false;
+}
+#endif
+
+/**
+ * Get the number of properties in a style
+ * @param style pointer to a style
+ * @return number of properties (all states are counted separately)
+ */
+uint16_t _lv_style_get_prop_cnt(const lv_style_t * style)
+{
+    LV_ASSERT_STYLE(style);
+
+    if(style == NULL || style->map == NULL) return 0;
+
+    uint16_t cnt = 0;
+    size_t i = 0;
+    uint8_t prop_id;
+    while((prop_id = get_style_prop_id(style, i)) != _LV_STYLE_CLOSING_PROP) {
+        i = get_next_prop_index(prop_id, i);
+        cnt++;
+    }
+
+    return cnt;
+}
+
 /**
  * Get the size of the properties in a style in bytes
  * @param style pointer to a style
@@ -361,6 +513,9 @@ void _lv_style_set_int(lv_style_t * style, lv_style_property_t prop, lv_style_in
     }
 
     /*Add new property if not exists yet*/
+#if LV_STYLE_INDEX
+    style_index_free(style);
+#endif
     uint8_t new_prop_size = sizeof(lv_style_property_t) + sizeof(lv_style_int_t);
     lv_style_property_t end_mark = _LV_STYLE_CLOSING_PROP;
     uint8_t end_mark_size = sizeof(end_mark);
@@ -404,6 +559,9 @@ void _lv_style_set_color(lv_style_t * style, lv_style_property_t prop, lv_color_
     }
 
     /*Add new property if not exists yet*/
+#if LV_STYLE_INDEX
+    style_index_free(style);
+#endif
     uint8_t new_prop_size = sizeof(lv_style_property_t) + sizeof(lv_color_t);
     lv_style_property_t end_mark = _LV_STYLE_CLOSING_PROP;
     uint8_t end_mark_size = sizeof(end_mark);
@@ -447,6 +605,9 @@ void _lv_style_set_opa(lv_style_t * style, lv_style_property_t prop, lv_opa_t op
     }
 
     /*Add new property if not exists yet*/
+#if LV_STYLE_INDEX
+    style_index_free(style);
+#endif
     uint8_t new_prop_size = sizeof(lv_style_property_t) + sizeof(lv_opa_t);
     lv_style_property_t end_mark = _LV_STYLE_CLOSING_PROP;
     uint8_t end_mark_size = sizeof(end_mark);
@@ -490,6 +651,9 @@ void _lv_style_set_ptr(lv_style_t * style, lv_style_property_t prop, const void
     }
 
     /*Add new property if not exists yet*/
+#if LV_STYLE_INDEX
+    style_index_free(style);
+#endif
     uint8_t new_prop_size = sizeof(lv_style_property_t) + sizeof(const void *);
     lv_style_property_t end_mark = _LV_STYLE_CLOSING_PROP;
     uint8_t end_mark_size = sizeof(end_mark);
@@ -938,6 +1102,97 @@ lv_res_t _lv_style_list_get_ptr(lv_style_list_t * list, lv_style_property_t prop
     else return LV_RES_INV;
 }
 
+#if LV_STYLE_RES_CACHE
+
+/**
+ * Get a resolved property value from the cache of a style list.
+ * @param list pointer to a style list
+ * @param prop a style property ORed with the state it was resolved in.
+ * @param value pointer to a buffer to store the value
+ * @return true: the value was found; false: not cached or the list ignores the cache now
+ */
+bool _lv_style_list_res_get(lv_style_list_t * list, lv_style_property_t prop, lv_style_res_value_t * value)
+{
+    if(list == NULL || list->res == NULL) return false;
+
+    /*While comparing the states or the transition's start and end value the styles are read directly*/
+    if(list->ignore_cache || list->skip_trans) return false;
+
+    style_res_t * res = list->res;
+    uint32_t mask = res->size - 1;
+    uint32_t i = style_prop_hash(prop) & mask;
+
+    /*There is always at least one free slot to stop at*/
+    while(res->slot[i].prop != 0) {
+        if(res->slot[i].prop == prop) {
+            *value = res->slot[i].value;
+            res_mon.hit_cnt++;
+            return true;
+        }
+        i = (i + 1) & mask;
+    }
+
+    return false;
+}
+
+/**
+ * Store a resolved property value in the cache of a style list.
+ * The table is allocated or enlarged if required. If it's full the value is not stored.
+ * @param list pointer to a style list
+ * @param prop a style property ORed with the state it was resolved in.
+ * @param value pointer to the value
+ */
+void _lv_style_list_res_set(lv_style_list_t * list, lv_style_property_t prop, const lv_style_res_value_t * value)
+{
+    res_mon.resolve_cnt++;
+
+    if(list == NULL) return;
+    if(list->ignore_cache || list->skip_trans) return;
+
+    style_res_t * res = list->res;
+    if(res == NULL || (res->cnt + 1) * 4 > res->size * 3) {
+        uint16_t size = res ? res->size * 2 : STYLE_RES_SIZE_MIN;
+        if(size > LV_STYLE_RES_CACHE_MAX) return;
+        if(style_res_resize(list, size) == false) return;
+        res = list->res;
+    }
+
+    uint32_t mask = res->size - 1;
+    uint32_t i = style_prop_hash(prop) & mask;
+    while(res->slot[i].prop != 0 && res->slot[i].prop != prop) {
+        i = (i + 1) & mask;
+    }
+
+    if(res->slot[i].prop == 0) res->cnt++;
+    res->slot[i].prop = prop;
+    res->slot[i].value = *value;
+}
+
+/**
+ * Remove all the resolved values from the cache of a style list
+ * @param list pointer to a style list
+ */
+void _lv_style_list_res_clear(lv_style_list_t * list)
+{
+    if(list == NULL || list->res == NULL) return;
+    if(list->res->cnt == 0) return;
+
+    _lv_memset_00(list->res->slot, list->res->size * sizeof(style_res_slot_t));
+    list->res->cnt = 0;
+    res_mon.clear_cnt++;
+}
+
+/**
+ * Get the statistics of the resolved property caches
+ * @param mon pointer to a variable to fill
+ */
+void lv_style_res_monitor(lv_style_res_monitor_t * mon)
+{
+    *mon = res_mon;
+}
+
+#endif
+
 /**
  * Check whether a style is valid (initialized correctly)
  * @param style pointer to a style
@@ -995,6 +1250,10 @@ LV_ATTRIBUTE_FAST_MEM static inline int32_t get_property_index(const lv_style_t
     if(style == NULL) return -1;
     if(style->map == NULL) return -1;
 
+#if LV_STYLE_INDEX
+    if(style->index) return style_index_find(style, prop);
+#endif
+
     uint8_t id_to_find = prop & 0xFF;
     lv_style_attr_t attr;
     attr = (prop >> 8) & 0xFF;
@@ -1132,3 +1391,176 @@ static inline size_t get_next_prop_index(uint8_t prop_id, size_t idx)
 {
     return idx + get_prop_size(prop_id);
 }
+
+/**
+ * Allocate an array for the style pointers of a style list.
+ * Use the array allocated together with the object if it's large enough.
+ * @param list pointer to a style list
+ * @param cnt number of style pointers
+ * @return pointer to the array or NULL if out of memory
+ */
+static lv_style_t ** style_list_alloc(lv_style_list_t * list, uint8_t cnt)
+{
+#if LV_OBJ_SLAB
+    if(list->inline_list) {
+        if(cnt <= LV_OBJ_SLAB_STYLE_CNT) return list->style_list;
+        list->inline_list = 0;
+    }
+#else
+    LV_UNUSED(list);
+#endif
+    return lv_mem_alloc(cnt * sizeof(lv_style_t *));
+}
+
+/**
+ * Resize the array of the style pointers of a style list. The current style pointers are kept.
+ * @param list pointer to a style list
+ * @param cnt new number of style pointers
+ * @return pointer to the array or NULL if out of memory
+ */
+static lv_style_t ** style_list_realloc(lv_style_list_t * list, uint8_t cnt)
+{
+#if LV_OBJ_SLAB
+    if(list->inline_list) {
+        if(cnt <= LV_OBJ_SLAB_STYLE_CNT) return list->style_list;
+
+        lv_style_t ** new_styles = lv_mem_alloc(cnt * sizeof(lv_style_t *));
+        if(new_styles == NULL) return NULL;
+        _lv_memcpy(new_styles, list->style_list, list->style_cnt * sizeof(lv_style_t *));
+        list->inline_list = 0;
+        return new_styles;
+    }
+#endif
+    return lv_mem_realloc(list->style_list, cnt * sizeof(lv_style_t *));
+}
+
+/**
+ * Free the array of the style pointers of a style list
+ * @param list pointer to a style list
+ */
+static void style_list_free(lv_style_list_t * list)
+{
+#if LV_OBJ_SLAB
+    if(list->inline_list) return;
+#endif
+    lv_mem_free(list->style_list);
+    list->style_list = NULL;
+}
+
+#if LV_STYLE_RES_CACHE || LV_STYLE_INDEX
+
+/**
+ * Get the hash of a property. The IDs in a group differ only in the lower bits
+ * so multiply them to spread the values.
+ * @param prop a style property ORed with a state
+ * @return the hash of the property (should be masked to the size of the table)
+ */
+static inline uint32_t style_prop_hash(lv_style_property_t prop)
+{
+    return ((uint32_t)prop * 2654435761U) >> 16;
+}
+#endif
+
+#if LV_STYLE_RES_CACHE
+
+/**
+ * Allocate a new table for the resolved values of a style list and move the old values into it
+ * @param list pointer to a style list
+ * @param size the new number of slots (power of 2)
+ * @return true: success; false: out of memory, the old table is kept
+ */
+static bool style_res_resize(lv_style_list_t * list, uint16_t size)
+{
+    uint32_t byte_size = sizeof(style_res_t) + size * sizeof(style_res_slot_t);
+    style_res_t * res_new = lv_mem_alloc(byte_size);
+    if(res_new == NULL) return false;
+
+    _lv_memset_00(res_new, byte_size);
+    res_new->size = size;
+    res_mon.table_cnt++;
+    res_mon.table_size += byte_size;
+
+    style_res_t * res_old = list->res;
+    if(res_old) {
+        uint32_t mask = size - 1;
+        uint32_t i;
+        for(i = 0; i < res_old->size; i++) {
+            if(res_old->slot[i].prop == 0) continue;
+
+            uint32_t j = style_prop_hash(res_old->slot[i].prop) & mask;
+            while(res_new->slot[j].prop != 0) j = (j + 1) & mask;
+            res_new->slot[j] = res_old->slot[i];
+            res_new->cnt++;
+        }
+        style_res_free(list);
+    }
+
+    list->res = res_new;
+    return true;
+}
+
+/**
+ * Free the table of the resolved values of a style list
+ * @param list pointer to a style list
+ */
+static void style_res_free(lv_style_list_t * list)
+{
+    if(list->res == NULL) return;
+
+    res_mon.table_cnt--;
+    res_mon.table_size -= sizeof(style_res_t) + list->res->size * sizeof(style_res_slot_t);
+    lv_mem_free(list->res);
+    list->res = NULL;
+}
+
+#endif
+
+#if LV_STYLE_INDEX
+
+/**
+ * Find a property in the hash table of a style.
+ * Works like the linear search: return the perfect match of the state or
+ * the property whose state is the highest subset of the requested state.
+ * @param style pointer to a frozen style
+ * @param prop a style property ORed with a state.
+ * @return byte index of the property in the map or -1 if not found
+ */
+static inline int32_t style_index_find(const lv_style_t * style, lv_style_property_t prop)
+{
+    const style_index_t * index = style->index;
+    uint32_t mask = index->size - 1;
+    uint8_t id = prop & 0xFF;
+
+    /*Only the states used in the style are interesting*/
+    uint8_t state = LV_STYLE_ATTR_GET_STATE(prop >> 8) & index->states;
+
+    /*Try the subsets of the state in decreasing order, so the first hit has the highest weight*/
+    uint8_t sub = state;
+    while(1) {
+        uint16_t key = id | (sub << 8);
+        uint32_t h = style_prop_hash(key) & mask;
+        while(index->slot[h].key != 0xFFFF) {
+            if(index->slot[h].key == key) return index->slot[h].idx;
+            h = (h + 1) & mask;
+        }
+
+        if(sub == 0) break;
+        sub = (sub - 1) & state;
+    }
+
+    return -1;
+}
+
+/**
+ * Free the hash table of a style
+ * @param style pointer to a style
+ */
+static void style_index_free(lv_style_t * style)
+{
+    if(style->index == NULL) return;
+
+    lv_mem_free(style->index);
+    style->index = NULL;
+}
+
+#endif
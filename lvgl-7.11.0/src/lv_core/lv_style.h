@@ -208,8 +208,15 @@ typedef uint16_t lv_style_property_t;
 
 typedef uint16_t lv_style_state_t;
 
+#if LV_STYLE_INDEX
+struct _lv_style_index_t;
+#endif
+
 typedef struct {
     uint8_t * map;
+#if LV_STYLE_INDEX
+    struct _lv_style_index_t * index;   /*Hash table of the properties in `map`. Built by `lv_style_freeze()`*/
+#endif
 #if LV_USE_ASSERT_STYLE
     uint32_t sentinel;
 #endif
@@ -217,8 +224,36 @@ typedef struct {
 
 typedef int16_t lv_style_int_t;
 
+#if LV_STYLE_RES_CACHE
+/**
+ * A resolved property value stored in the cache of a style list
+ */
+typedef union {
+    lv_style_int_t _int;
+    lv_opa_t _opa;
+    lv_color_t _color;
+    const void * _ptr;
+} lv_style_res_value_t;
+
+/**
+ * Statistics of the resolved property caches
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of properties read from a cache*/
+    uint32_t resolve_cnt;   /**< Number of properties resolved from the styles (cache misses)*/
+    uint32_t clear_cnt;     /**< Number of times a cache was cleared because the styles or states changed*/
+    uint32_t table_cnt;     /**< Number of allocated cache tables*/
+    uint32_t table_size;    /**< Total size of the cache tables in bytes*/
+} lv_style_res_monitor_t;
+
+struct _lv_style_res_t;
+#endif
+
 typedef struct {
     lv_style_t ** style_list;
+#if LV_STYLE_RES_CACHE
+    struct _lv_style_res_t * res;   /*Resolved property values. Cleared when the styles or the states change*/
+#endif
 #if LV_USE_ASSERT_STYLE
     uint32_t sentinel;
 #endif
@@ -229,6 +264,9 @@ typedef struct {
     uint32_t ignore_trans  : 1;      /*1: Mark that this style list shouldn't receive transitions at all*/
     uint32_t valid_cache   : 1;      /*1: The cache is valid and can be used*/
     uint32_t ignore_cache  : 1;      /*1: Ignore cache while getting value of properties*/
+#if LV_OBJ_SLAB
+    uint32_t inline_list   : 1;      /*1: `style_list` is allocated together with the object. Don't free it*/
+#endif
 
     uint32_t radius_zero : 1;
     uint32_t opa_scale_cover : 1;
@@ -321,6 +359,31 @@ static inline lv_style_t * lv_style_list_get_style(lv_style_list_t * list, uint8
  */
 void lv_style_reset(lv_style_t * style);
 
+#if LV_STYLE_INDEX
+/**
+ * Build a hash table to find the properties of a style quickly.
+ * Useful for large styles which don't change anymore, e.g. the styles of a theme.
+ * The values of the existing properties still can be changed,
+ * but adding or removing a property drops the table (the style works as before).
+ * @param style pointer to a style
+ */
+void lv_style_freeze(lv_style_t * style);
+
+/**
+ * Check whether a style has a hash table
+ * @param style pointer to a style
+ * @return true: the style is frozen
+ */
+bool lv_style_is_frozen(const lv_style_t * style);
+#endif
+
+/**
+ * Get the number of properties in a style
+ * @param style pointer to a style
+ * @return number of properties (all states are counted separately)
+ */
+uint16_t _lv_style_get_prop_cnt(const lv_style_t * style);
+
 /**
  * Get the size of the properties in a style in bytes
  * @param style pointer to a style
@@ -565,6 +628,40 @@ lv_res_t _lv_style_list_get_opa(lv_style_list_t * list, lv_style_property_t prop
  */
 lv_res_t _lv_style_list_get_ptr(lv_style_list_t * list, lv_style_property_t prop, const void ** res);
 
+#if LV_STYLE_RES_CACHE
+
+/**
+ * Get a resolved property value from the cache of a style list.
+ * @param list pointer to a style list
+ * @param prop a style property ORed with the state it was resolved in.
+ * @param value pointer to a buffer to store the value
+ * @return true: the value was found; false: not cached or the list ignores the cache now
+ */
+bool _lv_style_list_res_get(lv_style_list_t * list, lv_style_property_t prop, lv_style_res_value_t * value);
+
+/**
+ * Store a resolved property value in the cache of a style list.
+ * The table is allocated or enlarged if required. If it's full the value is not stored.
+ * @param list pointer to a style list
+ * @param prop a style property ORed with the state it was resolved in.
+ * @param value pointer to the value
+ */
+void _lv_style_list_res_set(lv_style_list_t * list, lv_style_property_t prop, const lv_style_res_value_t * value);
+
+/**
+ * Remove all the resolved values from the cache of a style list
+ * @param list pointer to a style list
+ */
+void _lv_style_list_res_clear(lv_style_list_t * list);
+
+/**
+ * Get the statistics of the resolved property caches
+ * @param mon pointer to a variable to fill
+ */
+void lv_style_res_monitor(lv_style_res_monitor_t * mon);
+
+#endif
+
 /**
  * Check whether a style is valid (initialized correctly)
  * @param style pointer to a style
@@ -9,6 +9,7 @@
 #include "lv_draw_arc.h"
 #include "lv_draw_rect.h"
 #include "lv_draw_mask.h"
+#include "lv_draw_blend.h"
 #include "../lv_misc/lv_math.h"
 
 /*********************
@@ -16,6 +17,7 @@
  *********************/
 #define SPLIT_RADIUS_LIMIT 10  /*With radius greater then this the arc will drawn in quarters. A quarter is drawn only if there is arc in it */
 #define SPLIT_ANGLE_GAP_LIMIT 60  /*With small gaps in the arc don't bother with splitting because there is nothing to skip.*/
+#define ARC_RAY_COVER (127 << 8)  /*Pixels are fully on the inner side of the start or end ray from this cross product*/
 
 /**********************
  *      TYPEDEFS
@@ -34,6 +36,30 @@ typedef struct {
     const lv_area_t * clip_area;
 } quarter_draw_dsc_t;
 
+/*Parameters of an arc drawn by `draw_arc_spans()`. Lengths are in half pixels.*/
+typedef struct {
+    lv_coord_t center_x;
+    int32_t r_out;
+    int32_t r_in;
+    int32_t r_out_sq;
+    int32_t r_in_sq;
+    int32_t inv_out;        /*`(64 << 16) / r_out`*/
+    int32_t inv_in;
+    int32_t start_x;        /*Direction of the start ray*/
+    int32_t start_y;
+    int32_t end_x;          /*Direction of the end ray*/
+    int32_t end_y;
+    lv_coord_t y;           /*The current row*/
+    int32_t dy;             /*Distance of the row from the center*/
+    int32_t k_solid;
+    int32_t k_in_solid;
+    const lv_area_t * clip_area;
+    const lv_draw_line_dsc_t * dsc;
+    lv_opa_t * mask_buf;
+    uint8_t full : 1;
+    uint8_t ray_and : 1;    /*1: the arc is in both half planes of the rays, 0: it's at least in one*/
+} arc_span_dsc_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -42,6 +68,23 @@ static void draw_quarter_1(quarter_draw_dsc_t * q);
 static void draw_quarter_2(quarter_draw_dsc_t * q);
 static void draw_quarter_3(quarter_draw_dsc_t * q);
 static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness, lv_area_t * res_area);
+static void draw_arc_masked(lv_coord_t center_x, lv_coord_t center_y, lv_coord_t radius, lv_coord_t width,
+                            uint16_t start_angle, uint16_t end_angle, const lv_area_t * area, const lv_area_t * clip_area,
+                            lv_draw_rect_dsc_t * cir_dsc);
+static void draw_arc_spans(lv_coord_t center_x, lv_coord_t center_y, lv_coord_t radius, lv_coord_t width,
+                           uint16_t start_angle, uint16_t end_angle, bool full, const lv_area_t * clip_area,
+                           const lv_draw_line_dsc_t * dsc);
+static void draw_arc_row(arc_span_dsc_t * a, lv_coord_t x1, lv_coord_t x2, lv_coord_t solid_x1, lv_coord_t solid_x2);
+static void draw_arc_edge(arc_span_dsc_t * a, lv_coord_t x1, lv_coord_t x2);
+static uint32_t get_ray_ranges(const arc_span_dsc_t * a, lv_coord_t x1, lv_coord_t x2, int32_t limit,
+                               lv_coord_t res[]);
+static void get_ray_range(int32_t cross, int32_t step, int32_t limit, lv_coord_t x1, lv_coord_t x2,
+                          lv_coord_t * res_x1, lv_coord_t * res_x2);
+static void get_arc_area(lv_coord_t center_x, lv_coord_t center_y, lv_coord_t radius, lv_coord_t width,
+                         uint16_t start_angle, uint16_t end_angle, lv_area_t * res_area);
+static int32_t arc_half_chord(int32_t r, int32_t dy);
+static inline lv_opa_t arc_edge_cov(int32_t diff, int32_t r, int32_t inv);
+static inline lv_opa_t arc_ray_cov(int32_t cross);
 
 /**********************
  *  STATIC VARIABLES
@@ -91,51 +134,26 @@ void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uin
     area.x2 = center_x + radius - 1;  /*-1 because the center already belongs to the left/bottom part*/
     area.y2 = center_y + radius - 1;
 
+    /*Without other masks the pixels of the ring can be calculated directly,
+     *else draw the ring as the border of a circle with an angle mask*/
+    bool direct = lv_draw_mask_get_cnt() == 0;
+
     /*Draw a full ring*/
     if(start_angle + 360 == end_angle || start_angle == end_angle + 360) {
-        lv_draw_rect(&area, clip_area, &cir_dsc);
+        if(direct) draw_arc_spans(center_x, center_y, radius, width, 0, 0, true, clip_area, dsc);
+        else lv_draw_rect(&area, clip_area, &cir_dsc);
         return;
     }
 
     if(start_angle >= 360) start_angle -= 360;
     if(end_angle >= 360) end_angle -= 360;
 
-    lv_draw_mask_angle_param_t mask_angle_param;
-    lv_draw_mask_angle_init(&mask_angle_param, center_x, center_y, start_angle, end_angle);
-
-    int16_t mask_angle_id = lv_draw_mask_add(&mask_angle_param, NULL);
-
-    int32_t angle_gap;
-    if(end_angle > start_angle) {
-        angle_gap = 360 - (end_angle - start_angle);
+    if(direct) {
+        draw_arc_spans(center_x, center_y, radius, width, start_angle, end_angle, false, clip_area, dsc);
     }
     else {
-        angle_gap = start_angle - end_angle;
+        draw_arc_masked(center_x, center_y, radius, width, start_angle, end_angle, &area, clip_area, &cir_dsc);
     }
-    if(angle_gap > SPLIT_ANGLE_GAP_LIMIT && radius > SPLIT_RADIUS_LIMIT) {
-        /*Handle each quarter individually and skip which is empty*/
-        quarter_draw_dsc_t q_dsc;
-        q_dsc.center_x = center_x;
-        q_dsc.center_y = center_y;
-        q_dsc.radius = radius;
-        q_dsc.start_angle = start_angle;
-        q_dsc.end_angle = end_angle;
-        q_dsc.start_quarter = (start_angle / 90) & 0x3;
-        q_dsc.end_quarter = (end_angle / 90) & 0x3;
-        q_dsc.width = width;
-        q_dsc.draw_dsc =  &cir_dsc;
-        q_dsc.draw_area = &area;
-        q_dsc.clip_area = clip_area;
-
-        draw_quarter_0(&q_dsc);
-        draw_quarter_1(&q_dsc);
-        draw_quarter_2(&q_dsc);
-        draw_quarter_3(&q_dsc);
-    }
-    else {
-        lv_draw_rect(&area, clip_area, &cir_dsc);
-    }
-    lv_draw_mask_remove_id(mask_angle_id);
 
     if(dsc->round_start || dsc->round_end) {
         cir_dsc.bg_color        = dsc->color;
@@ -170,6 +188,60 @@ void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uin
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Draw an arc as the border of a circle with an angle mask. Used if there are other masks too.
+ * @param center_x the x coordinate of the center of the arc
+ * @param center_y the y coordinate of the center of the arc
+ * @param radius the radius of the arc
+ * @param width the width of the arc
+ * @param start_angle the start angle of the arc (0..359)
+ * @param end_angle the end angle of the arc (0..359)
+ * @param area the area of the circle
+ * @param clip_area the arc will be drawn only in this area
+ * @param cir_dsc descriptor of the circle
+ */
+static void draw_arc_masked(lv_coord_t center_x, lv_coord_t center_y, lv_coord_t radius, lv_coord_t width,
+                            uint16_t start_angle, uint16_t end_angle, const lv_area_t * area, const lv_area_t * clip_area,
+                            lv_draw_rect_dsc_t * cir_dsc)
+{
+    lv_draw_mask_angle_param_t mask_angle_param;
+    lv_draw_mask_angle_init(&mask_angle_param, center_x, center_y, start_angle, end_angle);
+
+    int16_t mask_angle_id = lv_draw_mask_add(&mask_angle_param, NULL);
+
+    int32_t angle_gap;
+    if(end_angle > start_angle) {
+        angle_gap = 360 - (end_angle - start_angle);
+    }
+    else {
+        angle_gap = start_angle - end_angle;
+    }
+    if(angle_gap > SPLIT_ANGLE_GAP_LIMIT && radius > SPLIT_RADIUS_LIMIT) {
+        /*Handle each quarter individually and skip which is empty*/
+        quarter_draw_dsc_t q_dsc;
+        q_dsc.center_x = center_x;
+        q_dsc.center_y = center_y;
+        q_dsc.radius = radius;
+        q_dsc.start_angle = start_angle;
+        q_dsc.end_angle = end_angle;
+        q_dsc.start_quarter = (start_angle / 90) & 0x3;
+        q_dsc.end_quarter = (end_angle / 90) & 0x3;
+        q_dsc.width = width;
+        q_dsc.draw_dsc =  cir_dsc;
+        q_dsc.draw_area = area;
+        q_dsc.clip_area = clip_area;
+
+        draw_quarter_0(&q_dsc);
+        draw_quarter_1(&q_dsc);
+        draw_quarter_2(&q_dsc);
+        draw_quarter_3(&q_dsc);
+    }
+    else {
+        lv_draw_rect(area, clip_area, cir_dsc);
+    }
+    lv_draw_mask_remove_id(mask_angle_id);
+}
+
 static void draw_quarter_0(quarter_draw_dsc_t * q)
 {
     lv_area_t quarter_area;
@@ -419,3 +491,415 @@ static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness
         res_area->y2 = cir_y + thick_half - thick_corr;
     }
 }
+
+/**
+ * Draw an arc row by row. In every row only the spans of the ring are visited:
+ * the fully covered parts are filled directly and the coverage of the edge pixels is calculated
+ * from their distance to the circles and to the start and end rays.
+ * Should be used only if there are no other masks.
+ * @param center_x the x coordinate of the center of the arc
+ * @param center_y the y coordinate of the center of the arc
+ * @param radius the radius of the arc
+ * @param width the width of the arc (not greater than `radius`)
+ * @param start_angle the start angle of the arc (0..359)
+ * @param end_angle the end angle of the arc (0..359)
+ * @param full true: draw a full ring and ignore the angles
+ * @param clip_area the arc will be drawn only in this area
+ * @param dsc pointer to an initialized `lv_draw_line_dsc_t` variable
+ */
+static void draw_arc_spans(lv_coord_t center_x, lv_coord_t center_y, lv_coord_t radius, lv_coord_t width,
+                           uint16_t start_angle, uint16_t end_angle, bool full, const lv_area_t * clip_area,
+                           const lv_draw_line_dsc_t * dsc)
+{
+    if(radius <= 0) return;
+
+    lv_area_t draw_area;
+    if(full) {
+        draw_area.x1 = center_x - radius;
+        draw_area.y1 = center_y - radius;
+        draw_area.x2 = center_x + radius - 1;
+        draw_area.y2 = center_y + radius - 1;
+    }
+    else {
+        get_arc_area(center_x, center_y, radius, width, start_angle, end_angle, &draw_area);
+    }
+    if(_lv_area_intersect(&draw_area, &draw_area, clip_area) == false) return;
+
+    /*The circles and the pixel centers are calculated in half pixels to keep them integer.
+     *The center of the circles is on the top left corner of the `center_x;center_y` pixel.*/
+    arc_span_dsc_t a;
+    a.center_x = center_x;
+    a.r_out = radius * 2;
+    a.r_in = (radius - width) * 2;
+    a.r_out_sq = a.r_out * a.r_out;
+    a.r_in_sq = a.r_in * a.r_in;
+    a.inv_out = (64 << 16) / a.r_out;
+    a.inv_in = a.r_in ? (64 << 16) / a.r_in : 0;
+
+    /*Direction of the start and end rays. Arcs up to 180 degree are on the common part of their half planes,
+     *greater arcs are on the union of them*/
+    a.full = full;
+    a.start_x = _lv_trigo_sin(start_angle + 90);
+    a.start_y = _lv_trigo_sin(start_angle);
+    a.end_x = _lv_trigo_sin(end_angle + 90);
+    a.end_y = _lv_trigo_sin(end_angle);
+    int32_t sweep = end_angle - start_angle;
+    if(sweep < 0) sweep += 360;
+    a.ray_and = sweep <= 180;
+
+    a.clip_area = clip_area;
+    a.dsc = dsc;
+    a.mask_buf = _lv_mem_buf_get(lv_area_get_width(&draw_area));
+
+    lv_coord_t y;
+    for(y = draw_area.y1; y <= draw_area.y2; y++) {
+        a.y = y;
+        a.dy = 2 * (y - center_y) + 1;
+
+        /*Pixels are on the same distance from the center on both sides: `k` is 0 for the 2 middle pixels.
+         *k >= k_out: out of the outer circle, k < k_solid: fully inside it,
+         *k < k_hole: fully in the inner circle, k >= k_in_solid: fully out of it*/
+        int32_t k_out = arc_half_chord(a.r_out + 2, a.dy) + 1;
+        if(k_out <= 0) continue;
+        a.k_solid = arc_half_chord(a.r_out - 2, a.dy) - 1;
+        int32_t k_hole = 0;
+        a.k_in_solid = 0;
+        if(a.r_in) {
+            k_hole = LV_MATH_MAX(arc_half_chord(a.r_in - 2, a.dy) - 1, 0);
+            a.k_in_solid = arc_half_chord(a.r_in + 2, a.dy) + 1;
+        }
+        int32_t k_solid = LV_MATH_MAX(a.k_solid, 0);
+
+        /*Left and right half of the row*/
+        lv_coord_t x1 = LV_MATH_MAX(center_x - k_out, draw_area.x1);
+        lv_coord_t x2 = LV_MATH_MIN(center_x - k_hole - 1, draw_area.x2);
+        draw_arc_row(&a, x1, x2, center_x - k_solid, center_x - a.k_in_solid - 1);
+
+        x1 = LV_MATH_MAX(center_x + k_hole, draw_area.x1);
+        x2 = LV_MATH_MIN(center_x + k_out - 1, draw_area.x2);
+        draw_arc_row(&a, x1, x2, center_x + a.k_in_solid, center_x + k_solid - 1);
+    }
+
+    _lv_mem_buf_release(a.mask_buf);
+}
+
+/**
+ * Draw a part of a row of an arc on one side of the center
+ * @param a the parameters of the arc and the row
+ * @param x1 the first pixel of the part
+ * @param x2 the last pixel of the part
+ * @param solid_x1 the ring fully covers the pixels from here...
+ * @param solid_x2 ...to here
+ */
+static void draw_arc_row(arc_span_dsc_t * a, lv_coord_t x1, lv_coord_t x2, lv_coord_t solid_x1, lv_coord_t solid_x2)
+{
+    if(x1 > x2) return;
+
+    /*Skip the pixels which are out of the rays*/
+    lv_coord_t vis[4];
+    uint32_t vis_cnt = 1;
+    vis[0] = x1;
+    vis[1] = x2;
+    if(!a->full) vis_cnt = get_ray_ranges(a, x1, x2, -ARC_RAY_COVER, vis);
+
+    uint32_t v;
+    for(v = 0; v < vis_cnt; v++) {
+        x1 = vis[v * 2];
+        x2 = vis[v * 2 + 1];
+
+        /*Get the parts where both the ring and the rays fully cover the pixels*/
+        lv_coord_t solid[4];
+        uint32_t solid_cnt = 0;
+        lv_coord_t s1 = LV_MATH_MAX(solid_x1, x1);
+        lv_coord_t s2 = LV_MATH_MIN(solid_x2, x2);
+        if(s1 <= s2) {
+            solid[0] = s1;
+            solid[1] = s2;
+            solid_cnt = 1;
+            if(!a->full) solid_cnt = get_ray_ranges(a, s1, s2, ARC_RAY_COVER, solid);
+        }
+
+        /*Draw the edges with a mask and fill the solid parts*/
+        uint32_t i;
+        for(i = 0; i < solid_cnt; i++) {
+            s1 = solid[i * 2];
+            s2 = solid[i * 2 + 1];
+            if(x1 < s1) draw_arc_edge(a, x1, s1 - 1);
+
+            lv_area_t fill_area;
+            fill_area.x1 = s1;
+            fill_area.x2 = s2;
+            fill_area.y1 = a->y;
+            fill_area.y2 = a->y;
+            _lv_blend_fill(a->clip_area, &fill_area, a->dsc->color, NULL, LV_DRAW_MASK_RES_FULL_COVER, a->dsc->opa,
+                           a->dsc->blend_mode);
+            x1 = s2 + 1;
+        }
+        if(x1 <= x2) draw_arc_edge(a, x1, x2);
+    }
+}
+
+/**
+ * Draw not fully covered pixels of an arc by calculating their coverage one by one
+ * @param a the parameters of the arc and the row
+ * @param x1 the first pixel
+ * @param x2 the last pixel
+ */
+static void draw_arc_edge(arc_span_dsc_t * a, lv_coord_t x1, lv_coord_t x2)
+{
+    int32_t dx = 2 * (x1 - a->center_x) + 1;
+    int32_t dy_sq = a->dy * a->dy;
+    int32_t cross_start = a->start_x * a->dy - a->start_y * dx;
+    int32_t cross_end = a->end_y * dx - a->end_x * a->dy;
+
+    lv_opa_t * mask_buf = a->mask_buf;
+    int32_t first = -1;
+    int32_t last = -1;
+    int32_t i;
+    for(i = 0; i <= x2 - x1; i++) {
+        int32_t k = (LV_MATH_ABS(dx) - 1) >> 1;
+        int32_t d_sq = dx * dx + dy_sq;
+
+        int32_t cov = LV_OPA_COVER;
+        if(k >= a->k_solid) cov = arc_edge_cov(a->r_out_sq - d_sq, a->r_out, a->inv_out);
+        if(k < a->k_in_solid) {
+            cov += arc_edge_cov(d_sq - a->r_in_sq, a->r_in, a->inv_in) - LV_OPA_COVER;
+            if(cov < 0) cov = 0;
+        }
+
+        if(!a->full && cov) {
+            lv_opa_t cov_start = arc_ray_cov(cross_start);
+            lv_opa_t cov_end = arc_ray_cov(cross_end);
+            lv_opa_t cov_ray = a->ray_and ? LV_MATH_MIN(cov_start, cov_end) : LV_MATH_MAX(cov_start, cov_end);
+            if(cov_ray != LV_OPA_COVER) cov = LV_MATH_UDIV255(cov * cov_ray);
+        }
+
+        mask_buf[i] = cov;
+        if(cov) {
+            if(first < 0) first = i;
+            last = i;
+        }
+
+        dx += 2;
+        cross_start -= 2 * a->start_y;
+        cross_end += 2 * a->end_y;
+    }
+
+    /*Blend only from the first to the last visible pixel*/
+    if(first < 0) return;
+    lv_area_t edge_area;
+    edge_area.x1 = x1 + first;
+    edge_area.x2 = x1 + last;
+    edge_area.y1 = a->y;
+    edge_area.y2 = a->y;
+    _lv_blend_fill(a->clip_area, &edge_area, a->dsc->color, mask_buf + first, LV_DRAW_MASK_RES_CHANGED, a->dsc->opa,
+                   a->dsc->blend_mode);
+}
+
+/**
+ * Get the parts of a row where the cross products with the start and end rays are large enough.
+ * Arcs up to 180 degree need both of them, greater arcs only one.
+ * @param a the parameters of the arc and the row
+ * @param x1 the first pixel to check
+ * @param x2 the last pixel to check
+ * @param limit the minimal cross product. `ARC_RAY_COVER`: fully covered, `-ARC_RAY_COVER`: not fully transparent
+ * @param res store the first and last pixels of the parts here. Should have space for 4 values.
+ * @return number of parts (0..2)
+ */
+static uint32_t get_ray_ranges(const arc_span_dsc_t * a, lv_coord_t x1, lv_coord_t x2, int32_t limit,
+                               lv_coord_t res[])
+{
+    /*The cross products change linearly along the row*/
+    int32_t dx = 2 * (x1 - a->center_x) + 1;
+    lv_coord_t s1;
+    lv_coord_t s2;
+    lv_coord_t e1;
+    lv_coord_t e2;
+    get_ray_range(a->start_x * a->dy - a->start_y * dx, -2 * a->start_y, limit, x1, x2, &s1, &s2);
+    get_ray_range(a->end_y * dx - a->end_x * a->dy, 2 * a->end_y, limit, x1, x2, &e1, &e2);
+
+    if(a->ray_and) {
+        res[0] = LV_MATH_MAX(s1, e1);
+        res[1] = LV_MATH_MIN(s2, e2);
+        return res[0] <= res[1] ? 1 : 0;
+    }
+
+    /*Both parts are at an end of the row, so they overlap or are separate*/
+    if(s1 > s2 || (e1 <= e2 && e1 < s1)) {
+        lv_coord_t tmp = s1;
+        s1 = e1;
+        e1 = tmp;
+        tmp = s2;
+        s2 = e2;
+        e2 = tmp;
+    }
+    if(s1 > s2) return 0;
+
+    res[0] = s1;
+    res[1] = s2;
+    if(e1 > e2) return 1;
+    if(e1 <= s2 + 1) {
+        res[1] = LV_MATH_MAX(s2, e2);
+        return 1;
+    }
+    res[2] = e1;
+    res[3] = e2;
+    return 2;
+}
+
+/**
+ * Get where the cross product of a ray and the pixels of a row reaches a limit
+ * @param cross the cross product of the ray and the first pixel (see `arc_ray_cov()`)
+ * @param step change of `cross` from pixel to pixel
+ * @param limit the minimal cross product
+ * @param x1 the first pixel
+ * @param x2 the last pixel
+ * @param res_x1 store the first pixel reaching the limit here
+ * @param res_x2 store the last pixel reaching the limit here. Less than `res_x1` if there is no such pixel.
+ */
+static void get_ray_range(int32_t cross, int32_t step, int32_t limit, lv_coord_t x1, lv_coord_t x2,
+                          lv_coord_t * res_x1, lv_coord_t * res_x2)
+{
+    int32_t len = x2 - x1 + 1;
+    *res_x1 = x1;
+    *res_x2 = x2;
+    if(step == 0) {
+        if(cross < limit) *res_x1 = x2 + 1;
+    }
+    else if(step > 0) {
+        if(cross < limit) {
+            int32_t n = (limit - cross + step - 1) / step;
+            *res_x1 = x1 + LV_MATH_MIN(n, len);
+        }
+    }
+    else {
+        if(cross < limit) *res_x2 = x1 - 1;
+        else {
+            int32_t n = (cross - limit) / (-step);
+            *res_x2 = x1 + LV_MATH_MIN(n, len - 1);
+        }
+    }
+}
+
+/**
+ * Get the bounding box of an arc from its end points and the outermost points of the circle between them
+ * @param center_x the x coordinate of the center of the arc
+ * @param center_y the y coordinate of the center of the arc
+ * @param radius the radius of the arc
+ * @param width the width of the arc
+ * @param start_angle the start angle of the arc (0..359)
+ * @param end_angle the end angle of the arc (0..359)
+ * @param res_area store the result here
+ */
+static void get_arc_area(lv_coord_t center_x, lv_coord_t center_y, lv_coord_t radius, lv_coord_t width,
+                         uint16_t start_angle, uint16_t end_angle, lv_area_t * res_area)
+{
+    lv_coord_t r_in = radius - width;
+    lv_coord_t x_min = LV_COORD_MAX;
+    lv_coord_t y_min = LV_COORD_MAX;
+    lv_coord_t x_max = LV_COORD_MIN;
+    lv_coord_t y_max = LV_COORD_MIN;
+
+    uint16_t angles[6] = {start_angle, end_angle, 0, 90, 180, 270};
+    uint32_t i;
+    for(i = 0; i < 6; i++) {
+        uint16_t a = angles[i];
+        /*Use the points on the axes only if they are on the arc*/
+        if(i >= 2) {
+            if(start_angle <= end_angle && (a < start_angle || a > end_angle)) continue;
+            if(start_angle > end_angle && a < start_angle && a > end_angle) continue;
+        }
+
+        int32_t cos_a = _lv_trigo_sin(a + 90);
+        int32_t sin_a = _lv_trigo_sin(a);
+        lv_coord_t x = (cos_a * radius) >> LV_TRIGO_SHIFT;
+        lv_coord_t y = (sin_a * radius) >> LV_TRIGO_SHIFT;
+        x_min = LV_MATH_MIN(x_min, x);
+        y_min = LV_MATH_MIN(y_min, y);
+        x_max = LV_MATH_MAX(x_max, x);
+        y_max = LV_MATH_MAX(y_max, y);
+
+        if(i < 2) {
+            x = (cos_a * r_in) >> LV_TRIGO_SHIFT;
+            y = (sin_a * r_in) >> LV_TRIGO_SHIFT;
+            x_min = LV_MATH_MIN(x_min, x);
+            y_min = LV_MATH_MIN(y_min, y);
+            x_max = LV_MATH_MAX(x_max, x);
+            y_max = LV_MATH_MAX(y_max, y);
+        }
+    }
+
+    /*Add some space for the anti-aliased edges and rounding but stay in the circle*/
+    res_area->x1 = center_x + LV_MATH_MAX(x_min - 2, -radius);
+    res_area->y1 = center_y + LV_MATH_MAX(y_min - 2, -radius);
+    res_area->x2 = center_x + LV_MATH_MIN(x_max + 2, radius - 1);
+    res_area->y2 = center_y + LV_MATH_MIN(y_max + 2, radius - 1);
+}
+
+/**
+ * Get the half width of a circle in a row
+ * @param r radius of the circle in half pixels
+ * @param dy distance of the row's center from the center of the circle in half pixels
+ * @return the half width in pixels rounded down, or -1 if the circle is not in the row
+ */
+static int32_t arc_half_chord(int32_t r, int32_t dy)
+{
+    if(r <= 0) return -1;
+    int32_t x = r * r - dy * dy;
+    if(x < 0) return -1;
+
+    /*Integer square root bit by bit*/
+    uint32_t rem = x;
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while(bit > rem) bit >>= 2;
+    while(bit) {
+        if(rem >= root + bit) {
+            rem -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root >> 1;
+}
+
+/**
+ * Get the coverage of a pixel on the edge of a circle.
+ * Close to the edge `r^2 - d^2` is about `2 * r * (r - d)`, so no square root is required.
+ * @param diff `r^2 - d^2` where `d` is the distance of the pixel from the center (in half pixels).
+ *             Negate it for the inner edge of the ring.
+ * @param r radius of the circle in half pixels
+ * @param inv `(64 << 16) / r`
+ * @return the coverage
+ */
+static inline lv_opa_t arc_edge_cov(int32_t diff, int32_t r, int32_t inv)
+{
+    /*Fully in or out if the pixel is at least 2 pixels from the edge*/
+    int32_t lim = r * 8;
+    if(diff >= lim) return LV_OPA_COVER;
+    if(diff <= -lim) return LV_OPA_TRANSP;
+
+    int32_t cov = 128 + ((diff * inv) >> 16);
+    if(cov < 0) return LV_OPA_TRANSP;
+    if(cov > LV_OPA_COVER) return LV_OPA_COVER;
+    return cov;
+}
+
+/**
+ * Get the coverage of a pixel on the edge of a half plane
+ * @param cross cross product of the direction of the edge (`LV_TRIGO_SIN_MAX` long)
+ *              and the pixel's center relative to the center of the arc (in half pixels)
+ * @return the coverage
+ */
+static inline lv_opa_t arc_ray_cov(int32_t cross)
+{
+    /*`cross` is about 2^16 times the distance from the edge*/
+    int32_t cov = 128 + (cross >> 8);
+    if(cov < 0) return LV_OPA_TRANSP;
+    if(cov > LV_OPA_COVER) return LV_OPA_COVER;
+    return cov;
+}
@@ -257,6 +257,34 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
             int32_t w = lv_area_get_width(coords);
             int32_t h = lv_area_get_height(coords);
 
+#if LV_USE_IMG_TRANSFORM && LV_IMG_CACHE_TRANSFORM_SIZE
+            /*Draw the already transformed image if the image is not animated*/
+            const uint8_t * trans_buf = NULL;
+            if(w == cdsc->dec_dsc.header.w && h == cdsc->dec_dsc.header.h) {
+                trans_buf = _lv_img_cache_transform_get(cdsc, draw_dsc->angle, draw_dsc->zoom, &draw_dsc->pivot,
+                                                        draw_dsc->antialias, &map_area_rot);
+            }
+
+            if(trans_buf) {
+                map_area_rot.x1 += coords->x1;
+                map_area_rot.y1 += coords->y1;
+                map_area_rot.x2 += coords->x1;
+                map_area_rot.y2 += coords->y1;
+
+                lv_area_t mask_com;
+                if(_lv_area_intersect(&mask_com, clip_area, &map_area_rot)) {
+                    lv_draw_img_dsc_t trans_dsc;
+                    _lv_memcpy_small(&trans_dsc, draw_dsc, sizeof(lv_draw_img_dsc_t));
+                    trans_dsc.angle = 0;
+                    trans_dsc.zoom = LV_IMG_ZOOM_NONE;
+                    lv_draw_map(&map_area_rot, &mask_com, trans_buf, &trans_dsc, false, true);
+                }
+
+                draw_cleanup(cdsc);
+                return LV_RES_OK;
+            }
+#endif
+
             _lv_img_buf_get_transformed_area(&map_area_rot, w, h, draw_dsc->angle, draw_dsc->zoom, &draw_dsc->pivot);
 
             map_area_rot.x1 += coords->x1;
@@ -287,36 +315,38 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
             return LV_RES_OK;
         }
 
+        /*Decode as many rows into the buffer as a screen wide row would need and blend them together*/
         int32_t width = lv_area_get_width(&mask_com);
+        int32_t row_size = width * (alpha_byte ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t));
+        int32_t band_h = (LV_HOR_RES_MAX * LV_IMG_PX_SIZE_ALPHA_BYTE) / row_size;
+        if(band_h < 1) band_h = 1;
+        if(band_h > lv_area_get_height(&mask_com)) band_h = lv_area_get_height(&mask_com);
 
-        uint8_t  * buf = _lv_mem_buf_get(lv_area_get_width(&mask_com) *
-                                         LV_IMG_PX_SIZE_ALPHA_BYTE);  /*+1 because of the possible alpha byte*/
+        uint8_t  * buf = _lv_mem_buf_get(row_size * band_h);
 
-        lv_area_t line;
-        lv_area_copy(&line, &mask_com);
-        lv_area_set_height(&line, 1);
+        lv_area_t band;
+        band.x1 = mask_com.x1;
+        band.x2 = mask_com.x2;
         int32_t x = mask_com.x1 - coords->x1;
         int32_t y = mask_com.y1 - coords->y1;
-        int32_t row;
         lv_res_t read_res;
-        for(row = mask_com.y1; row <= mask_com.y2; row++) {
-            lv_area_t mask_line;
-            union_ok = _lv_area_intersect(&mask_line, clip_area, &line);
-            if(union_ok == false) continue;
-
-            read_res = lv_img_decoder_read_line(&cdsc->dec_dsc, x, y, width, buf);
-            if(read_res != LV_RES_OK) {
-                lv_img_decoder_close(&cdsc->dec_dsc);
-                LV_LOG_WARN("Image draw can't read the line");
-                _lv_mem_buf_release(buf);
-                draw_cleanup(cdsc);
-                return LV_RES_INV;
+        for(band.y1 = mask_com.y1; band.y1 <= mask_com.y2; band.y1 += band_h) {
+            band.y2 = LV_MATH_MIN(band.y1 + band_h - 1, mask_com.y2);
+
+            int32_t row;
+            for(row = 0; row < lv_area_get_height(&band); row++) {
+                read_res = lv_img_decoder_read_line(&cdsc->dec_dsc, x, y, width, buf + row * row_size);
+                if(read_res != LV_RES_OK) {
+                    lv_img_decoder_close(&cdsc->dec_dsc);
+                    LV_LOG_WARN("Image draw can't read the line");
+                    _lv_mem_buf_release(buf);
+                    draw_cleanup(cdsc);
+                    return LV_RES_INV;
+                }
+                y++;
             }
 
-            lv_draw_map(&line, &mask_line, buf, draw_dsc, chroma_keyed, alpha_byte);
-            line.y1++;
-            line.y2++;
-            y++;
+            lv_draw_map(&band, &band, buf, draw_dsc, chroma_keyed, alpha_byte);
         }
         _lv_mem_buf_release(buf);
     }
@@ -526,29 +556,25 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
                 uint32_t px_i_start = px_i;
 
 #if LV_USE_IMG_TRANSFORM
-                int32_t rot_x = disp_area->x1 + draw_area.x1 - map_area->x1;
-#endif
-                for(x = 0; x < draw_area_w; x++, map_px += px_size_byte, px_i++) {
-
-#if LV_USE_IMG_TRANSFORM
-                    if(transform) {
-
-                        /*Transform*/
-                        bool ret;
-                        ret = _lv_img_buf_transform(&trans_dsc, rot_x + x, rot_y + y);
-                        if(ret == false) {
-                            mask_buf[px_i] = LV_OPA_TRANSP;
-                            continue;
-                        }
-                        else {
-                            mask_buf[px_i] = trans_dsc.res.opa;
-                            c.full = trans_dsc.res.color.full;
+                if(transform) {
+                    /*Transform the whole line at once*/
+                    int32_t rot_x = disp_area->x1 + draw_area.x1 - map_area->x1;
+                    _lv_img_buf_transform_line(&trans_dsc, rot_x, rot_y + y, draw_area_w, &map2[px_i], &mask_buf[px_i]);
+                    if(draw_dsc->recolor_opa != 0) {
+                        for(x = 0; x < draw_area_w; x++, px_i++) {
+                            if(mask_buf[px_i] == LV_OPA_TRANSP) continue;
+                            map2[px_i] = lv_color_mix_premult(recolor_premult, map2[px_i], recolor_opa_inv);
                         }
                     }
-                    /*No transform*/
-                    else
+                    else {
+                        px_i += draw_area_w;
+                    }
+                }
+                /*No transform*/
+                else
 #endif
-                    {
+                {
+                    for(x = 0; x < draw_area_w; x++, map_px += px_size_byte, px_i++) {
                         if(alpha_byte) {
                             lv_opa_t px_opa = map_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
                             mask_buf[px_i] = px_opa;
@@ -582,13 +608,13 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
                                 continue;
                             }
                         }
-                    }
 
-                    if(draw_dsc->recolor_opa != 0) {
-                        c = lv_color_mix_premult(recolor_premult, c, recolor_opa_inv);
-                    }
+                        if(draw_dsc->recolor_opa != 0) {
+                            c = lv_color_mix_premult(recolor_premult, c, recolor_opa_inv);
+                        }
 
-                    map2[px_i].full = c.full;
+                        map2[px_i].full = c.full;
+                    }
                 }
 
                 /*Apply the masks if any*/
@@ -16,10 +16,23 @@
 /*********************
  *      DEFINES
  *********************/
+#define POLYLINE_SEG_MAX    16  /*Number of lines of a polyline rasterized together*/
 
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct {
+    lv_area_t area;         /*The line can have pixels only here (clipped)*/
+    lv_point_t p;           /*A point of the line*/
+    int32_t steep;          /*Change of x in 1 px y on steep, of y in 1 px x on flat lines (1/65536 px)*/
+    int32_t inv_steep;      /*Change of x in 1 px y on flat lines (1/65536 px)*/
+    int32_t ofs_start;      /*Start of the line relative to its center line (1/256 px)*/
+    int32_t ofs_end;        /*End of the line relative to its center line (1/256 px)*/
+    uint8_t skew        : 1;    /*0: horizontal or vertical line which fully covers `area`*/
+    uint8_t flat        : 1;    /*1: more horizontal than vertical*/
+    uint8_t cap_start   : 1;    /*Apply the perpendicular ending of the polyline's start*/
+    uint8_t cap_end     : 1;    /*Apply the perpendicular ending of the polyline's end*/
+} polyline_seg_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -33,10 +46,26 @@ LV_ATTRIBUTE_FAST_MEM static void draw_line_hor(const lv_point_t * point1, const
 LV_ATTRIBUTE_FAST_MEM static void draw_line_ver(const lv_point_t * point1, const lv_point_t * point2,
                                                 const lv_area_t * clip,
                                                 const lv_draw_line_dsc_t * dsc);
+static bool polyline_seg_init(polyline_seg_t * seg, const lv_point_t * point1, const lv_point_t * point2,
+                              bool first, bool last, const lv_area_t * clip, const lv_draw_line_dsc_t * dsc,
+                              lv_draw_mask_line_param_t caps[]);
+LV_ATTRIBUTE_FAST_MEM static void polyline_draw(polyline_seg_t segs[], uint32_t seg_cnt, const lv_area_t * area,
+                                                lv_draw_mask_line_param_t caps[], const lv_area_t * clip,
+                                                const lv_draw_line_dsc_t * dsc);
+LV_ATTRIBUTE_FAST_MEM static void polyline_seg_cov(const polyline_seg_t * seg, int32_t y, lv_opa_t * cov, int32_t cov_x);
+static void draw_round_end(const lv_point_t * point, const lv_area_t * clip, const lv_draw_line_dsc_t * dsc);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*Width correction of skew lines: the masks are shifted along the x or y axis but the width is perpendicular*/
+static const uint8_t wcorr[] = {
+    128, 128, 128, 129, 129, 130, 130, 131,
+    132, 133, 134, 135, 137, 138, 140, 141,
+    143, 145, 147, 149, 151, 153, 155, 158,
+    160, 162, 165, 167, 170, 173, 175, 178,
+    181,
+};
 
 /**********************
  *      MACROS
@@ -83,32 +112,94 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_line(const lv_point_t * point1, const lv_poin
     else if(point1->x == point2->x) draw_line_ver(point1, point2, &clip_line, dsc);
     else draw_line_skew(point1, point2, &clip_line, dsc);
 
-    if(dsc->round_end || dsc->round_start) {
-        lv_draw_rect_dsc_t cir_dsc;
-        lv_draw_rect_dsc_init(&cir_dsc);
-        cir_dsc.bg_color = dsc->color;
-        cir_dsc.radius = LV_RADIUS_CIRCLE;
-        cir_dsc.bg_opa = dsc->opa;
-
-        int32_t r = (dsc->width >> 1);
-        int32_t r_corr = (dsc->width & 1) ? 0 : 1;
-        lv_area_t cir_area;
-
-        if(dsc->round_start) {
-            cir_area.x1 = point1->x - r;
-            cir_area.y1 = point1->y - r;
-            cir_area.x2 = point1->x + r - r_corr;
-            cir_area.y2 = point1->y + r - r_corr ;
-            lv_draw_rect(&cir_area, clip, &cir_dsc);
+    if(dsc->round_start) draw_round_end(point1, clip, dsc);
+    if(dsc->round_end) draw_round_end(point2, clip, dsc);
+}
+
+/**
+ * Draw connected lines through an array of points.
+ * The lines are rasterized together into one coverage buffer so the joins are blended only once.
+ * @param points array of points
+ * @param point_cnt number of points in `points`
+ * @param clip the lines will be drawn only in this area
+ * @param dsc pointer to an initialized `lv_draw_line_dsc_t` variable.
+ *            `round_start` rounds the first point, `round_end` rounds the last point and the joins.
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_draw_polyline(const lv_point_t points[], uint16_t point_cnt, const lv_area_t * clip,
+                                            const lv_draw_line_dsc_t * dsc)
+{
+    if(point_cnt < 2) return;
+    if(dsc->width == 0) return;
+    if(dsc->opa <= LV_OPA_MIN) return;
+
+    uint16_t i;
+
+    /*The dashes start on every line again so draw dashed lines one by one*/
+    if(dsc->dash_gap && dsc->dash_width) {
+        lv_draw_line_dsc_t line_dsc;
+        _lv_memcpy_small(&line_dsc, dsc, sizeof(lv_draw_line_dsc_t));
+        for(i = 0; i < point_cnt - 1; i++) {
+            lv_draw_line(&points[i], &points[i + 1], clip, &line_dsc);
+            line_dsc.round_start = 0;
         }
+        return;
+    }
+
+    /*Skip the zero length lines at the ends to know which lines get the endings*/
+    uint16_t first = 0;
+    uint16_t last = point_cnt - 2;
+    while(first <= last && points[first].x == points[first + 1].x && points[first].y == points[first + 1].y) first++;
+    if(first > last) return;
+    while(points[last].x == points[last + 1].x && points[last].y == points[last + 1].y) last--;
 
-        if(dsc->round_end) {
-            cir_area.x1 = point2->x - r;
-            cir_area.y1 = point2->y - r;
-            cir_area.x2 = point2->x + r - r_corr;
-            cir_area.y2 = point2->y + r - r_corr ;
-            lv_draw_rect(&cir_area, clip, &cir_dsc);
+    bool simple_mode = true;
+    if(dsc->opa < LV_OPA_MAX) simple_mode = false;
+    else if(dsc->blend_mode != LV_BLEND_MODE_NORMAL) simple_mode = false;
+    else if(lv_draw_mask_get_cnt()) simple_mode = false;
+
+    polyline_seg_t * segs = _lv_mem_buf_get(sizeof(polyline_seg_t) * POLYLINE_SEG_MAX);
+    lv_draw_mask_line_param_t caps[2];
+    lv_area_t area;
+    uint32_t seg_cnt = 0;
+    for(i = first; i <= last; i++) {
+        polyline_seg_t * seg = &segs[seg_cnt];
+        if(polyline_seg_init(seg, &points[i], &points[i + 1], i == first, i == last, clip, dsc, caps) == false) continue;
+
+        /*Opaque horizontal and vertical lines look the same if the joins are blended twice so simply fill them*/
+        if(seg->skew == 0 && simple_mode) {
+            _lv_blend_fill(clip, &seg->area,
+                           dsc->color, NULL, LV_DRAW_MASK_RES_FULL_COVER, dsc->opa,
+                           dsc->blend_mode);
+            continue;
+        }
+
+        if(seg_cnt == 0) {
+            lv_area_copy(&area, &seg->area);
+        }
+        else {
+            area.x1 = LV_MATH_MIN(area.x1, seg->area.x1);
+            area.y1 = LV_MATH_MIN(area.y1, seg->area.y1);
+            area.x2 = LV_MATH_MAX(area.x2, seg->area.x2);
+            area.y2 = LV_MATH_MAX(area.y2, seg->area.y2);
+        }
+
+        seg_cnt++;
+        if(seg_cnt == POLYLINE_SEG_MAX) {
+            polyline_draw(segs, seg_cnt, &area, caps, clip, dsc);
+            seg_cnt = 0;
+        }
+    }
+
+    if(seg_cnt) polyline_draw(segs, seg_cnt, &area, caps, clip, dsc);
+    _lv_mem_buf_release(segs);
+
+    if(dsc->round_start) draw_round_end(&points[first], clip, dsc);
+    if(dsc->round_end) {
+        /*The rasterized joins of thin lines already look round*/
+        if(dsc->width > 2) {
+            for(i = first + 1; i <= last; i++) draw_round_end(&points[i], clip, dsc);
         }
+        draw_round_end(&points[last + 1], clip, dsc);
     }
 }
 
@@ -334,14 +425,6 @@ LV_ATTRIBUTE_FAST_MEM static void draw_line_skew(const lv_point_t * point1, cons
     int32_t ydiff = p2.y - p1.y;
     bool flat = LV_MATH_ABS(xdiff) > LV_MATH_ABS(ydiff) ? true : false;
 
-    static const uint8_t wcorr[] = {
-        128, 128, 128, 129, 129, 130, 130, 131,
-        132, 133, 134, 135, 137, 138, 140, 141,
-        143, 145, 147, 149, 151, 153, 155, 158,
-        160, 162, 165, 167, 170, 173, 175, 178,
-        181,
-    };
-
     int32_t w = dsc->width;
     int32_t wcorr_i = 0;
     if(flat) wcorr_i = (LV_MATH_ABS(ydiff) << 5) / LV_MATH_ABS(xdiff);
@@ -476,3 +559,286 @@ LV_ATTRIBUTE_FAST_MEM static void draw_line_skew(const lv_point_t * point1, cons
     lv_draw_mask_remove_id(mask_top_id);
     lv_draw_mask_remove_id(mask_bottom_id);
 }
+
+/**
+ * Initialize a line of a polyline
+ * @param seg pointer to the line to initialize
+ * @param point1 first point of the line
+ * @param point2 second point of the line
+ * @param first true: it's the first line of the polyline
+ * @param last true: it's the last line of the polyline
+ * @param clip the line will be drawn only in this area
+ * @param dsc pointer to an initialized `lv_draw_line_dsc_t` variable
+ * @param caps the masks of the polyline's start and end. Initialized here on the first and last line.
+ * @return true: the line is (partially) on `clip`; false: there is nothing to draw
+ */
+static bool polyline_seg_init(polyline_seg_t * seg, const lv_point_t * point1, const lv_point_t * point2,
+                              bool first, bool last, const lv_area_t * clip, const lv_draw_line_dsc_t * dsc,
+                              lv_draw_mask_line_param_t caps[])
+{
+    if(point1->x == point2->x && point1->y == point2->y) return false;
+
+    lv_area_t * area = &seg->area;
+    seg->skew = 0;
+    seg->cap_start = 0;
+    seg->cap_end = 0;
+
+    int32_t w = dsc->width - 1;
+    int32_t w_half0 = w >> 1;
+    int32_t w_half1 = w_half0 + (w & 0x1); /*Compensate rounding error*/
+
+    if(point1->y == point2->y) {
+        area->x1 = LV_MATH_MIN(point1->x, point2->x);
+        area->x2 = LV_MATH_MAX(point1->x, point2->x) - 1;
+        area->y1 = point1->y - w_half1;
+        area->y2 = point1->y + w_half0;
+
+        /*Cover the corners at the joins*/
+        bool ext_x1 = point1->x < point2->x ? !first : !last;
+        bool ext_x2 = point1->x < point2->x ? !last : !first;
+        if(ext_x1) area->x1 -= w_half1;
+        if(ext_x2) area->x2 += w_half0 + 1;
+    }
+    else if(point1->x == point2->x) {
+        area->x1 = point1->x - w_half1;
+        area->x2 = point1->x + w_half0;
+        area->y1 = LV_MATH_MIN(point1->y, point2->y);
+        area->y2 = LV_MATH_MAX(point1->y, point2->y) - 1;
+
+        bool ext_y1 = point1->y < point2->y ? !first : !last;
+        bool ext_y2 = point1->y < point2->y ? !last : !first;
+        if(ext_y1) area->y1 -= w_half1;
+        if(ext_y2) area->y2 += w_half0 + 1;
+    }
+    else {
+        /*Keep the great y in p2*/
+        const lv_point_t * p1 = point1->y < point2->y ? point1 : point2;
+        const lv_point_t * p2 = point1->y < point2->y ? point2 : point1;
+
+        int32_t xdiff = p2->x - p1->x;
+        int32_t ydiff = p2->y - p1->y;
+        bool flat = LV_MATH_ABS(xdiff) > LV_MATH_ABS(ydiff) ? true : false;
+
+        int32_t wcorr_i;
+        if(flat) wcorr_i = (LV_MATH_ABS(ydiff) << 5) / LV_MATH_ABS(xdiff);
+        else wcorr_i = (LV_MATH_ABS(xdiff) << 5) / LV_MATH_ABS(ydiff);
+
+        /*The corrected width in 1/256 px. The odd widths are shifted by half pixel like `draw_line_skew` does.*/
+        int32_t w_fine = (dsc->width * wcorr[wcorr_i]) << 1;
+        int32_t center = (dsc->width & 0x1) ? 128 : 0;
+        seg->ofs_start = center - (w_fine >> 1);
+        seg->ofs_end = center + (w_fine >> 1);
+        seg->p = *p1;
+        seg->flat = flat ? 1 : 0;
+        if(flat) {
+            seg->steep = (int32_t)(((int64_t)ydiff << 16) / xdiff);
+            seg->inv_steep = (int32_t)(((int64_t)xdiff << 16) / ydiff);
+        }
+        else {
+            seg->steep = (int32_t)(((int64_t)xdiff << 16) / ydiff);
+            seg->inv_steep = 0;
+        }
+
+        /*Use the normal vector for the endings of the polyline. The joins are not cut.*/
+        if(!dsc->raw_end) {
+            /*Shorten it to keep the second points of the masks in the coordinate range*/
+            int32_t nx = -ydiff;
+            int32_t ny = xdiff;
+            while(LV_MATH_ABS(nx) > 1024 || LV_MATH_ABS(ny) > 1024) {
+                nx /= 2;
+                ny /= 2;
+            }
+
+            if(first) {
+                lv_draw_mask_line_points_init(&caps[0], point1->x, point1->y, point1->x + nx, point1->y + ny,
+                                              point1 == p1 ? LV_DRAW_MASK_LINE_SIDE_BOTTOM : LV_DRAW_MASK_LINE_SIDE_TOP);
+                seg->cap_start = 1;
+            }
+            if(last) {
+                lv_draw_mask_line_points_init(&caps[1], point2->x, point2->y, point2->x + nx, point2->y + ny,
+                                              point2 == p1 ? LV_DRAW_MASK_LINE_SIDE_BOTTOM : LV_DRAW_MASK_LINE_SIDE_TOP);
+                seg->cap_end = 1;
+            }
+        }
+
+        area->x1 = LV_MATH_MIN(p1->x, p2->x) - dsc->width / 2;
+        area->x2 = LV_MATH_MAX(p1->x, p2->x) + dsc->width / 2;
+        area->y1 = p1->y - dsc->width / 2;
+        area->y2 = p2->y + dsc->width / 2;
+        seg->skew = 1;
+    }
+
+    return _lv_area_intersect(area, area, clip);
+}
+
+/**
+ * Rasterize lines of a polyline row by row.
+ * The coverage of the lines is merged into one buffer and blended once, in blocks of rows.
+ * The skew lines' coverage is calculated directly from their center line instead of with line masks.
+ * @param segs the initialized lines
+ * @param seg_cnt number of lines in `segs`
+ * @param area the union of the lines' areas
+ * @param caps the masks of the polyline's start and end
+ * @param clip the lines will be drawn only in this area
+ * @param dsc pointer to an initialized `lv_draw_line_dsc_t` variable
+ */
+LV_ATTRIBUTE_FAST_MEM static void polyline_draw(polyline_seg_t segs[], uint32_t seg_cnt, const lv_area_t * area,
+                                                lv_draw_mask_line_param_t caps[], const lv_area_t * clip,
+                                                const lv_draw_line_dsc_t * dsc)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    uint32_t hor_res = (uint32_t)lv_disp_get_hor_res(disp);
+    int32_t area_w = lv_area_get_width(area);
+    uint32_t cov_buf_size = LV_MATH_MIN(lv_area_get_size(area), hor_res);
+    lv_opa_t * cov_buf = _lv_mem_buf_get(cov_buf_size);
+    lv_opa_t * seg_buf = _lv_mem_buf_get(area_w);
+    _lv_memset_00(cov_buf, cov_buf_size);
+
+    bool other_mask = lv_draw_mask_get_cnt() ? true : false;
+
+    lv_area_t fill_area;
+    fill_area.x1 = area->x1;
+    fill_area.x2 = area->x2;
+    fill_area.y1 = area->y1;
+
+    uint32_t row_p = 0;
+    int32_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_opa_t * row = &cov_buf[row_p];
+        int32_t drawn_x1 = area->x2 + 1;  /*The drawn part of the row*/
+        int32_t drawn_x2 = area->x1 - 1;
+        uint32_t i;
+        for(i = 0; i < seg_cnt; i++) {
+            polyline_seg_t * seg = &segs[i];
+            if(y < seg->area.y1 || y > seg->area.y2) continue;
+
+            int32_t x1 = seg->area.x1;
+            int32_t x2 = seg->area.x2;
+            int32_t len = x2 - x1 + 1;
+            lv_opa_t * cov = &row[x1 - area->x1];
+            if(seg->skew == 0) {
+                _lv_memset_ff(cov, len);
+            }
+            else if(seg->cap_start || seg->cap_end) {
+                /*Cut the ends of the polyline with the perpendicular masks*/
+                _lv_memset_00(seg_buf, len);
+                polyline_seg_cov(seg, y, seg_buf, x1);
+                lv_draw_mask_res_t res = LV_DRAW_MASK_RES_CHANGED;
+                if(seg->cap_start) res = caps[0].dsc.cb(seg_buf, x1, y, len, &caps[0]);
+                if(res != LV_DRAW_MASK_RES_TRANSP && seg->cap_end) res = caps[1].dsc.cb(seg_buf, x1, y, len, &caps[1]);
+                if(res == LV_DRAW_MASK_RES_TRANSP) continue;
+
+                int32_t k;
+                for(k = 0; k < len; k++) {
+                    if(seg_buf[k] > cov[k]) cov[k] = seg_buf[k];
+                }
+            }
+            else {
+                polyline_seg_cov(seg, y, row, area->x1);
+            }
+
+            if(x1 < drawn_x1) drawn_x1 = x1;
+            if(x2 > drawn_x2) drawn_x2 = x2;
+        }
+
+        if(drawn_x1 <= drawn_x2 && other_mask) {
+            lv_draw_mask_res_t mask_res = lv_draw_mask_apply(row, area->x1, y, area_w);
+            if(mask_res == LV_DRAW_MASK_RES_TRANSP) _lv_memset_00(row, area_w);
+        }
+
+        /*Blend the collected rows if the next row doesn't fit*/
+        row_p += area_w;
+        if(y != area->y2 && row_p + area_w <= cov_buf_size) continue;
+
+        fill_area.y2 = y;
+        _lv_blend_fill(clip, &fill_area,
+                       dsc->color, cov_buf, LV_DRAW_MASK_RES_CHANGED, dsc->opa,
+                       dsc->blend_mode);
+
+        _lv_memset_00(cov_buf, row_p);
+        row_p = 0;
+        fill_area.y1 = y + 1;
+    }
+
+    _lv_mem_buf_release(seg_buf);
+    _lv_mem_buf_release(cov_buf);
+}
+
+/**
+ * Add the coverage of a skew line in a row to a buffer. The greater coverage is kept where it's already set.
+ * The pixels are sampled in their middle: steep lines in the middle of the row, flat lines in the middle of the columns.
+ * @param seg pointer to an initialized skew line
+ * @param y the row
+ * @param cov the coverage buffer of the row
+ * @param cov_x the x coordinate of `cov[0]`
+ */
+LV_ATTRIBUTE_FAST_MEM static void polyline_seg_cov(const polyline_seg_t * seg, int32_t y, lv_opa_t * cov, int32_t cov_x)
+{
+    int32_t x;
+    int32_t x_start;
+    int32_t x_end;
+
+    if(seg->flat == 0) {
+        /*The x of the center line in the middle of the row in 1/256 px*/
+        int32_t xc = (seg->p.x << 8) + (int32_t)(((int64_t)(((y - seg->p.y) << 1) + 1) * seg->steep) >> 9);
+        int32_t xl = xc + seg->ofs_start;
+        int32_t xr = xc + seg->ofs_end;
+
+        x_start = LV_MATH_MAX(xl >> 8, seg->area.x1);
+        x_end = LV_MATH_MIN((xr - 1) >> 8, seg->area.x2);
+        for(x = x_start; x <= x_end; x++) {
+            int32_t v = LV_MATH_MIN(xr, (x + 1) << 8) - LV_MATH_MAX(xl, x << 8);
+            if(v <= 0) continue;
+            lv_opa_t opa = v >= 256 ? LV_OPA_COVER : (lv_opa_t)v;
+            if(opa > cov[x - cov_x]) cov[x - cov_x] = opa;
+        }
+    }
+    else {
+        /*The center line is in the row between these x coordinates (1/256 px)*/
+        int32_t y_rel = (y - seg->p.y) << 8;
+        int32_t xa = (seg->p.x << 8) + (int32_t)(((int64_t)(y_rel - seg->ofs_end) * seg->inv_steep) >> 16);
+        int32_t xb = (seg->p.x << 8) + (int32_t)(((int64_t)(y_rel + 256 - seg->ofs_start) * seg->inv_steep) >> 16);
+        if(xa > xb) {
+            int32_t tmp = xa;
+            xa = xb;
+            xb = tmp;
+        }
+
+        x_start = LV_MATH_MAX((xa >> 8) - 1, seg->area.x1);
+        x_end = LV_MATH_MIN((xb >> 8) + 1, seg->area.x2);
+        int32_t row_top = y << 8;
+        int32_t row_bottom = row_top + 256;
+        for(x = x_start; x <= x_end; x++) {
+            /*The y of the center line in the middle of the column*/
+            int32_t yc = (seg->p.y << 8) + (int32_t)(((int64_t)(((x - seg->p.x) << 1) + 1) * seg->steep) >> 9);
+            int32_t v = LV_MATH_MIN(yc + seg->ofs_end, row_bottom) - LV_MATH_MAX(yc + seg->ofs_start, row_top);
+            if(v <= 0) continue;
+            lv_opa_t opa = v >= 256 ? LV_OPA_COVER : (lv_opa_t)v;
+            if(opa > cov[x - cov_x]) cov[x - cov_x] = opa;
+        }
+    }
+}
+
+/**
+ * Draw a circle on the end of a line
+ * @param point the end point of the line
+ * @param clip the circle will be drawn only in this area
+ * @param dsc pointer to an initialized `lv_draw_line_dsc_t` variable
+ */
+static void draw_round_end(const lv_point_t * point, const lv_area_t * clip, const lv_draw_line_dsc_t * dsc)
+{
+    lv_draw_rect_dsc_t cir_dsc;
+    lv_draw_rect_dsc_init(&cir_dsc);
+    cir_dsc.bg_color = dsc->color;
+    cir_dsc.radius = LV_RADIUS_CIRCLE;
+    cir_dsc.bg_opa = dsc->opa;
+
+    int32_t r = (dsc->width >> 1);
+    int32_t r_corr = (dsc->width & 1) ? 0 : 1;
+    lv_area_t cir_area;
+    cir_area.x1 = point->x - r;
+    cir_area.y1 = point->y - r;
+    cir_area.x2 = point->x + r - r_corr;
+    cir_area.y2 = point->y + r - r_corr ;
+    lv_draw_rect(&cir_area, clip, &cir_dsc);
+}
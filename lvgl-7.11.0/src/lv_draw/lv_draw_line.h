@@ -49,6 +49,18 @@ typedef struct {
 LV_ATTRIBUTE_FAST_MEM void lv_draw_line(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * clip,
                                         const lv_draw_line_dsc_t * dsc);
 
+/**
+ * Draw connected lines through an array of points.
+ * The lines are rasterized together into one coverage buffer so the joins are blended only once.
+ * @param points array of points
+ * @param point_cnt number of points in `points`
+ * @param clip the lines will be drawn only in this area
+ * @param dsc pointer to an initialized `lv_draw_line_dsc_t` variable.
+ *            `round_start` rounds the first point, `round_end` rounds the last point and the joins.
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_draw_polyline(const lv_point_t points[], uint16_t point_cnt, const lv_area_t * clip,
+                                            const lv_draw_line_dsc_t * dsc);
+
 LV_ATTRIBUTE_FAST_MEM void lv_draw_line_dsc_init(lv_draw_line_dsc_t * dsc);
 
 //! @endcond
@@ -21,9 +21,30 @@
 #define SHADOW_ENHANCE          1
 #define SPLIT_LIMIT             50
 
+/*Ordered dithering makes sense only if the gradient has more shades than the display*/
+#define GRAD_DITHER             (LV_DITHER_GRADIENT && LV_COLOR_DEPTH == 16)
+#if GRAD_DITHER
+    #define GRAD_PHASES         4   /*Number of dithered lines, one for every row (or column) of the dither matrix*/
+#else
+    #define GRAD_PHASES         1
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_GRAD_CACHE_SIZE
+/*Header of a cached gradient map. The colors of the map follow it.*/
+typedef struct {
+    lv_color_t main_color;
+    lv_color_t grad_color;
+    uint32_t bytes;         /*Size of the entry with the map*/
+    uint32_t last_use;      /*Value of `grad_cache_life` when the entry was used the last time*/
+    lv_coord_t size;
+    uint8_t main_stop;
+    uint8_t grad_stop;
+    uint8_t dir;            /*Only with dithering, else the same map is used in both directions*/
+} grad_cache_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -54,6 +75,14 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t
 static void draw_full_border(const lv_area_t * area_inner, const lv_area_t * area_outer, const lv_area_t * clip,
                              lv_coord_t radius, bool radius_is_in, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
 LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t * dsc, lv_coord_t s, lv_coord_t i);
+static lv_color_t * grad_map_get(const lv_draw_rect_dsc_t * dsc, lv_grad_dir_t dir, lv_coord_t s, bool * is_buf);
+static void grad_map_build(const lv_draw_rect_dsc_t * dsc, lv_grad_dir_t dir, lv_coord_t s, lv_color_t * map);
+#if GRAD_DITHER
+    static void grad_map_dither(const lv_draw_rect_dsc_t * dsc, lv_grad_dir_t dir, lv_coord_t s, lv_color_t * map);
+#endif
+#if LV_GRAD_CACHE_SIZE
+    static lv_color_t * grad_cache_get(const lv_draw_rect_dsc_t * dsc, lv_grad_dir_t dir, lv_coord_t s);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -64,6 +93,22 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t
     static int32_t sh_cache_r = -1;
 #endif
 
+#if LV_GRAD_CACHE_SIZE
+    static uint32_t grad_cache_mem[(LV_GRAD_CACHE_SIZE + 3) / 4];   /*`uint32_t` to align the entries*/
+    static uint32_t grad_cache_used;
+    static uint32_t grad_cache_life;
+#endif
+
+#if GRAD_DITHER
+/*4x4 Bayer matrix: threshold of the pixels in 1/16 color steps*/
+static const uint8_t dither_ordered_4x4[4][4] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5}
+};
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -215,6 +260,7 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
     bool simple_mode = true;
     if(other_mask_cnt) simple_mode = false;
     else if(grad_dir == LV_GRAD_DIR_HOR) simple_mode = false;
+    else if(GRAD_DITHER && grad_dir == LV_GRAD_DIR_VER) simple_mode = false;  /*The dithered lines are not single colored*/
 
     int16_t mask_rout_id = LV_MASK_ID_INV;
 
@@ -245,17 +291,20 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
         lv_draw_mask_res_t mask_res = LV_DRAW_MASK_RES_FULL_COVER;
         lv_color_t grad_color = dsc->bg_color;
 
+        /*Get the colors of the gradient from the cache or pre-compute them*/
         lv_color_t * grad_map = NULL;
-        /*In case of horizontal gradient pre-compute a line with a gradient*/
-        if(grad_dir == LV_GRAD_DIR_HOR) {
-            grad_map = _lv_mem_buf_get(coords_w * sizeof(lv_color_t));
-
-            int32_t i;
-            for(i = 0; i < coords_w; i++) {
-                grad_map[i] = grad_get(dsc, coords_w, i);
-            }
+        bool grad_map_buf = false;
+        int32_t grad_size = grad_dir == LV_GRAD_DIR_HOR ? coords_w : coords_h;
+        if(grad_dir != LV_GRAD_DIR_NONE) {
+            grad_map = grad_map_get(dsc, grad_dir, grad_size, &grad_map_buf);
         }
 
+#if GRAD_DITHER
+        /*The dithered colors of a line of a vertical gradient*/
+        lv_color_t * grad_line = NULL;
+        if(grad_dir == LV_GRAD_DIR_VER) grad_line = _lv_mem_buf_get(draw_area_w * sizeof(lv_color_t));
+#endif
+
         bool split = false;
         if(lv_area_get_width(&coords_bg) - 2 * rout > SPLIT_LIMIT) split = true;
 
@@ -293,7 +342,22 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
 
             /*Get the current line color*/
             if(grad_dir == LV_GRAD_DIR_VER) {
-                grad_color = grad_get(dsc, lv_area_get_height(&coords_bg), y - coords_bg.y1);
+#if GRAD_DITHER
+                /*The dithered lines repeat the colors of the 4 columns of the dither matrix*/
+                lv_color_t phase_colors[GRAD_PHASES];
+                int32_t i;
+                for(i = 0; i < GRAD_PHASES; i++) {
+                    phase_colors[i] = grad_map[i * grad_size + y - coords_bg.y1];
+                }
+
+                int32_t phase = disp_area->x1 + draw_area.x1 - coords_bg.x1;
+                for(i = 0; i < draw_area_w; i++) {
+                    grad_line[i] = phase_colors[(phase + i) & 0x3];
+                }
+#else
+                if(grad_map) grad_color = grad_map[y - coords_bg.y1];
+                else grad_color = grad_get(dsc, grad_size, y - coords_bg.y1);
+#endif
             }
 
             /* If there is not other mask and drawing the corner area split the drawing to corner and middle areas
@@ -332,11 +396,25 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
             }
             else {
                 if(grad_dir == LV_GRAD_DIR_HOR) {
-                    _lv_blend_map(clip, &fill_area, grad_map, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
+                    lv_color_t * grad_line_hor = grad_map;
+#if GRAD_DITHER
+                    grad_line_hor += ((y - coords_bg.y1) & 0x3) * grad_size;
+#endif
+                    _lv_blend_map(clip, &fill_area, grad_line_hor, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
                 }
                 else if(grad_dir == LV_GRAD_DIR_VER) {
+#if GRAD_DITHER
+                    /*`grad_line` has the colors only on the clipped area*/
+                    lv_area_t line_area;
+                    line_area.x1 = disp_area->x1 + draw_area.x1;
+                    line_area.x2 = disp_area->x1 + draw_area.x2;
+                    line_area.y1 = fill_area.y1;
+                    line_area.y2 = fill_area.y2;
+                    _lv_blend_map(clip, &line_area, grad_line, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
+#else
                     _lv_blend_fill(clip, &fill_area,
                                    grad_color, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
+#endif
                 }
                 else if(other_mask_cnt != 0 || !split) {
                     _lv_blend_fill(clip, &fill_area,
@@ -374,7 +452,10 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
 
         }
 
-        if(grad_map) _lv_mem_buf_release(grad_map);
+        if(grad_map_buf) _lv_mem_buf_release(grad_map);
+#if GRAD_DITHER
+        if(grad_line) _lv_mem_buf_release(grad_line);
+#endif
     }
 
     lv_draw_mask_remove_id(mask_rout_id);
@@ -519,6 +600,182 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t
     return lv_color_mix(dsc->bg_grad_color, dsc->bg_color, mix);
 }
 
+/**
+ * Get the colors of a gradient from the cache or compute them into a buffer
+ * @param dsc the descriptor of the rectangle
+ * @param dir direction of the gradient
+ * @param s size of the gradient in `dir` direction
+ * @param is_buf set to true if the map is computed into a buffer from `_lv_mem_buf_get()`
+ * @return `s` colors of the gradient. With dithering 4 lines of `s` colors, one for each phase of the dither matrix.
+ *         `NULL` for not cached vertical gradients without dithering,
+ *         because then computing only the colors of the drawn rows is faster.
+ */
+static lv_color_t * grad_map_get(const lv_draw_rect_dsc_t * dsc, lv_grad_dir_t dir, lv_coord_t s, bool * is_buf)
+{
+    lv_color_t * map;
+    *is_buf = false;
+
+#if LV_GRAD_CACHE_SIZE
+    map = grad_cache_get(dsc, dir, s);
+    if(map) return map;
+#endif
+
+    if(GRAD_DITHER == 0 && dir == LV_GRAD_DIR_VER) return NULL;
+
+    map = _lv_mem_buf_get(s * GRAD_PHASES * sizeof(lv_color_t));
+    *is_buf = true;
+    grad_map_build(dsc, dir, s, map);
+    return map;
+}
+
+/**
+ * Compute the colors of a gradient
+ * @param dsc the descriptor of the rectangle
+ * @param dir direction of the gradient (used only with dithering)
+ * @param s size of the gradient in `dir` direction
+ * @param map store `s * GRAD_PHASES` colors here
+ */
+static void grad_map_build(const lv_draw_rect_dsc_t * dsc, lv_grad_dir_t dir, lv_coord_t s, lv_color_t * map)
+{
+#if GRAD_DITHER
+    grad_map_dither(dsc, dir, s, map);
+#else
+    LV_UNUSED(dir);
+    lv_coord_t i;
+    for(i = 0; i < s; i++) {
+        map[i] = grad_get(dsc, s, i);
+    }
+#endif
+}
+
+#if GRAD_DITHER
+/**
+ * Compute the colors of a gradient with ordered dithering.
+ * The channels are interpolated in 1/16 color steps and rounded up or down by the 4x4 Bayer matrix.
+ * @param dsc the descriptor of the rectangle
+ * @param dir direction of the gradient
+ * @param s size of the gradient in `dir` direction
+ * @param map store 4 lines of `s` colors here.
+ *            For horizontal gradients a line for every 4th row, for vertical gradients for every 4th column.
+ */
+static void grad_map_dither(const lv_draw_rect_dsc_t * dsc, lv_grad_dir_t dir, lv_coord_t s, lv_color_t * map)
+{
+    int32_t min = (dsc->bg_main_color_stop * s) >> 8;
+    int32_t max = (dsc->bg_grad_color_stop * s) >> 8;
+    int32_t d = ((dsc->bg_grad_color_stop - dsc->bg_main_color_stop) * s) >> 8;
+
+    int32_t r1 = LV_COLOR_GET_R(dsc->bg_color) << 4;
+    int32_t g1 = LV_COLOR_GET_G(dsc->bg_color) << 4;
+    int32_t b1 = LV_COLOR_GET_B(dsc->bg_color) << 4;
+    int32_t r2 = LV_COLOR_GET_R(dsc->bg_grad_color) << 4;
+    int32_t g2 = LV_COLOR_GET_G(dsc->bg_grad_color) << 4;
+    int32_t b2 = LV_COLOR_GET_B(dsc->bg_grad_color) << 4;
+
+    lv_coord_t i;
+    for(i = 0; i < s; i++) {
+        int32_t r;
+        int32_t g;
+        int32_t b;
+        if(i <= min) {
+            r = r1;
+            g = g1;
+            b = b1;
+        }
+        else if(i >= max || i - min >= d) {
+            r = r2;
+            g = g2;
+            b = b2;
+        }
+        else {
+            int32_t j = i - min;
+            r = (r1 * (d - j) + r2 * j) / d;
+            g = (g1 * (d - j) + g2 * j) / d;
+            b = (b1 * (d - j) + b2 * j) / d;
+        }
+
+        int32_t p;
+        for(p = 0; p < GRAD_PHASES; p++) {
+            uint8_t t = dir == LV_GRAD_DIR_HOR ? dither_ordered_4x4[p][i & 0x3] : dither_ordered_4x4[i & 0x3][p];
+            lv_color_t c;
+            c.full = 0;
+            LV_COLOR_SET_R(c, (r + t) >> 4);
+            LV_COLOR_SET_G(c, (g + t) >> 4);
+            LV_COLOR_SET_B(c, (b + t) >> 4);
+            map[p * s + i] = c;
+        }
+    }
+}
+#endif
+
+#if LV_GRAD_CACHE_SIZE
+/**
+ * Get the colors of a gradient from the cache.
+ * If it's not cached yet compute and add it, removing the least recently used gradients if required.
+ * @param dsc the descriptor of the rectangle
+ * @param dir direction of the gradient
+ * @param s size of the gradient in `dir` direction
+ * @return the colors of the gradient (like `grad_map_get()`) or `NULL` if it doesn't fit into the cache
+ */
+static lv_color_t * grad_cache_get(const lv_draw_rect_dsc_t * dsc, lv_grad_dir_t dir, lv_coord_t s)
+{
+#if GRAD_DITHER == 0
+    dir = LV_GRAD_DIR_NONE;    /*The same colors are used in both directions*/
+#endif
+
+    uint8_t * mem = (uint8_t *)grad_cache_mem;
+    grad_cache_t * entry;
+    uint32_t ofs;
+
+    grad_cache_life++;
+    for(ofs = 0; ofs < grad_cache_used; ofs += entry->bytes) {
+        entry = (grad_cache_t *)(mem + ofs);
+        if(entry->size == s && entry->dir == dir &&
+           entry->main_color.full == dsc->bg_color.full && entry->grad_color.full == dsc->bg_grad_color.full &&
+           entry->main_stop == dsc->bg_main_color_stop && entry->grad_stop == dsc->bg_grad_color_stop) {
+            entry->last_use = grad_cache_life;
+            return (lv_color_t *)(entry + 1);
+        }
+    }
+
+    uint32_t bytes = sizeof(grad_cache_t) + ((s * GRAD_PHASES * sizeof(lv_color_t) + 3) & ~0x3);
+    if(bytes > sizeof(grad_cache_mem)) return NULL;
+
+    /*Remove the least recently used entries and move the next ones in their place*/
+    while(grad_cache_used + bytes > sizeof(grad_cache_mem)) {
+        grad_cache_t * lru = NULL;
+        for(ofs = 0; ofs < grad_cache_used; ofs += entry->bytes) {
+            entry = (grad_cache_t *)(mem + ofs);
+            if(lru == NULL || entry->last_use < lru->last_use) lru = entry;
+        }
+
+        uint32_t * dst = (uint32_t *)lru;
+        uint32_t * src = (uint32_t *)((uint8_t *)lru + lru->bytes);
+        uint32_t * end = (uint32_t *)(mem + grad_cache_used);
+        grad_cache_used -= lru->bytes;
+        while(src < end) {
+            *dst = *src;
+            dst++;
+            src++;
+        }
+    }
+
+    entry = (grad_cache_t *)(mem + grad_cache_used);
+    entry->main_color = dsc->bg_color;
+    entry->grad_color = dsc->bg_grad_color;
+    entry->main_stop = dsc->bg_main_color_stop;
+    entry->grad_stop = dsc->bg_grad_color_stop;
+    entry->size = s;
+    entry->dir = dir;
+    entry->bytes = bytes;
+    entry->last_use = grad_cache_life;
+    grad_cache_used += bytes;
+
+    lv_color_t * map = (lv_color_t *)(entry + 1);
+    grad_map_build(dsc, dir, s, map);
+    return map;
+}
+#endif
+
 #if LV_USE_SHADOW
 LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv_area_t * clip,
                                               const lv_draw_rect_dsc_t * dsc)
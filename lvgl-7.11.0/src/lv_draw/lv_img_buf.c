@@ -25,6 +25,15 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_USE_IMG_TRANSFORM
+static void transform_get_span(int32_t v, int32_t dv, int32_t max, int32_t * start, int32_t * end);
+static void transform_line_nearest(const lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys, int32_t len,
+                                   lv_color_t * cbuf, lv_opa_t * abuf);
+static void transform_line_bilinear(const lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys, int32_t len,
+                                    lv_color_t * cbuf, lv_opa_t * abuf);
+static inline lv_color_t transform_read_px(const uint8_t * px);
+static inline lv_color_t transform_mix(lv_color_t c0, lv_color_t c1, uint32_t mix);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -433,6 +442,14 @@ void _lv_img_buf_transform_init(lv_img_transform_dsc_t * dsc)
     dsc->tmp.sinma = (s1 * (10 - angle_rem) + s2 * angle_rem) / 10;
     dsc->tmp.cosma = (c1 * (10 - angle_rem) + c2 * angle_rem) / 10;
 
+    /* The steps of the source coordinates with full precision: sin * 256 / zoom in 1/65536 units.
+     * `sin * 512` fits into 24 bits so it won't overflow.
+     * Scale it by 32768 / LV_TRIGO_SIN_MAX to step exactly 1 pixel at 0 degree without zoom.*/
+    int32_t sin_512 = dsc->tmp.sinma * 512;
+    int32_t cos_512 = dsc->tmp.cosma * 512;
+    dsc->tmp.sin_step = (sin_512 + sin_512 / LV_TRIGO_SIN_MAX) / dsc->cfg.zoom;
+    dsc->tmp.cos_step = (cos_512 + cos_512 / LV_TRIGO_SIN_MAX) / dsc->cfg.zoom;
+
     /*Use smaller value to avoid overflow*/
     dsc->tmp.sinma = dsc->tmp.sinma >> (LV_TRIGO_SHIFT - _LV_TRANSFORM_TRIGO_SHIFT);
     dsc->tmp.cosma = dsc->tmp.cosma >> (LV_TRIGO_SHIFT - _LV_TRANSFORM_TRIGO_SHIFT);
@@ -457,9 +474,63 @@ void _lv_img_buf_transform_init(lv_img_transform_dsc_t * dsc)
      *  + dsc->cfg.zoom / 2 for rounding*/
     dsc->tmp.zoom_inv = (((256 * 256) << _LV_ZOOM_INV_UPSCALE) + dsc->cfg.zoom / 2) / dsc->cfg.zoom;
 
+    /*Integer upscaling just repeats the pixels so sampling the nearest pixel is enough*/
+    if(dsc->cfg.antialias == false || (dsc->cfg.angle == 0 && dsc->cfg.zoom % LV_IMG_ZOOM_NONE == 0)) {
+        dsc->tmp.nearest = 1;
+    }
+    else {
+        dsc->tmp.nearest = 0;
+    }
+
+    dsc->tmp.px_size = dsc->tmp.has_alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : LV_COLOR_SIZE >> 3;
+
     dsc->res.opa = LV_OPA_COVER;
     dsc->res.color = dsc->cfg.color;
 }
+
+/**
+ * Transform a horizontal line of pixels.
+ * The source coordinates are stepped along the line and only the part of the line
+ * which falls onto the source image is sampled.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init()`.
+ *            Only the `LV_IMG_CF_TRUE_COLOR...` color formats are supported.
+ * @param x the first x coordinate of the line relative to the image
+ * @param y the y coordinate of the line relative to the image
+ * @param len number of pixels in the line
+ * @param cbuf store the colors here
+ * @param abuf store the opacities here. `LV_OPA_TRANSP` where the line is out of the image.
+ */
+void _lv_img_buf_transform_line(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    /*The source coordinates of the first pixel in 1/65536 pixels*/
+    int32_t xt = x - dsc->cfg.pivot_x;
+    int32_t yt = y - dsc->cfg.pivot_y;
+    int32_t dx = dsc->tmp.cos_step;
+    int32_t dy = dsc->tmp.sin_step;
+    int32_t xs = xt * dx - yt * dy + ((int32_t)dsc->cfg.pivot_x << 16);
+    int32_t ys = xt * dy + yt * dx + ((int32_t)dsc->cfg.pivot_y << 16);
+
+    /*Find the part of the line which is on the image*/
+    int32_t start = 0;
+    int32_t end = len;
+    transform_get_span(xs, dx, (int32_t)dsc->cfg.src_w << 16, &start, &end);
+    transform_get_span(ys, dy, (int32_t)dsc->cfg.src_h << 16, &start, &end);
+
+    if(start >= end) {
+        _lv_memset_00(abuf, len);
+        return;
+    }
+
+    if(start > 0) _lv_memset_00(abuf, start);
+    if(end < len) _lv_memset_00(abuf + end, len - end);
+
+    xs += start * dx;
+    ys += start * dy;
+
+    if(dsc->tmp.nearest) transform_line_nearest(dsc, xs, ys, end - start, cbuf + start, abuf + start);
+    else transform_line_bilinear(dsc, xs, ys, end - start, cbuf + start, abuf + start);
+}
 #endif
 
 /**
@@ -680,3 +751,219 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc)
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_USE_IMG_TRANSFORM
+/**
+ * Narrow a range of steps to where a stepped coordinate is in [0, max)
+ * @param v the coordinate at the 0th step
+ * @param dv the change of the coordinate in a step
+ * @param max the coordinate needs to be smaller than this
+ * @param start the first step of the range. Increased if needed.
+ * @param end the step after the range. Decreased if needed.
+ */
+static void transform_get_span(int32_t v, int32_t dv, int32_t max, int32_t * start, int32_t * end)
+{
+    int32_t s;
+    int32_t e;
+    if(dv == 0) {
+        if(v < 0 || v >= max) *end = *start;
+        return;
+    }
+    else if(dv > 0) {
+        s = v >= 0 ? 0 : (-v + dv - 1) / dv;
+        e = v >= max ? 0 : (max - v + dv - 1) / dv;
+    }
+    else {
+        s = v < max ? 0 : (v - max) / (-dv) + 1;
+        e = v < 0 ? 0 : v / (-dv) + 1;
+    }
+
+    if(s > *start) *start = s;
+    if(e < *end) *end = e;
+}
+
+/**
+ * Sample the nearest source pixels along a line. All the pixels need to be on the image.
+ * @param dsc the transformation descriptor
+ * @param xs source x coordinate of the first pixel in 1/65536 pixels
+ * @param ys source y coordinate of the first pixel in 1/65536 pixels
+ * @param len number of pixels
+ * @param cbuf store the colors here
+ * @param abuf store the opacities here
+ */
+static void transform_line_nearest(const lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys, int32_t len,
+                                   lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    const uint8_t * src = dsc->cfg.src;
+    uint32_t px_size = dsc->tmp.px_size;
+    uint32_t stride = dsc->cfg.src_w * px_size;
+    int32_t dx = dsc->tmp.cos_step;
+    int32_t dy = dsc->tmp.sin_step;
+    lv_color_t ct = LV_COLOR_TRANSP;
+
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        const uint8_t * px = src + (ys >> 16) * stride + (xs >> 16) * px_size;
+        cbuf[i] = transform_read_px(px);
+        abuf[i] = dsc->tmp.has_alpha ? px[px_size - 1] : LV_OPA_COVER;
+        if(dsc->tmp.chroma_keyed && cbuf[i].full == ct.full) abuf[i] = LV_OPA_TRANSP;
+
+        xs += dx;
+        ys += dy;
+    }
+}
+
+/**
+ * Interpolate the 4 nearest source pixels along a line. All the pixels need to be on the image.
+ * @param dsc the transformation descriptor
+ * @param xs source x coordinate of the first pixel in 1/65536 pixels
+ * @param ys source y coordinate of the first pixel in 1/65536 pixels
+ * @param len number of pixels
+ * @param cbuf store the colors here
+ * @param abuf store the opacities here
+ */
+static void transform_line_bilinear(const lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys, int32_t len,
+                                    lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    const uint8_t * src = dsc->cfg.src;
+    uint32_t px_size = dsc->tmp.px_size;
+    uint32_t stride = dsc->cfg.src_w * px_size;
+    int32_t x_max = dsc->cfg.src_w - 1;
+    int32_t y_max = dsc->cfg.src_h - 1;
+    int32_t dx = dsc->tmp.cos_step;
+    int32_t dy = dsc->tmp.sin_step;
+    bool has_opa = dsc->tmp.has_alpha || dsc->tmp.chroma_keyed;
+    lv_color_t ct = LV_COLOR_TRANSP;
+
+    int32_t i;
+    for(i = 0; i < len; i++, xs += dx, ys += dy) {
+        /*The pixel centers are at 0.5 so the pixels to mix are around -0.5*/
+        int32_t u = xs - 0x8000;
+        int32_t v = ys - 0x8000;
+        int32_t x0 = u >> 16;
+        int32_t y0 = v >> 16;
+        uint32_t fx = (u >> 8) & 0xFF;
+        uint32_t fy = (v >> 8) & 0xFF;
+
+        /*Repeat the edge pixels*/
+        int32_t x1 = x0 + 1;
+        int32_t y1 = y0 + 1;
+        if(x0 < 0) x0 = 0;
+        if(y0 < 0) y0 = 0;
+        if(x1 > x_max) x1 = x_max;
+        if(y1 > y_max) y1 = y_max;
+
+        const uint8_t * px00 = src + y0 * stride + x0 * px_size;
+        const uint8_t * px01 = src + y0 * stride + x1 * px_size;
+        const uint8_t * px10 = src + y1 * stride + x0 * px_size;
+        const uint8_t * px11 = src + y1 * stride + x1 * px_size;
+
+        lv_color_t c00 = transform_read_px(px00);
+        lv_color_t c01 = transform_read_px(px01);
+        lv_color_t c10 = transform_read_px(px10);
+        lv_color_t c11 = transform_read_px(px11);
+
+        if(has_opa) {
+            lv_opa_t a00 = LV_OPA_COVER;
+            lv_opa_t a01 = LV_OPA_COVER;
+            lv_opa_t a10 = LV_OPA_COVER;
+            lv_opa_t a11 = LV_OPA_COVER;
+            if(dsc->tmp.has_alpha) {
+                a00 = px00[px_size - 1];
+                a01 = px01[px_size - 1];
+                a10 = px10[px_size - 1];
+                a11 = px11[px_size - 1];
+            }
+            else {
+                if(c00.full == ct.full) a00 = LV_OPA_TRANSP;
+                if(c01.full == ct.full) a01 = LV_OPA_TRANSP;
+                if(c10.full == ct.full) a10 = LV_OPA_TRANSP;
+                if(c11.full == ct.full) a11 = LV_OPA_TRANSP;
+            }
+
+            uint32_t wx = fx + (fx >> 7);
+            uint32_t wy = fy + (fy >> 7);
+            uint32_t a0 = (a00 * (256 - wx) + a01 * wx) >> 8;
+            uint32_t a1 = (a10 * (256 - wx) + a11 * wx) >> 8;
+            abuf[i] = (a0 * (256 - wy) + a1 * wy) >> 8;
+            if(abuf[i] <= LV_OPA_MIN) {
+                abuf[i] = LV_OPA_TRANSP;
+                continue;
+            }
+
+            /*Don't mix the color of transparent pixels into the result. Use the most opaque one instead.*/
+            if(a00 <= LV_OPA_MIN || a01 <= LV_OPA_MIN || a10 <= LV_OPA_MIN || a11 <= LV_OPA_MIN) {
+                lv_color_t c_max = c00;
+                lv_opa_t a_max = a00;
+                if(a01 > a_max) {
+                    c_max = c01;
+                    a_max = a01;
+                }
+                if(a10 > a_max) {
+                    c_max = c10;
+                    a_max = a10;
+                }
+                if(a11 > a_max) c_max = c11;
+
+                if(a00 <= LV_OPA_MIN) c00 = c_max;
+                if(a01 <= LV_OPA_MIN) c01 = c_max;
+                if(a10 <= LV_OPA_MIN) c10 = c_max;
+                if(a11 <= LV_OPA_MIN) c11 = c_max;
+            }
+        }
+        else {
+            abuf[i] = LV_OPA_COVER;
+        }
+
+        cbuf[i] = transform_mix(transform_mix(c00, c01, fx), transform_mix(c10, c11, fx), fy);
+    }
+}
+
+/**
+ * Read a pixel of a true color image
+ * @param px pointer to the pixel
+ * @return the color of the pixel
+ */
+static inline lv_color_t transform_read_px(const uint8_t * px)
+{
+    lv_color_t c;
+#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
+    c.full = px[0];
+#elif LV_COLOR_DEPTH == 16
+    c.full = px[0] + (px[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+    c.full = *((const uint32_t *)px);
+    c.ch.alpha = 0xFF;
+#endif
+    return c;
+}
+
+/**
+ * Mix two colors. The channels are mixed together in one 32 bit integer where it's possible.
+ * @param c0 the first color
+ * @param c1 the second color
+ * @param mix the ratio of `c1` (0..255)
+ * @return the mixed color
+ */
+static inline lv_color_t transform_mix(lv_color_t c0, lv_color_t c1, uint32_t mix)
+{
+    lv_color_t ret;
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+    /*Spread the channels to gaps as G-R-B and mix them with a 5 bit ratio*/
+    uint32_t w = (mix + 4) >> 3;
+    uint32_t a = (c0.full | ((uint32_t)c0.full << 16)) & 0x07E0F81F;
+    uint32_t b = (c1.full | ((uint32_t)c1.full << 16)) & 0x07E0F81F;
+    a = ((((b - a) * w) >> 5) + a) & 0x07E0F81F;
+    ret.full = (uint16_t)((a >> 16) | a);
+#elif LV_COLOR_DEPTH == 32
+    /*Mix R and B together and G separately*/
+    uint32_t w = mix + (mix >> 7);
+    uint32_t rb = (((c0.full & 0x00FF00FF) * (256 - w) + (c1.full & 0x00FF00FF) * w) >> 8) & 0x00FF00FF;
+    uint32_t g = (((c0.full & 0x0000FF00) * (256 - w) + (c1.full & 0x0000FF00) * w) >> 8) & 0x0000FF00;
+    ret.full = 0xFF000000 | rb | g;
+#else
+    ret = lv_color_mix(c1, c0, mix);
+#endif
+    return ret;
+}
+#endif
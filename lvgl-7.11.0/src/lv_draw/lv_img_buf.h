@@ -173,6 +173,11 @@ typedef struct {
 
         uint32_t zoom_inv;
 
+        /*Source step per destination pixel in 1/65536 pixels for `_lv_img_buf_transform_line()`*/
+        int32_t cos_step;
+        int32_t sin_step;
+        uint8_t nearest : 1;
+
         /*Runtime data*/
         lv_coord_t xs;
         lv_coord_t ys;
@@ -272,6 +277,21 @@ uint32_t lv_img_buf_get_img_size(lv_coord_t w, lv_coord_t h, lv_img_cf_t cf);
  */
 void _lv_img_buf_transform_init(lv_img_transform_dsc_t * dsc);
 
+/**
+ * Transform a horizontal line of pixels.
+ * The source coordinates are stepped along the line and only the part of the line
+ * which falls onto the source image is sampled.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init()`.
+ *            Only the `LV_IMG_CF_TRUE_COLOR...` color formats are supported.
+ * @param x the first x coordinate of the line relative to the image
+ * @param y the y coordinate of the line relative to the image
+ * @param len number of pixels in the line
+ * @param cbuf store the colors here
+ * @param abuf store the opacities here. `LV_OPA_TRANSP` where the line is out of the image.
+ */
+void _lv_img_buf_transform_line(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                lv_color_t * cbuf, lv_opa_t * abuf);
+
 /**
  * Continue transformation by taking the neighbors into account
  * @param dsc pointer to the transformation descriptor
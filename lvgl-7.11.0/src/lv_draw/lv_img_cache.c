@@ -26,6 +26,9 @@
  * "die" from very high values */
 #define LV_IMG_CACHE_LIFE_LIMIT 1000
 
+/*Keep at most this many transformed images including the ones which are not settled yet*/
+#define LV_IMG_CACHE_TRANSFORM_MAX_CNT 32
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -41,6 +44,12 @@
     static lv_img_cache_entry_t cache_temp;
 #endif
 
+#if LV_USE_IMG_TRANSFORM && LV_IMG_CACHE_TRANSFORM_SIZE
+    static bool transform_match(const lv_img_cache_transform_t * entry, const void * src);
+    static bool transform_build(lv_img_cache_transform_t * entry, const lv_img_decoder_dsc_t * dec_dsc);
+    static void transform_remove(lv_img_cache_transform_t * entry);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -48,6 +57,10 @@
     static uint16_t entry_cnt;
 #endif
 
+#if LV_USE_IMG_TRANSFORM && LV_IMG_CACHE_TRANSFORM_SIZE
+    static uint32_t transform_used;     /*Bytes used by the transformed images*/
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -196,6 +209,130 @@ void lv_img_cache_invalidate_src(const void * src)
         }
     }
 #endif
+
+    lv_img_cache_invalidate_transform_src(src);
+}
+
+#if LV_USE_IMG_TRANSFORM && LV_IMG_CACHE_TRANSFORM_SIZE
+/**
+ * Get an image from the cache of transformed images.
+ * If the image was drawn with the same parameters for longer than a refresh period it's transformed and cached now.
+ * @param cdsc the opened image. Its whole uncompressed image needs to be available.
+ * @param angle angle of rotation in 0.1 degree
+ * @param zoom zoom factor, `LV_IMG_ZOOM_NONE` for no zoom
+ * @param pivot the pivot of the rotation and zoom
+ * @param antialias true: transform with anti-aliasing
+ * @param area store the area of the transformed image relative to the original image here
+ * @return the transformed image as `LV_IMG_CF_TRUE_COLOR_ALPHA` or `NULL` if it's not cached
+ */
+const uint8_t * _lv_img_cache_transform_get(lv_img_cache_entry_t * cdsc, int16_t angle, uint16_t zoom,
+                                            const lv_point_t * pivot, bool antialias, lv_area_t * area)
+{
+    lv_img_decoder_dsc_t * dec_dsc = &cdsc->dec_dsc;
+    lv_img_cf_t cf = dec_dsc->header.cf;
+    if(dec_dsc->img_data == NULL) return NULL;
+    if(cf != LV_IMG_CF_TRUE_COLOR && cf != LV_IMG_CF_TRUE_COLOR_ALPHA &&
+       cf != LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) return NULL;
+
+    /*The pixels of image variables can be replaced without changing the source*/
+    const void * data = NULL;
+    if(lv_img_src_get_type(dec_dsc->src) == LV_IMG_SRC_VARIABLE) data = dec_dsc->img_data;
+
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_cache_transform_ll);
+    lv_img_cache_transform_t * entry;
+    _LV_LL_READ(*ll, entry) {
+        if(entry->angle == angle && entry->zoom == zoom &&
+           entry->pivot.x == pivot->x && entry->pivot.y == pivot->y &&
+           entry->antialias == antialias && entry->color.full == dec_dsc->color.full &&
+           transform_match(entry, dec_dsc->src)) {
+            break;
+        }
+    }
+
+    if(entry == NULL) {
+        /*Don't track the images which would never fit*/
+        lv_area_t a;
+        _lv_img_buf_get_transformed_area(&a, dec_dsc->header.w, dec_dsc->header.h, angle, zoom, pivot);
+        if(lv_area_get_size(&a) * LV_IMG_PX_SIZE_ALPHA_BYTE > LV_IMG_CACHE_TRANSFORM_SIZE) return NULL;
+
+        if(_lv_ll_get_len(ll) >= LV_IMG_CACHE_TRANSFORM_MAX_CNT) transform_remove(_lv_ll_get_tail(ll));
+
+        entry = _lv_ll_ins_head(ll);
+        LV_ASSERT_MEM(entry);
+        if(entry == NULL) return NULL;
+        _lv_memset_00(entry, sizeof(lv_img_cache_transform_t));
+
+        if(lv_img_src_get_type(dec_dsc->src) == LV_IMG_SRC_FILE) {
+            size_t fn_len = strlen(dec_dsc->src);
+            entry->src = lv_mem_alloc(fn_len + 1);
+            LV_ASSERT_MEM(entry->src);
+            if(entry->src == NULL) {
+                _lv_ll_remove(ll, entry);
+                lv_mem_free(entry);
+                return NULL;
+            }
+            strcpy(entry->src, dec_dsc->src);
+            entry->src_is_file = 1;
+        }
+        else {
+            entry->src = (void *)dec_dsc->src;
+        }
+
+        entry->data = data;
+        entry->color = dec_dsc->color;
+        entry->pivot = *pivot;
+        entry->angle = angle;
+        entry->zoom = zoom;
+        entry->antialias = antialias ? 1 : 0;
+        lv_area_copy(&entry->area, &a);
+        entry->first_use = lv_tick_get();
+        return NULL;
+    }
+
+    /*Move to the head to keep the order of use*/
+    lv_img_cache_transform_t * head = _lv_ll_get_head(ll);
+    if(entry != head) _lv_ll_move_before(ll, entry, head);
+
+    if(entry->data != data) {
+        if(entry->buf) {
+            transform_used -= lv_area_get_size(&entry->area) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+            lv_mem_free(entry->buf);
+            entry->buf = NULL;
+        }
+        entry->data = data;
+        entry->first_use = lv_tick_get();
+        return NULL;
+    }
+
+    if(entry->buf == NULL) {
+        /*Probably animated if it's drawn differently in the next refresh*/
+        if(lv_tick_elaps(entry->first_use) < LV_DISP_DEF_REFR_PERIOD) return NULL;
+        if(transform_build(entry, dec_dsc) == false) return NULL;
+    }
+
+    lv_area_copy(area, &entry->area);
+    return entry->buf;
+}
+#endif
+
+/**
+ * Invalidate an image source in the cache of transformed images.
+ * Needs to be called if the pixels of an image variable are changed (`lv_canvas` does it automatically).
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable. `NULL` to invalidate all.
+ */
+void lv_img_cache_invalidate_transform_src(const void * src)
+{
+#if LV_USE_IMG_TRANSFORM && LV_IMG_CACHE_TRANSFORM_SIZE
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_cache_transform_ll);
+    lv_img_cache_transform_t * entry = _lv_ll_get_head(ll);
+    while(entry) {
+        lv_img_cache_transform_t * next = _lv_ll_get_next(ll, entry);
+        if(src == NULL || transform_match(entry, src)) transform_remove(entry);
+        entry = next;
+    }
+#else
+    LV_UNUSED(src);
+#endif
 }
 
 /**********************
@@ -215,3 +352,97 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
     return strcmp(src1, src2) == 0;
 }
 #endif
+
+#if LV_USE_IMG_TRANSFORM && LV_IMG_CACHE_TRANSFORM_SIZE
+/**
+ * Check whether a transformed image belongs to an image source.
+ * Don't read the saved source of the image variables as it might be freed since then.
+ * @param entry a transformed image
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @return true: the image is transformed from `src`
+ */
+static bool transform_match(const lv_img_cache_transform_t * entry, const void * src)
+{
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type == LV_IMG_SRC_VARIABLE) return entry->src_is_file == 0 && entry->src == src;
+    if(src_type == LV_IMG_SRC_FILE) return entry->src_is_file && strcmp(entry->src, src) == 0;
+    return false;
+}
+
+/**
+ * Transform an image into the buffer of a cache entry.
+ * The least recently used images are removed to have enough memory for it.
+ * @param entry the entry to fill. It should be the head of the list.
+ * @param dec_dsc the opened image
+ * @return true: the image is transformed; false: out of memory
+ */
+static bool transform_build(lv_img_cache_transform_t * entry, const lv_img_decoder_dsc_t * dec_dsc)
+{
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_cache_transform_ll);
+    uint32_t size = lv_area_get_size(&entry->area) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    while(transform_used + size > LV_IMG_CACHE_TRANSFORM_SIZE) {
+        lv_img_cache_transform_t * tail = _lv_ll_get_tail(ll);
+        if(tail == NULL || tail == entry) break;
+        transform_remove(tail);
+    }
+
+    entry->buf = lv_mem_alloc(size);
+    if(entry->buf == NULL) {
+        LV_LOG_WARN("Couldn't allocate memory for a transformed image");
+        /*Try again after some time*/
+        entry->first_use = lv_tick_get();
+        return false;
+    }
+    transform_used += size;
+
+    lv_img_transform_dsc_t trans_dsc;
+    _lv_memset_00(&trans_dsc, sizeof(lv_img_transform_dsc_t));
+    trans_dsc.cfg.src = dec_dsc->img_data;
+    trans_dsc.cfg.src_w = dec_dsc->header.w;
+    trans_dsc.cfg.src_h = dec_dsc->header.h;
+    trans_dsc.cfg.cf = dec_dsc->header.cf;
+    trans_dsc.cfg.pivot_x = entry->pivot.x;
+    trans_dsc.cfg.pivot_y = entry->pivot.y;
+    trans_dsc.cfg.angle = entry->angle;
+    trans_dsc.cfg.zoom = entry->zoom;
+    trans_dsc.cfg.color = entry->color;
+    trans_dsc.cfg.antialias = entry->antialias;
+    _lv_img_buf_transform_init(&trans_dsc);
+
+    lv_coord_t w = lv_area_get_width(&entry->area);
+    lv_color_t * cbuf = _lv_mem_buf_get(w * sizeof(lv_color_t));
+    lv_opa_t * abuf = _lv_mem_buf_get(w);
+    uint8_t * px = entry->buf;
+    lv_coord_t y;
+    for(y = entry->area.y1; y <= entry->area.y2; y++) {
+        _lv_img_buf_transform_line(&trans_dsc, entry->area.x1, y, w, cbuf, abuf);
+
+        lv_coord_t x;
+        for(x = 0; x < w; x++) {
+            _lv_memcpy_small(px, &cbuf[x], sizeof(lv_color_t));
+            px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = abuf[x];
+            px += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+    }
+    _lv_mem_buf_release(abuf);
+    _lv_mem_buf_release(cbuf);
+
+    return true;
+}
+
+/**
+ * Remove a transformed image from the cache and free its memory
+ * @param entry the transformed image to remove
+ */
+static void transform_remove(lv_img_cache_transform_t * entry)
+{
+    if(entry->buf) {
+        transform_used -= lv_area_get_size(&entry->area) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        lv_mem_free(entry->buf);
+    }
+    if(entry->src_is_file) lv_mem_free(entry->src);
+
+    _lv_ll_remove(&LV_GC_ROOT(_lv_img_cache_transform_ll), entry);
+    lv_mem_free(entry);
+}
+#endif
@@ -37,6 +37,26 @@ typedef struct {
     int32_t life;
 } lv_img_cache_entry_t;
 
+#if LV_USE_IMG_TRANSFORM && LV_IMG_CACHE_TRANSFORM_SIZE
+/**
+ * A rotated and/or zoomed image stored as `LV_IMG_CF_TRUE_COLOR_ALPHA` to draw it without transformation.
+ * The entries are stored in a linked list with the most recently used entry as head.
+ */
+typedef struct {
+    void * src;                 /**< Source of the image. File names are copied.*/
+    uint8_t src_is_file : 1;
+    const void * data;          /**< Pixel data of `LV_IMG_SRC_VARIABLE` sources to notice if it's replaced*/
+    lv_color_t color;           /**< The color of `LV_IMG_CF_ALPHA_...` images*/
+    lv_point_t pivot;
+    int16_t angle;
+    uint16_t zoom;
+    uint8_t antialias : 1;
+    lv_area_t area;             /**< Area of the transformed image relative to the original image*/
+    uint8_t * buf;              /**< The transformed pixels or `NULL` if the image is not settled yet*/
+    uint32_t first_use;         /**< Time when the image was first drawn with these parameters*/
+} lv_img_cache_transform_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -66,6 +86,29 @@ void lv_img_cache_set_size(uint16_t new_slot_num);
  */
 void lv_img_cache_invalidate_src(const void * src);
 
+#if LV_USE_IMG_TRANSFORM && LV_IMG_CACHE_TRANSFORM_SIZE
+/**
+ * Get an image from the cache of transformed images.
+ * If the image was drawn with the same parameters for longer than a refresh period it's transformed and cached now.
+ * @param cdsc the opened image. Its whole uncompressed image needs to be available.
+ * @param angle angle of rotation in 0.1 degree
+ * @param zoom zoom factor, `LV_IMG_ZOOM_NONE` for no zoom
+ * @param pivot the pivot of the rotation and zoom
+ * @param antialias true: transform with anti-aliasing
+ * @param area store the area of the transformed image relative to the original image here
+ * @return the transformed image as `LV_IMG_CF_TRUE_COLOR_ALPHA` or `NULL` if it's not cached
+ */
+const uint8_t * _lv_img_cache_transform_get(lv_img_cache_entry_t * cdsc, int16_t angle, uint16_t zoom,
+                                            const lv_point_t * pivot, bool antialias, lv_area_t * area);
+#endif
+
+/**
+ * Invalidate an image source in the cache of transformed images.
+ * Needs to be called if the pixels of an image variable are changed (`lv_canvas` does it automatically).
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable. `NULL` to invalidate all.
+ */
+void lv_img_cache_invalidate_transform_src(const void * src);
+
 /**********************
  *      MACROS
  **********************/
@@ -17,6 +17,7 @@
  *********************/
 #define CF_BUILT_IN_FIRST LV_IMG_CF_TRUE_COLOR
 #define CF_BUILT_IN_LAST LV_IMG_CF_ALPHA_8BIT
+#define FILE_POS_UNKNOWN UINT32_MAX
 
 /**********************
  *      TYPEDEFS
@@ -24,9 +25,10 @@
 typedef struct {
 #if LV_USE_FILESYSTEM
     lv_fs_file_t f;
+    uint32_t file_pos;      /*Position in the file to not seek if the rows are read one after the other*/
+    const uint8_t * map;    /*The content of the file if the driver has it in memory*/
 #endif
-    lv_color_t * palette;
-    lv_opa_t * opa;
+    uint8_t * palette;      /*Pixels with alpha byte for each index of an indexed or alpha image*/
 } lv_img_decoder_built_in_data_t;
 
 /**********************
@@ -38,6 +40,20 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
                                                    lv_coord_t len, uint8_t * buf);
 static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                      lv_coord_t len, uint8_t * buf);
+#if LV_IMG_CF_INDEXED || LV_IMG_CF_ALPHA
+static lv_img_decoder_built_in_data_t * alloc_palette(lv_img_decoder_dsc_t * dsc, uint32_t palette_size);
+static void set_palette_px(lv_img_decoder_built_in_data_t * user_data, uint32_t id, lv_color_t color, lv_opa_t opa);
+static const uint8_t * get_row_data(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                    uint32_t palette_size, uint8_t ** fs_buf);
+LV_ATTRIBUTE_FAST_MEM static void expand_row(const uint8_t * data, lv_coord_t x, lv_coord_t len, uint8_t bpp,
+                                             const uint8_t * palette, uint8_t * buf);
+LV_ATTRIBUTE_FAST_MEM static inline void expand_row_bpp(const uint8_t * data, lv_coord_t x, lv_coord_t len,
+                                                        const uint8_t bpp, const uint8_t * palette, uint8_t * buf);
+LV_ATTRIBUTE_FAST_MEM static inline void copy_px(uint8_t * dest, const uint8_t * src);
+#endif
+#if LV_USE_FILESYSTEM
+static lv_res_t read_file(lv_img_decoder_dsc_t * dsc, uint32_t pos, void * buf, uint32_t btr);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -352,6 +368,16 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 
         lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
         _lv_memcpy_small(&user_data->f, &f, sizeof(f));
+        user_data->file_pos = 0;
+
+        /*Use the pixels in place if the driver has the file in memory*/
+        const void * map;
+        uint32_t map_size;
+        user_data->map = NULL;
+        if(lv_fs_get_direct(&user_data->f, &map, &map_size) == LV_FS_RES_OK &&
+           map_size >= sizeof(lv_img_header_t) + lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf)) {
+            user_data->map = map;
+        }
 #else
         LV_LOG_WARN("Image built-in decoder cannot read file because LV_USE_FILESYSTEM = 0");
         return LV_RES_INV;
@@ -374,7 +400,11 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             return LV_RES_OK;
         }
         else {
-            /*If it's a file it need to be read line by line later*/
+#if LV_USE_FILESYSTEM
+            /*Memory mapped files can be used as variables, else it need to be read line by line later*/
+            lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+            if(user_data->map) dsc->img_data = user_data->map + sizeof(lv_img_header_t);
+#endif
             return LV_RES_OK;
         }
     }
@@ -385,38 +415,39 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
         uint8_t px_size       = lv_img_cf_get_px_size(cf);
         uint32_t palette_size = 1 << px_size;
 
-        /*Allocate the palette*/
-        if(dsc->user_data == NULL) {
-            dsc->user_data = lv_mem_alloc(sizeof(lv_img_decoder_built_in_data_t));
-            LV_ASSERT_MEM(dsc->user_data);
-            if(dsc->user_data == NULL) {
-                LV_LOG_ERROR("img_decoder_built_in_open: out of memory");
-                return LV_RES_INV;
-            }
-            _lv_memset_00(dsc->user_data, sizeof(lv_img_decoder_built_in_data_t));
-        }
-
-        lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
-        user_data->palette                         = lv_mem_alloc(palette_size * sizeof(lv_color_t));
-        LV_ASSERT_MEM(user_data->palette);
-        user_data->opa                             = lv_mem_alloc(palette_size * sizeof(lv_opa_t));
-        LV_ASSERT_MEM(user_data->opa);
-        if(user_data->palette == NULL || user_data->opa == NULL) {
-            LV_LOG_ERROR("img_decoder_built_in_open: out of memory");
+        lv_img_decoder_built_in_data_t * user_data = alloc_palette(dsc, palette_size);
+        if(user_data == NULL) {
             lv_img_decoder_built_in_close(decoder, dsc);
             return LV_RES_INV;
         }
 
-        if(dsc->src_type == LV_IMG_SRC_FILE) {
+        /*The palette begins in the beginning of the image data.*/
+        const lv_color32_t * palette_p = NULL;
+        if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
+            palette_p = (const lv_color32_t *)((lv_img_dsc_t *)dsc->src)->data;
+        }
+#if LV_USE_FILESYSTEM
+        else if(user_data->map) {
+            palette_p = (const lv_color32_t *)(user_data->map + sizeof(lv_img_header_t));
+        }
+#endif
+
+        /*Store the colors with their alpha as ready to copy pixels*/
+        uint32_t i;
+        if(palette_p == NULL) {
             /*Read the palette from file*/
 #if LV_USE_FILESYSTEM
-            lv_fs_seek(&user_data->f, 4); /*Skip the header*/
             lv_color32_t cur_color;
-            uint32_t i;
+            uint32_t pos = 4; /*Skip the header*/
             for(i = 0; i < palette_size; i++) {
-                lv_fs_read(&user_data->f, &cur_color, sizeof(lv_color32_t), NULL);
-                user_data->palette[i] = lv_color_make(cur_color.ch.red, cur_color.ch.green, cur_color.ch.blue);
-                user_data->opa[i]     = cur_color.ch.alpha;
+                if(read_file(dsc, pos, &cur_color, sizeof(lv_color32_t)) != LV_RES_OK) {
+                    LV_LOG_WARN("Built-in image decoder can't read the palette");
+                    lv_img_decoder_built_in_close(decoder, dsc);
+                    return LV_RES_INV;
+                }
+                set_palette_px(user_data, i, lv_color_make(cur_color.ch.red, cur_color.ch.green, cur_color.ch.blue),
+                               cur_color.ch.alpha);
+                pos += sizeof(lv_color32_t);
             }
 #else
             LV_LOG_WARN("Image built-in decoder can read the palette because LV_USE_FILESYSTEM = 0");
@@ -424,13 +455,9 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 #endif
         }
         else {
-            /*The palette begins in the beginning of the image data. Just point to it.*/
-            lv_color32_t * palette_p = (lv_color32_t *)((lv_img_dsc_t *)dsc->src)->data;
-
-            uint32_t i;
             for(i = 0; i < palette_size; i++) {
-                user_data->palette[i] = lv_color_make(palette_p[i].ch.red, palette_p[i].ch.green, palette_p[i].ch.blue);
-                user_data->opa[i]     = palette_p[i].ch.alpha;
+                set_palette_px(user_data, i, lv_color_make(palette_p[i].ch.red, palette_p[i].ch.green, palette_p[i].ch.blue),
+                               palette_p[i].ch.alpha);
             }
         }
 
@@ -445,7 +472,25 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
     else if(cf == LV_IMG_CF_ALPHA_1BIT || cf == LV_IMG_CF_ALPHA_2BIT || cf == LV_IMG_CF_ALPHA_4BIT ||
             cf == LV_IMG_CF_ALPHA_8BIT) {
 #if LV_IMG_CF_ALPHA
-        return LV_RES_OK; /*Nothing to process*/
+        /*Build a palette from the color with every opacity. 8 bit alpha is simply copied.*/
+        if(cf == LV_IMG_CF_ALPHA_8BIT) return LV_RES_OK;
+
+        uint8_t px_size       = lv_img_cf_get_px_size(cf);
+        uint32_t palette_size = 1 << px_size;
+
+        lv_img_decoder_built_in_data_t * user_data = alloc_palette(dsc, palette_size);
+        if(user_data == NULL) {
+            lv_img_decoder_built_in_close(decoder, dsc);
+            return LV_RES_INV;
+        }
+
+        /*E.g. with 2 bit the opacities are 0, 85, 170, 255*/
+        uint32_t i;
+        for(i = 0; i < palette_size; i++) {
+            set_palette_px(user_data, i, dsc->color, (i * LV_OPA_COVER) / (palette_size - 1));
+        }
+
+        return LV_RES_OK;
 #else
         LV_LOG_WARN("Alpha indexed images are not enabled in lv_conf.h. See LV_IMG_CF_ALPHA");
         lv_img_decoder_built_in_close(decoder, dsc);
@@ -520,7 +565,6 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
             lv_fs_close(&user_data->f);
 #endif
         if(user_data->palette) lv_mem_free(user_data->palette);
-        if(user_data->opa) lv_mem_free(user_data->opa);
 
         lv_mem_free(user_data);
         dsc->user_data = NULL;
@@ -535,21 +579,11 @@ static lv_res_t lv_img_decoder_built_in_line_true_color(lv_img_decoder_dsc_t * d
                                                         lv_coord_t len, uint8_t * buf)
 {
 #if LV_USE_FILESYSTEM
-    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
-    lv_fs_res_t res;
     uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf);
 
     uint32_t pos = ((y * dsc->header.w + x) * px_size) >> 3;
     pos += 4; /*Skip the header*/
-    res = lv_fs_seek(&user_data->f, pos);
-    if(res != LV_FS_RES_OK) {
-        LV_LOG_WARN("Built-in image decoder seek failed");
-        return LV_RES_INV;
-    }
-    uint32_t btr = len * (px_size >> 3);
-    uint32_t br  = 0;
-    res = lv_fs_read(&user_data->f, buf, btr, &br);
-    if(res != LV_FS_RES_OK || btr != br) {
+    if(read_file(dsc, pos, buf, len * (px_size >> 3)) != LV_RES_OK) {
         LV_LOG_WARN("Built-in image decoder read failed");
         return LV_RES_INV;
     }
@@ -570,103 +604,36 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
                                                    lv_coord_t len, uint8_t * buf)
 {
 #if LV_IMG_CF_ALPHA
-    const lv_opa_t alpha1_opa_table[2]  = {0, 255};          /*Opacity mapping with bpp = 1 (Just for compatibility)*/
-    const lv_opa_t alpha2_opa_table[4]  = {0, 85, 170, 255}; /*Opacity mapping with bpp = 2*/
-    const lv_opa_t alpha4_opa_table[16] = {0,  17, 34,  51,  /*Opacity mapping with bpp = 4*/
-                                           68, 85, 102, 119, 136, 153, 170, 187, 204, 221, 238, 255
-                                          };
-
-    /*Simply fill the buffer with the color. Later only the alpha value will be modified.*/
-    lv_color_t bg_color = dsc->color;
-    lv_coord_t i;
-    for(i = 0; i < len; i++) {
-#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE] = bg_color.full;
-#elif LV_COLOR_DEPTH == 16
-        /*Because of Alpha byte 16 bit color can start on odd address which can cause crash*/
-        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE] = bg_color.full & 0xFF;
-        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + 1] = (bg_color.full >> 8) & 0xFF;
-#elif LV_COLOR_DEPTH == 32
-        *((uint32_t *)&buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE]) = bg_color.full;
-#else
-#error "Invalid LV_COLOR_DEPTH. Check it in lv_conf.h"
-#endif
-    }
-
-    const lv_opa_t * opa_table = NULL;
-    uint8_t px_size            = lv_img_cf_get_px_size(dsc->header.cf);
-    uint16_t mask              = (1 << px_size) - 1; /*E.g. px_size = 2; mask = 0x03*/
-
-    lv_coord_t w = 0;
-    uint32_t ofs = 0;
-    int8_t pos   = 0;
-    switch(dsc->header.cf) {
-        case LV_IMG_CF_ALPHA_1BIT:
-            w = (dsc->header.w + 7) >> 3; /*E.g. w = 20 -> w = 2 + 1*/
-            ofs += w * y + (x >> 3); /*First pixel*/
-            pos = 7 - (x & 0x7);
-            opa_table = alpha1_opa_table;
-            break;
-        case LV_IMG_CF_ALPHA_2BIT:
-            w = (dsc->header.w + 3) >> 2; /*E.g. w = 13 -> w = 3 + 1 (bytes)*/
-            ofs += w * y + (x >> 2); /*First pixel*/
-            pos = 6 - (x & 0x3) * 2;
-            opa_table = alpha2_opa_table;
-            break;
-        case LV_IMG_CF_ALPHA_4BIT:
-            w = (dsc->header.w + 1) >> 1; /*E.g. w = 13 -> w = 6 + 1 (bytes)*/
-            ofs += w * y + (x >> 1); /*First pixel*/
-            pos = 4 - (x & 0x1) * 4;
-            opa_table = alpha4_opa_table;
-            break;
-        case LV_IMG_CF_ALPHA_8BIT:
-            w = dsc->header.w; /*E.g. x = 7 -> w = 7 (bytes)*/
-            ofs += w * y + x;  /*First pixel*/
-            pos = 0;
-            break;
-    }
+    uint8_t * fs_buf = NULL;
+    const uint8_t * data = get_row_data(dsc, x, y, len, 0, &fs_buf);
+    if(data == NULL) return LV_RES_INV;
 
-#if LV_USE_FILESYSTEM
+    uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf);
     lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
-    uint8_t * fs_buf = _lv_mem_buf_get(w);
-    if(fs_buf == NULL) return LV_RES_INV;
-#endif
-
-    const uint8_t * data_tmp = NULL;
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        const lv_img_dsc_t * img_dsc = dsc->src;
-
-        data_tmp = img_dsc->data + ofs;
+    if(px_size == 8) {
+        /*Copy the color and use the values as opacity*/
+        uint8_t px[LV_IMG_PX_SIZE_ALPHA_BYTE];
+        _lv_memcpy_small(px, &dsc->color, sizeof(lv_color_t));
+        px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = LV_OPA_TRANSP;
+        lv_coord_t i;
+        for(i = 0; i < len; i++) {
+            copy_px(buf, px);
+            buf[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = data[i];
+            buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
     }
     else {
-#if LV_USE_FILESYSTEM
-        lv_fs_seek(&user_data->f, ofs + 4); /*+4 to skip the header*/
-        lv_fs_read(&user_data->f, fs_buf, w, NULL);
-        data_tmp = fs_buf;
-#else
-        LV_LOG_WARN("Image built-in alpha line reader can't read file because LV_USE_FILESYSTEM = 0");
-        data_tmp = NULL; /*To avoid warnings*/
-        return LV_RES_INV;
-#endif
+        expand_row(data, x, len, px_size, user_data->palette, buf);
     }
 
-    for(i = 0; i < len; i++) {
-        uint8_t val_act = (*data_tmp >> pos) & mask;
-
-        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] =
-            dsc->header.cf == LV_IMG_CF_ALPHA_8BIT ? val_act : opa_table[val_act];
-
-        pos -= px_size;
-        if(pos < 0) {
-            pos = 8 - px_size;
-            data_tmp++;
-        }
-    }
-#if LV_USE_FILESYSTEM
-    _lv_mem_buf_release(fs_buf);
-#endif
+    if(fs_buf) _lv_mem_buf_release(fs_buf);
     return LV_RES_OK;
 #else
+    LV_UNUSED(dsc);
+    LV_UNUSED(x);
+    LV_UNUSED(y);
+    LV_UNUSED(len);
+    LV_UNUSED(buf);
     LV_LOG_WARN("Image built-in alpha line reader failed because LV_IMG_CF_ALPHA is 0 in lv_conf.h");
     return LV_RES_INV;
 #endif
@@ -677,91 +644,246 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
 {
 #if LV_IMG_CF_INDEXED
     uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf);
-    uint16_t mask   = (1 << px_size) - 1; /*E.g. px_size = 2; mask = 0x03*/
-
-    lv_coord_t w = 0;
-    int8_t pos   = 0;
-    uint32_t ofs = 0;
-    switch(dsc->header.cf) {
-        case LV_IMG_CF_INDEXED_1BIT:
-            w = (dsc->header.w + 7) >> 3; /*E.g. w = 20 -> w = 2 + 1*/
-            ofs += w * y + (x >> 3); /*First pixel*/
-            ofs += 8;                /*Skip the palette*/
-            pos = 7 - (x & 0x7);
-            break;
-        case LV_IMG_CF_INDEXED_2BIT:
-            w = (dsc->header.w + 3) >> 2; /*E.g. w = 13 -> w = 3 + 1 (bytes)*/
-            ofs += w * y + (x >> 2); /*First pixel*/
-            ofs += 16;               /*Skip the palette*/
-            pos = 6 - (x & 0x3) * 2;
-            break;
-        case LV_IMG_CF_INDEXED_4BIT:
-            w = (dsc->header.w + 1) >> 1; /*E.g. w = 13 -> w = 6 + 1 (bytes)*/
-            ofs += w * y + (x >> 1); /*First pixel*/
-            ofs += 64;               /*Skip the palette*/
-            pos = 4 - (x & 0x1) * 4;
-            break;
-        case LV_IMG_CF_INDEXED_8BIT:
-            w = dsc->header.w; /*E.g. x = 7 -> w = 7 (bytes)*/
-            ofs += w * y + x;  /*First pixel*/
-            ofs += 1024;       /*Skip the palette*/
-            pos = 0;
-            break;
-    }
+
+    uint8_t * fs_buf = NULL;
+    const uint8_t * data = get_row_data(dsc, x, y, len, (1 << px_size) * sizeof(lv_color32_t), &fs_buf);
+    if(data == NULL) return LV_RES_INV;
 
     lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    expand_row(data, x, len, px_size, user_data->palette, buf);
 
-#if LV_USE_FILESYSTEM
-    uint8_t * fs_buf = _lv_mem_buf_get(w);
-    if(fs_buf == NULL) return LV_RES_INV;
+    if(fs_buf) _lv_mem_buf_release(fs_buf);
+    return LV_RES_OK;
+#else
+    LV_UNUSED(dsc);
+    LV_UNUSED(x);
+    LV_UNUSED(y);
+    LV_UNUSED(len);
+    LV_UNUSED(buf);
+    LV_LOG_WARN("Image built-in indexed line reader failed because LV_IMG_CF_INDEXED is 0 in lv_conf.h");
+    return LV_RES_INV;
 #endif
-    const uint8_t * data_tmp = NULL;
+}
+
+#if LV_IMG_CF_INDEXED || LV_IMG_CF_ALPHA
+/**
+ * Allocate the palette of an indexed or alpha image in the user data of the decoder
+ * @param dsc pointer to decoder descriptor
+ * @param palette_size number of colors in the palette
+ * @return the user data or `NULL` if out of memory
+ */
+static lv_img_decoder_built_in_data_t * alloc_palette(lv_img_decoder_dsc_t * dsc, uint32_t palette_size)
+{
+    if(dsc->user_data == NULL) {
+        dsc->user_data = lv_mem_alloc(sizeof(lv_img_decoder_built_in_data_t));
+        LV_ASSERT_MEM(dsc->user_data);
+        if(dsc->user_data == NULL) {
+            LV_LOG_ERROR("img_decoder_built_in_open: out of memory");
+            return NULL;
+        }
+        _lv_memset_00(dsc->user_data, sizeof(lv_img_decoder_built_in_data_t));
+    }
+
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    user_data->palette = lv_mem_alloc(palette_size * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    LV_ASSERT_MEM(user_data->palette);
+    if(user_data->palette == NULL) {
+        LV_LOG_ERROR("img_decoder_built_in_open: out of memory");
+        return NULL;
+    }
+
+    return user_data;
+}
+
+/**
+ * Set a color of a palette
+ * @param user_data the user data of the decoder with an allocated palette
+ * @param id index of the color
+ * @param color the color
+ * @param opa the opacity of the color
+ */
+static void set_palette_px(lv_img_decoder_built_in_data_t * user_data, uint32_t id, lv_color_t color, lv_opa_t opa)
+{
+    uint8_t * px = &user_data->palette[id * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    _lv_memcpy_small(px, &color, sizeof(lv_color_t));
+    px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = opa;
+}
+
+/**
+ * Get the bytes of an indexed or alpha image which store some pixels of a row
+ * @param dsc pointer to decoder descriptor
+ * @param x the first pixel
+ * @param y the row
+ * @param len number of pixels
+ * @param palette_size size of the palette before the pixels in bytes
+ * @param fs_buf if the image is a file a buffer is allocated for the bytes. Release it when not needed.
+ * @return pointer to the byte of the first pixel or `NULL` on error
+ */
+static const uint8_t * get_row_data(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                    uint32_t palette_size, uint8_t ** fs_buf)
+{
+    uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf);
+    uint32_t stride = ((uint32_t)dsc->header.w * px_size + 7) >> 3;
+    uint32_t ofs = palette_size + stride * y + (((uint32_t)x * px_size) >> 3);
+
     if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
         const lv_img_dsc_t * img_dsc = dsc->src;
-        data_tmp                     = img_dsc->data + ofs;
+        return img_dsc->data + ofs;
     }
-    else {
+
 #if LV_USE_FILESYSTEM
-        lv_fs_seek(&user_data->f, ofs + 4); /*+4 to skip the header*/
-        lv_fs_read(&user_data->f, fs_buf, w, NULL);
-        data_tmp = fs_buf;
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    if(user_data->map) return user_data->map + sizeof(lv_img_header_t) + ofs;
+
+    /*Read only the bytes of the required pixels*/
+    uint32_t btr = ((((uint32_t)x * px_size) & 0x7) + (uint32_t)len * px_size + 7) >> 3;
+    *fs_buf = _lv_mem_buf_get(btr);
+    if(*fs_buf == NULL) return NULL;
+
+    if(read_file(dsc, ofs + 4, *fs_buf, btr) != LV_RES_OK) { /*+4 to skip the header*/
+        LV_LOG_WARN("Built-in image decoder read failed");
+        _lv_mem_buf_release(*fs_buf);
+        *fs_buf = NULL;
+        return NULL;
+    }
+    return *fs_buf;
 #else
-        LV_LOG_WARN("Image built-in indexed line reader can't read file because LV_USE_FILESYSTEM = 0");
-        data_tmp = NULL; /*To avoid warnings*/
-        return LV_RES_INV;
+    LV_UNUSED(len);
+    LV_UNUSED(fs_buf);
+    LV_LOG_WARN("Image built-in line reader can't read file because LV_USE_FILESYSTEM = 0");
+    return NULL;
 #endif
+}
+
+/**
+ * Convert the indices of a row to pixels with alpha byte by looking up them in a palette
+ * @param data the byte of the first index
+ * @param x x coordinate of the first pixel. Tells where the first index is in its byte.
+ * @param len number of pixels
+ * @param bpp bit per index: 1, 2, 4 or 8
+ * @param palette the colors of the indices as ready to copy pixels
+ * @param buf store the pixels here
+ */
+LV_ATTRIBUTE_FAST_MEM static void expand_row(const uint8_t * data, lv_coord_t x, lv_coord_t len, uint8_t bpp,
+                                             const uint8_t * palette, uint8_t * buf)
+{
+    /*Use a separate loop for each bit depth to have constant shifts*/
+    switch(bpp) {
+        case 1:
+            expand_row_bpp(data, x, len, 1, palette, buf);
+            break;
+        case 2:
+            expand_row_bpp(data, x, len, 2, palette, buf);
+            break;
+        case 4:
+            expand_row_bpp(data, x, len, 4, palette, buf);
+            break;
+        case 8:
+            expand_row_bpp(data, x, len, 8, palette, buf);
+            break;
+    }
+}
+
+/**
+ * Convert indices of a given bit depth to pixels. A whole byte of indices is processed in one step.
+ * @param data the byte of the first index
+ * @param x x coordinate of the first pixel. Tells where the first index is in its byte.
+ * @param len number of pixels
+ * @param bpp bit per index: 1, 2, 4 or 8
+ * @param palette the colors of the indices as ready to copy pixels
+ * @param buf store the pixels here
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void expand_row_bpp(const uint8_t * data, lv_coord_t x, lv_coord_t len,
+                                                        const uint8_t bpp, const uint8_t * palette, uint8_t * buf)
+{
+    const uint8_t mask = (1 << bpp) - 1;
+    const int32_t px_per_byte = 8 / bpp;
+    int32_t shift;
+
+    /*The first byte if the row doesn't start on its first index*/
+    int32_t skip = x & (px_per_byte - 1);
+    if(skip) {
+        uint8_t b = *data++;
+        for(shift = 8 - bpp * (skip + 1); shift >= 0 && len > 0; shift -= bpp) {
+            copy_px(buf, &palette[((b >> shift) & mask) * LV_IMG_PX_SIZE_ALPHA_BYTE]);
+            buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+            len--;
+        }
     }
 
-    lv_coord_t i;
-    for(i = 0; i < len; i++) {
-        uint8_t val_act = (*data_tmp >> pos) & mask;
+    /*Whole bytes*/
+    while(len >= px_per_byte) {
+        uint8_t b = *data++;
+        for(shift = 8 - bpp; shift >= 0; shift -= bpp) {
+            copy_px(buf, &palette[((b >> shift) & mask) * LV_IMG_PX_SIZE_ALPHA_BYTE]);
+            buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+        len -= px_per_byte;
+    }
 
-        lv_color_t color = user_data->palette[val_act];
+    /*The first indices of the last byte*/
+    if(len > 0) {
+        uint8_t b = *data;
+        for(shift = 8 - bpp; len > 0; shift -= bpp) {
+            copy_px(buf, &palette[((b >> shift) & mask) * LV_IMG_PX_SIZE_ALPHA_BYTE]);
+            buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+            len--;
+        }
+    }
+}
+
+/**
+ * Copy a pixel with alpha byte
+ * @param dest copy here
+ * @param src copy from here
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void copy_px(uint8_t * dest, const uint8_t * src)
+{
 #if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE] = color.full;
+    dest[0] = src[0];
+    dest[1] = src[1];
 #elif LV_COLOR_DEPTH == 16
-        /*Because of Alpha byte 16 bit color can start on odd address which can cause crash*/
-        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE] = color.full & 0xFF;
-        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + 1] = (color.full >> 8) & 0xFF;
+    /*Because of Alpha byte 16 bit color can start on odd address which can cause crash*/
+    dest[0] = src[0];
+    dest[1] = src[1];
+    dest[2] = src[2];
 #elif LV_COLOR_DEPTH == 32
-        *((uint32_t *)&buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE]) = color.full;
+    *((uint32_t *)dest) = *((const uint32_t *)src);
 #else
 #error "Invalid LV_COLOR_DEPTH. Check it in lv_conf.h"
 #endif
-        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = user_data->opa[val_act];
+}
+#endif
 
-        pos -= px_size;
-        if(pos < 0) {
-            pos = 8 - px_size;
-            data_tmp++;
+#if LV_USE_FILESYSTEM
+/**
+ * Read from the file of an image. Seek only if the position is not the end of the previous read.
+ * @param dsc pointer to decoder descriptor
+ * @param pos position in the file
+ * @param buf store the read bytes here
+ * @param btr bytes to read
+ * @return LV_RES_OK: all bytes are read; LV_RES_INV: error
+ */
+static lv_res_t read_file(lv_img_decoder_dsc_t * dsc, uint32_t pos, void * buf, uint32_t btr)
+{
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    lv_fs_res_t res;
+    if(user_data->file_pos != pos) {
+        res = lv_fs_seek(&user_data->f, pos);
+        if(res != LV_FS_RES_OK) {
+            user_data->file_pos = FILE_POS_UNKNOWN;
+            return LV_RES_INV;
         }
     }
-#if LV_USE_FILESYSTEM
-    _lv_mem_buf_release(fs_buf);
-#endif
+
+    uint32_t br = 0;
+    res = lv_fs_read(&user_data->f, buf, btr, &br);
+    if(res != LV_FS_RES_OK || br != btr) {
+        user_data->file_pos = FILE_POS_UNKNOWN;
+        return LV_RES_INV;
+    }
+
+    user_data->file_pos = pos + br;
     return LV_RES_OK;
-#else
-    LV_LOG_WARN("Image built-in indexed line reader failed because LV_IMG_CF_INDEXED is 0 in lv_conf.h");
-    return LV_RES_INV;
-#endif
 }
+#endif
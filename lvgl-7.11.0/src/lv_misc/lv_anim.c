@@ -16,6 +16,10 @@
 #include "lv_task.h"
 #include "lv_math.h"
 #include "lv_gc.h"
+#if LV_ANIM_FRAME_SYNC
+    #include "../lv_hal/lv_hal_disp.h"
+    #include "../lv_core/lv_refr.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -32,6 +36,7 @@
  *  STATIC PROTOTYPES
  **********************/
 static void anim_task(lv_task_t * param);
+static void anim_step(uint32_t elaps);
 static void anim_mark_list_change(void);
 static void anim_ready_handler(lv_anim_t * a);
 
@@ -41,7 +46,14 @@ static void anim_ready_handler(lv_anim_t * a);
 static uint32_t last_task_run;
 static bool anim_list_changed;
 static bool anim_run_round;
-static lv_task_t * _lv_anim_task;
+#if LV_ANIM_FRAME_SYNC == 0
+    static lv_task_t * _lv_anim_task;
+#else
+    static lv_anim_frame_stat_t frame_stat;
+    static uint32_t last_vsync_cnt;
+    static uint32_t vsync_time;
+    static uint32_t vsync_period;
+#endif
 const lv_anim_path_t lv_anim_path_def = {.cb = lv_anim_path_linear};
 
 /**********************
@@ -58,7 +70,9 @@ const lv_anim_path_t lv_anim_path_def = {.cb = lv_anim_path_linear};
 void _lv_anim_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
+#if LV_ANIM_FRAME_SYNC == 0
     _lv_anim_task = lv_task_create(anim_task, LV_DISP_DEF_REFR_PERIOD, LV_ANIM_TASK_PRIO, NULL);
+#endif
     anim_mark_list_change(); /*Turn off the animation task*/
     anim_list_changed = false; /*The list has not actually changed*/
 }
@@ -220,6 +234,83 @@ void lv_anim_refr_now(void)
     anim_task(NULL);
 }
 
+#if LV_ANIM_FRAME_SYNC
+/**
+ * Step all animations once for the current frame.
+ * Called by the refresh task of the default display right before the dirty areas are rendered.
+ * Shouldn't be used directly.
+ * @param period the expected time between two frames [ms]
+ * @return true: there are animations which require further frames
+ */
+bool _lv_anim_refr_frame(uint32_t period)
+{
+    uint32_t frame_time = lv_tick_get();
+
+    /*Use the time of the last vsync if there was one since the previous frame*/
+    if(frame_stat.vsync_cnt != last_vsync_cnt) {
+        last_vsync_cnt = frame_stat.vsync_cnt;
+        frame_time = vsync_time;
+        if(vsync_period != 0) period = vsync_period;
+    }
+
+    if(_lv_ll_is_empty(&LV_GC_ROOT(_lv_anim_ll))) {
+        last_task_run = frame_time;
+        return false;
+    }
+
+    /*The vsync might be older than the last frame sampled from the tick*/
+    if((int32_t)(frame_time - last_task_run) < 0) frame_time = last_task_run;
+
+    uint32_t elaps = frame_time - last_task_run;
+
+    frame_stat.frame_cnt++;
+    frame_stat.last_elaps = elaps;
+    if(elaps == 0) {
+        frame_stat.duplicated_cnt++;
+    }
+    else if(period != 0 && elaps >= period + period / 2) {
+        frame_stat.dropped_cnt += (elaps + period / 2) / period - 1;
+    }
+
+    if(elaps != 0) anim_step(elaps);
+    last_task_run = frame_time;
+
+    return _lv_ll_is_empty(&LV_GC_ROOT(_lv_anim_ll)) ? false : true;
+}
+
+/**
+ * Tell the animation clock that a vertical sync happened.
+ * If called (e.g. by the display driver after waiting for the vsync) the animations are advanced
+ * with the time between the vsyncs instead of the time between two runs of the refresh task.
+ */
+void lv_anim_frame_vsync(void)
+{
+    uint32_t t = lv_tick_get();
+    if(frame_stat.vsync_cnt != 0) vsync_period = t - vsync_time;
+    vsync_time = t;
+    frame_stat.vsync_cnt++;
+}
+
+/**
+ * Get the frame pacing statistics of the animations
+ * @param stat pointer to an `lv_anim_frame_stat_t` variable to fill
+ */
+void lv_anim_get_frame_stat(lv_anim_frame_stat_t * stat)
+{
+    _lv_memcpy_small(stat, &frame_stat, sizeof(lv_anim_frame_stat_t));
+}
+
+/**
+ * Clear the frame pacing statistics of the animations
+ */
+void lv_anim_reset_frame_stat(void)
+{
+    _lv_memset_00(&frame_stat, sizeof(lv_anim_frame_stat_t));
+    last_vsync_cnt = 0;
+    vsync_period = 0;
+}
+#endif
+
 /**
  * Calculate the current value of an animation applying linear characteristic
  * @param a pointer to an animation
@@ -418,8 +509,17 @@ static void anim_task(lv_task_t * param)
 {
     (void)param;
 
-    uint32_t elaps = lv_tick_elaps(last_task_run);
+    anim_step(lv_tick_elaps(last_task_run));
+
+    last_task_run = lv_tick_get();
+}
 
+/**
+ * Advance all the animations with the same amount of time.
+ * @param elaps the time elapsed since the previous step [ms]
+ */
+static void anim_step(uint32_t elaps)
+{
     /*Flip the run round*/
     anim_run_round = anim_run_round ? false : true;
 
@@ -468,8 +568,6 @@ static void anim_task(lv_task_t * param)
         else
             a = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
     }
-
-    last_task_run = lv_tick_get();
 }
 
 /**
@@ -524,9 +622,17 @@ static void anim_ready_handler(lv_anim_t * a)
 static void anim_mark_list_change(void)
 {
     anim_list_changed = true;
+#if LV_ANIM_FRAME_SYNC
+    /*Be sure a frame is refreshed to step the animations*/
+    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) != NULL) {
+        lv_disp_t * disp = lv_disp_get_default();
+        if(disp) lv_task_set_prio(disp->refr_task, LV_REFR_TASK_PRIO);
+    }
+#else
     if(_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL)
         lv_task_set_prio(_lv_anim_task, LV_TASK_PRIO_OFF);
     else
         lv_task_set_prio(_lv_anim_task, LV_ANIM_TASK_PRIO);
+#endif
 }
 #endif
@@ -98,6 +98,17 @@ typedef struct _lv_anim_t {
     uint32_t time_orig;
 } lv_anim_t;
 
+#if LV_ANIM_FRAME_SYNC
+/** Frame pacing statistics of the frame synchronized animation clock*/
+typedef struct {
+    uint32_t frame_cnt;      /**< Number of frames in which the animations were sampled*/
+    uint32_t dropped_cnt;    /**< Number of animation frames skipped because a frame took longer than the period*/
+    uint32_t duplicated_cnt; /**< Number of frames in which the animation clock didn't advance*/
+    uint32_t vsync_cnt;      /**< Number of vsyncs reported by `lv_anim_frame_vsync()`*/
+    uint32_t last_elaps;     /**< Time elapsed between the last two sampled frames [ms]*/
+} lv_anim_frame_stat_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -365,6 +376,35 @@ uint32_t lv_anim_speed_to_time(uint32_t speed, lv_anim_value_t start, lv_anim_va
  */
 void lv_anim_refr_now(void);
 
+#if LV_ANIM_FRAME_SYNC
+/**
+ * Step all animations once for the current frame.
+ * Called by the refresh task of the default display right before the dirty areas are rendered.
+ * Shouldn't be used directly.
+ * @param period the expected time between two frames [ms]
+ * @return true: there are animations which require further frames
+ */
+bool _lv_anim_refr_frame(uint32_t period);
+
+/**
+ * Tell the animation clock that a vertical sync happened.
+ * If called (e.g. by the display driver after waiting for the vsync) the animations are advanced
+ * with the time between the vsyncs instead of the time between two runs of the refresh task.
+ */
+void lv_anim_frame_vsync(void);
+
+/**
+ * Get the frame pacing statistics of the animations
+ * @param stat pointer to an `lv_anim_frame_stat_t` variable to fill
+ */
+void lv_anim_get_frame_stat(lv_anim_frame_stat_t * stat);
+
+/**
+ * Clear the frame pacing statistics of the animations
+ */
+void lv_anim_reset_frame_stat(void);
+#endif
+
 /**
  * Calculate the current value of an animation applying linear characteristic
  * @param a pointer to an animation
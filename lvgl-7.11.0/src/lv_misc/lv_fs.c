@@ -29,15 +29,39 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_FS_CACHE_BLOCK_CNT
+/*A block of a file in the cache*/
+typedef struct {
+    lv_fs_drv_t * drv;  /*The driver of the file. NULL: unused block*/
+    void * file_d;      /*The file of the block*/
+    uint32_t id;        /*Index of the block in the file*/
+    uint32_t len;       /*Number of valid bytes. Less than a block only at the end of the file*/
+    uint32_t life;      /*Time stamp of the last use to find the least recently used block*/
+    uint8_t buf[LV_FS_CACHE_BLOCK_SIZE];
+} lv_fs_cache_block_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static const char * lv_fs_get_real_path(const char * path);
+#if LV_FS_CACHE_BLOCK_CNT
+    static bool cache_used(const lv_fs_drv_t * drv);
+    static lv_fs_res_t cache_read(lv_fs_file_t * file_p, uint8_t * buf, uint32_t btr, uint32_t * br);
+    static lv_fs_cache_block_t * cache_find(lv_fs_file_t * file_p, uint32_t id);
+    static lv_fs_cache_block_t * cache_load(lv_fs_file_t * file_p, uint32_t id, lv_fs_res_t * res);
+    static void cache_invalidate(lv_fs_file_t * file_p, uint32_t first_id, uint32_t last_id);
+    static lv_fs_res_t drv_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br);
+    static lv_fs_res_t drv_seek(lv_fs_file_t * file_p, uint32_t pos);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_FS_CACHE_BLOCK_CNT
+    static lv_fs_cache_block_t cache_blocks[LV_FS_CACHE_BLOCK_CNT];
+    static uint32_t cache_life;
+#endif
 
 /**********************
  *      MACROS
@@ -83,6 +107,10 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
 {
     file_p->drv    = NULL;
     file_p->file_d = NULL;
+#if LV_FS_CACHE_BLOCK_CNT
+    file_p->pos     = 0;
+    file_p->drv_pos = 0;
+#endif
 
     if(path == NULL) return LV_FS_RES_INV_PARAM;
 
@@ -146,6 +174,10 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
         return LV_FS_RES_NOT_IMP;
     }
 
+#if LV_FS_CACHE_BLOCK_CNT
+    cache_invalidate(file_p, 0, UINT32_MAX);
+#endif
+
     lv_fs_res_t res = file_p->drv->close_cb(file_p->drv, file_p->file_d);
 
     lv_mem_free(file_p->file_d); /*Clean up*/
@@ -195,7 +227,13 @@ lv_fs_res_t lv_fs_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t
     if(file_p->drv->read_cb == NULL) return LV_FS_RES_NOT_IMP;
 
     uint32_t br_tmp = 0;
+#if LV_FS_CACHE_BLOCK_CNT
+    lv_fs_res_t res;
+    if(cache_used(file_p->drv)) res = cache_read(file_p, buf, btr, &br_tmp);
+    else res = drv_read(file_p, buf, btr, &br_tmp);
+#else
     lv_fs_res_t res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, &br_tmp);
+#endif
     if(br != NULL) *br = br_tmp;
 
     return res;
@@ -222,12 +260,56 @@ lv_fs_res_t lv_fs_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, u
     }
 
     uint32_t bw_tmp = 0;
+#if LV_FS_CACHE_BLOCK_CNT
+    if(cache_used(file_p->drv)) {
+        lv_fs_res_t res = drv_seek(file_p, file_p->pos);
+        if(res != LV_FS_RES_OK) return res;
+    }
+
     lv_fs_res_t res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
+    file_p->drv->stat.write_cnt++;
+    file_p->drv->stat.write_bytes += bw_tmp;
+
+    /*The cache is write-through, just drop the overwritten blocks*/
+    if(bw_tmp > 0) {
+        cache_invalidate(file_p, file_p->pos / LV_FS_CACHE_BLOCK_SIZE, (file_p->pos + bw_tmp - 1) / LV_FS_CACHE_BLOCK_SIZE);
+    }
+    file_p->pos += bw_tmp;
+    file_p->drv_pos = file_p->pos;
+#else
+    lv_fs_res_t res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
+#endif
     if(bw != NULL) *bw = bw_tmp;
 
     return res;
 }
 
+/**
+ * Get the content of a file in place, without reading it into a buffer.
+ * Only the drivers which hold the files in memory (e.g. memory mapped files) support it.
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param data store the pointer to the first byte of the file here. It's valid until the file is closed.
+ * @param size store the size of the file here
+ * @return LV_FS_RES_OK or LV_FS_RES_NOT_IMP if the driver can't give the content in place
+ */
+lv_fs_res_t lv_fs_get_direct(lv_fs_file_t * file_p, const void ** data, uint32_t * size)
+{
+    *data = NULL;
+    *size = 0;
+
+    if(file_p->drv == NULL) {
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    if(file_p->drv->direct_cb == NULL) {
+        return LV_FS_RES_NOT_IMP;
+    }
+
+    lv_fs_res_t res = file_p->drv->direct_cb(file_p->drv, file_p->file_d, data, size);
+
+    return res;
+}
+
 /**
  * Set the position of the 'cursor' (read write pointer) in a file
  * @param file_p pointer to a lv_fs_file_t variable
@@ -244,6 +326,14 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos)
         return LV_FS_RES_NOT_IMP;
     }
 
+#if LV_FS_CACHE_BLOCK_CNT
+    /*Move the driver's pointer only when it's really read or written*/
+    if(cache_used(file_p->drv)) {
+        file_p->pos = pos;
+        return LV_FS_RES_OK;
+    }
+#endif
+
     lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos);
 
     return res;
@@ -262,6 +352,13 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
         return LV_FS_RES_INV_PARAM;
     }
 
+#if LV_FS_CACHE_BLOCK_CNT
+    if(cache_used(file_p->drv)) {
+        *pos = file_p->pos;
+        return LV_FS_RES_OK;
+    }
+#endif
+
     if(file_p->drv->tell_cb == NULL) {
         *pos = 0;
         return LV_FS_RES_NOT_IMP;
@@ -288,6 +385,14 @@ lv_fs_res_t lv_fs_trunc(lv_fs_file_t * file_p)
         return LV_FS_RES_NOT_IMP;
     }
 
+#if LV_FS_CACHE_BLOCK_CNT
+    if(cache_used(file_p->drv)) {
+        lv_fs_res_t res = drv_seek(file_p, file_p->pos);
+        if(res != LV_FS_RES_OK) return res;
+    }
+    cache_invalidate(file_p, file_p->pos / LV_FS_CACHE_BLOCK_SIZE, UINT32_MAX);
+#endif
+
     lv_fs_res_t res = file_p->drv->trunc_cb(file_p->drv, file_p->file_d);
 
     return res;
@@ -488,6 +593,36 @@ lv_fs_res_t lv_fs_free_space(char letter, uint32_t * total_p, uint32_t * free_p)
     return res;
 }
 
+#if LV_FS_CACHE_BLOCK_CNT
+/**
+ * Get the I/O statistics of a driver
+ * @param letter the driver letter
+ * @param stat pointer to store the statistics
+ * @return LV_FS_RES_OK or LV_FS_RES_NOT_EX if there is no such driver
+ */
+lv_fs_res_t lv_fs_get_stat(char letter, lv_fs_stat_t * stat)
+{
+    lv_fs_drv_t * drv = lv_fs_get_drv(letter);
+    if(drv == NULL) {
+        _lv_memset_00(stat, sizeof(lv_fs_stat_t));
+        return LV_FS_RES_NOT_EX;
+    }
+
+    *stat = drv->stat;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Clear the I/O statistics of a driver
+ * @param letter the driver letter
+ */
+void lv_fs_reset_stat(char letter)
+{
+    lv_fs_drv_t * drv = lv_fs_get_drv(letter);
+    if(drv) _lv_memset_00(&drv->stat, sizeof(lv_fs_stat_t));
+}
+#endif
+
 /**
  * Initialize a file system driver with default values.
  * It is used to surly have known values in the fields ant not memory junk.
@@ -661,4 +796,184 @@ static const char * lv_fs_get_real_path(const char * path)
     return path;
 }
 
+#if LV_FS_CACHE_BLOCK_CNT
+/**
+ * Tell whether the files of a driver are read through the cache.
+ * The cache needs `seek_cb` to read the blocks and it's not worth to copy memory mapped files.
+ * @param drv pointer to a driver
+ * @return true: use the cache
+ */
+static bool cache_used(const lv_fs_drv_t * drv)
+{
+    return drv->seek_cb != NULL && drv->direct_cb == NULL;
+}
+
+/**
+ * Read from a file through the block cache.
+ * Whole blocks are read directly into `buf`, the rest is copied from the cached blocks.
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param buf pointer to a buffer where the read bytes are stored
+ * @param btr Bytes To Read
+ * @param br store the number of real read bytes here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t cache_read(lv_fs_file_t * file_p, uint8_t * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_res_t res = LV_FS_RES_OK;
+    while(btr > 0) {
+        uint32_t id = file_p->pos / LV_FS_CACHE_BLOCK_SIZE;
+        uint32_t ofs = file_p->pos % LV_FS_CACHE_BLOCK_SIZE;
+        lv_fs_cache_block_t * block = cache_find(file_p, id);
+        if(block) {
+            file_p->drv->stat.hit_cnt++;
+        }
+        /*Don't pollute the cache with large reads*/
+        else if(ofs == 0 && btr >= LV_FS_CACHE_BLOCK_SIZE) {
+            uint32_t n = btr - btr % LV_FS_CACHE_BLOCK_SIZE;
+            uint32_t rn = 0;
+            res = drv_seek(file_p, file_p->pos);
+            if(res == LV_FS_RES_OK) res = drv_read(file_p, buf, n, &rn);
+            file_p->pos += rn;
+            *br += rn;
+            buf += rn;
+            btr -= rn;
+            if(res != LV_FS_RES_OK || rn < n) break;
+            continue;
+        }
+        else {
+            block = cache_load(file_p, id, &res);
+            if(block == NULL) break;
+        }
+
+        if(ofs >= block->len) break;    /*End of the file*/
+
+        uint32_t n = LV_MATH_MIN(block->len - ofs, btr);
+        _lv_memcpy(buf, &block->buf[ofs], n);
+        file_p->pos += n;
+        *br += n;
+        buf += n;
+        btr -= n;
+
+        /*A partial block is the end of the file*/
+        if(block->len < LV_FS_CACHE_BLOCK_SIZE) break;
+    }
+
+    /*Report the error only if nothing was read, else it's a short read like at the end of the file*/
+    if(*br > 0) res = LV_FS_RES_OK;
+
+    return res;
+}
+
+/**
+ * Find a block of a file in the cache
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param id index of the block in the file
+ * @return pointer to the block or NULL if it's not cached
+ */
+static lv_fs_cache_block_t * cache_find(lv_fs_file_t * file_p, uint32_t id)
+{
+    uint32_t i;
+    for(i = 0; i < LV_FS_CACHE_BLOCK_CNT; i++) {
+        lv_fs_cache_block_t * block = &cache_blocks[i];
+        if(block->id == id && block->file_d == file_p->file_d && block->drv == file_p->drv) {
+            cache_life++;
+            block->life = cache_life;
+            return block;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Read a block of a file into the place of the least recently used block
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param id index of the block in the file
+ * @param res store the result of the driver here
+ * @return pointer to the block or NULL on error or at the end of the file
+ */
+static lv_fs_cache_block_t * cache_load(lv_fs_file_t * file_p, uint32_t id, lv_fs_res_t * res)
+{
+    lv_fs_cache_block_t * block = &cache_blocks[0];
+    uint32_t i;
+    for(i = 1; i < LV_FS_CACHE_BLOCK_CNT; i++) {
+        if(cache_blocks[i].life < block->life) block = &cache_blocks[i];
+    }
+
+    file_p->drv->stat.miss_cnt++;
+
+    /*Invalid until it's read*/
+    block->drv = NULL;
+    block->life = 0;
+    block->len = 0;
+
+    *res = drv_seek(file_p, id * LV_FS_CACHE_BLOCK_SIZE);
+    if(*res == LV_FS_RES_OK) *res = drv_read(file_p, block->buf, LV_FS_CACHE_BLOCK_SIZE, &block->len);
+    if(*res != LV_FS_RES_OK || block->len == 0) return NULL;
+
+    block->drv = file_p->drv;
+    block->file_d = file_p->file_d;
+    block->id = id;
+    cache_life++;
+    block->life = cache_life;
+
+    return block;
+}
+
+/**
+ * Drop the cached blocks of a file
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param first_id index of the first block to drop
+ * @param last_id index of the last block to drop
+ */
+static void cache_invalidate(lv_fs_file_t * file_p, uint32_t first_id, uint32_t last_id)
+{
+    uint32_t i;
+    for(i = 0; i < LV_FS_CACHE_BLOCK_CNT; i++) {
+        lv_fs_cache_block_t * block = &cache_blocks[i];
+        if(block->file_d == file_p->file_d && block->drv == file_p->drv &&
+           block->id >= first_id && block->id <= last_id) {
+            block->drv = NULL;
+            block->life = 0;
+        }
+    }
+}
+
+/**
+ * Read with the driver and update its statistics
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param buf pointer to a buffer where the read bytes are stored
+ * @param btr Bytes To Read
+ * @param br store the number of real read bytes here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t drv_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_res_t res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, br);
+    file_p->drv->stat.read_cnt++;
+    file_p->drv->stat.read_bytes += *br;
+    file_p->drv_pos += *br;
+
+    return res;
+}
+
+/**
+ * Move the driver's read write pointer if it's not there yet
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param pos the new position
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t drv_seek(lv_fs_file_t * file_p, uint32_t pos)
+{
+    if(file_p->drv_pos == pos) return LV_FS_RES_OK;
+
+    lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos);
+    file_p->drv->stat.seek_cnt++;
+    if(res == LV_FS_RES_OK) file_p->drv_pos = pos;
+    else file_p->drv_pos = UINT32_MAX;  /*Unknown*/
+
+    return res;
+}
+#endif
+
 #endif /*LV_USE_FILESYSTEM*/
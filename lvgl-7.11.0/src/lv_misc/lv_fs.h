@@ -60,6 +60,23 @@ enum {
 };
 typedef uint8_t lv_fs_mode_t;
 
+#if LV_FS_CACHE_BLOCK_CNT
+/**
+ * I/O statistics of a driver.
+ * The counters and the block cache are shared by all the files without locking,
+ * so with `LV_FS_CACHE_BLOCK_CNT` the `lv_fs` functions must be called only from the LVGL thread.
+ */
+typedef struct {
+    uint32_t read_cnt;      /*Number of `read_cb` calls*/
+    uint32_t read_bytes;    /*Bytes read by `read_cb`*/
+    uint32_t write_cnt;     /*Number of `write_cb` calls*/
+    uint32_t write_bytes;   /*Bytes written by `write_cb`*/
+    uint32_t seek_cnt;      /*Number of `seek_cb` calls*/
+    uint32_t hit_cnt;       /*Reads served by a cached block*/
+    uint32_t miss_cnt;      /*Blocks read from the driver into the cache*/
+} lv_fs_stat_t;
+#endif
+
 typedef struct _lv_fs_drv_t {
     char letter;
     uint16_t file_size;
@@ -78,6 +95,9 @@ typedef struct _lv_fs_drv_t {
     lv_fs_res_t (*rename_cb)(struct _lv_fs_drv_t * drv, const char * oldname, const char * newname);
     lv_fs_res_t (*free_space_cb)(struct _lv_fs_drv_t * drv, uint32_t * total_p, uint32_t * free_p);
 
+    /*Optional: give a pointer to the content of the file if the driver has it in memory*/
+    lv_fs_res_t (*direct_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void ** data_p, uint32_t * size_p);
+
     lv_fs_res_t (*dir_open_cb)(struct _lv_fs_drv_t * drv, void * rddir_p, const char * path);
     lv_fs_res_t (*dir_read_cb)(struct _lv_fs_drv_t * drv, void * rddir_p, char * fn);
     lv_fs_res_t (*dir_close_cb)(struct _lv_fs_drv_t * drv, void * rddir_p);
@@ -85,11 +105,19 @@ typedef struct _lv_fs_drv_t {
 #if LV_USE_USER_DATA
     lv_fs_drv_user_data_t user_data; /**< Custom file user data */
 #endif
+
+#if LV_FS_CACHE_BLOCK_CNT
+    lv_fs_stat_t stat;
+#endif
 } lv_fs_drv_t;
 
 typedef struct {
     void * file_d;
     lv_fs_drv_t * drv;
+#if LV_FS_CACHE_BLOCK_CNT
+    uint32_t pos;       /*Position of the read write pointer*/
+    uint32_t drv_pos;   /*Position of the driver's read write pointer*/
+#endif
 } lv_fs_file_t;
 
 typedef struct {
@@ -179,6 +207,16 @@ lv_fs_res_t lv_fs_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t
  */
 lv_fs_res_t lv_fs_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, uint32_t * bw);
 
+/**
+ * Get the content of a file in place, without reading it into a buffer.
+ * Only the drivers which hold the files in memory (e.g. memory mapped files) support it.
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param data store the pointer to the first byte of the file here. It's valid until the file is closed.
+ * @param size store the size of the file here
+ * @return LV_FS_RES_OK or LV_FS_RES_NOT_IMP if the driver can't give the content in place
+ */
+lv_fs_res_t lv_fs_get_direct(lv_fs_file_t * file_p, const void ** data, uint32_t * size);
+
 /**
  * Set the position of the 'cursor' (read write pointer) in a file
  * @param file_p pointer to a lv_fs_file_t variable
@@ -252,6 +290,22 @@ lv_fs_res_t lv_fs_dir_close(lv_fs_dir_t * rddir_p);
  */
 lv_fs_res_t lv_fs_free_space(char letter, uint32_t * total_p, uint32_t * free_p);
 
+#if LV_FS_CACHE_BLOCK_CNT
+/**
+ * Get the I/O statistics of a driver
+ * @param letter the driver letter
+ * @param stat pointer to store the statistics
+ * @return LV_FS_RES_OK or LV_FS_RES_NOT_EX if there is no such driver
+ */
+lv_fs_res_t lv_fs_get_stat(char letter, lv_fs_stat_t * stat);
+
+/**
+ * Clear the I/O statistics of a driver
+ * @param letter the driver letter
+ */
+void lv_fs_reset_stat(char letter);
+#endif
+
 /**
  * Fill a buffer with the letters of existing drivers
  * @param buf buffer to store the letters ('\0' added after the last letter)
@@ -36,6 +36,7 @@ extern "C" {
     f(lv_ll_t, _lv_img_defoder_ll)                                 \
     f(lv_ll_t, _lv_obj_style_trans_ll)                             \
     f(lv_img_cache_entry_t*, _lv_img_cache_array)                  \
+    f(lv_ll_t, _lv_img_cache_transform_ll)                         \
     f(lv_task_t*, _lv_task_act)                                    \
     f(lv_mem_buf_arr_t , _lv_mem_buf)                              \
     f(_lv_draw_mask_saved_arr_t , _lv_draw_mask_list)              \
@@ -73,21 +73,30 @@ void * _lv_ll_ins_head(lv_ll_t * ll_p)
 
     n_new = lv_mem_alloc(ll_p->n_size + LL_NODE_META_SIZE);
 
-    if(n_new != NULL) {
-        node_set_prev(ll_p, n_new, NULL);       /*No prev. before the new head*/
-        node_set_next(ll_p, n_new, ll_p->head); /*After new comes the old head*/
+    if(n_new != NULL) _lv_ll_link_head(ll_p, n_new);
 
-        if(ll_p->head != NULL) { /*If there is old head then before it goes the new*/
-            node_set_prev(ll_p, ll_p->head, n_new);
-        }
+    return n_new;
+}
 
-        ll_p->head = n_new;      /*Set the new head in the dsc.*/
-        if(ll_p->tail == NULL) { /*If there is no tail (1. node) set the tail too*/
-            ll_p->tail = n_new;
-        }
+/**
+ * Add a node allocated by the caller as the new head of a linked list.
+ * The node can be freed only after it was removed from the list.
+ * @param ll_p pointer to linked list
+ * @param n_new pointer to a memory area of at least `_lv_ll_get_node_size(ll_p)` bytes
+ */
+void _lv_ll_link_head(lv_ll_t * ll_p, void * n_new)
+{
+    node_set_prev(ll_p, n_new, NULL);       /*No prev. before the new head*/
+    node_set_next(ll_p, n_new, ll_p->head); /*After new comes the old head*/
+
+    if(ll_p->head != NULL) { /*If there is old head then before it goes the new*/
+        node_set_prev(ll_p, ll_p->head, n_new);
     }
 
-    return n_new;
+    ll_p->head = n_new;      /*Set the new head in the dsc.*/
+    if(ll_p->tail == NULL) { /*If there is no tail (1. node) set the tail too*/
+        ll_p->tail = n_new;
+    }
 }
 
 /**
@@ -249,6 +258,16 @@ void _lv_ll_chg_list(lv_ll_t * ll_ori_p, lv_ll_t * ll_new_p, void * node, bool h
     }
 }
 
+/**
+ * Get the size of a node including the list's own meta data
+ * @param ll_p pointer to linked list
+ * @return size of a node in bytes
+ */
+uint32_t _lv_ll_get_node_size(const lv_ll_t * ll_p)
+{
+    return ll_p->n_size + LL_NODE_META_SIZE;
+}
+
 /**
  * Return with head node of the linked list
  * @param ll_p pointer to linked list
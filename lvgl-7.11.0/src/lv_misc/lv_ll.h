@@ -54,6 +54,14 @@ void _lv_ll_init(lv_ll_t * ll_p, uint32_t node_size);
  */
 void * _lv_ll_ins_head(lv_ll_t * ll_p);
 
+/**
+ * Add a node allocated by the caller as the new head of a linked list.
+ * The node can be freed only after it was removed from the list.
+ * @param ll_p pointer to linked list
+ * @param n_new pointer to a memory area of at least `_lv_ll_get_node_size(ll_p)` bytes
+ */
+void _lv_ll_link_head(lv_ll_t * ll_p, void * n_new);
+
 /**
  * Insert a new node in front of the n_act node
  * @param ll_p pointer to linked list
@@ -93,6 +101,13 @@ void _lv_ll_clear(lv_ll_t * ll_p);
  */
 void _lv_ll_chg_list(lv_ll_t * ll_ori_p, lv_ll_t * ll_new_p, void * node, bool head);
 
+/**
+ * Get the size of a node including the list's own meta data
+ * @param ll_p pointer to linked list
+ * @return size of a node in bytes
+ */
+uint32_t _lv_ll_get_node_size(const lv_ll_t * ll_p);
+
 /**
  * Return with head node of the linked list
  * @param ll_p pointer to linked list
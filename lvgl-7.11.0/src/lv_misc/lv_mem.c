@@ -17,6 +17,10 @@
     #include LV_MEM_CUSTOM_INCLUDE
 #endif
 
+#if LV_MEM_LATENCY_HIST
+    #include LV_MEM_LATENCY_TIME_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -65,14 +69,104 @@ typedef struct {
 
 #define MEM_BUF_SMALL_SIZE 16
 
+#if LV_MEM_BUF_POOL
+#if LV_ENABLE_GC
+    #error "LV_MEM_BUF_POOL can't be used with LV_ENABLE_GC"
+#endif
+#define MEM_BUF_CLASS_MIN_LOG2  4   /*The smallest buffers are 16 bytes*/
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+/* The blocks are aligned to pointer size because the free blocks store pointers in their data.
+ * Block layout: [prev. physical block pointer][... lv_mem_header_t][data]*/
+#if UINTPTR_MAX > 0xFFFFFFFFu
+    #define TLSF_ALIGN_LOG2     3
+#else
+    #define TLSF_ALIGN_LOG2     2
+#endif
+#define TLSF_ALIGN          (1U << TLSF_ALIGN_LOG2)
+#define TLSF_OVERHEAD       (2 * TLSF_ALIGN)        /*Space for the previous block pointer and the header*/
+#define TLSF_MIN_SIZE       (2 * sizeof(void *))    /*A free block needs to store the free list pointers*/
+
+/*Second level: divide every power of 2 range to 16 linearly spaced lists*/
+#define TLSF_SL_LOG2        4
+#define TLSF_SL_CNT         (1U << TLSF_SL_LOG2)
+#define TLSF_FL_SHIFT       (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_SMALL_SIZE     (1U << TLSF_FL_SHIFT)   /*Below this size only the second level is used*/
+
+/*Don't waste RAM on first level lists which can't be used with the given work memory*/
+#if LV_MEM_SIZE <= (1UL << 16)
+    #define TLSF_FL_MAX     16
+#elif LV_MEM_SIZE <= (1UL << 20)
+    #define TLSF_FL_MAX     20
+#elif LV_MEM_SIZE <= (1UL << 24)
+    #define TLSF_FL_MAX     24
+#else
+    #define TLSF_FL_MAX     31
+#endif
+#define TLSF_FL_CNT         (TLSF_FL_MAX - TLSF_FL_SHIFT + 1)
+#endif
+
+#if LV_MEM_BUF_POOL
+/*Placed in front of the pool buffers*/
+typedef struct _mem_buf_hdr_t {
+    struct _mem_buf_hdr_t * next;   /*Next free buffer of the class or next used buffer*/
+    struct _mem_buf_hdr_t * prev;   /*Previous used buffer*/
+    uint32_t cls;                   /*Index of the size class*/
+    uint32_t used;
+} mem_buf_hdr_t;
+
+typedef struct {
+    mem_buf_hdr_t * free_head;
+    uint16_t cnt;       /*Number of buffers in the class*/
+    uint16_t used;      /*Number of used buffers*/
+    uint16_t used_max;  /*The most used buffers since the last `_lv_mem_buf_free_all()`*/
+    uint16_t keep;      /*Number of buffers to keep (the most used in the recent refreshes)*/
+    uint16_t keep_age;  /*Number of refreshes since `keep` was reached*/
+} mem_buf_class_t;
+
+typedef struct {
+    mem_buf_class_t cls[LV_MEM_BUF_CLASS_CNT];
+    mem_buf_hdr_t * used_head;  /*List of the used buffers to release them in `_lv_mem_buf_free_all()`*/
+    uint16_t used;
+    lv_mem_buf_monitor_t mon;
+} mem_buf_pool_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 #if LV_MEM_CUSTOM == 0
     static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e);
+#if LV_MEM_TLSF
+    static void tlsf_init(void);
+    static void * tlsf_alloc(size_t size);
+    static void tlsf_free(lv_mem_ent_t * e);
+    static bool tlsf_resize(lv_mem_ent_t * e, size_t size);
+    static void tlsf_split(lv_mem_ent_t * e, size_t size);
+    static void tlsf_insert(lv_mem_ent_t * e);
+    static void tlsf_remove(lv_mem_ent_t * e);
+    static void tlsf_mapping(size_t size, uint32_t * fl, uint32_t * sl);
+    static size_t tlsf_adjust_size(size_t size);
+    static lv_mem_ent_t * tlsf_first(void);
+    static lv_mem_ent_t * tlsf_next_phys(lv_mem_ent_t * e);
+    static uint32_t tlsf_fls(uint32_t x);
+    static uint32_t tlsf_ffs(uint32_t x);
+#else
     static void * ent_alloc(lv_mem_ent_t * e, size_t size);
     static void ent_trunc(lv_mem_ent_t * e, size_t size);
 #endif
+#endif
+#if LV_MEM_LATENCY_HIST
+    static void latency_add(uint32_t t);
+#endif
+#if LV_MEM_BUF_POOL
+    static void * buf_pool_get(uint32_t size);
+    static void buf_pool_release(void * p);
+    static void buf_pool_trim(void);
+    static void buf_pool_flush(void);
+    static uint32_t buf_pool_get_class(uint32_t size);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -87,12 +181,29 @@ static uint32_t zero_mem; /*Give the address of this variable if 0 byte should b
     static uint32_t mem_max_size; /*Tracks the maximum total size of memory ever used from the internal heap*/
 #endif
 
-static uint8_t mem_buf1_32[MEM_BUF_SMALL_SIZE];
-static uint8_t mem_buf2_32[MEM_BUF_SMALL_SIZE];
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    static uint8_t * tlsf_end;  /*The closing sentinel block. Always "used" with 0 size*/
+    static uint32_t tlsf_fl_bitmap;
+    static uint32_t tlsf_sl_bitmap[TLSF_FL_CNT];
+    static lv_mem_ent_t * tlsf_free_head[TLSF_FL_CNT][TLSF_SL_CNT];
+#endif
+
+#if LV_MEM_LATENCY_HIST
+    static uint32_t lat_alloc_cnt;
+    static uint32_t lat_max;
+    static uint32_t lat_hist[LV_MEM_LATENCY_HIST_CNT];
+#endif
 
-static lv_mem_buf_t mem_buf_small[] = {{.p = mem_buf1_32, .size = MEM_BUF_SMALL_SIZE, .used = 0},
-    {.p = mem_buf2_32, .size = MEM_BUF_SMALL_SIZE, .used = 0}
-};
+#if LV_MEM_BUF_POOL
+    static LV_MEM_BUF_POOL_ATTR mem_buf_pool_t buf_pool;
+#else
+    static uint8_t mem_buf1_32[MEM_BUF_SMALL_SIZE];
+    static uint8_t mem_buf2_32[MEM_BUF_SMALL_SIZE];
+
+    static lv_mem_buf_t mem_buf_small[] = {{.p = mem_buf1_32, .size = MEM_BUF_SMALL_SIZE, .used = 0},
+        {.p = mem_buf2_32, .size = MEM_BUF_SMALL_SIZE, .used = 0}
+    };
+#endif
 
 /**********************
  *      MACROS
@@ -104,6 +215,14 @@ static lv_mem_buf_t mem_buf_small[] = {{.p = mem_buf1_32, .size = MEM_BUF_SMALL_
 #define SET8(x) *d8 = x; d8++;
 #define REPEAT8(expr) expr expr expr expr expr expr expr expr
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+/*The previous physical block is stored right before the header*/
+#define TLSF_PREV_PHYS(e) (*(lv_mem_ent_t **)((uint8_t *)(e) + sizeof(lv_mem_header_t) - TLSF_OVERHEAD))
+/*The free list pointers are stored in the data of the free blocks*/
+#define TLSF_NEXT_FREE(e) (((lv_mem_ent_t **)&(e)->first_data)[0])
+#define TLSF_PREV_FREE(e) (((lv_mem_ent_t **)&(e)->first_data)[1])
+#endif
+
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
@@ -123,11 +242,15 @@ void _lv_mem_init(void)
     work_mem = (uint8_t *)LV_MEM_ADR;
 #endif
 
+#if LV_MEM_TLSF
+    tlsf_init();
+#else
     lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
     full->header.s.used = 0;
     /*The total mem size reduced by the first header and the close patterns */
     full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
 #endif
+#endif
 }
 
 /**
@@ -136,12 +259,20 @@ void _lv_mem_init(void)
  */
 void _lv_mem_deinit(void)
 {
+#if LV_MEM_BUF_POOL
+    buf_pool_flush();
+#endif
+
 #if LV_MEM_CUSTOM == 0
+#if LV_MEM_TLSF
+    tlsf_init();
+#else
     lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
     full->header.s.used = 0;
     /*The total mem size reduced by the first header and the close patterns */
     full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
 #endif
+#endif
 }
 
 /**
@@ -155,11 +286,17 @@ void * lv_mem_alloc(size_t size)
         return &zero_mem;
     }
 
+#if LV_MEM_LATENCY_HIST
+    uint32_t lat_start = LV_MEM_LATENCY_TIME_EXPR;
+#endif
+
     /*Round the size up to ALIGN_MASK*/
     size = (size + ALIGN_MASK) & (~ALIGN_MASK);
     void * alloc = NULL;
 
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    alloc = tlsf_alloc(size);
+#elif LV_MEM_CUSTOM == 0
     /*Use the built-in allocators*/
     lv_mem_ent_t * e = NULL;
 
@@ -209,6 +346,10 @@ void * lv_mem_alloc(size_t size)
 #endif
     }
 
+#if LV_MEM_LATENCY_HIST
+    latency_add(LV_MEM_LATENCY_TIME_EXPR - lat_start);
+#endif
+
     return alloc;
 }
 
@@ -232,7 +373,9 @@ void lv_mem_free(const void * data)
 #endif
 
 #if LV_MEM_CUSTOM == 0
-#if LV_MEM_AUTO_DEFRAG
+#if LV_MEM_TLSF
+    tlsf_free(e);
+#elif LV_MEM_AUTO_DEFRAG
     static uint16_t full_defrag_cnt = 0;
     full_defrag_cnt++;
     if(full_defrag_cnt < LV_MEM_FULL_DEFRAG_CNT) {
@@ -280,6 +423,12 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     /*Round the size up to ALIGN_MASK*/
     new_size = (new_size + ALIGN_MASK) & (~ALIGN_MASK);
 
+    /*The 0 byte allocation has no header, handle it like NULL*/
+    if(data_p == &zero_mem) {
+        if(new_size == 0) return data_p;
+        data_p = NULL;
+    }
+
     /*data_p could be previously freed pointer (in this case it is invalid)*/
     if(data_p != NULL) {
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
@@ -291,7 +440,13 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     uint32_t old_size = _lv_mem_get_size(data_p);
     if(old_size == new_size) return data_p; /*Also avoid reallocating the same memory*/
 
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    /*Shrink or grow in place if possible*/
+    if(data_p != NULL) {
+        lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
+        if(tlsf_resize(e, new_size)) return &e->first_data;
+    }
+#elif LV_MEM_CUSTOM == 0
     /* Truncate the memory if the new size is smaller. */
     if(new_size < old_size) {
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
@@ -334,7 +489,8 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
  */
 void lv_mem_defrag(void)
 {
-#if LV_MEM_CUSTOM == 0
+    /*With TLSF the free blocks are always joined on free*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0
     lv_mem_ent_t * e_free;
     lv_mem_ent_t * e_next;
     e_free = ent_get_next(NULL);
@@ -431,6 +587,12 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
         mon_p->frag_pct = 0; /*no fragmentation if all the RAM is used*/
     }
 #endif
+
+#if LV_MEM_LATENCY_HIST
+    mon_p->alloc_cnt = lat_alloc_cnt;
+    mon_p->alloc_lat_max = lat_max;
+    _lv_memcpy(mon_p->alloc_lat_hist, lat_hist, sizeof(lat_hist));
+#endif
 }
 
 /**
@@ -468,6 +630,9 @@ void * _lv_mem_buf_get(uint32_t size)
 {
     if(size == 0) return NULL;
 
+#if LV_MEM_BUF_POOL
+    return buf_pool_get(size);
+#else
     /*Try small static buffers first*/
     uint8_t i;
     if(size <= MEM_BUF_SMALL_SIZE) {
@@ -520,6 +685,7 @@ void * _lv_mem_buf_get(uint32_t size)
 
     LV_DEBUG_ASSERT(false, "No free buffer. Increase LV_MEM_BUF_MAX_NUM.", 0x00);
     return NULL;
+#endif
 }
 
 /**
@@ -528,6 +694,9 @@ void * _lv_mem_buf_get(uint32_t size)
  */
 void _lv_mem_buf_release(void * p)
 {
+#if LV_MEM_BUF_POOL
+    buf_pool_release(p);
+#else
     uint8_t i;
 
     /*Try small static buffers first*/
@@ -546,13 +715,19 @@ void _lv_mem_buf_release(void * p)
     }
 
     LV_LOG_ERROR("lv_mem_buf_release: p is not a known buffer")
+#endif
 }
 
 /**
- * Free all memory buffers
+ * Free all memory buffers.
+ * With `LV_MEM_BUF_POOL` release all buffers and free only those which weren't needed recently.
+ * Only the pool of the calling thread is affected.
  */
 void _lv_mem_buf_free_all(void)
 {
+#if LV_MEM_BUF_POOL
+    buf_pool_trim();
+#else
     uint8_t i;
     for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
         mem_buf_small[i].used = 0;
@@ -566,8 +741,30 @@ void _lv_mem_buf_free_all(void)
             LV_GC_ROOT(_lv_mem_buf[i]).size = 0;
         }
     }
+#endif
 }
 
+#if LV_MEM_BUF_POOL
+/**
+ * Release and free every buffer of the calling thread's pool.
+ * With a thread local `LV_MEM_BUF_POOL_ATTR` a rendering thread should call it before it exits
+ * as the pools of the other threads are never trimmed.
+ */
+void lv_mem_buf_flush(void)
+{
+    buf_pool_flush();
+}
+
+/**
+ * Give information about the temporary buffer pool of the calling thread
+ * @param mon_p pointer to a monitor variable
+ */
+void lv_mem_buf_monitor(lv_mem_buf_monitor_t * mon_p)
+{
+    _lv_memcpy(mon_p, &buf_pool.mon, sizeof(lv_mem_buf_monitor_t));
+}
+#endif
+
 #if LV_MEMCPY_MEMSET_STD == 0
 /**
  * Same as `memcpy` but optimized for 4 byte operation.
@@ -765,6 +962,13 @@ LV_ATTRIBUTE_FAST_MEM void _lv_memset_ff(void * dst, size_t len)
  */
 static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e)
 {
+#if LV_MEM_TLSF
+    lv_mem_ent_t * next_e;
+    if(act_e == NULL) next_e = tlsf_first();
+    else next_e = tlsf_next_phys(act_e);
+
+    return (uint8_t *)next_e < tlsf_end ? next_e : NULL;
+#else
     lv_mem_ent_t * next_e = NULL;
 
     if(act_e == NULL) { /*NULL means: get the first entry*/
@@ -778,8 +982,11 @@ static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e)
     }
 
     return next_e;
+#endif
 }
 
+#if LV_MEM_TLSF == 0
+
 /**
  * Try to do the real allocation with a given size
  * @param e try to allocate to this entry
@@ -829,4 +1036,446 @@ static void ent_trunc(lv_mem_ent_t * e, size_t size)
     }
 }
 
+#else /*LV_MEM_TLSF*/
+
+/* The entries (pointing to the header as everywhere else) are managed as the blocks of a TLSF allocator.
+ * The free blocks are kept in lists by size classes:
+ * - first level: power of 2 ranges
+ * - second level: `TLSF_SL_CNT` linear ranges inside each power of 2
+ * Bitmaps tell which lists are not empty so finding a large enough block takes constant time.
+ * Adjacent free blocks are joined immediately with the help of the previous physical block pointer.*/
+
+/**
+ * Initialize the work memory as one large free block closed by a sentinel
+ */
+static void tlsf_init(void)
+{
+    tlsf_fl_bitmap = 0;
+    _lv_memset_00(tlsf_sl_bitmap, sizeof(tlsf_sl_bitmap));
+    _lv_memset_00(tlsf_free_head, sizeof(tlsf_free_head));
+
+    lv_uintptr_t start = ((lv_uintptr_t)work_mem + TLSF_ALIGN - 1) & ~((lv_uintptr_t)TLSF_ALIGN - 1);
+    lv_uintptr_t end = ((lv_uintptr_t)work_mem + LV_MEM_SIZE) & ~((lv_uintptr_t)TLSF_ALIGN - 1);
+
+    lv_mem_ent_t * full = (lv_mem_ent_t *)(start + TLSF_OVERHEAD - sizeof(lv_mem_header_t));
+    full->header.s.used = 0;
+    full->header.s.d_size = end - start - 2 * TLSF_OVERHEAD;
+    TLSF_PREV_PHYS(full) = NULL;
+
+    lv_mem_ent_t * sentinel = tlsf_next_phys(full);
+    sentinel->header.s.used = 1;
+    sentinel->header.s.d_size = 0;
+    TLSF_PREV_PHYS(sentinel) = full;
+    tlsf_end = (uint8_t *)sentinel;
+
+    tlsf_insert(full);
+}
+
+/**
+ * Allocate a block from the free lists
+ * @param size size of the data in bytes
+ * @return pointer to the data or NULL if there is no large enough free block
+ */
+static void * tlsf_alloc(size_t size)
+{
+    size = tlsf_adjust_size(size);
+
+    /*Round up to the next list to be sure every block in it is large enough*/
+    size_t search_size = size;
+    if(search_size >= TLSF_SMALL_SIZE) {
+        search_size += (1U << (tlsf_fls(search_size) - TLSF_SL_LOG2)) - 1;
+    }
+
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(search_size, &fl, &sl);
+    if(fl >= TLSF_FL_CNT) return NULL;
+
+    /*Search in the current first level from `sl` and in the larger first levels*/
+    uint32_t sl_map = tlsf_sl_bitmap[fl] & (~0U << sl);
+    if(sl_map == 0) {
+        uint32_t fl_map = tlsf_fl_bitmap & (~0U << (fl + 1));
+        if(fl_map == 0) return NULL;
+        fl = tlsf_ffs(fl_map);
+        sl_map = tlsf_sl_bitmap[fl];
+    }
+    sl = tlsf_ffs(sl_map);
+
+    lv_mem_ent_t * e = tlsf_free_head[fl][sl];
+    tlsf_remove(e);
+    e->header.s.used = 1;
+    tlsf_split(e, size);
+
+    return &e->first_data;
+}
+
+/**
+ * Give back a block to the free lists and join it with the free neighbors
+ * @param e pointer to an entry. Its `used` flag should be already cleared
+ */
+static void tlsf_free(lv_mem_ent_t * e)
+{
+    e->header.s.used = 0;
+
+    lv_mem_ent_t * prev = TLSF_PREV_PHYS(e);
+    if(prev && prev->header.s.used == 0) {
+        tlsf_remove(prev);
+        prev->header.s.d_size += e->header.s.d_size + TLSF_OVERHEAD;
+        e = prev;
+    }
+
+    lv_mem_ent_t * next = tlsf_next_phys(e);
+    if(next->header.s.used == 0) {
+        tlsf_remove(next);
+        e->header.s.d_size += next->header.s.d_size + TLSF_OVERHEAD;
+    }
+
+    TLSF_PREV_PHYS(tlsf_next_phys(e)) = e;
+    tlsf_insert(e);
+}
+
+/**
+ * Change the size of a used block in place.
+ * @param e pointer to an entry
+ * @param size the new size of the data in bytes
+ * @return true: the size is changed; false: there is not enough free space after the block
+ */
+static bool tlsf_resize(lv_mem_ent_t * e, size_t size)
+{
+    size = tlsf_adjust_size(size);
+
+    if(size > e->header.s.d_size) {
+        /*Try to take the following free block*/
+        lv_mem_ent_t * next = tlsf_next_phys(e);
+        if(next->header.s.used != 0) return false;
+        if(e->header.s.d_size + TLSF_OVERHEAD + next->header.s.d_size < size) return false;
+
+        tlsf_remove(next);
+        e->header.s.d_size += next->header.s.d_size + TLSF_OVERHEAD;
+        TLSF_PREV_PHYS(tlsf_next_phys(e)) = e;
+    }
+
+    tlsf_split(e, size);
+    return true;
+}
+
+/**
+ * Cut the unused end of a used block as a new free block if it's large enough.
+ * @param e pointer to a used entry
+ * @param size the required size of the data
+ */
+static void tlsf_split(lv_mem_ent_t * e, size_t size)
+{
+    if(e->header.s.d_size < size + TLSF_OVERHEAD + TLSF_MIN_SIZE) return;
+
+    lv_mem_ent_t * rest = (lv_mem_ent_t *)(&e->first_data + size + TLSF_OVERHEAD - sizeof(lv_mem_header_t));
+    rest->header.s.used = 1;
+    rest->header.s.d_size = e->header.s.d_size - size - TLSF_OVERHEAD;
+    TLSF_PREV_PHYS(rest) = e;
+    TLSF_PREV_PHYS(tlsf_next_phys(rest)) = rest;
+    e->header.s.d_size = size;
+
+    /*Free it to join with the next block if it's free too*/
+    tlsf_free(rest);
+}
+
+/**
+ * Add a free block to the list of its size class
+ * @param e pointer to a free entry
+ */
+static void tlsf_insert(lv_mem_ent_t * e)
+{
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(e->header.s.d_size, &fl, &sl);
+
+    lv_mem_ent_t * head = tlsf_free_head[fl][sl];
+    TLSF_NEXT_FREE(e) = head;
+    TLSF_PREV_FREE(e) = NULL;
+    if(head) TLSF_PREV_FREE(head) = e;
+    tlsf_free_head[fl][sl] = e;
+
+    tlsf_fl_bitmap |= 1U << fl;
+    tlsf_sl_bitmap[fl] |= 1U << sl;
+}
+
+/**
+ * Remove a free block from the list of its size class
+ * @param e pointer to a free entry
+ */
+static void tlsf_remove(lv_mem_ent_t * e)
+{
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(e->header.s.d_size, &fl, &sl);
+
+    lv_mem_ent_t * prev = TLSF_PREV_FREE(e);
+    lv_mem_ent_t * next = TLSF_NEXT_FREE(e);
+    if(next) TLSF_PREV_FREE(next) = prev;
+    if(prev) TLSF_NEXT_FREE(prev) = next;
+    else {
+        tlsf_free_head[fl][sl] = next;
+        if(next == NULL) {
+            tlsf_sl_bitmap[fl] &= ~(1U << sl);
+            if(tlsf_sl_bitmap[fl] == 0) tlsf_fl_bitmap &= ~(1U << fl);
+        }
+    }
+}
+
+/**
+ * Get the first and second level index of a size
+ * @param size size of a block's data
+ * @param fl store the first level index here
+ * @param sl store the second level index here
+ */
+static void tlsf_mapping(size_t size, uint32_t * fl, uint32_t * sl)
+{
+    if(size < TLSF_SMALL_SIZE) {
+        *fl = 0;
+        *sl = size / (TLSF_SMALL_SIZE / TLSF_SL_CNT);
+    }
+    else {
+        uint32_t f = tlsf_fls(size);
+        *sl = (size >> (f - TLSF_SL_LOG2)) ^ TLSF_SL_CNT;
+        *fl = f - (TLSF_FL_SHIFT - 1);
+    }
+}
+
+/**
+ * Round up a requested size to the size really used for the block
+ * @param size the requested size in bytes
+ * @return the adjusted size
+ */
+static size_t tlsf_adjust_size(size_t size)
+{
+    size = (size + TLSF_ALIGN - 1) & ~((size_t)TLSF_ALIGN - 1);
+    return size < TLSF_MIN_SIZE ? TLSF_MIN_SIZE : size;
+}
+
+/**
+ * Get the first (lowest address) block of the work memory
+ * @return pointer to the first entry
+ */
+static lv_mem_ent_t * tlsf_first(void)
+{
+    lv_uintptr_t start = ((lv_uintptr_t)work_mem + TLSF_ALIGN - 1) & ~((lv_uintptr_t)TLSF_ALIGN - 1);
+    return (lv_mem_ent_t *)(start + TLSF_OVERHEAD - sizeof(lv_mem_header_t));
+}
+
+/**
+ * Get the physically next block
+ * @param e pointer to an entry
+ * @return pointer to the following entry (the sentinel after the last block)
+ */
+static lv_mem_ent_t * tlsf_next_phys(lv_mem_ent_t * e)
+{
+    return (lv_mem_ent_t *)(&e->first_data + e->header.s.d_size + TLSF_OVERHEAD - sizeof(lv_mem_header_t));
+}
+
+/**
+ * Find the index of the most significant set bit
+ * @param x a non-zero value
+ * @return the index of the bit (0..31)
+ */
+static uint32_t tlsf_fls(uint32_t x)
+{
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(x);
+#else
+    uint32_t i = 0;
+    while(x >>= 1) i++;
+    return i;
+#endif
+}
+
+/**
+ * Find the index of the least significant set bit
+ * @param x a non-zero value
+ * @return the index of the bit (0..31)
+ */
+static uint32_t tlsf_ffs(uint32_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    uint32_t i = 0;
+    while((x & 1) == 0) {
+        x >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+#endif /*LV_MEM_TLSF*/
+#endif /*LV_MEM_CUSTOM == 0*/
+
+#if LV_MEM_LATENCY_HIST
+/**
+ * Add the duration of an allocation to the latency histogram
+ * @param t the duration in the units of `LV_MEM_LATENCY_TIME_EXPR`
+ */
+static void latency_add(uint32_t t)
+{
+    uint32_t i = 0;
+    while(i < LV_MEM_LATENCY_HIST_CNT - 1 && t >= (1UL << i)) i++;
+
+    lat_hist[i]++;
+    lat_alloc_cnt++;
+    if(t > lat_max) lat_max = t;
+}
+#endif
+
+#if LV_MEM_BUF_POOL
+/**
+ * Get a buffer from the pool. Allocate a new one if there is no free buffer in the size class.
+ * @param size the required size
+ * @return pointer to the buffer or NULL on error
+ */
+static void * buf_pool_get(uint32_t size)
+{
+    uint32_t cls_id = buf_pool_get_class(size);
+    if(cls_id >= LV_MEM_BUF_CLASS_CNT) {
+        LV_DEBUG_ASSERT(false, "Too large buffer. Increase LV_MEM_BUF_CLASS_CNT.", size);
+        return NULL;
+    }
+
+    mem_buf_class_t * cls = &buf_pool.cls[cls_id];
+    mem_buf_hdr_t * hdr = cls->free_head;
+    if(hdr) {
+        cls->free_head = hdr->next;
+    }
+    else {
+        uint32_t buf_size = 1UL << (cls_id + MEM_BUF_CLASS_MIN_LOG2);
+        /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
+        hdr = lv_mem_alloc(sizeof(mem_buf_hdr_t) + buf_size);
+        if(hdr == NULL) {
+            LV_DEBUG_ASSERT(false, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)", 0x00);
+            return NULL;
+        }
+        hdr->cls = cls_id;
+        cls->cnt++;
+        buf_pool.mon.alloc_cnt++;
+        buf_pool.mon.buf_cnt++;
+        buf_pool.mon.buf_size += buf_size;
+    }
+
+    /*Add to the used buffers*/
+    hdr->used = 1;
+    hdr->prev = NULL;
+    hdr->next = buf_pool.used_head;
+    if(buf_pool.used_head) buf_pool.used_head->prev = hdr;
+    buf_pool.used_head = hdr;
+
+    cls->used++;
+    if(cls->used > cls->used_max) cls->used_max = cls->used;
+    if(cls->used > buf_pool.mon.class_used_max[cls_id]) buf_pool.mon.class_used_max[cls_id] = cls->used;
+
+    buf_pool.used++;
+    if(buf_pool.used > buf_pool.mon.used_max) buf_pool.mon.used_max = buf_pool.used;
+    buf_pool.mon.get_cnt++;
+
+    return hdr + 1;
+}
+
+/**
+ * Put a buffer back to the free buffers of its size class
+ * @param p buffer to release
+ */
+static void buf_pool_release(void * p)
+{
+    if(p == NULL) return;
+
+    mem_buf_hdr_t * hdr = (mem_buf_hdr_t *)p - 1;
+    if(hdr->used == 0) {
+        LV_LOG_ERROR("lv_mem_buf_release: p is not a used buffer")
+        return;
+    }
+
+    /*Remove from the used buffers*/
+    if(hdr->prev) hdr->prev->next = hdr->next;
+    else buf_pool.used_head = hdr->next;
+    if(hdr->next) hdr->next->prev = hdr->prev;
+
+    mem_buf_class_t * cls = &buf_pool.cls[hdr->cls];
+    hdr->used = 0;
+    hdr->next = cls->free_head;
+    cls->free_head = hdr;
+    cls->used--;
+    buf_pool.used--;
+}
+
+/**
+ * Release all buffers and free the buffers of a size class
+ * which were not needed in the last `LV_MEM_BUF_POOL_KEEP` refreshes
+ */
+static void buf_pool_trim(void)
+{
+    while(buf_pool.used_head) buf_pool_release(buf_pool.used_head + 1);
+
+    uint32_t i;
+    for(i = 0; i < LV_MEM_BUF_CLASS_CNT; i++) {
+        mem_buf_class_t * cls = &buf_pool.cls[i];
+        if(cls->used_max >= cls->keep) {
+            cls->keep = cls->used_max;
+            cls->keep_age = 0;
+        }
+        else {
+            cls->keep_age++;
+            if(cls->keep_age >= LV_MEM_BUF_POOL_KEEP) {
+                cls->keep = cls->used_max;
+                cls->keep_age = 0;
+            }
+        }
+        cls->used_max = 0;
+
+        while(cls->cnt > cls->keep) {
+            mem_buf_hdr_t * hdr = cls->free_head;
+            cls->free_head = hdr->next;
+            cls->cnt--;
+            buf_pool.mon.buf_cnt--;
+            buf_pool.mon.buf_size -= 1UL << (i + MEM_BUF_CLASS_MIN_LOG2);
+            lv_mem_free(hdr);
+        }
+    }
+}
+
+/**
+ * Release and free all buffers of the pool
+ */
+static void buf_pool_flush(void)
+{
+    while(buf_pool.used_head) buf_pool_release(buf_pool.used_head + 1);
+
+    uint32_t i;
+    for(i = 0; i < LV_MEM_BUF_CLASS_CNT; i++) {
+        while(buf_pool.cls[i].free_head) {
+            mem_buf_hdr_t * hdr = buf_pool.cls[i].free_head;
+            buf_pool.cls[i].free_head = hdr->next;
+            lv_mem_free(hdr);
+        }
+    }
+
+    _lv_memset_00(&buf_pool, sizeof(buf_pool));
+}
+
+/**
+ * Get the size class of a buffer size: the smallest `i` for which `size <= 16 << i`
+ * @param size a buffer size (> 0)
+ * @return index of the size class
+ */
+static uint32_t buf_pool_get_class(uint32_t size)
+{
+    uint32_t x = (size - 1) >> MEM_BUF_CLASS_MIN_LOG2;
+    if(x == 0) return 0;
+#if defined(__GNUC__)
+    return 32 - __builtin_clz(x);
+#else
+    uint32_t i = 0;
+    while(x) {
+        x >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
 #endif
@@ -32,6 +32,20 @@ extern "C" {
 #define LV_MEM_BUF_MAX_NUM    16
 #endif
 
+#if LV_MEM_BUF_POOL
+/*Number of size classes in the buffer pool. Class `i` has buffers of `16 << i` bytes*/
+#ifndef LV_MEM_BUF_CLASS_CNT
+#define LV_MEM_BUF_CLASS_CNT    24
+#endif
+#endif
+
+#if LV_MEM_LATENCY_HIST
+/*Number of latency buckets. Bucket `i` counts the allocations which took less than 2^i time units*/
+#ifndef LV_MEM_LATENCY_HIST_CNT
+#define LV_MEM_LATENCY_HIST_CNT    16
+#endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -48,6 +62,11 @@ typedef struct {
     uint32_t max_used; /**< Max size of Heap memory used */
     uint8_t used_pct; /**< Percentage used */
     uint8_t frag_pct; /**< Amount of fragmentation */
+#if LV_MEM_LATENCY_HIST
+    uint32_t alloc_cnt; /**< Number of measured allocations */
+    uint32_t alloc_lat_max; /**< The longest allocation in the units of `LV_MEM_LATENCY_TIME_EXPR` */
+    uint32_t alloc_lat_hist[LV_MEM_LATENCY_HIST_CNT]; /**< Number of allocations per latency bucket */
+#endif
 } lv_mem_monitor_t;
 
 typedef struct {
@@ -59,6 +78,20 @@ typedef struct {
 typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
 extern lv_mem_buf_arr_t _lv_mem_buf;
 
+#if LV_MEM_BUF_POOL
+/**
+ * Statistics of the temporary buffer pool
+ */
+typedef struct {
+    uint32_t get_cnt;   /**< Number of `_lv_mem_buf_get()` calls */
+    uint32_t alloc_cnt; /**< Number of buffers allocated with `lv_mem_alloc` */
+    uint32_t buf_cnt;   /**< Number of buffers in the pool now */
+    uint32_t buf_size;  /**< Total size of the buffers in the pool now */
+    uint16_t used_max;  /**< The most buffers used at the same time */
+    uint16_t class_used_max[LV_MEM_BUF_CLASS_CNT]; /**< The most buffers used at the same time per size class */
+} lv_mem_buf_monitor_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -134,10 +167,27 @@ void * _lv_mem_buf_get(uint32_t size);
 void _lv_mem_buf_release(void * p);
 
 /**
- * Free all memory buffers
+ * Free all memory buffers.
+ * With `LV_MEM_BUF_POOL` release all buffers and free only those which weren't needed recently.
+ * Only the pool of the calling thread is affected.
  */
 void _lv_mem_buf_free_all(void);
 
+#if LV_MEM_BUF_POOL
+/**
+ * Release and free every buffer of the calling thread's pool.
+ * With a thread local `LV_MEM_BUF_POOL_ATTR` a rendering thread should call it before it exits
+ * as the pools of the other threads are never trimmed.
+ */
+void lv_mem_buf_flush(void);
+
+/**
+ * Give information about the temporary buffer pool of the calling thread
+ * @param mon_p pointer to a monitor variable
+ */
+void lv_mem_buf_monitor(lv_mem_buf_monitor_t * mon_p);
+#endif
+
 //! @cond Doxygen_Suppress
 
 #if LV_MEMCPY_MEMSET_STD
@@ -12,6 +12,7 @@
 #include "../lv_misc/lv_debug.h"
 #include "../lv_hal/lv_hal_tick.h"
 #include "lv_gc.h"
+#include "../lv_core/lv_cmdq.h"
 
 /*********************
  *      DEFINES
@@ -81,6 +82,11 @@ LV_ATTRIBUTE_TASK_HANDLER uint32_t lv_task_handler(void)
 
     uint32_t handler_start = lv_tick_get();
 
+#if LV_USE_CMDQ
+    /*Apply the updates posted from other threads before the tasks (e.g. the refresh) run*/
+    _lv_cmdq_drain();
+#endif
+
     /* Run all task from the highest to the lowest priority
      * If a lower priority task is executed check task again from the highest priority
      * but on the priority of executed tasks don't run tasks before the executed*/
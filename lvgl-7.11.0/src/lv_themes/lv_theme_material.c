@@ -67,6 +67,9 @@
 
 #define PAD_DEF (lv_disp_get_size_category(NULL) <= LV_DISP_SIZE_MEDIUM ? LV_DPX(15) : (LV_DPX(30)))
 
+/*Index the styles with at least this many properties. Smaller ones are searched faster linearly*/
+#define STYLE_INDEX_MIN_PROP_CNT    8
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -942,6 +945,15 @@ lv_theme_t * lv_theme_material_init(lv_color_t color_primary, lv_color_t color_s
     theme.apply_xcb = NULL;
     theme.apply_cb = theme_apply;
 
+#if LV_STYLE_INDEX
+    /*The styles are not modified after this point so index the large ones*/
+    lv_style_t * style_array = (lv_style_t *)styles;
+    uint32_t i;
+    for(i = 0; i < sizeof(theme_styles_t) / sizeof(lv_style_t); i++) {
+        if(_lv_style_get_prop_cnt(&style_array[i]) >= STYLE_INDEX_MIN_PROP_CNT) lv_style_freeze(&style_array[i]);
+    }
+#endif
+
     lv_obj_report_style_mod(NULL);
 
     return &theme;
@@ -62,6 +62,7 @@ lv_obj_t * lv_arc_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("arc create started");
 
     /*Create the ancestor of arc*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_arc_ext_t));
     lv_obj_t * arc = lv_obj_create(par, copy);
     LV_ASSERT_MEM(arc);
     if(arc == NULL) return NULL;
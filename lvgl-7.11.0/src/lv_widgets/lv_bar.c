@@ -78,6 +78,7 @@ lv_obj_t * lv_bar_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("lv_bar create started");
 
     /*Create the ancestor basic object*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_bar_ext_t));
     lv_obj_t * bar = lv_obj_create(par, copy);
     LV_ASSERT_MEM(bar);
     if(bar == NULL) return NULL;
@@ -62,6 +62,8 @@ lv_obj_t * lv_btn_create(lv_obj_t * par, const lv_obj_t * copy)
 
     lv_obj_t * btn;
 
+    _lv_obj_reserve_ext_attr(sizeof(lv_btn_ext_t));
+
     btn = lv_cont_create(par, copy);
     LV_ASSERT_MEM(btn);
     if(btn == NULL) return NULL;
@@ -74,6 +74,7 @@ lv_obj_t * lv_btnmatrix_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("button matrix create started");
 
     /*Create the ancestor object*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_btnmatrix_ext_t));
     lv_obj_t * btnm = lv_obj_create(par, copy);
     LV_ASSERT_MEM(btnm);
     if(btnm == NULL) return NULL;
@@ -84,6 +84,7 @@ lv_obj_t * lv_calendar_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("calendar create started");
 
     /*Create the ancestor of calendar*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_calendar_ext_t));
     lv_obj_t * calendar = lv_obj_create(par, copy);
     LV_ASSERT_MEM(calendar);
     if(calendar == NULL) return NULL;
@@ -11,6 +11,7 @@
 #include "../lv_misc/lv_debug.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_draw/lv_img_cache.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_themes/lv_theme.h"
 
@@ -21,14 +22,45 @@
  *********************/
 #define LV_OBJX_NAME "lv_canvas"
 
+/*Number of columns transposed together in vertical blur*/
+#define LV_CANVAS_BLUR_TILE         16
+
+/*Number of box blurs to approximate a gaussian blur*/
+#define LV_CANVAS_BLUR_GAUSS_PASSES 3
+
+/*Limit the sigma of gaussian blur to not overflow the calculations*/
+#define LV_CANVAS_BLUR_SIGMA_MAX    1000
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_CANVAS_DIRTY_AREA
+/*The dummy display shared by the drawings between `lv_canvas_draw_begin/end()`*/
+typedef struct {
+    lv_disp_t disp;
+    lv_disp_buf_t disp_buf;
+} lv_canvas_batch_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_res_t lv_canvas_signal(lv_obj_t * canvas, lv_signal_t sign, void * param);
+static void init_dummy_disp(lv_img_dsc_t * dsc, lv_disp_t * disp, lv_disp_buf_t * disp_buf);
+static lv_disp_t * get_dummy_disp(lv_obj_t * canvas, lv_disp_t * disp, lv_disp_buf_t * disp_buf);
+static void set_dummy_disp_antialias(lv_disp_t * disp, lv_img_cf_t cf, lv_color_t color);
+static void invalidate_px_area(lv_obj_t * canvas, const lv_area_t * area);
+#if LV_CANVAS_DIRTY_AREA
+    static void invalidate_dirty_area(lv_obj_t * canvas, const lv_area_t * area);
+#endif
+static void get_points_area(const lv_point_t points[], uint32_t point_cnt, lv_area_t * res);
+static lv_coord_t get_rect_ext_size(const lv_draw_rect_dsc_t * rect_dsc);
+static bool draw_rect_direct(lv_img_dsc_t * dsc, const lv_area_t * coords, const lv_draw_rect_dsc_t * rect_dsc);
+static void fill_rows(lv_img_dsc_t * dsc, const lv_area_t * area, lv_color_t color, lv_opa_t opa);
+static void get_blur_area(const lv_img_dsc_t * dsc, const lv_area_t * area, lv_area_t * res);
+static bool blur_native(lv_img_dsc_t * dsc, const lv_area_t * area, const uint16_t r[], uint8_t pass_cnt, bool ver);
+static void blur_line(const lv_color_t * c_in, const lv_opa_t * a_in, lv_coord_t len, lv_coord_t x1, lv_coord_t x2,
+                      uint16_t r, lv_color_t * c_out, lv_opa_t * a_out);
 static void set_set_px_cb(lv_disp_drv_t * disp_drv, lv_img_cf_t cf);
 
 static void set_px_true_color_alpha(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x,
@@ -58,6 +90,13 @@ static lv_design_cb_t ancestor_design;
 /**********************
  *      MACROS
  **********************/
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+    #define BLUR_GET_GREEN(c)       (((c).ch.green_h << 3) + (c).ch.green_l)
+    #define BLUR_SET_GREEN(c, v)    {(c).ch.green_h = (v) >> 3; (c).ch.green_l = (v) & 0x7;}
+#else
+    #define BLUR_GET_GREEN(c)       ((c).ch.green)
+    #define BLUR_SET_GREEN(c, v)    {(c).ch.green = (v);}
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -74,6 +113,7 @@ lv_obj_t * lv_canvas_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("canvas create started");
 
     /*Create the ancestor of canvas*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_canvas_ext_t));
     lv_obj_t * new_canvas = lv_img_create(par, copy);
     LV_ASSERT_MEM(new_canvas);
     if(new_canvas == NULL) return NULL;
@@ -96,6 +136,10 @@ lv_obj_t * lv_canvas_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->dsc.header.w           = 0;
     ext->dsc.data_size          = 0;
     ext->dsc.data               = NULL;
+#if LV_CANVAS_DIRTY_AREA
+    ext->batch                  = NULL;
+    ext->dirty_valid            = 0;
+#endif
 
     lv_img_set_src(new_canvas, &ext->dsc);
 
@@ -148,6 +192,15 @@ void lv_canvas_set_buffer(lv_obj_t * canvas, void * buf, lv_coord_t w, lv_coord_
     ext->dsc.data      = buf;
 
     lv_img_set_src(canvas, &ext->dsc);
+
+#if LV_CANVAS_DIRTY_AREA
+    /*The shared dummy display needs to draw into the new buffer*/
+    if(ext->batch) {
+        lv_canvas_batch_t * batch = ext->batch;
+        init_dummy_disp(&ext->dsc, &batch->disp, &batch->disp_buf);
+        ext->dirty_valid = 0;
+    }
+#endif
 }
 
 /**
@@ -164,7 +217,13 @@ void lv_canvas_set_px(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_color_t
     lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
 
     lv_img_buf_set_px_color(&ext->dsc, x, y, c);
-    lv_obj_invalidate(canvas);
+
+    lv_area_t a;
+    a.x1 = x;
+    a.y1 = y;
+    a.x2 = x;
+    a.y2 = y;
+    invalidate_px_area(canvas, &a);
 }
 
 /**
@@ -184,7 +243,7 @@ void lv_canvas_set_palette(lv_obj_t * canvas, uint8_t id, lv_color_t c)
     lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
 
     lv_img_buf_set_palette(&ext->dsc, id, c);
-    lv_obj_invalidate(canvas);
+    invalidate_px_area(canvas, NULL);
 }
 
 /*=====================
@@ -256,6 +315,13 @@ void lv_canvas_copy_buf(lv_obj_t * canvas, const void * to_copy, lv_coord_t x, l
         px += ext->dsc.header.w * px_size;
         to_copy8 += w * px_size;
     }
+
+    lv_area_t a;
+    a.x1 = x;
+    a.y1 = y;
+    a.x2 = x + w - 1;
+    a.y2 = y + h - 1;
+    invalidate_px_area(canvas, &a);
 }
 
 /**
@@ -361,7 +427,7 @@ void lv_canvas_transform(lv_obj_t * canvas, lv_img_dsc_t * img, int16_t angle, u
         }
     }
 
-    lv_obj_invalidate(canvas);
+    invalidate_px_area(canvas, NULL);
 #else
     LV_UNUSED(canvas);
     LV_UNUSED(img);
@@ -391,18 +457,12 @@ void lv_canvas_blur_hor(lv_obj_t * canvas, const lv_area_t * area, uint16_t r)
     lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
 
     lv_area_t a;
-    if(area) {
-        lv_area_copy(&a, area);
-        if(a.x1 < 0) a.x1 = 0;
-        if(a.y1 < 0) a.y1 = 0;
-        if(a.x2 > ext->dsc.header.w - 1) a.x2 = ext->dsc.header.w - 1;
-        if(a.y2 > ext->dsc.header.h - 1) a.y2 = ext->dsc.header.h - 1;
-    }
-    else {
-        a.x1 = 0;
-        a.y1 = 0;
-        a.x2 = ext->dsc.header.w - 1;
-        a.y2 = ext->dsc.header.h - 1;
+    get_blur_area(&ext->dsc, area, &a);
+
+    /*True color canvases are blurred directly on their pixels*/
+    if(blur_native(&ext->dsc, &a, &r, 1, false)) {
+        invalidate_px_area(canvas, &a);
+        return;
     }
 
     lv_color_t color = lv_obj_get_style_image_recolor(canvas, LV_CANVAS_PART_MAIN);
@@ -505,7 +565,7 @@ void lv_canvas_blur_hor(lv_obj_t * canvas, const lv_area_t * area, uint16_t r)
             if(has_alpha) asum += opa;
         }
     }
-    lv_obj_invalidate(canvas);
+    invalidate_px_area(canvas, &a);
 
     _lv_mem_buf_release(line_buf);
 }
@@ -525,18 +585,12 @@ void lv_canvas_blur_ver(lv_obj_t * canvas, const lv_area_t * area, uint16_t r)
     lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
 
     lv_area_t a;
-    if(area) {
-        lv_area_copy(&a, area);
-        if(a.x1 < 0) a.x1 = 0;
-        if(a.y1 < 0) a.y1 = 0;
-        if(a.x2 > ext->dsc.header.w - 1) a.x2 = ext->dsc.header.w - 1;
-        if(a.y2 > ext->dsc.header.h - 1) a.y2 = ext->dsc.header.h - 1;
-    }
-    else {
-        a.x1 = 0;
-        a.y1 = 0;
-        a.x2 = ext->dsc.header.w - 1;
-        a.y2 = ext->dsc.header.h - 1;
+    get_blur_area(&ext->dsc, area, &a);
+
+    /*True color canvases are blurred directly on their pixels*/
+    if(blur_native(&ext->dsc, &a, &r, 1, true)) {
+        invalidate_px_area(canvas, &a);
+        return;
     }
 
     lv_color_t color = lv_obj_get_style_image_recolor(canvas, LV_CANVAS_PART_MAIN);
@@ -644,11 +698,61 @@ void lv_canvas_blur_ver(lv_obj_t * canvas, const lv_area_t * area, uint16_t r)
         }
     }
 
-    lv_obj_invalidate(canvas);
+    invalidate_px_area(canvas, &a);
 
     _lv_mem_buf_release(col_buf);
 }
 
+/**
+ * Apply gaussian blur on the canvas.
+ * It's approximated by 3 horizontal and 3 vertical box blurs so its speed doesn't depend on `sigma`.
+ * @param canvas pointer to a canvas object
+ * @param area the area to blur. If `NULL` the whole canvas will be blurred.
+ * @param sigma standard deviation of the gaussian blur in pixels
+ */
+void lv_canvas_blur_gauss(lv_obj_t * canvas, const lv_area_t * area, uint16_t sigma)
+{
+    LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
+
+    if(sigma == 0) return;
+    if(sigma > LV_CANVAS_BLUR_SIGMA_MAX) sigma = LV_CANVAS_BLUR_SIGMA_MAX;
+
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+
+    lv_area_t a;
+    get_blur_area(&ext->dsc, area, &a);
+
+    /* Sizes of the boxes whose variances add up to sigma^2.
+     * Use boxes with the odd size below and above the ideal size to have centered windows.*/
+    int32_t s2 = (int32_t)sigma * sigma;
+    lv_sqrt_res_t w_ideal;
+    _lv_sqrt(4 * s2 + 1, &w_ideal, 0x8000);
+    int32_t wl = w_ideal.i;
+    if((wl & 0x1) == 0) wl--;
+
+    /*Number of passes with the smaller box*/
+    int32_t m_num = 12 * s2 - LV_CANVAS_BLUR_GAUSS_PASSES * (wl * wl + 4 * wl + 3);
+    int32_t m_den = 4 * wl + 4;
+    int32_t m = m_num >= 0 ? 0 : (-m_num * 2 + m_den) / (2 * m_den);
+    if(m > LV_CANVAS_BLUR_GAUSS_PASSES) m = LV_CANVAS_BLUR_GAUSS_PASSES;
+
+    uint16_t r[LV_CANVAS_BLUR_GAUSS_PASSES];
+    uint32_t i;
+    for(i = 0; i < LV_CANVAS_BLUR_GAUSS_PASSES; i++) {
+        r[i] = (int32_t)i < m ? wl : wl + 2;
+    }
+
+    if(blur_native(&ext->dsc, &a, r, LV_CANVAS_BLUR_GAUSS_PASSES, false) == false) {
+        for(i = 0; i < LV_CANVAS_BLUR_GAUSS_PASSES; i++) lv_canvas_blur_hor(canvas, &a, r[i]);
+    }
+
+    if(blur_native(&ext->dsc, &a, r, LV_CANVAS_BLUR_GAUSS_PASSES, true) == false) {
+        for(i = 0; i < LV_CANVAS_BLUR_GAUSS_PASSES; i++) lv_canvas_blur_ver(canvas, &a, r[i]);
+    }
+
+    invalidate_px_area(canvas, &a);
+}
+
 /**
  * Fill the canvas with color
  * @param canvas pointer to a canvas
@@ -670,6 +774,15 @@ void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color, lv_opa_t opa)
         uint32_t row_byte_cnt = (dsc->header.w + 7) >> 3;
         _lv_memset((uint8_t *)dsc->data, opa > LV_OPA_50 ? 0xff : 0x00, row_byte_cnt * dsc->header.h);
     }
+    else if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR || dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED ||
+            dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+        lv_area_t a;
+        a.x1 = 0;
+        a.y1 = 0;
+        a.x2 = dsc->header.w - 1;
+        a.y2 = dsc->header.h - 1;
+        fill_rows(dsc, &a, color, opa);
+    }
     else {
         uint32_t x;
         uint32_t y;
@@ -681,7 +794,7 @@ void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color, lv_opa_t opa)
         }
     }
 
-    lv_obj_invalidate(canvas);
+    invalidate_px_area(canvas, NULL);
 }
 
 /**
@@ -705,53 +818,47 @@ void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
         return;
     }
 
-    /* Create a dummy display to fool the lv_draw function.
-     * It will think it draws to real screen. */
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
     lv_area_t coords;
     coords.x1 = x;
     coords.y1 = y;
     coords.x2 = x + w - 1;
     coords.y2 = y + h - 1;
 
-    lv_disp_t disp;
-    _lv_memset_00(&disp, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
+    /*Plain rectangles are filled directly into the buffer*/
+    if(draw_rect_direct(dsc, &coords, rect_dsc) == false) {
+        /* Create a dummy display to fool the lv_draw function.
+         * It will think it draws to real screen. */
+        lv_area_t mask;
+        mask.x1 = 0;
+        mask.x2 = dsc->header.w - 1;
+        mask.y1 = 0;
+        mask.y2 = dsc->header.h - 1;
 
-    lv_disp_drv_init(&disp.driver);
+        lv_disp_t disp_tmp;
+        lv_disp_buf_t disp_buf_tmp;
+        lv_disp_t * disp = get_dummy_disp(canvas, &disp_tmp, &disp_buf_tmp);
+        set_dummy_disp_antialias(disp, dsc->header.cf, rect_dsc->bg_color);
 
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
+        lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
+        _lv_refr_set_disp_refreshing(disp);
 
-    set_set_px_cb(&disp.driver, dsc->header.cf);
+        lv_draw_rect(&coords, &mask, rect_dsc);
 
-#if LV_ANTIALIAS
-
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_TRANSP;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       rect_dsc->bg_color.full == ctransp.full) {
-        disp.driver.antialiasing = 0;
+        _lv_refr_set_disp_refreshing(refr_ori);
     }
-#endif
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
-
-    lv_draw_rect(&coords, &mask, rect_dsc);
-
-    _lv_refr_set_disp_refreshing(refr_ori);
 
-    lv_obj_invalidate(canvas);
+    /*The value text can be aligned anywhere so invalidate the whole canvas for it*/
+    if(rect_dsc->value_str && rect_dsc->value_opa > LV_OPA_MIN) {
+        invalidate_px_area(canvas, NULL);
+    }
+    else {
+        lv_coord_t ext_size = get_rect_ext_size(rect_dsc);
+        coords.x1 -= ext_size;
+        coords.y1 -= ext_size;
+        coords.x2 += ext_size;
+        coords.y2 += ext_size;
+        invalidate_px_area(canvas, &coords);
+    }
 }
 
 /**
@@ -791,23 +898,12 @@ void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
     coords.x2 = x + max_w - 1;
     coords.y2 = dsc->header.h - 1;
 
-    lv_disp_t disp;
-    _lv_memset_00(&disp, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
-
-    set_set_px_cb(&disp.driver, dsc->header.cf);
+    lv_disp_t disp_tmp;
+    lv_disp_buf_t disp_buf_tmp;
+    lv_disp_t * disp = get_dummy_disp(canvas, &disp_tmp, &disp_buf_tmp);
 
     lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
+    _lv_refr_set_disp_refreshing(disp);
 
     lv_txt_flag_t flag;
     switch(align) {
@@ -831,7 +927,22 @@ void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
 
     _lv_refr_set_disp_refreshing(refr_ori);
 
-    lv_obj_invalidate(canvas);
+#if LV_CANVAS_DIRTY_AREA
+    /*Scrolled texts can be anywhere, else only the lines of the text are drawn*/
+    if(label_draw_dsc->ofs_x == 0 && label_draw_dsc->ofs_y == 0) {
+        lv_point_t size;
+        _lv_txt_get_size(&size, txt, label_draw_dsc->font, label_draw_dsc->letter_space, label_draw_dsc->line_space,
+                         max_w, flag);
+        if(size.y < lv_area_get_height(&coords)) coords.y2 = coords.y1 + size.y - 1;
+    }
+    else {
+        coords.x1 = 0;
+        coords.y1 = 0;
+        coords.x2 = dsc->header.w - 1;
+    }
+#endif
+
+    invalidate_px_area(canvas, &coords);
 }
 
 /**
@@ -873,29 +984,26 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
     coords.x2 = x + header.w - 1;
     coords.y2 = y + header.h - 1;
 
-    lv_disp_t disp;
-    _lv_memset_00(&disp, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
-
-    set_set_px_cb(&disp.driver, dsc->header.cf);
+    lv_disp_t disp_tmp;
+    lv_disp_buf_t disp_buf_tmp;
+    lv_disp_t * disp = get_dummy_disp(canvas, &disp_tmp, &disp_buf_tmp);
 
     lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
+    _lv_refr_set_disp_refreshing(disp);
 
     lv_draw_img(&coords, &mask, src, img_draw_dsc);
 
     _lv_refr_set_disp_refreshing(refr_ori);
 
-    lv_obj_invalidate(canvas);
+    /*Rotated and zoomed images can be drawn out of their coordinates*/
+    _lv_img_buf_get_transformed_area(&coords, header.w, header.h, img_draw_dsc->angle, img_draw_dsc->zoom,
+                                     &img_draw_dsc->pivot);
+    coords.x1 += x;
+    coords.y1 += y;
+    coords.x2 += x;
+    coords.y2 += y;
+
+    invalidate_px_area(canvas, &coords);
 }
 
 /**
@@ -924,32 +1032,13 @@ void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t points[], uint32_t
     mask.y1 = 0;
     mask.y2 = dsc->header.h - 1;
 
-    lv_disp_t disp;
-    _lv_memset_00(&disp, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
-
-    set_set_px_cb(&disp.driver, dsc->header.cf);
-
-#if LV_ANTIALIAS
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_TRANSP;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       line_draw_dsc->color.full == ctransp.full) {
-        disp.driver.antialiasing = 0;
-    }
-#endif
+    lv_disp_t disp_tmp;
+    lv_disp_buf_t disp_buf_tmp;
+    lv_disp_t * disp = get_dummy_disp(canvas, &disp_tmp, &disp_buf_tmp);
+    set_dummy_disp_antialias(disp, dsc->header.cf, line_draw_dsc->color);
 
     lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
+    _lv_refr_set_disp_refreshing(disp);
 
     uint32_t i;
     for(i = 0; i < point_cnt - 1; i++) {
@@ -958,7 +1047,14 @@ void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t points[], uint32_t
 
     _lv_refr_set_disp_refreshing(refr_ori);
 
-    lv_obj_invalidate(canvas);
+    lv_area_t a;
+    get_points_area(points, point_cnt, &a);
+    lv_coord_t ext_size = line_draw_dsc->width / 2 + 1;
+    a.x1 -= ext_size;
+    a.y1 -= ext_size;
+    a.x2 += ext_size;
+    a.y2 += ext_size;
+    invalidate_px_area(canvas, &a);
 }
 
 /**
@@ -988,38 +1084,26 @@ void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t points[], uint32
     mask.y1 = 0;
     mask.y2 = dsc->header.h - 1;
 
-    lv_disp_t disp;
-    _lv_memset_00(&disp, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
-
-    set_set_px_cb(&disp.driver, dsc->header.cf);
-
-#if LV_ANTIALIAS
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_TRANSP;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       poly_draw_dsc->bg_color.full == ctransp.full) {
-        disp.driver.antialiasing = 0;
-    }
-#endif
+    lv_disp_t disp_tmp;
+    lv_disp_buf_t disp_buf_tmp;
+    lv_disp_t * disp = get_dummy_disp(canvas, &disp_tmp, &disp_buf_tmp);
+    set_dummy_disp_antialias(disp, dsc->header.cf, poly_draw_dsc->bg_color);
 
     lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
+    _lv_refr_set_disp_refreshing(disp);
 
     lv_draw_polygon(points, point_cnt, &mask, poly_draw_dsc);
 
     _lv_refr_set_disp_refreshing(refr_ori);
 
-    lv_obj_invalidate(canvas);
+    lv_area_t a;
+    get_points_area(points, point_cnt, &a);
+    lv_coord_t ext_size = get_rect_ext_size(poly_draw_dsc) + 1;
+    a.x1 -= ext_size;
+    a.y1 -= ext_size;
+    a.x2 += ext_size;
+    a.y2 += ext_size;
+    invalidate_px_area(canvas, &a);
 }
 
 /**
@@ -1052,39 +1136,70 @@ void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_
     mask.y1 = 0;
     mask.y2 = dsc->header.h - 1;
 
-    lv_disp_t disp;
-    _lv_memset_00(&disp, sizeof(lv_disp_t));
+    lv_disp_t disp_tmp;
+    lv_disp_buf_t disp_buf_tmp;
+    lv_disp_t * disp = get_dummy_disp(canvas, &disp_tmp, &disp_buf_tmp);
+    set_dummy_disp_antialias(disp, dsc->header.cf, arc_draw_dsc->color);
 
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
+    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(disp);
 
-    lv_disp_drv_init(&disp.driver);
+    lv_draw_arc(x, y, r,  start_angle, end_angle, &mask, arc_draw_dsc);
 
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
+    _lv_refr_set_disp_refreshing(refr_ori);
 
-    set_set_px_cb(&disp.driver, dsc->header.cf);
+    lv_area_t a;
+    a.x1 = x - r;
+    a.y1 = y - r;
+    a.x2 = x + r;
+    a.y2 = y + r;
+    invalidate_px_area(canvas, &a);
+}
 
-#if LV_ANTIALIAS
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_TRANSP;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       arc_draw_dsc->color.full == ctransp.full) {
-        disp.driver.antialiasing = 0;
-    }
-#endif
+#if LV_CANVAS_DIRTY_AREA
+/**
+ * Start drawing many primitives to the canvas.
+ * The drawings until `lv_canvas_draw_end()` share one dummy display
+ * and the canvas is invalidated only once, on the joined area of the drawings.
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_draw_begin(lv_obj_t * canvas)
+{
+    LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
 
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+    if(ext->batch) return;
 
-    lv_draw_arc(x, y, r,  start_angle, end_angle, &mask, arc_draw_dsc);
+    /*If the display can't be allocated the drawings simply use their own*/
+    lv_canvas_batch_t * batch = lv_mem_alloc(sizeof(lv_canvas_batch_t));
+    LV_ASSERT_MEM(batch);
+    if(batch == NULL) return;
 
-    _lv_refr_set_disp_refreshing(refr_ori);
+    init_dummy_disp(&ext->dsc, &batch->disp, &batch->disp_buf);
+    ext->batch = batch;
+    ext->dirty_valid = 0;
+}
 
-    lv_obj_invalidate(canvas);
+/**
+ * Finish the drawings started with `lv_canvas_draw_begin()` and invalidate the drawn area
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_draw_end(lv_obj_t * canvas)
+{
+    LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
+
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+    if(ext->batch == NULL) return;
+
+    lv_mem_free(ext->batch);
+    ext->batch = NULL;
+
+    if(ext->dirty_valid) {
+        ext->dirty_valid = 0;
+        invalidate_dirty_area(canvas, &ext->dirty);
+    }
 }
+#endif
 
 /**********************
  *   STATIC FUNCTIONS
@@ -1107,12 +1222,460 @@ static lv_res_t lv_canvas_signal(lv_obj_t * canvas, lv_signal_t sign, void * par
     if(sign == LV_SIGNAL_GET_TYPE) return lv_obj_handle_get_type_signal(param, LV_OBJX_NAME);
 
     if(sign == LV_SIGNAL_CLEANUP) {
-        /*Nothing to cleanup. (No dynamically allocated memory in 'ext')*/
+        lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+        lv_img_cache_invalidate_transform_src(&ext->dsc);
+#if LV_CANVAS_DIRTY_AREA
+        if(ext->batch) {
+            lv_mem_free(ext->batch);
+            ext->batch = NULL;
+        }
+#endif
     }
 
     return res;
 }
 
+/**
+ * Initialize a dummy display which draws into the buffer of a canvas
+ * @param dsc the image descriptor of the canvas
+ * @param disp the display to initialize
+ * @param disp_buf the display buffer to initialize
+ */
+static void init_dummy_disp(lv_img_dsc_t * dsc, lv_disp_t * disp, lv_disp_buf_t * disp_buf)
+{
+    lv_area_t mask;
+    mask.x1 = 0;
+    mask.x2 = dsc->header.w - 1;
+    mask.y1 = 0;
+    mask.y2 = dsc->header.h - 1;
+
+    _lv_memset_00(disp, sizeof(lv_disp_t));
+
+    lv_disp_buf_init(disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
+    lv_area_copy(&disp_buf->area, &mask);
+
+    lv_disp_drv_init(&disp->driver);
+
+    disp->driver.buffer  = disp_buf;
+    disp->driver.hor_res = dsc->header.w;
+    disp->driver.ver_res = dsc->header.h;
+
+    set_set_px_cb(&disp->driver, dsc->header.cf);
+}
+
+/**
+ * Get the dummy display to draw into a canvas.
+ * Between `lv_canvas_draw_begin/end()` it's the shared display, else the given one is initialized.
+ * @param canvas pointer to a canvas object
+ * @param disp a display to initialize if there is no shared display
+ * @param disp_buf a display buffer to initialize if there is no shared display
+ * @return the display to draw with
+ */
+static lv_disp_t * get_dummy_disp(lv_obj_t * canvas, lv_disp_t * disp, lv_disp_buf_t * disp_buf)
+{
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+
+#if LV_CANVAS_DIRTY_AREA
+    if(ext->batch) {
+        lv_canvas_batch_t * batch = ext->batch;
+        batch->disp.driver.antialiasing = LV_ANTIALIAS;
+        return &batch->disp;
+    }
+#endif
+
+    init_dummy_disp(&ext->dsc, disp, disp_buf);
+    return disp;
+}
+
+/**
+ * Disable anti-aliasing if drawing with transparent color to chroma keyed canvas
+ * @param disp the dummy display of the canvas
+ * @param cf color format of the canvas
+ * @param color the color to draw with
+ */
+static void set_dummy_disp_antialias(lv_disp_t * disp, lv_img_cf_t cf, lv_color_t color)
+{
+#if LV_ANTIALIAS
+    lv_color_t ctransp = LV_COLOR_TRANSP;
+    if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED && color.full == ctransp.full) {
+        disp->driver.antialiasing = 0;
+    }
+#else
+    LV_UNUSED(disp);
+    LV_UNUSED(cf);
+    LV_UNUSED(color);
+#endif
+}
+
+/**
+ * Invalidate the changed pixels of a canvas.
+ * Between `lv_canvas_draw_begin/end()` the area is only saved to invalidate it at the end.
+ * @param canvas pointer to a canvas object
+ * @param area the changed area in pixels of the canvas. `NULL` to invalidate the whole canvas.
+ */
+static void invalidate_px_area(lv_obj_t * canvas, const lv_area_t * area)
+{
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+
+    /*The rotated or zoomed canvas needs to be transformed again*/
+    lv_img_cache_invalidate_transform_src(&ext->dsc);
+
+#if LV_CANVAS_DIRTY_AREA
+    lv_area_t a;
+    a.x1 = 0;
+    a.y1 = 0;
+    a.x2 = ext->dsc.header.w - 1;
+    a.y2 = ext->dsc.header.h - 1;
+    if(area && _lv_area_intersect(&a, &a, area) == false) return;
+
+    if(ext->batch) {
+        if(ext->dirty_valid) _lv_area_join(&ext->dirty, &ext->dirty, &a);
+        else lv_area_copy(&ext->dirty, &a);
+        ext->dirty_valid = 1;
+        return;
+    }
+
+    invalidate_dirty_area(canvas, &a);
+#else
+    LV_UNUSED(area);
+    lv_obj_invalidate(canvas);
+#endif
+}
+
+#if LV_CANVAS_DIRTY_AREA
+/**
+ * Invalidate the area of the object where some pixels of the canvas are shown
+ * @param canvas pointer to a canvas object
+ * @param area the changed area in pixels of the canvas
+ */
+static void invalidate_dirty_area(lv_obj_t * canvas, const lv_area_t * area)
+{
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+
+    /*With transformation, offset or tiling the pixels are shown elsewhere or many times*/
+    int32_t zoom_final = lv_obj_get_style_transform_zoom(canvas, LV_IMG_PART_MAIN);
+    zoom_final = (zoom_final * ext->img.zoom) >> 8;
+    int32_t angle_final = lv_obj_get_style_transform_angle(canvas, LV_IMG_PART_MAIN);
+    angle_final += ext->img.angle;
+
+    if(zoom_final != LV_IMG_ZOOM_NONE || angle_final != 0 ||
+       ext->img.offset.x != 0 || ext->img.offset.y != 0 ||
+       lv_obj_get_width(canvas) != ext->dsc.header.w || lv_obj_get_height(canvas) != ext->dsc.header.h) {
+        lv_obj_invalidate(canvas);
+        return;
+    }
+
+    lv_area_t a;
+    a.x1 = canvas->coords.x1 + area->x1;
+    a.y1 = canvas->coords.y1 + area->y1;
+    a.x2 = canvas->coords.x1 + area->x2;
+    a.y2 = canvas->coords.y1 + area->y2;
+    lv_obj_invalidate_area(canvas, &a);
+}
+#endif
+
+/**
+ * Get the bounding box of points
+ * @param points array of points
+ * @param point_cnt number of points
+ * @param res store the bounding box here
+ */
+static void get_points_area(const lv_point_t points[], uint32_t point_cnt, lv_area_t * res)
+{
+    res->x1 = LV_COORD_MAX;
+    res->y1 = LV_COORD_MAX;
+    res->x2 = LV_COORD_MIN;
+    res->y2 = LV_COORD_MIN;
+
+    uint32_t i;
+    for(i = 0; i < point_cnt; i++) {
+        res->x1 = LV_MATH_MIN(res->x1, points[i].x);
+        res->y1 = LV_MATH_MIN(res->y1, points[i].y);
+        res->x2 = LV_MATH_MAX(res->x2, points[i].x);
+        res->y2 = LV_MATH_MAX(res->y2, points[i].y);
+    }
+}
+
+/**
+ * Get how far a rectangle is drawn out of its coordinates by its outline and shadow
+ * @param rect_dsc descriptor of the rectangle
+ * @return the extra size on each side
+ */
+static lv_coord_t get_rect_ext_size(const lv_draw_rect_dsc_t * rect_dsc)
+{
+    lv_coord_t s = 0;
+    if(rect_dsc->outline_width && rect_dsc->outline_opa > LV_OPA_MIN) {
+        s = LV_MATH_MAX(rect_dsc->outline_width + rect_dsc->outline_pad, 0);
+    }
+
+    if(rect_dsc->shadow_width && rect_dsc->shadow_opa > LV_OPA_MIN) {
+        lv_coord_t sh = rect_dsc->shadow_width / 2 + 1;
+        sh += rect_dsc->shadow_spread;
+        sh += LV_MATH_MAX(LV_MATH_ABS(rect_dsc->shadow_ofs_x), LV_MATH_ABS(rect_dsc->shadow_ofs_y));
+        s = LV_MATH_MAX(s, sh);
+    }
+
+    return s;
+}
+
+/**
+ * Fill a rectangle of a true color canvas directly if it has only an opaque background
+ * @param dsc the image descriptor of the canvas
+ * @param coords coordinates of the rectangle
+ * @param rect_dsc descriptor of the rectangle
+ * @return true: the rectangle is drawn; false: it needs to be drawn with `lv_draw_rect()`
+ */
+static bool draw_rect_direct(lv_img_dsc_t * dsc, const lv_area_t * coords, const lv_draw_rect_dsc_t * rect_dsc)
+{
+    if(dsc->header.cf != LV_IMG_CF_TRUE_COLOR && dsc->header.cf != LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
+       dsc->header.cf != LV_IMG_CF_TRUE_COLOR_ALPHA) return false;
+
+    if(rect_dsc->radius != 0) return false;
+    if(rect_dsc->bg_opa < LV_OPA_MAX) return false;
+    if(rect_dsc->bg_grad_dir != LV_GRAD_DIR_NONE && rect_dsc->bg_color.full != rect_dsc->bg_grad_color.full) return false;
+    if(rect_dsc->border_width && rect_dsc->border_opa > LV_OPA_MIN) return false;
+    if(rect_dsc->outline_width && rect_dsc->outline_opa > LV_OPA_MIN) return false;
+    if(rect_dsc->shadow_width && rect_dsc->shadow_opa > LV_OPA_MIN) return false;
+    if(rect_dsc->pattern_image && rect_dsc->pattern_opa > LV_OPA_MIN) return false;
+    if(rect_dsc->value_str && rect_dsc->value_opa > LV_OPA_MIN) return false;
+    if(rect_dsc->bg_blend_mode != LV_BLEND_MODE_NORMAL) return false;
+    if(lv_draw_mask_get_cnt() != 0) return false;
+
+    lv_area_t a;
+    a.x1 = 0;
+    a.y1 = 0;
+    a.x2 = dsc->header.w - 1;
+    a.y2 = dsc->header.h - 1;
+    if(_lv_area_intersect(&a, &a, coords)) fill_rows(dsc, &a, rect_dsc->bg_color, LV_OPA_COVER);
+
+    return true;
+}
+
+/**
+ * Get the area to blur on a canvas
+ * @param dsc the image descriptor of the canvas
+ * @param area the area to blur or `NULL` for the whole canvas
+ * @param res store the area clipped to the canvas here
+ */
+static void get_blur_area(const lv_img_dsc_t * dsc, const lv_area_t * area, lv_area_t * res)
+{
+    if(area) {
+        lv_area_copy(res, area);
+        if(res->x1 < 0) res->x1 = 0;
+        if(res->y1 < 0) res->y1 = 0;
+        if(res->x2 > dsc->header.w - 1) res->x2 = dsc->header.w - 1;
+        if(res->y2 > dsc->header.h - 1) res->y2 = dsc->header.h - 1;
+    }
+    else {
+        res->x1 = 0;
+        res->y1 = 0;
+        res->x2 = dsc->header.w - 1;
+        res->y2 = dsc->header.h - 1;
+    }
+}
+
+/**
+ * Blur a true color canvas directly on its pixels with running sums.
+ * The lines are loaded into continuous buffers where all the passes are applied before storing them.
+ * In vertical blur a tile of columns is transposed into the buffers to read and write the canvas row by row.
+ * @param dsc the image descriptor of the canvas
+ * @param area the area to blur. Should be on the canvas.
+ * @param r window size of the passes
+ * @param pass_cnt number of passes
+ * @param ver false: horizontal blur; true: vertical blur
+ * @return true: ready; false: the color format is not supported or out of memory
+ */
+static bool blur_native(lv_img_dsc_t * dsc, const lv_area_t * area, const uint16_t r[], uint8_t pass_cnt, bool ver)
+{
+    lv_img_cf_t cf = dsc->header.cf;
+    if(cf != LV_IMG_CF_TRUE_COLOR && cf != LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
+       cf != LV_IMG_CF_TRUE_COLOR_ALPHA) return false;
+    if(area->x1 > area->x2 || area->y1 > area->y2) return true;
+
+    bool has_alpha = cf == LV_IMG_CF_TRUE_COLOR_ALPHA;
+    uint32_t px_size = lv_img_cf_get_px_size(cf) >> 3;
+    uint32_t stride = dsc->header.w * px_size;
+    /*The pixels are `lv_color_t`s (with the alpha byte in it with 32 bit color depth)*/
+    bool px_native = px_size == sizeof(lv_color_t);
+    lv_coord_t len = ver ? dsc->header.h : dsc->header.w;
+    lv_coord_t x1 = ver ? area->y1 : area->x1;
+    lv_coord_t x2 = ver ? area->y2 : area->x2;
+    lv_coord_t seg_len = x2 - x1 + 1;
+    lv_coord_t line_cnt = ver ? lv_area_get_width(area) : lv_area_get_height(area);
+
+    /*Get memory for the lines. Use smaller tiles if there is not enough memory.*/
+    lv_coord_t tile = ver ? LV_MATH_MIN(LV_CANVAS_BLUR_TILE, line_cnt) : 1;
+    uint8_t * mem = NULL;
+    while(tile > 0) {
+        mem = lv_mem_alloc((tile * len + seg_len) * (sizeof(lv_color_t) + sizeof(lv_opa_t)));
+        if(mem) break;
+        tile = tile / 2;
+    }
+    if(mem == NULL) return false;
+
+    lv_color_t * c_buf = (lv_color_t *)mem;
+    lv_color_t * c_out = c_buf + tile * len;
+    lv_opa_t * a_buf = (lv_opa_t *)(c_out + seg_len);
+    lv_opa_t * a_out = a_buf + tile * len;
+
+    lv_coord_t l;
+    for(l = 0; l < line_cnt; l += tile) {
+        lv_coord_t tile_act = LV_MATH_MIN(tile, line_cnt - l);
+        lv_coord_t i;
+        lv_coord_t t;
+        const uint8_t * px;
+
+        /*Load the lines. Read each row only once in vertical blur.*/
+        if(ver) {
+            for(i = 0; i < len; i++) {
+                px = dsc->data + i * stride + (area->x1 + l) * px_size;
+                for(t = 0; t < tile_act; t++) {
+                    if(px_native) c_buf[t * len + i] = *((const lv_color_t *)px);
+                    else _lv_memcpy_small(&c_buf[t * len + i], px, sizeof(lv_color_t));
+                    if(has_alpha) a_buf[t * len + i] = px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                    px += px_size;
+                }
+            }
+        }
+        else {
+            px = dsc->data + (area->y1 + l) * stride;
+            if(px_native) _lv_memcpy(c_buf, px, len * sizeof(lv_color_t));
+            for(i = 0; i < len && (has_alpha || px_native == false); i++) {
+                if(px_native == false) _lv_memcpy_small(&c_buf[i], px, sizeof(lv_color_t));
+                if(has_alpha) a_buf[i] = px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                px += px_size;
+            }
+        }
+
+        /*Apply all passes on the lines*/
+        for(t = 0; t < tile_act; t++) {
+            lv_color_t * c_line = &c_buf[t * len];
+            lv_opa_t * a_line = has_alpha ? &a_buf[t * len] : NULL;
+            uint8_t p;
+            for(p = 0; p < pass_cnt; p++) {
+                blur_line(c_line, a_line, len, x1, x2, r[p], c_out, a_out);
+                _lv_memcpy(&c_line[x1], c_out, seg_len * sizeof(lv_color_t));
+                if(has_alpha) _lv_memcpy(&a_line[x1], a_out, seg_len);
+            }
+        }
+
+        /*Store the blurred segment of the lines*/
+        uint8_t * px_w;
+        if(ver) {
+            for(i = x1; i <= x2; i++) {
+                px_w = (uint8_t *)dsc->data + i * stride + (area->x1 + l) * px_size;
+                for(t = 0; t < tile_act; t++) {
+                    if(px_native) *((lv_color_t *)px_w) = c_buf[t * len + i];
+                    else _lv_memcpy_small(px_w, &c_buf[t * len + i], sizeof(lv_color_t));
+                    if(has_alpha) px_w[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = a_buf[t * len + i];
+                    px_w += px_size;
+                }
+            }
+        }
+        else {
+            px_w = (uint8_t *)dsc->data + (area->y1 + l) * stride + x1 * px_size;
+            if(px_native) _lv_memcpy(px_w, &c_buf[x1], seg_len * sizeof(lv_color_t));
+            for(i = x1; i <= x2 && (has_alpha || px_native == false); i++) {
+                if(px_native == false) _lv_memcpy_small(px_w, &c_buf[i], sizeof(lv_color_t));
+                if(has_alpha) px_w[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = a_buf[i];
+                px_w += px_size;
+            }
+        }
+    }
+
+    lv_mem_free(mem);
+
+    return true;
+}
+
+/**
+ * Box blur a segment of a line by adding the entering and subtracting the leaving pixels of the window.
+ * Out of the line the first and last pixels are repeated.
+ * @param c_in colors of the whole line
+ * @param a_in opacities of the whole line or `NULL` if the line has no alpha
+ * @param len length of the line
+ * @param x1 first pixel of the segment to blur
+ * @param x2 last pixel of the segment to blur
+ * @param r size of the window
+ * @param c_out store the colors of the segment here
+ * @param a_out store the opacities of the segment here (if `a_in != NULL`)
+ */
+static void blur_line(const lv_color_t * c_in, const lv_opa_t * a_in, lv_coord_t len, lv_coord_t x1, lv_coord_t x2,
+                      uint16_t r, lv_color_t * c_out, lv_opa_t * a_out)
+{
+    int32_t r_back = r / 2;
+    int32_t r_front = r / 2;
+    if((r & 0x1) == 0) r_back--;
+
+    /*Divide by `r` with a multiplication. `sum * r_inv` fits into 32 bits as `sum <= 255 * r`*/
+    uint32_t r_inv = 0x1000000 / r;
+
+    uint32_t rsum = 0;
+    uint32_t gsum = 0;
+    uint32_t bsum = 0;
+    uint32_t asum = 0;
+
+    int32_t x;
+    int32_t x_safe;
+    for(x = x1 - r_back; x <= x1 + r_front; x++) {
+        x_safe = LV_MATH_MAX(x, 0);
+        x_safe = LV_MATH_MIN(x_safe, len - 1);
+        rsum += c_in[x_safe].ch.red;
+        gsum += BLUR_GET_GREEN(c_in[x_safe]);
+        bsum += c_in[x_safe].ch.blue;
+        if(a_in) asum += a_in[x_safe];
+    }
+
+    for(x = x1; x <= x2; x++) {
+        lv_color_t c = c_in[x];
+        /*Keep the color of the fully transparent pixels*/
+        if(a_in == NULL || asum) {
+            c.ch.red = (rsum * r_inv + 0x800000) >> 24;
+            BLUR_SET_GREEN(c, (gsum * r_inv + 0x800000) >> 24);
+            c.ch.blue = (bsum * r_inv + 0x800000) >> 24;
+        }
+        c_out[x - x1] = c;
+
+        int32_t x_back = LV_MATH_MAX(x - r_back, 0);
+        int32_t x_front = LV_MATH_MIN(x + 1 + r_front, len - 1);
+        rsum += c_in[x_front].ch.red - c_in[x_back].ch.red;
+        gsum += BLUR_GET_GREEN(c_in[x_front]) - BLUR_GET_GREEN(c_in[x_back]);
+        bsum += c_in[x_front].ch.blue - c_in[x_back].ch.blue;
+
+        if(a_in) {
+            a_out[x - x1] = (asum * r_inv + 0x800000) >> 24;
+            asum += a_in[x_front] - a_in[x_back];
+        }
+    }
+}
+
+/**
+ * Fill an area of a true color canvas by setting the first row and copying it to the others
+ * @param dsc the image descriptor of the canvas
+ * @param area the area to fill. Should be on the canvas.
+ * @param color the color to set
+ * @param opa the opacity to set (used only with `LV_IMG_CF_TRUE_COLOR_ALPHA`)
+ */
+static void fill_rows(lv_img_dsc_t * dsc, const lv_area_t * area, lv_color_t color, lv_opa_t opa)
+{
+    lv_coord_t x;
+    for(x = area->x1; x <= area->x2; x++) {
+        lv_img_buf_set_px_color(dsc, x, area->y1, color);
+        lv_img_buf_set_px_alpha(dsc, x, area->y1, opa);
+    }
+
+    uint32_t px_size = lv_img_cf_get_px_size(dsc->header.cf) >> 3;
+    uint32_t stride = dsc->header.w * px_size;
+    uint32_t row_size = lv_area_get_width(area) * px_size;
+    const uint8_t * first = dsc->data + stride * area->y1 + px_size * area->x1;
+    uint8_t * row = (uint8_t *)first + stride;
+    lv_coord_t y;
+    for(y = area->y1 + 1; y <= area->y2; y++) {
+        _lv_memcpy(row, first, row_size);
+        row += stride;
+    }
+}
+
 static void set_set_px_cb(lv_disp_drv_t * disp_drv, lv_img_cf_t cf)
 {
     switch(cf) {
@@ -33,6 +33,11 @@ typedef struct {
     lv_img_ext_t img; /*Ext. of ancestor*/
     /*New data for this type */
     lv_img_dsc_t dsc;
+#if LV_CANVAS_DIRTY_AREA
+    lv_area_t dirty;    /*The area drawn since `lv_canvas_draw_begin()`*/
+    void * batch;       /*The dummy display shared by the drawings between `lv_canvas_draw_begin/end()`*/
+    uint8_t dirty_valid : 1;
+#endif
 } lv_canvas_ext_t;
 
 /*Canvas part*/
@@ -116,6 +121,22 @@ lv_img_dsc_t * lv_canvas_get_img(lv_obj_t * canvas);
  * Other functions
  *====================*/
 
+#if LV_CANVAS_DIRTY_AREA
+/**
+ * Start drawing many primitives to the canvas.
+ * The drawings until `lv_canvas_draw_end()` share one dummy display
+ * and the canvas is invalidated only once, on the joined area of the drawings.
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_draw_begin(lv_obj_t * canvas);
+
+/**
+ * Finish the drawings started with `lv_canvas_draw_begin()` and invalidate the drawn area
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_draw_end(lv_obj_t * canvas);
+#endif
+
 /**
  * Copy a buffer to the canvas
  * @param canvas pointer to a canvas object
@@ -164,6 +185,15 @@ void lv_canvas_blur_hor(lv_obj_t * canvas, const lv_area_t * area, uint16_t r);
  */
 void lv_canvas_blur_ver(lv_obj_t * canvas, const lv_area_t * area, uint16_t r);
 
+/**
+ * Apply gaussian blur on the canvas.
+ * It's approximated by 3 horizontal and 3 vertical box blurs so its speed doesn't depend on `sigma`.
+ * @param canvas pointer to a canvas object
+ * @param area the area to blur. If `NULL` the whole canvas will be blurred.
+ * @param sigma standard deviation of the gaussian blur in pixels
+ */
+void lv_canvas_blur_gauss(lv_obj_t * canvas, const lv_area_t * area, uint16_t sigma);
+
 /**
  * Fill the canvas with color
  * @param canvas pointer to a canvas
@@ -29,6 +29,7 @@
 #define LV_CHART_AXIS_MINOR_TICK_LEN_COE 2 / 3
 #define LV_CHART_LABEL_ITERATOR_FORWARD 1
 #define LV_CHART_LABEL_ITERATOR_REVERSE 0
+#define LV_CHART_LINE_POINT_CNT 64  /*Number of points drawn with one polyline*/
 
 /**********************
  *      TYPEDEFS
@@ -55,6 +56,12 @@ static void draw_cursors(lv_obj_t * chart, const lv_area_t * series_area, const
 static void draw_axes(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * mask);
 static void invalidate_lines(lv_obj_t * chart, uint16_t i);
 static void invalidate_columns(lv_obj_t * chart, uint16_t i);
+#if LV_CHART_STREAM
+static void draw_series_line_decimated(lv_obj_t * chart, lv_chart_series_t * ser, const lv_area_t * series_area,
+                                       const lv_area_t * series_mask, const lv_draw_line_dsc_t * line_dsc,
+                                       lv_draw_rect_dsc_t * area_dsc, lv_draw_mask_fade_param_t * fade_p);
+static void invalidate_series(lv_obj_t * chart);
+#endif
 static void get_next_axis_label(lv_chart_label_iterator_t * iterator, char * buf);
 static inline bool is_tick_with_label(uint8_t tick_num, lv_chart_axis_cfg_t * axis);
 static lv_chart_label_iterator_t create_axis_label_iter(const char * list, uint8_t iterator_dir);
@@ -85,6 +92,7 @@ lv_obj_t * lv_chart_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("chart create started");
 
     /*Create the ancestor basic object*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_chart_ext_t));
     lv_obj_t * chart = lv_obj_create(par, copy);
     LV_ASSERT_MEM(chart);
     if(chart == NULL) return NULL;
@@ -473,7 +481,12 @@ void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y)
         ser->points[ser->start_point] =
             y; /*This was the place of the former left most value, after shifting it is the rightmost*/
         ser->start_point = (ser->start_point + 1) % ext->point_cnt;
+#if LV_CHART_STREAM
+        /*Only the series move, not the axes*/
+        invalidate_series(chart);
+#else
         lv_chart_refresh(chart);
+#endif
     }
     else if(ext->update_mode == LV_CHART_UPDATE_MODE_CIRCULAR) {
         ser->points[ser->start_point] = y;
@@ -485,6 +498,43 @@ void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y)
     }
 }
 
+#if LV_CHART_STREAM
+/**
+ * Add several points to the end of a data line at once.
+ * Only the last `point count` values are kept if there are more of them.
+ * @param chart pointer to chart object
+ * @param ser pointer to a data series on 'chart'
+ * @param y_array the new values, the last one will be the most right
+ * @param cnt number of values in `y_array`
+ */
+void lv_chart_set_next_array(lv_obj_t * chart, lv_chart_series_t * ser, const lv_coord_t y_array[], uint32_t cnt)
+{
+    LV_ASSERT_OBJ(chart, LV_OBJX_NAME);
+    LV_ASSERT_NULL(ser);
+    LV_ASSERT_NULL(y_array);
+
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(cnt == 0) return;
+
+    /*The older values would be overwritten anyway*/
+    uint32_t start = ser->start_point;
+    if(cnt > ext->point_cnt) {
+        start = (start + cnt - ext->point_cnt) % ext->point_cnt;
+        y_array += cnt - ext->point_cnt;
+        cnt = ext->point_cnt;
+    }
+
+    /*Copy in at most two parts around the end of the ring buffer*/
+    uint32_t part = LV_MATH_MIN(cnt, ext->point_cnt - start);
+    _lv_memcpy(&ser->points[start], y_array, part * sizeof(lv_coord_t));
+    if(cnt > part) _lv_memcpy(ser->points, &y_array[part], (cnt - part) * sizeof(lv_coord_t));
+
+    ser->start_point = (start + cnt) % ext->point_cnt;
+
+    invalidate_series(chart);
+}
+#endif
+
 /**
  * Set update mode of the chart object.
  * @param chart pointer to a chart object
@@ -1180,6 +1230,15 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
         area_dsc.bg_color = ser->color;
         area_dsc.bg_grad_color = ser->color;
 
+#if LV_CHART_STREAM
+        /*Draw only the minimum and maximum of the pixel columns if there are more points than columns*/
+        if(ext->point_cnt > w) {
+            draw_series_line_decimated(chart, ser, series_area, &series_mask, &line_dsc,
+                                       has_area ? &area_dsc : NULL, has_fade ? &mask_fade_p : NULL);
+            continue;
+        }
+#endif
+
         lv_coord_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
 
         p1.x = 0 + x_ofs;
@@ -1191,6 +1250,10 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
         y_tmp = y_tmp / (ext->ymax[ser->y_axis] - ext->ymin[ser->y_axis]);
         p2.y   = h - y_tmp + y_ofs;
 
+        /*Collect the connected points and draw them as polylines*/
+        lv_point_t line_points[LV_CHART_LINE_POINT_CNT];
+        uint16_t line_cnt = 0;
+
         for(i = 0; i < ext->point_cnt; i++) {
             p1.x = p2.x;
             p1.y = p2.y;
@@ -1205,7 +1268,13 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
 
             /*Don't draw the first point. A second point is also required to draw the line*/
             if(i != 0 && ser->points[p_prev] != LV_CHART_POINT_DEF && ser->points[p_act] != LV_CHART_POINT_DEF) {
-                lv_draw_line(&p1, &p2, &series_mask, &line_dsc);
+                if(line_cnt == 0) line_points[line_cnt++] = p1;
+                line_points[line_cnt++] = p2;
+                if(line_cnt == LV_CHART_LINE_POINT_CNT) {
+                    lv_draw_polyline(line_points, line_cnt, &series_mask, &line_dsc);
+                    line_points[0] = p2;
+                    line_cnt = 1;
+                }
 
                 lv_coord_t y_top = LV_MATH_MIN(p1.y, p2.y);
                 if(has_area && y_top <= clip_area->y2) {
@@ -1228,46 +1297,155 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
                     lv_draw_mask_remove_id(mask_fade_id);
                 }
             }
+            /*Leave a gap at the missing points*/
+            else {
+                if(line_cnt > 1) lv_draw_polyline(line_points, line_cnt, &series_mask, &line_dsc);
+                line_cnt = 0;
+            }
 
-            if(point_radius) {
-                lv_area_t point_area;
+            p_prev = p_act;
+        }
+
+        if(line_cnt > 1) lv_draw_polyline(line_points, line_cnt, &series_mask, &line_dsc);
 
-                point_area.x1 = p1.x;
+        /*Draw the points on the lines*/
+        if(point_radius) {
+            for(i = 0; i < ext->point_cnt; i++) {
+                p_act = (start_point + i) % ext->point_cnt;
+                if(ser->points[p_act] == LV_CHART_POINT_DEF) continue;
+
+                y_tmp = (int32_t)((int32_t)ser->points[p_act] - ext->ymin[ser->y_axis]) * h;
+                y_tmp = y_tmp / (ext->ymax[ser->y_axis] - ext->ymin[ser->y_axis]);
+
+                lv_area_t point_area;
+                point_area.x1 = (ext->point_cnt > 1 ? (w * i) / (ext->point_cnt - 1) : 0) + x_ofs;
                 point_area.x2 = point_area.x1 + point_radius;
                 point_area.x1 -= point_radius;
 
-                point_area.y1 = p1.y;
+                point_area.y1 = h - y_tmp + y_ofs;
                 point_area.y2 = point_area.y1 + point_radius;
                 point_area.y1 -= point_radius;
 
-                if(ser->points[p_act] != LV_CHART_POINT_DEF) {
-                    /*Don't limit to `series_mask` to get full circles on the ends*/
-                    lv_draw_rect(&point_area, clip_area, &point_dsc);
-                }
+                /*Don't limit to `series_mask` to get full circles on the ends*/
+                lv_draw_rect(&point_area, clip_area, &point_dsc);
             }
-
-            p_prev = p_act;
         }
+    }
+}
 
-        /*Draw the last point*/
-        if(point_radius) {
-            lv_area_t point_area;
+#if LV_CHART_STREAM
+/**
+ * Draw a data line which has more points than pixel columns.
+ * The points of a pixel column are reduced to their minimum and maximum.
+ * A vertical line is drawn between them and an other line connects the columns.
+ * The points are not marked with circles.
+ * @param chart pointer to chart object
+ * @param ser pointer to the data series to draw
+ * @param series_area the area of the series
+ * @param series_mask the series area where to draw
+ * @param line_dsc descriptor of the lines
+ * @param area_dsc descriptor of the area below the line or NULL to not draw it
+ * @param fade_p parameter of the mask to fade the area or NULL to not fade it
+ */
+static void draw_series_line_decimated(lv_obj_t * chart, lv_chart_series_t * ser, const lv_area_t * series_area,
+                                       const lv_area_t * series_mask, const lv_draw_line_dsc_t * line_dsc,
+                                       lv_draw_rect_dsc_t * area_dsc, lv_draw_mask_fade_param_t * fade_p)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    int32_t w = lv_area_get_width(series_area);
+    int32_t h = lv_area_get_height(series_area);
+    int32_t ymin = ext->ymin[ser->y_axis];
+    int32_t yrange = ext->ymax[ser->y_axis] - ymin;
+    uint32_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+    int32_t last_id = ext->point_cnt - 1;
+
+    /*Only the points around the area to draw are required*/
+    int32_t x_min = series_mask->x1 - series_area->x1 - line_dsc->width - 1;
+    int32_t x_max = series_mask->x2 - series_area->x1 + line_dsc->width + 1;
+    int32_t i_start = x_min <= 0 ? 0 : (x_min * last_id) / w;
+    int32_t i_end = x_max >= w ? last_id : ((x_max + 1) * last_id) / w;
+    if(i_end > last_id) i_end = last_id;
+
+    lv_point_t prev = {0, 0};
+    bool prev_valid = false;
+    lv_coord_t col_x = 0;
+    lv_coord_t col_first = 0;
+    lv_coord_t col_last = 0;
+    lv_coord_t col_min = 0;
+    lv_coord_t col_max = 0;
+    uint32_t col_cnt = 0;
+
+    int32_t i;
+    for(i = i_start; i <= i_end + 1; i++) {
+        bool end = i > i_end ? true : false;
+        lv_coord_t x = 0;
+        lv_coord_t v = LV_CHART_POINT_DEF;
+        if(!end) {
+            x = (lv_coord_t)((w * i) / last_id + series_area->x1);
+            v = ser->points[(start_point + i) % ext->point_cnt];
+        }
 
-            point_area.x1 = p2.x;
-            point_area.x2 = point_area.x1 + point_radius;
-            point_area.x1 -= point_radius;
+        /*Draw the column if all of its points are collected*/
+        if(col_cnt && (end || x != col_x || v == LV_CHART_POINT_DEF)) {
+            lv_point_t p1;
+            lv_point_t p2;
+            if(prev_valid) {
+                p2.x = col_x;
+                p2.y = col_first;
+                lv_draw_line(&prev, &p2, series_mask, line_dsc);
+            }
 
-            point_area.y1 = p2.y;
-            point_area.y2 = point_area.y1 + point_radius;
-            point_area.y1 -= point_radius;
+            if(col_min != col_max) {
+                p1.x = col_x;
+                p1.y = col_min;
+                p2.x = col_x;
+                p2.y = col_max;
+                lv_draw_line(&p1, &p2, series_mask, line_dsc);
+            }
 
-            if(ser->points[p_act] != LV_CHART_POINT_DEF) {
-                /*Don't limit to `series_mask` to get full circles on the ends*/
-                lv_draw_rect(&point_area, clip_area, &point_dsc);
+            if(area_dsc && (prev_valid || col_cnt > 1)) {
+                lv_area_t a;
+                a.x1 = prev_valid ? prev.x + 1 : col_x;
+                a.x2 = col_x;
+                a.y1 = col_min;
+                a.y2 = series_area->y2;
+
+                int16_t mask_fade_id = LV_MASK_ID_INV;
+                if(fade_p) mask_fade_id = lv_draw_mask_add(fade_p, NULL);
+                lv_draw_rect(&a, series_mask, area_dsc);
+                lv_draw_mask_remove_id(mask_fade_id);
             }
+
+            prev.x = col_x;
+            prev.y = col_last;
+            prev_valid = true;
+            col_cnt = 0;
         }
+
+        if(end) break;
+
+        /*Leave a gap at the missing points*/
+        if(v == LV_CHART_POINT_DEF) {
+            prev_valid = false;
+            continue;
+        }
+
+        lv_coord_t y = (lv_coord_t)(h - ((v - ymin) * h) / yrange + series_area->y1);
+        if(col_cnt == 0) {
+            col_x = x;
+            col_first = y;
+            col_min = y;
+            col_max = y;
+        }
+        else {
+            if(y < col_min) col_min = y;
+            if(y > col_max) col_max = y;
+        }
+        col_last = y;
+        col_cnt++;
     }
 }
+#endif
 
 /**
  * Draw the data lines as columns on a chart
@@ -1828,6 +2006,26 @@ static void invalidate_lines(lv_obj_t * chart, uint16_t i)
     }
 }
 
+#if LV_CHART_STREAM
+/**
+ * Invalidate only the series area of a chart, where the lines and columns are drawn
+ * @param chart pointer to chart object
+ */
+static void invalidate_series(lv_obj_t * chart)
+{
+    lv_style_int_t line_width = lv_obj_get_style_line_width(chart, LV_CHART_PART_SERIES);
+    lv_style_int_t point_radius = lv_obj_get_style_size(chart, LV_CHART_PART_SERIES);
+
+    lv_area_t coords;
+    lv_chart_get_series_area(chart, &coords);
+    coords.x1 -= line_width + point_radius;
+    coords.x2 += line_width + point_radius;
+    coords.y1 -= line_width + point_radius;
+    coords.y2 += line_width + point_radius;
+    lv_obj_invalidate_area(chart, &coords);
+}
+#endif
+
 /**
  * invalid area of the new column data lines on a chart
  * @param chart pointer to chart object
@@ -243,6 +243,18 @@ void lv_chart_set_points(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y
  */
 void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y);
 
+#if LV_CHART_STREAM
+/**
+ * Add several points to the end of a data line at once.
+ * Only the last `point count` values are kept if there are more of them.
+ * @param chart pointer to chart object
+ * @param ser pointer to a data series on 'chart'
+ * @param y_array the new values, the last one will be the most right
+ * @param cnt number of values in `y_array`
+ */
+void lv_chart_set_next_array(lv_obj_t * chart, lv_chart_series_t * ser, const lv_coord_t y_array[], uint32_t cnt);
+#endif
+
 /**
  * Set update mode of the chart object.
  * @param chart pointer to a chart object
@@ -52,6 +52,7 @@ lv_obj_t * lv_checkbox_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("check box create started");
 
     /*Create the ancestor basic object*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_checkbox_ext_t));
     lv_obj_t * cb = lv_btn_create(par, copy);
     LV_ASSERT_MEM(cb);
     if(cb == NULL) return NULL;
@@ -21,6 +21,7 @@
 #include "../lv_misc/lv_area.h"
 #include "../lv_misc/lv_color.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_core/lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -34,6 +35,13 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_CONT_LAYOUT_DEFER
+/*An element of the queue of containers waiting for a refresh*/
+typedef struct {
+    lv_obj_t * cont;    /*NULL if the container was deleted*/
+    uint16_t depth;     /*Number of ancestors. The deepest containers are refreshed first*/
+} layout_queue_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -47,12 +55,27 @@ static void lv_cont_layout_center(lv_obj_t * cont);
 static void lv_cont_layout_pretty(lv_obj_t * cont);
 static void lv_cont_layout_grid(lv_obj_t * cont);
 static void lv_cont_refr_autofit(lv_obj_t * cont);
+static void lv_cont_refr(lv_obj_t * cont, bool layout);
+#if LV_CONT_LAYOUT_DEFER
+static bool layout_queue_add(lv_obj_t * cont, bool layout);
+static void layout_queue_remove(lv_obj_t * cont);
+static lv_obj_t * layout_queue_pop(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static lv_design_cb_t ancestor_design;
 static lv_signal_cb_t ancestor_signal;
+static lv_cont_layout_monitor_t layout_mon;
+static uint32_t frame_start_layout_cnt;
+static uint32_t frame_start_fit_cnt;
+#if LV_CONT_LAYOUT_DEFER
+static layout_queue_t * layout_queue;   /*Binary max-heap by depth*/
+static uint32_t layout_queue_cnt;
+static uint32_t layout_queue_size;
+static bool layout_flushing;
+#endif
 
 /**********************
  *      MACROS
@@ -74,6 +97,7 @@ lv_obj_t * lv_cont_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("container create started");
 
     /*Create a basic object*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_cont_ext_t));
     lv_obj_t * cont = lv_obj_create(par, copy);
     LV_ASSERT_MEM(cont);
     if(cont == NULL) return NULL;
@@ -94,6 +118,10 @@ lv_obj_t * lv_cont_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->fit_top    = LV_FIT_NONE;
     ext->fit_bottom = LV_FIT_NONE;
     ext->layout     = LV_LAYOUT_OFF;
+#if LV_CONT_LAYOUT_DEFER
+    ext->layout_pending = 0;
+    ext->fit_pending    = 0;
+#endif
 
     lv_obj_set_signal_cb(cont, lv_cont_signal);
 
@@ -242,6 +270,74 @@ lv_fit_t lv_cont_get_fit_bottom(const lv_obj_t * cont)
     return ext->fit_bottom;
 }
 
+/*=====================
+ * Other functions
+ *====================*/
+
+/**
+ * Get statistics about the layout and fit refreshes of the containers
+ * @param mon_p pointer to a variable to fill
+ */
+void lv_cont_layout_monitor(lv_cont_layout_monitor_t * mon_p)
+{
+    *mon_p = layout_mon;
+#if LV_CONT_LAYOUT_DEFER
+    mon_p->pending_cnt = layout_queue_cnt;
+#endif
+}
+
+/**
+ * Refresh the layout and fit of the containers marked by `LV_CONT_LAYOUT_DEFER`.
+ * Does nothing if nothing is pending.
+ */
+void _lv_cont_layout_flush(void)
+{
+#if LV_CONT_LAYOUT_DEFER
+    /*Called from the getters so it can be called while refreshing a layout too*/
+    if(layout_queue_cnt == 0 || layout_flushing) return;
+
+    layout_flushing = true;
+
+    /* Refreshing a container marks its parent (size change) and children (parent size change) again.
+     * Limit the number of refreshes to not loop forever if the containers keep resizing each other.
+     * The remaining ones are refreshed in the next call.*/
+    uint32_t budget = (layout_queue_cnt + 1) * LV_LAYOUT_MAX_RECURSION;
+    while(layout_queue_cnt > 0) {
+        if(budget == 0) {
+            LV_LOG_WARN("_lv_cont_layout_flush: too many refreshes. The containers might resize each other.");
+            break;
+        }
+        budget--;
+
+        lv_obj_t * cont = layout_queue_pop();
+        if(cont == NULL) continue;  /*Deleted while pending*/
+
+        lv_cont_ext_t * ext = lv_obj_get_ext_attr(cont);
+        bool layout = ext->layout_pending ? true : false;
+        ext->layout_pending = 0;
+        ext->fit_pending = 0;
+
+        if(layout) lv_cont_refr_layout(cont);
+        lv_cont_refr_autofit(cont);
+    }
+
+    layout_flushing = false;
+#endif
+}
+
+/**
+ * Refresh the pending containers and update the per frame counters. Called before refreshing a frame.
+ */
+void _lv_cont_refr_frame(void)
+{
+    _lv_cont_layout_flush();
+
+    layout_mon.frame_layout_cnt = layout_mon.layout_cnt - frame_start_layout_cnt;
+    layout_mon.frame_fit_cnt = layout_mon.fit_cnt - frame_start_fit_cnt;
+    frame_start_layout_cnt = layout_mon.layout_cnt;
+    frame_start_fit_cnt = layout_mon.fit_cnt;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -270,23 +366,26 @@ static lv_res_t lv_cont_signal(lv_obj_t * cont, lv_signal_t sign, void * param)
     if(sign == LV_SIGNAL_GET_TYPE) return lv_obj_handle_get_type_signal(param, LV_OBJX_NAME);
 
     if(sign == LV_SIGNAL_STYLE_CHG) { /*Recalculate the padding if the style changed*/
-        lv_cont_refr_layout(cont);
-        lv_cont_refr_autofit(cont);
+        lv_cont_refr(cont, true);
     }
     else if(sign == LV_SIGNAL_CHILD_CHG) {
-        lv_cont_refr_layout(cont);
-        lv_cont_refr_autofit(cont);
+        lv_cont_refr(cont, true);
     }
     else if(sign == LV_SIGNAL_COORD_CHG) {
-        if(lv_obj_get_width(cont) != lv_area_get_width(param) || lv_obj_get_height(cont) != lv_area_get_height(param)) {
-            lv_cont_refr_layout(cont);
-            lv_cont_refr_autofit(cont);
+        if(lv_area_get_width(&cont->coords) != lv_area_get_width(param) ||
+           lv_area_get_height(&cont->coords) != lv_area_get_height(param)) {
+            lv_cont_refr(cont, true);
         }
     }
     else if(sign == LV_SIGNAL_PARENT_SIZE_CHG) {
         /*MAX and EDGE fit needs to be refreshed if the parent's size has changed*/
-        lv_cont_refr_autofit(cont);
+        lv_cont_refr(cont, false);
     }
+#if LV_CONT_LAYOUT_DEFER
+    else if(sign == LV_SIGNAL_CLEANUP) {
+        layout_queue_remove(cont);
+    }
+#endif
 
     return res;
 }
@@ -319,6 +418,8 @@ static void lv_cont_refr_layout(lv_obj_t * cont)
 
     if(type == LV_LAYOUT_OFF) return;
 
+    layout_mon.layout_cnt++;
+
     if(type == LV_LAYOUT_CENTER) {
         lv_cont_layout_center(cont);
     }
@@ -666,6 +767,8 @@ static void lv_cont_refr_autofit(lv_obj_t * cont)
         return;
     }
 
+    layout_mon.fit_cnt++;
+
     static int recursion_level = 0;
     recursion_level++;
     /*Ensure it won't keep recursing forever*/
@@ -814,4 +917,129 @@ static void lv_cont_refr_autofit(lv_obj_t * cont)
     recursion_level--;
 }
 
+/**
+ * Refresh the layout and fit of a container now or mark it to refresh later with `LV_CONT_LAYOUT_DEFER`
+ * @param cont pointer to a container
+ * @param layout true: refresh the layout and the fit; false: refresh only the fit
+ */
+static void lv_cont_refr(lv_obj_t * cont, bool layout)
+{
+#if LV_CONT_LAYOUT_DEFER
+    if(layout_queue_add(cont, layout)) return;
+#endif
+
+    if(layout) lv_cont_refr_layout(cont);
+    lv_cont_refr_autofit(cont);
+}
+
+#if LV_CONT_LAYOUT_DEFER
+
+/**
+ * Mark a container to refresh it before the next frame
+ * @param cont pointer to a container
+ * @param layout true: refresh the layout and the fit; false: refresh only the fit
+ * @return true: the container is in the queue; false: out of memory, refresh it now
+ */
+static bool layout_queue_add(lv_obj_t * cont, bool layout)
+{
+    lv_cont_ext_t * ext = lv_obj_get_ext_attr(cont);
+    bool queued = ext->layout_pending || ext->fit_pending;
+
+    if(!queued) {
+        /*Be sure the refresher runs even if nothing was invalidated*/
+        if(layout_queue_cnt == 0) {
+            lv_disp_t * disp = lv_disp_get_default();
+            if(disp && disp->refr_task) lv_task_set_prio(disp->refr_task, LV_REFR_TASK_PRIO);
+        }
+
+        if(layout_queue_cnt == layout_queue_size) {
+            uint32_t new_size = layout_queue_size ? layout_queue_size * 2 : 16;
+            layout_queue_t * new_queue = lv_mem_realloc(layout_queue, new_size * sizeof(layout_queue_t));
+            if(new_queue == NULL) return false;
+            layout_queue = new_queue;
+            layout_queue_size = new_size;
+        }
+
+        uint16_t depth = 0;
+        lv_obj_t * par = lv_obj_get_parent(cont);
+        while(par) {
+            depth++;
+            par = lv_obj_get_parent(par);
+        }
+
+        /*Sift up*/
+        uint32_t i = layout_queue_cnt;
+        layout_queue_cnt++;
+        while(i > 0) {
+            uint32_t up = (i - 1) / 2;
+            if(layout_queue[up].depth >= depth) break;
+            layout_queue[i] = layout_queue[up];
+            i = up;
+        }
+        layout_queue[i].cont = cont;
+        layout_queue[i].depth = depth;
+    }
+
+    if(layout) ext->layout_pending = 1;
+    ext->fit_pending = 1;
+
+    return true;
+}
+
+/**
+ * Forget a deleted container. Its element stays in the queue with NULL container.
+ * @param cont pointer to a container
+ */
+static void layout_queue_remove(lv_obj_t * cont)
+{
+    lv_cont_ext_t * ext = lv_obj_get_ext_attr(cont);
+    if(!ext->layout_pending && !ext->fit_pending) return;
+
+    uint32_t i;
+    for(i = 0; i < layout_queue_cnt; i++) {
+        if(layout_queue[i].cont == cont) {
+            layout_queue[i].cont = NULL;
+            break;
+        }
+    }
+
+    ext->layout_pending = 0;
+    ext->fit_pending = 0;
+}
+
+/**
+ * Remove the deepest container from the queue
+ * @return pointer to the container or NULL if it was deleted
+ */
+static lv_obj_t * layout_queue_pop(void)
+{
+    lv_obj_t * cont = layout_queue[0].cont;
+
+    layout_queue_cnt--;
+    layout_queue_t last = layout_queue[layout_queue_cnt];
+
+    /*Sift down*/
+    uint32_t i = 0;
+    while(1) {
+        uint32_t child = i * 2 + 1;
+        if(child >= layout_queue_cnt) break;
+        if(child + 1 < layout_queue_cnt && layout_queue[child + 1].depth > layout_queue[child].depth) child++;
+        if(last.depth >= layout_queue[child].depth) break;
+        layout_queue[i] = layout_queue[child];
+        i = child;
+    }
+    layout_queue[i] = last;
+
+    /*Free the queue when it's empty to not hold the memory of a one time large update*/
+    if(layout_queue_cnt == 0) {
+        lv_mem_free(layout_queue);
+        layout_queue = NULL;
+        layout_queue_size = 0;
+    }
+
+    return cont;
+}
+
+#endif /*LV_CONT_LAYOUT_DEFER*/
+
 #endif
@@ -104,8 +104,23 @@ typedef struct {
     lv_fit_t fit_right : 2;  /*A fit type from `lv_fit_t` enum */
     lv_fit_t fit_top : 2;    /*A fit type from `lv_fit_t` enum */
     lv_fit_t fit_bottom : 2; /*A fit type from `lv_fit_t` enum */
+#if LV_CONT_LAYOUT_DEFER
+    uint8_t layout_pending : 1; /*1: the layout needs to be refreshed before the next frame*/
+    uint8_t fit_pending : 1;    /*1: the fit needs to be refreshed before the next frame*/
+#endif
 } lv_cont_ext_t;
 
+/**
+ * Statistics of the layout and fit refreshes
+ */
+typedef struct {
+    uint32_t layout_cnt;        /**< Number of layout passes*/
+    uint32_t fit_cnt;           /**< Number of fit passes*/
+    uint32_t frame_layout_cnt;  /**< Number of layout passes before the last frame*/
+    uint32_t frame_fit_cnt;     /**< Number of fit passes before the last frame*/
+    uint32_t pending_cnt;       /**< Number of containers waiting for a refresh*/
+} lv_cont_layout_monitor_t;
+
 /*Part of the container*/
 enum {
     LV_CONT_PART_MAIN = LV_OBJ_PART_MAIN,
@@ -209,6 +224,27 @@ lv_fit_t lv_cont_get_fit_top(const lv_obj_t * cont);
  */
 lv_fit_t lv_cont_get_fit_bottom(const lv_obj_t * cont);
 
+/*=====================
+ * Other functions
+ *====================*/
+
+/**
+ * Get statistics about the layout and fit refreshes of the containers
+ * @param mon_p pointer to a variable to fill
+ */
+void lv_cont_layout_monitor(lv_cont_layout_monitor_t * mon_p);
+
+/**
+ * Refresh the layout and fit of the containers marked by `LV_CONT_LAYOUT_DEFER`.
+ * Does nothing if nothing is pending.
+ */
+void _lv_cont_layout_flush(void);
+
+/**
+ * Refresh the pending containers and update the per frame counters. Called before refreshing a frame.
+ */
+void _lv_cont_refr_frame(void);
+
 /**********************
  *      MACROS
  **********************/
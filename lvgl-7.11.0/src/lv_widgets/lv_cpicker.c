@@ -103,6 +103,8 @@ lv_obj_t * lv_cpicker_create(lv_obj_t * par, const lv_obj_t * copy)
 {
     LV_LOG_TRACE("color_picker create started");
 
+    _lv_obj_reserve_ext_attr(sizeof(lv_cpicker_ext_t));
+
     lv_obj_t * cpicker = lv_obj_create(par, copy);
     LV_ASSERT_MEM(cpicker);
     if(cpicker == NULL) return NULL;
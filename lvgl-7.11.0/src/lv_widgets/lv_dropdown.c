@@ -87,6 +87,7 @@ lv_obj_t * lv_dropdown_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("drop down list create started");
 
     /*Create the ancestor drop down list*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_dropdown_ext_t));
     lv_obj_t * ddlist = lv_obj_create(par, copy);
     LV_ASSERT_MEM(ddlist);
     if(ddlist == NULL) return NULL;
@@ -601,6 +602,7 @@ void lv_dropdown_open(lv_obj_t * ddlist)
     lv_dropdown_ext_t * ext = lv_obj_get_ext_attr(ddlist);
     if(ext->page) return;
 
+    _lv_obj_reserve_ext_attr(sizeof(lv_dropdown_page_ext_t));
     ext->page = lv_page_create(lv_obj_get_screen(ddlist), NULL);
     lv_obj_add_protect(ext->page, LV_PROTECT_POS | LV_PROTECT_CLICK_FOCUS);
     lv_obj_add_protect(lv_page_get_scrollable(ext->page), LV_PROTECT_CLICK_FOCUS);
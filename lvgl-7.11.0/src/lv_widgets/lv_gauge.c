@@ -67,6 +67,7 @@ lv_obj_t * lv_gauge_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("gauge create started");
 
     /*Create the ancestor gauge*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_gauge_ext_t));
     lv_obj_t * gauge = lv_linemeter_create(par, copy);
     LV_ASSERT_MEM(gauge);
     if(gauge == NULL) return NULL;
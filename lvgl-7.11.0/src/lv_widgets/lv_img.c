@@ -62,6 +62,7 @@ lv_obj_t * lv_img_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("image create started");
 
     /*Create a basic object*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_img_ext_t));
     lv_obj_t * img = lv_obj_create(par, copy);
     LV_ASSERT_MEM(img);
     if(img == NULL) return NULL;
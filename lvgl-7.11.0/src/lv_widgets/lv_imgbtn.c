@@ -57,6 +57,7 @@ lv_obj_t * lv_imgbtn_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("image button create started");
 
     /*Create the ancestor of image button*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_imgbtn_ext_t));
     lv_obj_t * imgbtn = lv_btn_create(par, copy);
     LV_ASSERT_MEM(imgbtn);
     if(imgbtn == NULL) return NULL;
@@ -164,6 +164,7 @@ lv_obj_t * lv_keyboard_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("keyboard create started");
 
     /*Create the ancestor of keyboard*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_keyboard_ext_t));
     lv_obj_t * kb = lv_btnmatrix_create(par, copy);
     LV_ASSERT_MEM(kb);
     if(kb == NULL) return NULL;
@@ -53,6 +53,12 @@ static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
 static void lv_label_dot_tmp_free(lv_obj_t * label);
 static void get_txt_coords(const lv_obj_t * label, lv_area_t * area);
+#if LV_LABEL_CELL_MODE
+static bool cell_mode_active(const lv_obj_t * label);
+static bool cell_set_text(lv_obj_t * label, const char * text);
+static void cell_draw(lv_obj_t * label, const lv_area_t * txt_coords, const lv_area_t * clip_area,
+                      lv_draw_label_dsc_t * dsc);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -78,6 +84,7 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("label create started");
 
     /*Create a basic object*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_label_ext_t));
     lv_obj_t * new_label = lv_obj_create(par, copy);
     LV_ASSERT_MEM(new_label);
     if(new_label == NULL) return NULL;
@@ -115,6 +122,9 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
 #if LV_LABEL_TEXT_SEL
     ext->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     ext->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
+#endif
+#if LV_LABEL_CELL_MODE
+    ext->cell_w    = 0;
 #endif
     ext->dot.tmp_ptr   = NULL;
     ext->dot_tmp_alloc = 0;
@@ -135,6 +145,9 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
         lv_label_set_long_mode(new_label, lv_label_get_long_mode(copy));
         lv_label_set_recolor(new_label, lv_label_get_recolor(copy));
         lv_label_set_align(new_label, lv_label_get_align(copy));
+#if LV_LABEL_CELL_MODE
+        ext->cell_w = copy_ext->cell_w;
+#endif
         if(copy_ext->static_txt == 0)
             lv_label_set_text(new_label, lv_label_get_text(copy));
         else
@@ -180,10 +193,23 @@ void lv_label_set_text(lv_obj_t * label, const char * text)
 {
     LV_ASSERT_OBJ(label, LV_OBJX_NAME);
 
-    lv_obj_invalidate(label);
-
     lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
 
+#if LV_USE_ARABIC_PERSIAN_CHARS == 0
+    /* Nothing changes if the same text is set again (e.g. a periodically updated value).
+     * Setting the label's own text or NULL still refreshes the label.
+     * In dot mode the stored text is modified so always refresh.*/
+    if(text != NULL && ext->text != NULL && text != ext->text && ext->static_txt == 0 &&
+       ext->long_mode != LV_LABEL_LONG_DOT) {
+        if(strcmp(ext->text, text) == 0) return;
+#if LV_LABEL_CELL_MODE
+        if(cell_set_text(label, text)) return;
+#endif
+    }
+#endif
+
+    lv_obj_invalidate(label);
+
     /*If text is NULL then just refresh with the current text */
     if(text == NULL) text = ext->text;
 
@@ -396,6 +422,31 @@ void lv_label_set_anim_speed(lv_obj_t * label, uint16_t anim_speed)
 #endif
 }
 
+/**
+ * Draw every character in a cell with fixed width, centered.
+ * Changing some characters of the text with the same length redraws only the changed cells.
+ * Used only with `LV_LABEL_LONG_EXPAND` and without recoloring, for single line texts.
+ * @param label pointer to a label object
+ * @param cell_w width of the cells (e.g. the width of the widest digit). 0: draw the text normally
+ */
+void lv_label_set_cell_width(lv_obj_t * label, lv_coord_t cell_w)
+{
+    LV_ASSERT_OBJ(label, LV_OBJX_NAME);
+
+#if LV_LABEL_CELL_MODE
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    if(cell_w < 0) cell_w = 0;
+    if(ext->cell_w == cell_w) return;
+
+    lv_obj_invalidate(label);
+    ext->cell_w = cell_w;
+    lv_label_refr_text(label);
+#else
+    (void)label;    /*Unused*/
+    (void)cell_w;   /*Unused*/
+#endif
+}
+
 void lv_label_set_text_sel_start(lv_obj_t * label, uint32_t index)
 {
     LV_ASSERT_OBJ(label, LV_OBJX_NAME);
@@ -496,6 +547,24 @@ bool lv_label_get_recolor(const lv_obj_t * label)
     return ext->recolor == 0 ? false : true;
 }
 
+/**
+ * Get the width of the character cells
+ * @param label pointer to a label object
+ * @return the width of the cells or 0 if the text is drawn normally
+ */
+lv_coord_t lv_label_get_cell_width(const lv_obj_t * label)
+{
+    LV_ASSERT_OBJ(label, LV_OBJX_NAME);
+
+#if LV_LABEL_CELL_MODE
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    return ext->cell_w;
+#else
+    (void)label;    /*Unused*/
+    return 0;
+#endif
+}
+
 /**
  * Get the label's animation speed in LV_LABEL_LONG_ROLL and SCROLL modes
  * @param label pointer to a label object
@@ -1012,7 +1081,17 @@ void lv_label_refr_text(lv_obj_t * label)
     if(ext->recolor != 0) flag |= LV_TXT_FLAG_RECOLOR;
     if(ext->expand != 0) flag |= LV_TXT_FLAG_EXPAND;
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
-    _lv_txt_get_size(&size, ext->text, font, letter_space, line_space, max_w, flag);
+#if LV_LABEL_CELL_MODE
+    if(cell_mode_active(label)) {
+        uint32_t cell_cnt = _lv_txt_get_encoded_length(ext->text);
+        size.x = cell_cnt ? cell_cnt * (ext->cell_w + letter_space) - letter_space : 0;
+        size.y = lv_font_get_line_height(font);
+    }
+    else
+#endif
+    {
+        _lv_txt_get_size(&size, ext->text, font, letter_space, line_space, max_w, flag);
+    }
 
     /*Set the full size in expand mode*/
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) {
@@ -1322,6 +1401,13 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
         label_draw_dsc.flag = flag;
         lv_obj_init_draw_label_dsc(label, LV_LABEL_PART_MAIN, &label_draw_dsc);
 
+#if LV_LABEL_CELL_MODE
+        if(cell_mode_active(label)) {
+            cell_draw(label, &txt_coords, &txt_clip, &label_draw_dsc);
+            return LV_DESIGN_RES_OK;
+        }
+#endif
+
         /* In SROLL and SROLL_CIRC mode the CENTER and RIGHT are pointless so remove them.
          * (In addition they will result misalignment is this case)*/
         if((ext->long_mode == LV_LABEL_LONG_SROLL || ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) &&
@@ -1538,4 +1624,129 @@ static void get_txt_coords(const lv_obj_t * label, lv_area_t * area)
     area->y2 -= bottom;
 }
 
+#if LV_LABEL_CELL_MODE
+
+/**
+ * Tell whether the characters of a label are drawn in cells
+ * @param label pointer to a label object
+ * @return true: cell mode is used
+ */
+static bool cell_mode_active(const lv_obj_t * label)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    return ext->cell_w > 0 && ext->long_mode == LV_LABEL_LONG_EXPAND && ext->recolor == 0;
+}
+
+/**
+ * Replace the text in cell mode and invalidate only the changed cells.
+ * @param label pointer to a label object
+ * @param text the new text
+ * @return true: the text is updated; false: the cells are different, set the text normally
+ */
+static bool cell_set_text(lv_obj_t * label, const char * text)
+{
+    if(!cell_mode_active(label)) return false;
+
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    size_t len = strlen(text);
+    if(strlen(ext->text) != len) return false;
+
+    /*Every character has to start at the same byte in both texts to keep the cells*/
+    uint32_t ofs_old = 0;
+    uint32_t ofs_new = 0;
+    while(ofs_old < len) {
+        _lv_txt_encoded_next(ext->text, &ofs_old);
+        _lv_txt_encoded_next(text, &ofs_new);
+        if(ofs_old != ofs_new) return false;
+    }
+
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+    lv_style_int_t letter_space = lv_obj_get_style_text_letter_space(label, LV_LABEL_PART_MAIN);
+    lv_area_t txt_coords;
+    get_txt_coords(label, &txt_coords);
+
+    uint32_t i = 0;
+    uint32_t ofs = 0;
+    while(ofs < len) {
+        uint32_t next = ofs;
+        uint32_t letter_old = _lv_txt_encoded_next(ext->text, &next);
+        next = ofs;
+        uint32_t letter_new = _lv_txt_encoded_next(text, &next);
+
+        if(letter_old != letter_new) {
+            lv_area_t cell;
+            cell.x1 = txt_coords.x1 + i * (ext->cell_w + letter_space);
+            cell.x2 = cell.x1 + ext->cell_w - 1;
+            cell.y1 = label->coords.y1;
+            cell.y2 = label->coords.y2;
+
+            /*A glyph wider than the cell overflows on both sides*/
+            lv_coord_t glyph_w = LV_MATH_MAX(lv_font_get_glyph_width(font, letter_old, 0),
+                                             lv_font_get_glyph_width(font, letter_new, 0));
+            if(glyph_w > ext->cell_w) {
+                lv_coord_t over = (glyph_w - ext->cell_w + 1) / 2;
+                cell.x1 -= over;
+                cell.x2 += over;
+            }
+
+            lv_obj_invalidate_area(label, &cell);
+        }
+
+        ofs = next;
+        i++;
+    }
+
+    _lv_memcpy(ext->text, text, len);
+#if LV_LABEL_LONG_TXT_HINT
+    ext->hint.line_start = -1;
+#endif
+
+    return true;
+}
+
+/**
+ * Draw the characters of a label centered in their cells
+ * @param label pointer to a label object
+ * @param txt_coords the area of the text
+ * @param clip_area the area to draw
+ * @param dsc the initialized draw descriptor of the label. Its flags and selection are modified.
+ */
+static void cell_draw(lv_obj_t * label, const lv_area_t * txt_coords, const lv_area_t * clip_area,
+                      lv_draw_label_dsc_t * dsc)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+
+    dsc->flag = LV_TXT_FLAG_CENTER | LV_TXT_FLAG_EXPAND;
+    dsc->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
+    dsc->sel_end = LV_DRAW_LABEL_NO_TXT_SEL;
+
+    lv_area_t cell;
+    cell.y1 = txt_coords->y1;
+    cell.y2 = txt_coords->y2;
+
+    char letter_buf[8];
+    uint32_t i = 0;
+    uint32_t ofs = 0;
+    while(ext->text[ofs] != '\0') {
+        uint32_t next = ofs;
+        _lv_txt_encoded_next(ext->text, &next);
+
+        cell.x1 = txt_coords->x1 + i * (ext->cell_w + dsc->letter_space);
+        cell.x2 = cell.x1 + ext->cell_w - 1;
+        if(cell.x1 > clip_area->x2) break;
+
+        /*A centered glyph can be wider than its cell so don't skip the neighbors of the clip area*/
+        if(cell.x2 + ext->cell_w >= clip_area->x1 && next - ofs < sizeof(letter_buf)) {
+            _lv_memcpy(letter_buf, &ext->text[ofs], next - ofs);
+            letter_buf[next - ofs] = '\0';
+            lv_draw_label(&cell, clip_area, dsc, letter_buf, NULL);
+        }
+
+        ofs = next;
+        i++;
+    }
+}
+
+#endif /*LV_LABEL_CELL_MODE*/
+
 #endif
@@ -89,6 +89,10 @@ typedef struct {
     uint32_t sel_end;
 #endif
 
+#if LV_LABEL_CELL_MODE
+    lv_coord_t cell_w;  /*Width of the character cells. 0: draw the text normally*/
+#endif
+
     lv_label_long_mode_t long_mode : 3; /*Determinate what to do with the long texts*/
     uint8_t static_txt : 1;             /*Flag to indicate the text is static*/
     uint8_t align : 2;                  /*Align type from 'lv_label_align_t'*/
@@ -186,6 +190,16 @@ void lv_label_set_text_sel_start(lv_obj_t * label, uint32_t index);
  * @param index index to set. `LV_LABEL_TXT_SEL_OFF` to select nothing.
  */
 void lv_label_set_text_sel_end(lv_obj_t * label, uint32_t index);
+
+/**
+ * Draw every character in a cell with fixed width, centered.
+ * Changing some characters of the text with the same length redraws only the changed cells.
+ * Used only with `LV_LABEL_LONG_EXPAND` and without recoloring, for single line texts.
+ * @param label pointer to a label object
+ * @param cell_w width of the cells (e.g. the width of the widest digit). 0: draw the text normally
+ */
+void lv_label_set_cell_width(lv_obj_t * label, lv_coord_t cell_w);
+
 /*=====================
  * Getter functions
  *====================*/
@@ -218,6 +232,13 @@ lv_label_align_t lv_label_get_align(const lv_obj_t * label);
  */
 bool lv_label_get_recolor(const lv_obj_t * label);
 
+/**
+ * Get the width of the character cells
+ * @param label pointer to a label object
+ * @return the width of the cells or 0 if the text is drawn normally
+ */
+lv_coord_t lv_label_get_cell_width(const lv_obj_t * label);
+
 /**
  * Get the label's animation speed in LV_LABEL_LONG_ROLL and SCROLL modes
  * @param label pointer to a label object
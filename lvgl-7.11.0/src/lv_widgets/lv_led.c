@@ -56,6 +56,7 @@ lv_obj_t * lv_led_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("led create started");
 
     /*Create the ancestor basic object*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_led_ext_t));
     lv_obj_t * led = lv_obj_create(par, copy);
     LV_ASSERT_MEM(led);
     if(led == NULL) return NULL;
@@ -21,6 +21,7 @@
  *      DEFINES
  *********************/
 #define LV_OBJX_NAME "lv_line"
+#define LV_LINE_DRAW_POINT_CNT  64  /*Number of points converted to absolute coordinates at once*/
 
 /**********************
  *      TYPEDEFS
@@ -55,6 +56,7 @@ lv_obj_t * lv_line_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("line create started");
 
     /*Create a basic object*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_line_ext_t));
     lv_obj_t * line = lv_obj_create(par, copy);
     LV_ASSERT_MEM(line);
     if(line == NULL) return NULL;
@@ -236,31 +238,30 @@ static lv_design_res_t lv_line_design(lv_obj_t * line, const lv_area_t * clip_ar
         lv_obj_get_coords(line, &area);
         lv_coord_t x_ofs = area.x1;
         lv_coord_t y_ofs = area.y1;
-        lv_point_t p1;
-        lv_point_t p2;
         lv_coord_t h = lv_obj_get_height(line);
+        lv_point_t points[LV_LINE_DRAW_POINT_CNT];
+        uint16_t cnt = 0;
         uint16_t i;
 
         lv_draw_line_dsc_t line_dsc;
         lv_draw_line_dsc_init(&line_dsc);
         lv_obj_init_draw_line_dsc(line, LV_LINE_PART_MAIN, &line_dsc);
 
-        /*Read all points and draw the lines*/
-        for(i = 0; i < ext->point_num - 1; i++) {
+        /*Convert the points to absolute coordinates in parts and draw them as polylines*/
+        for(i = 0; i < ext->point_num; i++) {
+            points[cnt].x = ext->point_array[i].x + x_ofs;
+            if(ext->y_inv == 0) points[cnt].y = ext->point_array[i].y + y_ofs;
+            else points[cnt].y = h - ext->point_array[i].y + y_ofs;
+            cnt++;
 
-            p1.x = ext->point_array[i].x + x_ofs;
-            p2.x = ext->point_array[i + 1].x + x_ofs;
+            if(cnt == LV_LINE_DRAW_POINT_CNT || i == ext->point_num - 1) {
+                lv_draw_polyline(points, cnt, clip_area, &line_dsc);
+                line_dsc.round_start = 0;   /*Draw the rounding only on the end points after the first part*/
 
-            if(ext->y_inv == 0) {
-                p1.y = ext->point_array[i].y + y_ofs;
-                p2.y = ext->point_array[i + 1].y + y_ofs;
+                /*The next part continues from the last point*/
+                points[0] = points[cnt - 1];
+                cnt = 1;
             }
-            else {
-                p1.y = h - ext->point_array[i].y + y_ofs;
-                p2.y = h - ext->point_array[i + 1].y + y_ofs;
-            }
-            lv_draw_line(&p1, &p2, clip_area, &line_dsc);
-            line_dsc.round_start = 0;   /*Draw the rounding only on the end points after the first line*/
         }
 
     }
@@ -55,6 +55,7 @@ lv_obj_t * lv_linemeter_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("line meter create started");
 
     /*Create the ancestor of line meter*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_linemeter_ext_t));
     lv_obj_t * linemeter = lv_obj_create(par, copy);
     LV_ASSERT_MEM(linemeter);
     if(linemeter == NULL) return NULL;
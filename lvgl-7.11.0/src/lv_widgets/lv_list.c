@@ -27,6 +27,10 @@
     #define LV_LIST_DEF_ANIM_TIME 0
 #endif
 
+/*The coordinates are 16 bit so a virtual list's scrollable holds only a window of the items
+ *which is moved while scrolling*/
+#define LV_LIST_VIRTUAL_WIN_H   (LV_COORD_MAX / 2)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -40,6 +44,13 @@ static lv_style_list_t * lv_list_get_style(lv_obj_t * list, uint8_t part);
 static bool lv_list_is_list_btn(lv_obj_t * list_btn);
 static bool lv_list_is_list_img(lv_obj_t * list_btn);
 static bool lv_list_is_list_label(lv_obj_t * list_btn);
+#if LV_LIST_VIRTUAL
+static lv_res_t lv_list_virt_scrl_signal(lv_obj_t * scrl, lv_signal_t sign, void * param);
+static void virt_refr(lv_obj_t * list, const lv_area_t * ori);
+static void virt_move_win(lv_obj_t * list, int32_t shift);
+static bool virt_add_btns(lv_obj_t * list, uint32_t cnt);
+static void virt_remove_btn(lv_obj_t * list, lv_obj_t * btn);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -50,6 +61,9 @@ static bool lv_list_is_list_label(lv_obj_t * list_btn);
 static lv_signal_cb_t label_signal;
 static lv_signal_cb_t ancestor_page_signal;
 static lv_signal_cb_t ancestor_btn_signal;
+#if LV_LIST_VIRTUAL
+    static lv_signal_cb_t ancestor_scrl_signal;
+#endif
 
 /**********************
  *      MACROS
@@ -70,6 +84,7 @@ lv_obj_t * lv_list_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("list create started");
 
     /*Create the ancestor basic object*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_list_ext_t));
     lv_obj_t * list = lv_page_create(par, copy);
     LV_ASSERT_MEM(list);
     if(list == NULL) return NULL;
@@ -87,6 +102,17 @@ lv_obj_t * lv_list_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->last_sel_btn = NULL;
 #endif
     ext->act_sel_btn = NULL;
+#if LV_LIST_VIRTUAL
+    ext->virt_cb = NULL;
+    ext->virt_btns = NULL;
+    ext->virt_idx = NULL;
+    ext->virt_cnt = 0;
+    ext->virt_first = 0;
+    ext->virt_win_cnt = 0;
+    ext->virt_btn_cnt = 0;
+    ext->virt_item_h = 0;
+    ext->virt_busy = 0;
+#endif
 
     lv_obj_set_signal_cb(list, lv_list_signal);
 
@@ -102,15 +128,24 @@ lv_obj_t * lv_list_create(lv_obj_t * par, const lv_obj_t * copy)
 
     }
     else {
-        lv_obj_t * copy_btn = lv_list_get_next_btn(copy, NULL);
-        while(copy_btn) {
-            const void * img_src = NULL;
+#if LV_LIST_VIRTUAL
+        lv_list_ext_t * copy_ext = lv_obj_get_ext_attr(copy);
+        if(copy_ext->virt_cb) {
+            lv_list_set_virtual(list, copy_ext->virt_cnt, copy_ext->virt_item_h, copy_ext->virt_cb);
+        }
+        else
+#endif
+        {
+            lv_obj_t * copy_btn = lv_list_get_next_btn(copy, NULL);
+            while(copy_btn) {
+                const void * img_src = NULL;
 #if LV_USE_IMG
-            lv_obj_t * copy_img = lv_list_get_btn_img(copy_btn);
-            if(copy_img) img_src = lv_img_get_src(copy_img);
+                lv_obj_t * copy_img = lv_list_get_btn_img(copy_btn);
+                if(copy_img) img_src = lv_img_get_src(copy_img);
 #endif
-            lv_list_add_btn(list, img_src, lv_list_get_btn_text(copy_btn));
-            copy_btn = lv_list_get_next_btn(copy, copy_btn);
+                lv_list_add_btn(list, img_src, lv_list_get_btn_text(copy_btn));
+                copy_btn = lv_list_get_next_btn(copy, copy_btn);
+            }
         }
 
         /*Refresh the style with new signal function*/
@@ -342,6 +377,85 @@ void lv_list_set_layout(lv_obj_t * list, lv_layout_t layout)
     lv_page_set_scrl_layout(list, layout);
 }
 
+#if LV_LIST_VIRTUAL
+/**
+ * Make a list virtual: show `item_cnt` items with only as many buttons as visible.
+ * The buttons are recycled while the list is scrolled and `item_cb` is called to show an item on them.
+ * The existing buttons are deleted and the list uses a fixed `item_h` for every item.
+ * @param list pointer to a list object
+ * @param item_cnt number of items
+ * @param item_h height of the items
+ * @param item_cb function to show an item on a button
+ */
+void lv_list_set_virtual(lv_obj_t * list, uint32_t item_cnt, lv_coord_t item_h, lv_list_item_cb_t item_cb)
+{
+    LV_ASSERT_OBJ(list, LV_OBJX_NAME);
+
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    lv_obj_t * scrl = lv_page_get_scrollable(list);
+
+    if(ext->virt_cb == NULL) {
+        /*The list positions the buttons itself*/
+        lv_list_clean(list);
+        lv_page_set_scrl_layout(list, LV_LAYOUT_OFF);
+        lv_page_set_scrollable_fit2(list, LV_FIT_PARENT, LV_FIT_NONE);
+
+        if(ancestor_scrl_signal == NULL) ancestor_scrl_signal = lv_obj_get_signal_cb(scrl);
+        lv_obj_set_signal_cb(scrl, lv_list_virt_scrl_signal);
+    }
+
+    ext->virt_cb = item_cb;
+    ext->virt_item_h = LV_MATH_MAX(item_h, 1);
+    ext->virt_first = 0;
+
+    uint16_t i;
+    for(i = 0; i < ext->virt_btn_cnt; i++) {
+        lv_obj_set_height(ext->virt_btns[i], ext->virt_item_h);
+    }
+
+    /*Start from the first item*/
+    ext->virt_busy = 1;
+    lv_obj_set_y(scrl, lv_obj_get_style_pad_top(list, LV_LIST_PART_BG));
+    ext->virt_busy = 0;
+
+    lv_list_set_virtual_cnt(list, item_cnt);
+}
+
+/**
+ * Change the number of items of a virtual list. The visible items are shown again.
+ * @param list pointer to a virtual list
+ * @param item_cnt the new number of items
+ */
+void lv_list_set_virtual_cnt(lv_obj_t * list, uint32_t item_cnt)
+{
+    LV_ASSERT_OBJ(list, LV_OBJX_NAME);
+
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->virt_cb == NULL) return;
+
+    uint32_t win_cnt = LV_MATH_MAX(LV_LIST_VIRTUAL_WIN_H / ext->virt_item_h, 1);
+    ext->virt_cnt = item_cnt;
+    ext->virt_win_cnt = LV_MATH_MIN(item_cnt, win_cnt);
+    if(ext->virt_first + ext->virt_win_cnt > item_cnt) ext->virt_first = item_cnt - ext->virt_win_cnt;
+
+    /*Show every visible item again*/
+    uint16_t i;
+    for(i = 0; i < ext->virt_btn_cnt; i++) {
+        ext->virt_idx[i] = LV_LIST_VIRTUAL_NONE;
+    }
+
+    lv_obj_t * scrl = lv_page_get_scrollable(list);
+    lv_coord_t pad_top = lv_obj_get_style_pad_top(scrl, LV_CONT_PART_MAIN);
+    lv_coord_t pad_bottom = lv_obj_get_style_pad_bottom(scrl, LV_CONT_PART_MAIN);
+
+    ext->virt_busy = 1;
+    lv_obj_set_height(scrl, (lv_coord_t)ext->virt_win_cnt * ext->virt_item_h + pad_top + pad_bottom);
+    ext->virt_busy = 0;
+
+    virt_refr(list, NULL);
+}
+#endif
+
 /*=====================
  * Getter functions
  *====================*/
@@ -504,6 +618,43 @@ uint16_t lv_list_get_size(const lv_obj_t * list)
     return size;
 }
 
+#if LV_LIST_VIRTUAL
+/**
+ * Get the number of items of a virtual list
+ * @param list pointer to a list object
+ * @return the number of items or 0 if the list is not virtual
+ */
+uint32_t lv_list_get_virtual_cnt(const lv_obj_t * list)
+{
+    LV_ASSERT_OBJ(list, LV_OBJX_NAME);
+
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    return ext->virt_cb ? ext->virt_cnt : 0;
+}
+
+/**
+ * Get the item shown on a button of a virtual list
+ * @param list pointer to a list object
+ * @param btn pointer to a button of the list
+ * @return index of the item or -1 if the button is not used now
+ */
+int32_t lv_list_get_virtual_index(const lv_obj_t * list, const lv_obj_t * btn)
+{
+    LV_ASSERT_OBJ(list, LV_OBJX_NAME);
+
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    uint16_t i;
+    for(i = 0; i < ext->virt_btn_cnt; i++) {
+        if(ext->virt_btns[i] == btn) {
+            if(ext->virt_idx[i] == LV_LIST_VIRTUAL_NONE) return -1;
+            return (int32_t)ext->virt_idx[i];
+        }
+    }
+
+    return -1;
+}
+#endif
+
 #if LV_USE_GROUP
 /**
  * Get the currently selected button
@@ -777,6 +928,20 @@ static lv_res_t lv_list_signal(lv_obj_t * list, lv_signal_t sign, void * param)
         }
 #endif
     }
+#if LV_LIST_VIRTUAL
+    else if(sign == LV_SIGNAL_COORD_CHG) {
+        /*More or less items might be visible*/
+        if(lv_obj_get_height(list) != lv_area_get_height(param)) virt_refr(list, NULL);
+    }
+    else if(sign == LV_SIGNAL_CLEANUP) {
+        lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+        lv_mem_free(ext->virt_btns);
+        lv_mem_free(ext->virt_idx);
+        ext->virt_btns = NULL;
+        ext->virt_idx = NULL;
+        ext->virt_btn_cnt = 0;
+    }
+#endif
     return res;
 }
 
@@ -831,6 +996,9 @@ static lv_res_t lv_list_btn_signal(lv_obj_t * btn, lv_signal_t sign, void * para
         lv_obj_t * sel  = lv_list_get_btn_selected(list);
         if(sel == btn) lv_list_focus_btn(list, lv_list_get_next_btn(list, btn));
         if(ext->last_sel_btn == btn) ext->last_sel_btn = NULL;
+#endif
+#if LV_LIST_VIRTUAL
+        virt_remove_btn(lv_obj_get_parent(lv_obj_get_parent(btn)), btn);
 #endif
     }
     else if(sign == LV_SIGNAL_FOCUS) {
@@ -929,4 +1097,216 @@ static bool lv_list_is_list_img(lv_obj_t * list_img)
     return false;
 }
 
+#if LV_LIST_VIRTUAL
+/**
+ * Signal function of the scrollable of virtual lists
+ * @param scrl pointer to the scrollable of a list
+ * @param sign a signal type from lv_signal_t enum
+ * @param param pointer to a signal specific variable
+ * @return LV_RES_OK: the object is not deleted in the function; LV_RES_INV: the object is deleted
+ */
+static lv_res_t lv_list_virt_scrl_signal(lv_obj_t * scrl, lv_signal_t sign, void * param)
+{
+    lv_res_t res;
+
+    /* Include the ancient signal function */
+    res = ancestor_scrl_signal(scrl, sign, param);
+    if(res != LV_RES_OK) return res;
+
+    if(sign == LV_SIGNAL_COORD_CHG) {
+        virt_refr(lv_obj_get_parent(scrl), param);
+    }
+
+    return res;
+}
+
+/**
+ * Show the visible items of a virtual list on the buttons.
+ * The buttons of the items scrolled out are reused for the items scrolled in.
+ * @param list pointer to a virtual list
+ * @param ori the previous coordinates of the scrollable or NULL if it hasn't moved
+ */
+static void virt_refr(lv_obj_t * list, const lv_area_t * ori)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->virt_cb == NULL || ext->virt_busy) return;
+
+    ext->virt_busy = 1;
+
+    lv_obj_t * scrl = lv_page_get_scrollable(list);
+    lv_coord_t item_h = ext->virt_item_h;
+    lv_coord_t pad_top = lv_obj_get_style_pad_top(scrl, LV_CONT_PART_MAIN);
+
+    /*The visible part of the window in pixels*/
+    int32_t view_y1 = list->coords.y1 - (scrl->coords.y1 + pad_top);
+    int32_t view_h = lv_obj_get_height(list);
+    int32_t win_h = (int32_t)ext->virt_win_cnt * item_h;
+
+    /*Move the window to the visible part if it got close to an edge of the window*/
+    if(ext->virt_win_cnt < ext->virt_cnt) {
+        if((view_y1 < view_h && ext->virt_first > 0) ||
+           (view_y1 + 2 * view_h > win_h && ext->virt_first + ext->virt_win_cnt < ext->virt_cnt)) {
+            int32_t first = (int32_t)ext->virt_first + (view_y1 + view_h / 2) / item_h - (int32_t)ext->virt_win_cnt / 2;
+            first = LV_MATH_MIN(first, (int32_t)(ext->virt_cnt - ext->virt_win_cnt));
+            first = LV_MATH_MAX(first, 0);
+            int32_t shift = first - (int32_t)ext->virt_first;
+
+            /*Don't move the scrollable back to where it was before this change
+             *else dragging would think it hasn't moved at all*/
+            if(ori && scrl->coords.y1 + shift * item_h == ori->y1) shift += shift > 0 ? -1 : 1;
+
+            if(shift != 0) {
+                virt_move_win(list, shift);
+                view_y1 -= shift * item_h;
+            }
+        }
+    }
+
+    /*The visible items*/
+    uint32_t vis_first = 0;
+    uint32_t vis_cnt = 0;
+    if(view_y1 + view_h > 0 && view_y1 < win_h) {
+        int32_t first = LV_MATH_MAX(view_y1, 0) / item_h;
+        int32_t last = LV_MATH_MIN((view_y1 + view_h - 1) / item_h, (int32_t)ext->virt_win_cnt - 1);
+        vis_first = ext->virt_first + (uint32_t)first;
+        vis_cnt = (uint32_t)(last - first + 1);
+    }
+
+    if(vis_cnt > ext->virt_btn_cnt) {
+        if(virt_add_btns(list, vis_cnt - ext->virt_btn_cnt) == false) vis_cnt = ext->virt_btn_cnt;
+    }
+
+    /*Release the buttons of the items which scrolled out (the unsigned difference wraps around below `vis_first`)*/
+    uint16_t i;
+    for(i = 0; i < ext->virt_btn_cnt; i++) {
+        if(ext->virt_idx[i] - vis_first >= vis_cnt) ext->virt_idx[i] = LV_LIST_VIRTUAL_NONE;
+    }
+
+    /*Show the items which scrolled in on the released buttons*/
+    uint16_t free_i = 0;
+    uint32_t k;
+    for(k = 0; k < vis_cnt; k++) {
+        uint32_t idx = vis_first + k;
+        for(i = 0; i < ext->virt_btn_cnt; i++) {
+            if(ext->virt_idx[i] == idx) break;
+        }
+        if(i < ext->virt_btn_cnt) continue;
+
+        while(ext->virt_idx[free_i] != LV_LIST_VIRTUAL_NONE) free_i++;
+
+        lv_obj_t * btn = ext->virt_btns[free_i];
+        ext->virt_idx[free_i] = idx;
+        if(btn == ext->act_sel_btn) lv_list_focus_btn(list, NULL);
+
+        lv_obj_set_y(btn, pad_top + (lv_coord_t)(idx - ext->virt_first) * item_h);
+        lv_obj_set_hidden(btn, false);
+        ext->virt_cb(list, btn, idx);
+    }
+
+    /*Hide the unused buttons*/
+    for(i = 0; i < ext->virt_btn_cnt; i++) {
+        if(ext->virt_idx[i] == LV_LIST_VIRTUAL_NONE && lv_obj_get_hidden(ext->virt_btns[i]) == false) {
+            lv_obj_set_hidden(ext->virt_btns[i], true);
+        }
+    }
+
+    ext->virt_busy = 0;
+}
+
+/**
+ * Move the window of a virtual list without moving the items on the screen
+ * @param list pointer to a virtual list
+ * @param shift move the first item of the window by this many items
+ */
+static void virt_move_win(lv_obj_t * list, int32_t shift)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    lv_obj_t * scrl = lv_page_get_scrollable(list);
+    lv_coord_t dy = (lv_coord_t)(shift * ext->virt_item_h);
+
+    ext->virt_first = (uint32_t)((int32_t)ext->virt_first + shift);
+    lv_obj_set_y(scrl, lv_obj_get_y(scrl) + dy);
+
+#if LV_USE_ANIMATION
+    /*Scroll animations continue from the new position*/
+    lv_anim_t * a = lv_anim_get(scrl, (lv_anim_exec_xcb_t)lv_obj_set_y);
+    if(a) {
+        a->start += dy;
+        a->current += dy;
+        a->end += dy;
+    }
+#endif
+
+    /*The buttons moved together with the scrollable so put them back*/
+    lv_coord_t pad_top = lv_obj_get_style_pad_top(scrl, LV_CONT_PART_MAIN);
+    uint16_t i;
+    for(i = 0; i < ext->virt_btn_cnt; i++) {
+        uint32_t idx = ext->virt_idx[i];
+        if(idx == LV_LIST_VIRTUAL_NONE) continue;
+        if(idx < ext->virt_first || idx >= ext->virt_first + ext->virt_win_cnt) {
+            ext->virt_idx[i] = LV_LIST_VIRTUAL_NONE;
+            continue;
+        }
+        lv_obj_set_y(ext->virt_btns[i], pad_top + (lv_coord_t)(idx - ext->virt_first) * ext->virt_item_h);
+    }
+}
+
+/**
+ * Add buttons to recycle to a virtual list
+ * @param list pointer to a virtual list
+ * @param cnt number of buttons to add
+ * @return true: the buttons are added; false: out of memory
+ */
+static bool virt_add_btns(lv_obj_t * list, uint32_t cnt)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    uint32_t new_cnt = ext->virt_btn_cnt + cnt;
+    if(new_cnt > UINT16_MAX) return false;
+
+    lv_obj_t ** btns = lv_mem_realloc(ext->virt_btns, new_cnt * sizeof(lv_obj_t *));
+    LV_ASSERT_MEM(btns);
+    if(btns == NULL) return false;
+    ext->virt_btns = btns;
+
+    uint32_t * idx = lv_mem_realloc(ext->virt_idx, new_cnt * sizeof(uint32_t));
+    LV_ASSERT_MEM(idx);
+    if(idx == NULL) return false;
+    ext->virt_idx = idx;
+
+    while(ext->virt_btn_cnt < new_cnt) {
+        lv_obj_t * btn = lv_list_add_btn(list, NULL, "");
+        if(btn == NULL) return false;
+
+        lv_btn_set_fit2(btn, LV_FIT_PARENT, LV_FIT_NONE);
+        lv_obj_set_height(btn, ext->virt_item_h);
+        lv_obj_set_hidden(btn, true);
+
+        ext->virt_btns[ext->virt_btn_cnt] = btn;
+        ext->virt_idx[ext->virt_btn_cnt] = LV_LIST_VIRTUAL_NONE;
+        ext->virt_btn_cnt++;
+    }
+
+    return true;
+}
+
+/**
+ * Forget a deleted button of a virtual list
+ * @param list pointer to a list
+ * @param btn pointer to the deleted button
+ */
+static void virt_remove_btn(lv_obj_t * list, lv_obj_t * btn)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    uint16_t i;
+    for(i = 0; i < ext->virt_btn_cnt; i++) {
+        if(ext->virt_btns[i] == btn) {
+            ext->virt_btn_cnt--;
+            ext->virt_btns[i] = ext->virt_btns[ext->virt_btn_cnt];
+            ext->virt_idx[i] = ext->virt_idx[ext->virt_btn_cnt];
+            return;
+        }
+    }
+}
+#endif
+
 #endif
@@ -39,10 +39,22 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+#if LV_LIST_VIRTUAL
+/*Item index of the unused recycled buttons*/
+#define LV_LIST_VIRTUAL_NONE    UINT32_MAX
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_LIST_VIRTUAL
+/**
+ * Type of the function which shows an item on a recycled button of a virtual list.
+ * E.g. set the text of `lv_list_get_btn_label(btn)`.
+ */
+typedef void (*lv_list_item_cb_t)(lv_obj_t * list, lv_obj_t * btn, uint32_t index);
+#endif
+
 /*Data of list*/
 typedef struct {
     lv_page_ext_t page; /*Ext. of ancestor*/
@@ -52,6 +64,17 @@ typedef struct {
     lv_obj_t * last_sel_btn;     /* The last selected button. It will be reverted when the list is focused again */
 #endif
     lv_obj_t * act_sel_btn; /* The button is currently being selected*/
+#if LV_LIST_VIRTUAL
+    lv_list_item_cb_t virt_cb;  /*Shows an item on a button. NULL: not a virtual list*/
+    lv_obj_t ** virt_btns;      /*The recycled buttons*/
+    uint32_t * virt_idx;        /*The item shown on the buttons or `LV_LIST_VIRTUAL_NONE`*/
+    uint32_t virt_cnt;          /*Number of items*/
+    uint32_t virt_first;        /*The first item in the scrollable*/
+    uint32_t virt_win_cnt;      /*Number of items in the scrollable*/
+    uint16_t virt_btn_cnt;      /*Number of recycled buttons*/
+    lv_coord_t virt_item_h;     /*Height of an item*/
+    uint8_t virt_busy : 1;      /*1: the visible items are being refreshed*/
+#endif
 } lv_list_ext_t;
 
 /** List styles. */
@@ -165,6 +188,26 @@ static inline void lv_list_set_anim_time(lv_obj_t * list, uint16_t anim_time)
  */
 void lv_list_set_layout(lv_obj_t * list, lv_layout_t layout);
 
+#if LV_LIST_VIRTUAL
+/**
+ * Make a list virtual: show `item_cnt` items with only as many buttons as visible.
+ * The buttons are recycled while the list is scrolled and `item_cb` is called to show an item on them.
+ * The existing buttons are deleted and the list uses a fixed `item_h` for every item.
+ * @param list pointer to a list object
+ * @param item_cnt number of items
+ * @param item_h height of the items
+ * @param item_cb function to show an item on a button
+ */
+void lv_list_set_virtual(lv_obj_t * list, uint32_t item_cnt, lv_coord_t item_h, lv_list_item_cb_t item_cb);
+
+/**
+ * Change the number of items of a virtual list. The visible items are shown again.
+ * @param list pointer to a virtual list
+ * @param item_cnt the new number of items
+ */
+void lv_list_set_virtual_cnt(lv_obj_t * list, uint32_t item_cnt);
+#endif
+
 /*=====================
  * Getter functions
  *====================*/
@@ -220,6 +263,23 @@ int32_t lv_list_get_btn_index(const lv_obj_t * list, const lv_obj_t * btn);
  */
 uint16_t lv_list_get_size(const lv_obj_t * list);
 
+#if LV_LIST_VIRTUAL
+/**
+ * Get the number of items of a virtual list
+ * @param list pointer to a list object
+ * @return the number of items or 0 if the list is not virtual
+ */
+uint32_t lv_list_get_virtual_cnt(const lv_obj_t * list);
+
+/**
+ * Get the item shown on a button of a virtual list
+ * @param list pointer to a list object
+ * @param btn pointer to a button of the list
+ * @return index of the item or -1 if the button is not used now
+ */
+int32_t lv_list_get_virtual_index(const lv_obj_t * list, const lv_obj_t * btn);
+#endif
+
 #if LV_USE_GROUP
 /**
  * Get the currently selected button. Can be used while navigating in the list with a keypad.
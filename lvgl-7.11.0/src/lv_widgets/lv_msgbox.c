@@ -71,6 +71,7 @@ lv_obj_t * lv_msgbox_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("message box create started");
 
     /*Create the ancestor message box*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_msgbox_ext_t));
     lv_obj_t * mbox = lv_cont_create(par, copy);
     LV_ASSERT_MEM(mbox);
     if(mbox == NULL) return NULL;
@@ -54,6 +54,7 @@ lv_obj_t * lv_objmask_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("object mask create started");
 
     /*Create the ancestor of object mask*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_objmask_ext_t));
     lv_obj_t * objmask = lv_cont_create(par, copy);
     LV_ASSERT_MEM(objmask);
     if(objmask == NULL) return NULL;
@@ -61,6 +61,7 @@ lv_obj_t * lv_templ_create(lv_obj_t * par, const lv_obj_t * copy)
 
     /*Create the ancestor of template*/
     /*TODO modify it to the ancestor create function */
+    _lv_obj_reserve_ext_attr(sizeof(lv_templ_ext_t));
     lv_obj_t * new_templ = lv_ANCESTOR_create(par, copy);
     LV_ASSERT_MEM(new_templ);
     if(new_templ == NULL) return NULL;
@@ -82,6 +82,7 @@ lv_obj_t * lv_page_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("page create started");
 
     /*Create the ancestor object*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_page_ext_t));
     lv_obj_t * page = lv_cont_create(par, copy);
     LV_ASSERT_MEM(page);
     if(page == NULL) return NULL;
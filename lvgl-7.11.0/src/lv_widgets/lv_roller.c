@@ -73,6 +73,7 @@ lv_obj_t * lv_roller_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("roller create started");
 
     /*Create the ancestor of roller*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_roller_ext_t));
     lv_obj_t * roller = lv_page_create(par, copy);
     LV_ASSERT_MEM(roller);
     if(roller == NULL) return NULL;
@@ -63,6 +63,7 @@ lv_obj_t * lv_slider_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("slider create started");
 
     /*Create the ancestor slider*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_slider_ext_t));
     lv_obj_t * slider = lv_bar_create(par, copy);
     LV_ASSERT_MEM(slider);
     if(slider == NULL) return NULL;
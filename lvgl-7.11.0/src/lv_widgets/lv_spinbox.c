@@ -55,6 +55,7 @@ lv_obj_t * lv_spinbox_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("spinbox create started");
 
     /*Create the ancestor of spinbox*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_spinbox_ext_t));
     lv_obj_t * spinbox = lv_textarea_create(par, copy);
     LV_ASSERT_MEM(spinbox);
     if(spinbox == NULL) return NULL;
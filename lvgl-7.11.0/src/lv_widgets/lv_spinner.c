@@ -67,6 +67,7 @@ lv_obj_t * lv_spinner_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("spinner create started");
 
     /*Create the ancestor of spinner*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_spinner_ext_t));
     lv_obj_t * spinner = lv_arc_create(par, copy);
     LV_ASSERT_MEM(spinner);
     if(spinner == NULL) return NULL;
@@ -63,6 +63,7 @@ lv_obj_t * lv_switch_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("switch create started");
 
     /*Create the ancestor of switch*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_switch_ext_t));
     lv_obj_t * sw = lv_bar_create(par, copy);
     LV_ASSERT_MEM(sw);
 
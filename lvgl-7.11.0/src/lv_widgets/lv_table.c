@@ -63,6 +63,7 @@ lv_obj_t * lv_table_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("table create started");
 
     /*Create the ancestor of table*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_table_ext_t));
     lv_obj_t * table = lv_obj_create(par, copy);
     LV_ASSERT_MEM(table);
     if(table == NULL) return NULL;
@@ -74,6 +74,7 @@ lv_obj_t * lv_tabview_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("tab view create started");
 
     /*Create the ancestor of tab*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_tabview_ext_t));
     lv_obj_t * tabview = lv_obj_create(par, copy);
     LV_ASSERT_MEM(tabview);
     if(tabview == NULL) return NULL;
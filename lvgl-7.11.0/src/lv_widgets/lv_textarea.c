@@ -90,6 +90,7 @@ lv_obj_t * lv_textarea_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("text area create started");
 
     /*Create the ancestor object*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_textarea_ext_t));
     lv_obj_t * ta = lv_page_create(par, copy);
     LV_ASSERT_MEM(ta);
     if(ta == NULL) return NULL;
@@ -67,6 +67,7 @@ lv_obj_t * lv_tileview_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("tileview create started");
 
     /*Create the ancestor of tileview*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_tileview_ext_t));
     lv_obj_t * new_tileview = lv_page_create(par, copy);
     LV_ASSERT_MEM(new_tileview);
     if(new_tileview == NULL) return NULL;
@@ -75,6 +75,7 @@ lv_obj_t * lv_win_create(lv_obj_t * par, const lv_obj_t * copy)
     LV_LOG_TRACE("window create started");
 
     /*Create the ancestor object*/
+    _lv_obj_reserve_ext_attr(sizeof(lv_win_ext_t));
     lv_obj_t * new_win = lv_obj_create(par, copy);
     LV_ASSERT_MEM(new_win);
     if(new_win == NULL) return NULL;
@@ -808,6 +809,7 @@ static lv_obj_t * lv_win_btn_create(lv_obj_t * par, const void * img_src)
 
     lv_obj_t * win_btn;
 
+    _lv_obj_reserve_ext_attr(sizeof(lv_win_btn_ext_t));
     win_btn = lv_btn_create(par, NULL);
     LV_ASSERT_MEM(win_btn);
     if(win_btn == NULL) return NULL;
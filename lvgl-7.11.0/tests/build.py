@@ -207,6 +207,9 @@ all_obj_minimal_features = {
 all_obj_all_features = {
   "LV_DPI":100,
   "LV_MEM_SIZE":32*1024,
+  "LV_MEM_TLSF":1,
+  "LV_MEM_LATENCY_HIST":1,
+  "LV_MEM_BUF_POOL":1,
   "LV_HOR_RES_MAX":480,
   "LV_VER_RES_MAX":320,
   "LV_COLOR_DEPTH":32,
@@ -293,6 +296,17 @@ advanced_features = {
   "LV_COLOR_SCREEN_TRANSP":1,
   "LV_USE_GROUP":1,
   "LV_USE_ANIMATION":1,
+  "LV_ANIM_FRAME_SYNC":1,
+  "LV_OBJ_SLAB":1,
+  "LV_USE_CMDQ":1,
+  "LV_STYLE_RES_CACHE":1,
+  "LV_STYLE_INDEX":1,
+  "LV_CONT_LAYOUT_DEFER":1,
+  "LV_LABEL_CELL_MODE":1,
+  "LV_INDEV_HIT_INDEX":1,
+  "LV_LIST_VIRTUAL":1,
+  "LV_CHART_STREAM":1,
+  "LV_CANVAS_DIRTY_AREA":1,
   "LV_ANTIALIAS":1,
   "LV_GPU":1,
   "LV_USE_FILESYSTEM":1,
@@ -300,6 +314,11 @@ advanced_features = {
   "LV_USE_API_EXTENSION_V6":1,
   "LV_USE_USER_DATA":1,
   "LV_IMG_CACHE_DEF_SIZE":32,
+  "LV_IMG_CACHE_TRANSFORM_SIZE":64*1024,
+  "LV_GRAD_CACHE_SIZE":4*1024,
+  "LV_DITHER_GRADIENT":1,
+  "LV_FS_CACHE_BLOCK_CNT":4,
+  "LV_FS_CACHE_BLOCK_SIZE":64,
   "LV_USE_LOG":1,
   "LV_USE_THEME_MATERIAL":1,
   "LV_USE_THEME_EMPTY":1,
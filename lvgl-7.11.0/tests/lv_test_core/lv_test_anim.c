@@ -0,0 +1,122 @@
+/**
+ * @file lv_test_anim.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_anim.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LATE_FRAME_MS   100
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_ANIMATION && LV_ANIM_FRAME_SYNC
+static void frame_stat(void);
+static void exec_cb(void * var, lv_anim_value_t v);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_anim(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_anim tests");
+    lv_test_print("===================");
+
+#if LV_USE_ANIMATION && LV_ANIM_FRAME_SYNC
+    frame_stat();
+#else
+    lv_test_print("Skip anim test: LV_USE_ANIMATION == 0 or LV_ANIM_FRAME_SYNC == 0");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_ANIMATION && LV_ANIM_FRAME_SYNC
+static void frame_stat(void)
+{
+    lv_test_print("");
+    lv_test_print("Sample the animations once per refresh:");
+    lv_test_print("---------------------------------------");
+
+    lv_anim_del_all();
+    lv_anim_reset_frame_stat();
+
+    /*A vsync older than the start of the animation doesn't advance the animation clock.
+     *The tick is stepped by hand to have exact elapsed times.*/
+    lv_anim_frame_vsync();
+    lv_tick_inc(1);
+
+    int32_t value = -1;
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &value);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_values(&a, 0, 10000);
+    lv_anim_set_time(&a, 10000);
+    lv_anim_start(&a);
+
+    lv_anim_frame_stat_t stat;
+    lv_test_print("Refresh after an old vsync");
+    lv_refr_now(NULL);
+    lv_anim_get_frame_stat(&stat);
+    lv_test_assert_int_eq(1, stat.frame_cnt, "Sampled frames");
+    lv_test_assert_int_eq(1, stat.duplicated_cnt, "Duplicated frames");
+    lv_test_assert_int_eq(0, stat.dropped_cnt, "Dropped frames");
+    lv_test_assert_int_eq(1, stat.vsync_cnt, "Vsyncs");
+    lv_test_assert_int_eq(0, value, "The animation is at its start value");
+
+    lv_test_print("Refresh late");
+    lv_tick_inc(LATE_FRAME_MS);
+    lv_refr_now(NULL);
+    lv_anim_get_frame_stat(&stat);
+    lv_test_assert_int_eq(2, stat.frame_cnt, "Sampled frames");
+    lv_test_assert_int_eq(1, stat.duplicated_cnt, "Duplicated frames");
+    lv_test_assert_int_eq(LATE_FRAME_MS, stat.last_elaps, "Time of the late frame");
+    lv_test_assert_int_eq((LATE_FRAME_MS + LV_DISP_DEF_REFR_PERIOD / 2) / LV_DISP_DEF_REFR_PERIOD - 1,
+                          stat.dropped_cnt, "Dropped frames");
+    lv_test_assert_int_gt(0, value, "The animation is advanced");
+
+    lv_test_print("Reset the statistics");
+    lv_anim_del(&value, exec_cb);
+    lv_anim_reset_frame_stat();
+    lv_refr_now(NULL);
+    lv_anim_get_frame_stat(&stat);
+    lv_test_assert_int_eq(0, stat.frame_cnt, "No frame is sampled without animations");
+    lv_test_assert_int_eq(0, stat.dropped_cnt, "Dropped frames");
+    lv_test_assert_int_eq(0, stat.duplicated_cnt, "Duplicated frames");
+}
+
+static void exec_cb(void * var, lv_anim_value_t v)
+{
+    *((int32_t *)var) = v;
+}
+#endif
+#endif
@@ -0,0 +1,131 @@
+/**
+ * @file lv_test_cmdq.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_cmdq.h"
+#include <string.h>
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_CMDQ
+static void post_and_drain(void);
+static void queue_full(void);
+static void count_cb(void * user_data);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_cmdq(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_cmdq tests");
+    lv_test_print("===================");
+
+#if LV_USE_CMDQ
+    post_and_drain();
+    queue_full();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_CMDQ
+
+static void post_and_drain(void)
+{
+    lv_test_print("");
+    lv_test_print("Execute the posted commands in lv_task_handler:");
+    lv_test_print("-----------------------------------------------");
+
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_label_set_text(label, "initial");
+
+    uint32_t cnt = 0;
+    char text[16];
+    strcpy(text, "posted");
+    lv_test_assert_true(lv_cmdq_set_text(label, text), "Post a text");
+    lv_test_assert_true(lv_cmdq_call(count_cb, &cnt), "Post a call");
+
+    /*The text should be copied in the command*/
+    strcpy(text, "changed");
+    lv_test_assert_str_eq("initial", lv_label_get_text(label), "Text before lv_task_handler");
+
+    lv_task_handler();
+    lv_test_assert_str_eq("posted", lv_label_get_text(label), "Text after lv_task_handler");
+    lv_test_assert_int_eq(1, cnt, "Called functions");
+
+    lv_obj_del(label);
+}
+
+static void queue_full(void)
+{
+    lv_test_print("");
+    lv_test_print("Drop the commands if the queue is full:");
+    lv_test_print("---------------------------------------");
+
+    lv_cmdq_stat_t stat_start;
+    lv_cmdq_stat_t stat_end;
+    lv_cmdq_get_stat(&stat_start);
+
+    uint32_t cnt = 0;
+    uint32_t i;
+    bool res = true;
+    for(i = 0; i < LV_CMDQ_SIZE; i++) res = res && lv_cmdq_call(count_cb, &cnt);
+    lv_test_assert_true(res, "Fill the queue");
+    lv_test_assert_true(!lv_cmdq_call(count_cb, &cnt), "Post to a full queue");
+
+    char long_text[LV_CMDQ_TEXT_MAX + 1];
+    _lv_memset(long_text, 'a', LV_CMDQ_TEXT_MAX);
+    long_text[LV_CMDQ_TEXT_MAX] = '\0';
+    lv_test_assert_true(!lv_cmdq_set_text(lv_scr_act(), long_text), "Post too long text");
+    lv_test_assert_true(!lv_cmdq_call(NULL, &cnt), "Post a NULL function");
+
+    lv_task_handler();
+    lv_cmdq_get_stat(&stat_end);
+    lv_test_assert_int_eq(LV_CMDQ_SIZE, cnt, "Called functions");
+    lv_test_assert_int_eq(stat_start.drop_cnt + 3, stat_end.drop_cnt, "Dropped commands");
+    lv_test_assert_int_eq(stat_start.exec_cnt + LV_CMDQ_SIZE, stat_end.exec_cnt, "Executed commands");
+
+    lv_test_assert_true(lv_cmdq_call(count_cb, &cnt), "Post after draining");
+    lv_task_handler();
+    lv_test_assert_int_eq(LV_CMDQ_SIZE + 1, cnt, "Called functions");
+}
+
+static void count_cb(void * user_data)
+{
+    uint32_t * cnt = user_data;
+    (*cnt)++;
+}
+
+#endif
+#endif
@@ -11,8 +11,13 @@
 #if LV_BUILD_TEST
 #include "lv_test_core.h"
 #include "lv_test_obj.h"
+#include "lv_test_mem.h"
+#include "lv_test_cmdq.h"
+#include "lv_test_indev.h"
 #include "lv_test_style.h"
+#include "lv_test_anim.h"
 #include "lv_test_font_loader.h"
+#include "lv_test_fs.h"
 
 /*********************
  *      DEFINES
@@ -45,8 +50,13 @@ void lv_test_core(void)
     lv_test_print("Start lv_core tests");
     lv_test_print("*******************");
 
+    lv_test_mem();
+    lv_test_cmdq();
     lv_test_obj();
+    lv_test_indev();
     lv_test_style();
+    lv_test_anim();
+    lv_test_fs();
     lv_test_font_loader();
 }
 
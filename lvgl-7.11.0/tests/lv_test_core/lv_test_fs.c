@@ -0,0 +1,437 @@
+/**
+ * @file lv_test_fs.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+
+#if LV_BUILD_TEST
+#include "lv_test_fs.h"
+#include "../../lv_drivers/fs/posix_fs.h"
+#include <stdio.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define REF_SIZE_MAX    8192
+#define RAM_IMG_W       5
+#define RAM_IMG_H       3
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_USE_FILESYSTEM
+typedef struct {
+    const uint8_t * data;
+    uint32_t size;
+    uint32_t pos;
+} ram_file_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_FILESYSTEM
+static uint32_t load_ref(const char * fn, uint8_t * buf);
+static void sequential_read(void);
+static void random_read(void);
+static void interleaved_read(void);
+static void direct_read(void);
+#if USE_POSIX_FS
+static void posix_overwrite(void);
+#endif
+static lv_fs_res_t ram_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t ram_close(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t ram_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t ram_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos);
+static lv_fs_res_t ram_direct(lv_fs_drv_t * drv, void * file_p, const void ** data_p, uint32_t * size_p);
+#if LV_FS_CACHE_BLOCK_CNT
+static void driver_stat(void);
+#endif
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_FILESYSTEM
+static uint8_t ref_1[REF_SIZE_MAX];
+static uint8_t ref_2[REF_SIZE_MAX];
+static uint32_t ref_1_size;
+static uint32_t ref_2_size;
+
+/*An indexed image file: header, palette and indices*/
+static uint8_t ram_img[4 + LV_IMG_BUF_SIZE_INDEXED_2BIT(RAM_IMG_W, RAM_IMG_H)];
+/*A true color image file*/
+static uint8_t ram_img_tc[4 + LV_IMG_BUF_SIZE_TRUE_COLOR(RAM_IMG_W, RAM_IMG_H)];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_fs(void)
+{
+#if LV_USE_FILESYSTEM
+    lv_test_print("");
+    lv_test_print("=================");
+    lv_test_print("Start lv_fs tests");
+    lv_test_print("=================");
+
+    ref_1_size = load_ref("font_1.fnt", ref_1);
+    ref_2_size = load_ref("font_2.fnt", ref_2);
+
+    sequential_read();
+    random_read();
+    interleaved_read();
+    direct_read();
+#if USE_POSIX_FS
+    posix_overwrite();
+#endif
+#if LV_FS_CACHE_BLOCK_CNT
+    driver_stat();
+#endif
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_FILESYSTEM
+static uint32_t load_ref(const char * fn, uint8_t * buf)
+{
+    FILE * fp = fopen(fn, "rb");
+    if(fp == NULL) {
+        lv_test_error("   FAIL: Can't open %s", fn);
+        return 0;
+    }
+
+    uint32_t size = fread(buf, 1, REF_SIZE_MAX, fp);
+    fclose(fp);
+
+    return size;
+}
+
+static void sequential_read(void)
+{
+    lv_test_print("");
+    lv_test_print("Read a file in chunks of different sizes");
+    lv_test_print("----------------------------------------");
+
+    static uint8_t buf[REF_SIZE_MAX];
+    static const uint32_t chunks[] = {1, 3, 7, 64, 100, 1, 500, 2, 1000, 129, 4096};
+
+    lv_fs_file_t f;
+    lv_fs_res_t res = lv_fs_open(&f, "f:font_1.fnt", LV_FS_MODE_RD);
+    lv_test_assert_int_eq(LV_FS_RES_OK, res, "Open the file");
+
+    uint32_t total = 0;
+    uint32_t i = 0;
+    while(total < ref_1_size) {
+        uint32_t br = 0;
+        res = lv_fs_read(&f, &buf[total], chunks[i % (sizeof(chunks) / sizeof(chunks[0]))], &br);
+        if(res != LV_FS_RES_OK || br == 0) break;
+        total += br;
+        i++;
+    }
+    lv_test_assert_int_eq(ref_1_size, total, "Read the whole file");
+    lv_test_assert_array_eq(ref_1, buf, ref_1_size, "Read data");
+
+    uint32_t br = 1;
+    lv_fs_read(&f, buf, 16, &br);
+    lv_test_assert_int_eq(0, br, "Read at the end of the file");
+
+    lv_fs_close(&f);
+}
+
+static void random_read(void)
+{
+    lv_test_print("");
+    lv_test_print("Read a file after seeks");
+    lv_test_print("-----------------------");
+
+    static const uint32_t pos[] = {5000, 10, 63, 64, 65, 6000, 127, 0, 4097, 2000};
+    static const uint32_t len[] = {100, 1, 2, 300, 64, 2000, 1, 128, 10, 3};
+
+    lv_fs_file_t f;
+    lv_fs_res_t res = lv_fs_open(&f, "f:font_1.fnt", LV_FS_MODE_RD);
+    lv_test_assert_int_eq(LV_FS_RES_OK, res, "Open the file");
+
+    static uint8_t buf[2000];
+    bool data_ok = true;
+    bool pos_ok = true;
+    uint32_t i;
+    for(i = 0; i < sizeof(pos) / sizeof(pos[0]); i++) {
+        uint32_t exp_len = LV_MATH_MIN(len[i], ref_1_size - pos[i]);
+        uint32_t br = 0;
+        lv_fs_seek(&f, pos[i]);
+        lv_fs_read(&f, buf, len[i], &br);
+        if(br != exp_len || memcmp(buf, &ref_1[pos[i]], exp_len) != 0) data_ok = false;
+
+        uint32_t act_pos = 0;
+        lv_fs_tell(&f, &act_pos);
+        if(act_pos != pos[i] + exp_len) pos_ok = false;
+    }
+
+    lv_test_assert_true(data_ok, "Read data");
+    lv_test_assert_true(pos_ok, "Position after the reads");
+
+    lv_fs_close(&f);
+}
+
+static void interleaved_read(void)
+{
+    lv_test_print("");
+    lv_test_print("Read two files byte by byte alternately");
+    lv_test_print("---------------------------------------");
+
+    lv_fs_file_t f1;
+    lv_fs_file_t f2;
+    lv_fs_open(&f1, "f:font_1.fnt", LV_FS_MODE_RD);
+    lv_fs_open(&f2, "f:font_2.fnt", LV_FS_MODE_RD);
+
+    bool ok = true;
+    uint32_t size = LV_MATH_MIN(ref_1_size, ref_2_size);
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        uint8_t b1 = 0;
+        uint8_t b2 = 0;
+        lv_fs_read(&f1, &b1, 1, NULL);
+        lv_fs_read(&f2, &b2, 1, NULL);
+        if(b1 != ref_1[i] || b2 != ref_2[i]) {
+            ok = false;
+            break;
+        }
+    }
+
+    lv_test_assert_true(ok, "Read data");
+
+    lv_fs_close(&f1);
+    lv_fs_close(&f2);
+}
+
+static void direct_read(void)
+{
+    lv_test_print("");
+    lv_test_print("Use a file in place");
+    lv_test_print("-------------------");
+
+    lv_fs_drv_t drv;
+    lv_fs_drv_init(&drv);
+    drv.letter = 'r';
+    drv.file_size = sizeof(ram_file_t);
+    drv.open_cb = ram_open;
+    drv.close_cb = ram_close;
+    drv.read_cb = ram_read;
+    drv.seek_cb = ram_seek;
+    drv.direct_cb = ram_direct;
+    lv_fs_drv_register(&drv);
+
+    lv_img_header_t header;
+    _lv_memset_00(&header, sizeof(header));
+    header.cf = LV_IMG_CF_INDEXED_2BIT;
+    header.w = RAM_IMG_W;
+    header.h = RAM_IMG_H;
+    _lv_memcpy(ram_img, &header, sizeof(header));
+    uint32_t i;
+    for(i = sizeof(header); i < sizeof(ram_img); i++) ram_img[i] = (uint8_t)(i * 37 + 11);
+
+    lv_fs_file_t f;
+    lv_fs_open(&f, "r:img.bin", LV_FS_MODE_RD);
+    const void * data = NULL;
+    uint32_t size = 0;
+    lv_fs_res_t res = lv_fs_get_direct(&f, &data, &size);
+    lv_test_assert_int_eq(LV_FS_RES_OK, res, "Get the content");
+    lv_test_assert_ptr_eq(ram_img, data, "Pointer to the content");
+    lv_test_assert_int_eq(sizeof(ram_img), size, "Size of the content");
+    lv_fs_close(&f);
+
+    lv_fs_open(&f, "f:font_1.fnt", LV_FS_MODE_RD);
+    res = lv_fs_get_direct(&f, &data, &size);
+    lv_test_assert_int_eq(LV_FS_RES_NOT_IMP, res, "No content from drivers without direct access");
+    lv_fs_close(&f);
+
+    /*The decoder should read the pixels in place like from a variable*/
+    lv_img_dsc_t img_dsc;
+    img_dsc.header = header;
+    img_dsc.data = &ram_img[sizeof(header)];
+    img_dsc.data_size = sizeof(ram_img) - sizeof(header);
+
+    lv_img_decoder_dsc_t dsc_file;
+    lv_img_decoder_dsc_t dsc_var;
+    lv_res_t res_file = lv_img_decoder_open(&dsc_file, "r:img.bin", LV_COLOR_BLACK);
+    lv_res_t res_var = lv_img_decoder_open(&dsc_var, &img_dsc, LV_COLOR_BLACK);
+    lv_test_assert_int_eq(LV_RES_OK, res_file, "Open the image file");
+    lv_test_assert_int_eq(LV_RES_OK, res_var, "Open the image variable");
+
+    bool ok = true;
+    lv_coord_t y;
+    for(y = 0; y < RAM_IMG_H; y++) {
+        uint8_t buf_file[RAM_IMG_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+        uint8_t buf_var[RAM_IMG_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+        lv_img_decoder_read_line(&dsc_file, 1, y, RAM_IMG_W - 1, buf_file);
+        lv_img_decoder_read_line(&dsc_var, 1, y, RAM_IMG_W - 1, buf_var);
+        if(memcmp(buf_file, buf_var, (RAM_IMG_W - 1) * LV_IMG_PX_SIZE_ALPHA_BYTE)) ok = false;
+    }
+    lv_test_assert_true(ok, "Decode the image in place");
+
+    lv_img_decoder_close(&dsc_file);
+    lv_img_decoder_close(&dsc_var);
+
+    header.cf = LV_IMG_CF_TRUE_COLOR;
+    _lv_memcpy(ram_img_tc, &header, sizeof(header));
+    res_file = lv_img_decoder_open(&dsc_file, "r:img_tc.bin", LV_COLOR_BLACK);
+    lv_test_assert_int_eq(LV_RES_OK, res_file, "Open the true color image file");
+    lv_test_assert_ptr_eq(&ram_img_tc[sizeof(header)], dsc_file.img_data, "True color pixels are used in place");
+    lv_img_decoder_close(&dsc_file);
+}
+
+#if USE_POSIX_FS
+static void posix_overwrite(void)
+{
+    lv_test_print("");
+    lv_test_print("Overwrite a file with a shorter one (POSIX driver)");
+    lv_test_print("--------------------------------------------------");
+
+    posix_fs_init();
+
+    static const char long_data[] = "0123456789abcdef";
+    static const char short_data[] = "xyz";
+    static const char fn[] = "P:lv_test_fs.tmp";
+
+    lv_fs_file_t f;
+    uint32_t bw = 0;
+    lv_fs_res_t res = lv_fs_open(&f, fn, LV_FS_MODE_WR);
+    lv_test_assert_int_eq(LV_FS_RES_OK, res, "Create the file");
+    lv_fs_write(&f, long_data, sizeof(long_data) - 1, &bw);
+    lv_fs_close(&f);
+
+    res = lv_fs_open(&f, fn, LV_FS_MODE_WR);
+    lv_test_assert_int_eq(LV_FS_RES_OK, res, "Open the file again");
+    lv_fs_write(&f, short_data, sizeof(short_data) - 1, &bw);
+    lv_fs_close(&f);
+
+    char buf[sizeof(long_data)];
+    uint32_t size = 0;
+    uint32_t br = 0;
+    lv_fs_open(&f, fn, LV_FS_MODE_RD);
+    lv_fs_size(&f, &size);
+    lv_fs_read(&f, buf, sizeof(buf), &br);
+    lv_fs_close(&f);
+    lv_test_assert_int_eq(sizeof(short_data) - 1, size, "No tail of the old content");
+    lv_test_assert_int_eq(sizeof(short_data) - 1, br, "Bytes read");
+    lv_test_assert_array_eq((const uint8_t *)short_data, (const uint8_t *)buf, br, "Data read");
+
+    res = lv_fs_remove(fn);
+    lv_test_assert_int_eq(LV_FS_RES_OK, res, "Remove the file");
+}
+#endif
+
+#if LV_FS_CACHE_BLOCK_CNT
+static void driver_stat(void)
+{
+    lv_test_print("");
+    lv_test_print("Count the I/O of a driver");
+    lv_test_print("-------------------------");
+
+    lv_fs_file_t f;
+    lv_fs_open(&f, "f:font_1.fnt", LV_FS_MODE_RD);
+    lv_fs_reset_stat('f');
+
+    /*Tiny reads are served by the cache*/
+    uint32_t i;
+    for(i = 0; i < 4 * LV_FS_CACHE_BLOCK_SIZE; i++) {
+        uint8_t b;
+        lv_fs_read(&f, &b, 1, NULL);
+    }
+
+    lv_fs_stat_t stat;
+    lv_fs_get_stat('f', &stat);
+    lv_test_assert_int_eq(4, stat.read_cnt, "Driver reads");
+    lv_test_assert_int_eq(4 * LV_FS_CACHE_BLOCK_SIZE, stat.read_bytes, "Bytes read by the driver");
+    lv_test_assert_int_eq(4, stat.miss_cnt, "Cache misses");
+    lv_test_assert_int_eq(4 * LV_FS_CACHE_BLOCK_SIZE - 4, stat.hit_cnt, "Cache hits");
+    lv_test_assert_int_eq(0, stat.seek_cnt, "No seeks for sequential reads");
+
+    /*Going back to a cached block needs no I/O*/
+    lv_fs_seek(&f, 3 * LV_FS_CACHE_BLOCK_SIZE + 1);
+    uint8_t b;
+    lv_fs_read(&f, &b, 1, NULL);
+    lv_fs_get_stat('f', &stat);
+    lv_test_assert_int_eq(4, stat.read_cnt, "No driver read for a cached block");
+    lv_test_assert_int_eq(ref_1[3 * LV_FS_CACHE_BLOCK_SIZE + 1], b, "Data of the cached block");
+
+    lv_fs_close(&f);
+}
+#endif
+
+static lv_fs_res_t ram_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(mode);
+
+    ram_file_t * file = file_p;
+    if(strcmp(path, "img.bin") == 0) {
+        file->data = ram_img;
+        file->size = sizeof(ram_img);
+    }
+    else if(strcmp(path, "img_tc.bin") == 0) {
+        file->data = ram_img_tc;
+        file->size = sizeof(ram_img_tc);
+    }
+    else {
+        return LV_FS_RES_NOT_EX;
+    }
+
+    file->pos = 0;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t ram_close(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(file_p);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t ram_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+
+    ram_file_t * file = file_p;
+    *br = file->pos < file->size ? LV_MATH_MIN(btr, file->size - file->pos) : 0;
+    memcpy(buf, file->data + file->pos, *br);
+    file->pos += *br;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t ram_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos)
+{
+    LV_UNUSED(drv);
+
+    ram_file_t * file = file_p;
+    file->pos = pos;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t ram_direct(lv_fs_drv_t * drv, void * file_p, const void ** data_p, uint32_t * size_p)
+{
+    LV_UNUSED(drv);
+
+    ram_file_t * file = file_p;
+    *data_p = file->data;
+    *size_p = file->size;
+    return LV_FS_RES_OK;
+}
+#endif
+
+#endif
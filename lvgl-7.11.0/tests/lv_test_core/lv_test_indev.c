@@ -0,0 +1,252 @@
+/**
+ * @file lv_test_indev.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_indev.h"
+
+#if LV_BUILD_TEST
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_COL_CNT       100
+#define BENCH_ROW_CNT       50
+#define BENCH_SEARCH_CNT    10000
+
+/*The tests with many objects don't fit into the smallest built-in heaps*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SIZE < 32 * 1024
+    #define MANY_OBJ_TEST   0
+#else
+    #define MANY_OBJ_TEST   1
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SIZE < 1024 * 1024
+    #define BENCH_TEST      0
+#else
+    #define BENCH_TEST      1
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_INDEV_HIT_INDEX && MANY_OBJ_TEST
+static void hit_index(void);
+static uint32_t search_diff_cnt(lv_obj_t * scr);
+static lv_obj_t * search_ref(lv_obj_t * obj, lv_point_t * point);
+#if BENCH_TEST
+static void hit_index_bench(void);
+#endif
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_indev(void)
+{
+    lv_test_print("");
+    lv_test_print("====================");
+    lv_test_print("Start lv_indev tests");
+    lv_test_print("====================");
+
+#if LV_INDEV_HIT_INDEX && MANY_OBJ_TEST
+    hit_index();
+#if BENCH_TEST
+    hit_index_bench();
+#endif
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_INDEV_HIT_INDEX && MANY_OBJ_TEST
+static void hit_index(void)
+{
+    lv_test_print("");
+    lv_test_print("Search with hit-test index:");
+    lv_test_print("---------------------------");
+
+    lv_hit_index_monitor_t mon_start;
+    lv_hit_index_monitor_t mon;
+    lv_hit_index_monitor(&mon_start);
+
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_t * par = lv_obj_create(scr, NULL);
+    lv_obj_set_pos(par, 10, 10);
+    lv_obj_set_size(par, 100, 60);
+
+    /*Overlapping children with some special ones*/
+    lv_obj_t * child[LV_INDEV_HIT_INDEX_MIN_CHILD];
+    uint32_t i;
+    for(i = 0; i < LV_INDEV_HIT_INDEX_MIN_CHILD; i++) {
+        child[i] = lv_obj_create(par, NULL);
+        lv_obj_set_pos(child[i], (i % 8) * 12, (i / 8) * 14);
+        lv_obj_set_size(child[i], 16, 18);
+    }
+    lv_obj_set_click(child[3], false);
+    lv_obj_set_hidden(child[5], true);
+    lv_obj_set_size(child[9], 150, 4);
+
+    lv_test_assert_int_eq(0, search_diff_cnt(scr), "Same result as checking every child");
+    lv_hit_index_monitor(&mon);
+    lv_test_assert_int_eq(mon_start.index_cnt + 1, mon.index_cnt, "The parent is indexed");
+    lv_test_assert_int_eq(0, search_diff_cnt(scr), "Same result with index");
+    lv_hit_index_monitor(&mon);
+    lv_test_assert_int_gt(mon_start.search_cnt, mon.search_cnt, "The index is used");
+
+    lv_test_print("Move and resize children");
+    lv_obj_set_pos(child[0], 70, 40);
+    lv_obj_set_size(child[10], 40, 40);
+    lv_obj_set_x(child[20], -10);
+    lv_test_assert_int_eq(0, search_diff_cnt(scr), "Same result after moving the children");
+    lv_hit_index_monitor(&mon);
+    lv_test_assert_int_gt(mon_start.update_cnt, mon.update_cnt, "The index is updated");
+
+    lv_test_print("Move the parent");
+    uint32_t build_cnt = mon.build_cnt;
+    lv_obj_set_pos(par, 30, 25);
+    lv_test_assert_int_eq(0, search_diff_cnt(scr), "Same result after moving the parent");
+    lv_hit_index_monitor(&mon);
+    lv_test_assert_int_eq(build_cnt, mon.build_cnt, "No rebuild after moving the parent");
+
+    lv_test_print("Reorder, add and delete children");
+    lv_obj_move_foreground(child[30]);
+    lv_obj_move_background(child[1]);
+    lv_obj_del(child[12]);
+    lv_obj_t * obj = lv_obj_create(par, NULL);
+    lv_obj_set_size(obj, 30, 30);
+    lv_obj_set_adv_hittest(child[25], true);
+    lv_obj_set_ext_click_area(child[26], 5, 5, 5, 5);
+    lv_test_assert_int_eq(0, search_diff_cnt(scr), "Same result after changing the children");
+
+    lv_obj_del(par);
+    lv_hit_index_monitor(&mon);
+    lv_test_assert_int_eq(mon_start.index_cnt, mon.index_cnt, "The index is deleted with the parent");
+}
+
+/**
+ * Compare the search with index and the reference search on the points of a screen
+ * @param scr pointer to a screen
+ * @return number of points where the found objects are different
+ */
+static uint32_t search_diff_cnt(lv_obj_t * scr)
+{
+    uint32_t cnt = 0;
+    lv_point_t p;
+    for(p.y = 0; p.y < 120; p.y += 3) {
+        for(p.x = 0; p.x < 160; p.x += 3) {
+            if(lv_indev_search_obj(scr, &p) != search_ref(scr, &p)) cnt++;
+        }
+    }
+
+    return cnt;
+}
+
+/**
+ * Search the top most clickable object by checking every child
+ * @param obj pointer to a start object
+ * @param point the point to search
+ * @return the found object or NULL
+ */
+static lv_obj_t * search_ref(lv_obj_t * obj, lv_point_t * point)
+{
+    if(lv_obj_hittest(obj, point) == false) return NULL;
+
+    lv_obj_t * i;
+    _LV_LL_READ(obj->child_ll, i) {
+        lv_obj_t * found = search_ref(i, point);
+        if(found) return found;
+    }
+
+    if(lv_obj_get_click(obj) == false) return NULL;
+    if(lv_obj_get_state(obj, LV_OBJ_PART_MAIN) & LV_STATE_DISABLED) return NULL;
+
+    lv_obj_t * hidden_i = obj;
+    while(hidden_i) {
+        if(lv_obj_get_hidden(hidden_i)) return NULL;
+        hidden_i = lv_obj_get_parent(hidden_i);
+    }
+
+    return obj;
+}
+
+#if BENCH_TEST
+static void hit_index_bench(void)
+{
+    lv_test_print("");
+    lv_test_print("Search among %d objects:", BENCH_COL_CNT * BENCH_ROW_CNT);
+    lv_test_print("----------------------------------");
+
+    lv_obj_t * par = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_pos(par, 0, 0);
+    lv_obj_set_size(par, BENCH_COL_CNT * 8, BENCH_ROW_CNT * 8);
+
+    uint32_t i;
+    for(i = 0; i < BENCH_COL_CNT * BENCH_ROW_CNT; i++) {
+        lv_obj_t * obj = lv_obj_create(par, NULL);
+        lv_obj_set_pos(obj, (i % BENCH_COL_CNT) * 8, (i / BENCH_COL_CNT) * 8);
+        lv_obj_set_size(obj, 7, 7);
+    }
+
+    /*Pseudo random points*/
+    static lv_point_t points[BENCH_SEARCH_CNT];
+    uint32_t seed = 1;
+    for(i = 0; i < BENCH_SEARCH_CNT; i++) {
+        seed = seed * 1103515245 + 12345;
+        points[i].x = (seed >> 8) % (BENCH_COL_CNT * 8);
+        seed = seed * 1103515245 + 12345;
+        points[i].y = (seed >> 8) % (BENCH_ROW_CNT * 8);
+    }
+
+    lv_obj_t * scr = lv_scr_act();
+    static lv_obj_t * found[BENCH_SEARCH_CNT];
+    clock_t start = clock();
+    for(i = 0; i < BENCH_SEARCH_CNT; i++) {
+        found[i] = search_ref(scr, &points[i]);
+    }
+    uint32_t ref_t = (uint32_t)((clock() - start) * 1000000 / CLOCKS_PER_SEC);
+
+    lv_hit_index_monitor_t mon_start;
+    lv_hit_index_monitor_t mon;
+    lv_indev_search_obj(scr, &points[0]);  /*Create and build the index*/
+    lv_hit_index_monitor(&mon_start);
+
+    uint32_t diff_cnt = 0;
+    start = clock();
+    for(i = 0; i < BENCH_SEARCH_CNT; i++) {
+        if(lv_indev_search_obj(scr, &points[i]) != found[i]) diff_cnt++;
+    }
+    uint32_t index_t = (uint32_t)((clock() - start) * 1000000 / CLOCKS_PER_SEC);
+    lv_hit_index_monitor(&mon);
+
+    lv_test_assert_int_eq(0, diff_cnt, "Same results with index");
+    lv_test_assert_int_lt(8, (mon.cand_cnt - mon_start.cand_cnt) / (mon.search_cnt - mon_start.search_cnt),
+                          "Few children are checked per search");
+    lv_test_print("%d searches: %d us without index, %d us with index", BENCH_SEARCH_CNT, ref_t, index_t);
+
+    lv_obj_del(par);
+}
+#endif
+#endif
+#endif
@@ -0,0 +1,322 @@
+/**
+ * @file lv_test_mem.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_mem.h"
+
+#if LV_BUILD_TEST
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BLOCK_CNT   32
+#define BENCH_OP_CNT    200000
+
+/*The benchmark keeps up to BLOCK_CNT blocks of 128 bytes*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SIZE < 16 * 1024
+    #define BENCH_TEST  0
+#else
+    #define BENCH_TEST  1
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void alloc_free(void);
+static void realloc_keep_data(void);
+static void realloc_zero_size(void);
+#if LV_MEM_LATENCY_HIST
+static void latency_hist(void);
+#endif
+#if BENCH_TEST
+static void alloc_bench(void);
+#endif
+#if LV_MEM_BUF_POOL
+static void buf_pool_reuse(void);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_mem(void)
+{
+    lv_test_print("");
+    lv_test_print("==================");
+    lv_test_print("Start lv_mem tests");
+    lv_test_print("==================");
+
+    alloc_free();
+    realloc_keep_data();
+    realloc_zero_size();
+#if LV_MEM_LATENCY_HIST
+    latency_hist();
+#endif
+#if BENCH_TEST
+    alloc_bench();
+#endif
+#if LV_MEM_BUF_POOL
+    buf_pool_reuse();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void alloc_free(void)
+{
+    lv_test_print("");
+    lv_test_print("Allocate and free blocks in mixed order:");
+    lv_test_print("----------------------------------------");
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor_t mon_end;
+    void * p[BLOCK_CNT];
+    uint32_t i;
+
+    lv_mem_defrag();
+    lv_mem_monitor(&mon_start);
+
+    lv_test_print("Allocate blocks with different sizes");
+    for(i = 0; i < BLOCK_CNT; i++) {
+        p[i] = lv_mem_alloc(4 + (i * 13) % 97);
+        lv_test_assert_true(p[i] != NULL, "Block allocated");
+        _lv_memset(p[i], (uint8_t)i, 4);
+    }
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    lv_test_print("Free every second block and allocate them again");
+    for(i = 0; i < BLOCK_CNT; i += 2) lv_mem_free(p[i]);
+    for(i = 0; i < BLOCK_CNT; i += 2) p[i] = lv_mem_alloc(8 + (i * 7) % 53);
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    for(i = 1; i < BLOCK_CNT; i += 2) {
+        lv_test_assert_int_eq(i, ((uint8_t *)p[i])[3], "Data of the untouched blocks is kept");
+    }
+
+    lv_test_print("Free all blocks");
+    for(i = 0; i < BLOCK_CNT; i++) lv_mem_free(p[(i * 5) % BLOCK_CNT]);
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    lv_mem_defrag();
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after freeing all blocks");
+#if LV_MEM_CUSTOM == 0
+    lv_test_assert_int_eq(mon_start.free_cnt, mon_end.free_cnt, "Free blocks are joined");
+#endif
+}
+
+static void realloc_keep_data(void)
+{
+    lv_test_print("");
+    lv_test_print("Reallocate a block:");
+    lv_test_print("-------------------");
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor_t mon_end;
+    uint32_t i;
+
+    lv_mem_defrag();
+    lv_mem_monitor(&mon_start);
+
+    uint8_t * p = lv_mem_alloc(16);
+    for(i = 0; i < 16; i++) p[i] = i;
+
+    lv_test_print("Grow a block");
+    uint8_t * blocker = lv_mem_alloc(16);
+    p = lv_mem_realloc(p, 200);
+    lv_test_assert_true(p != NULL, "Block reallocated");
+    lv_test_assert_int_gt(199, _lv_mem_get_size(p), "Size of the grown block");
+    for(i = 0; i < 16; i++) {
+        if(p[i] != i) break;
+    }
+    lv_test_assert_int_eq(16, i, "Data is kept after growing");
+
+    lv_test_print("Shrink a block");
+    p = lv_mem_realloc(p, 8);
+    lv_test_assert_int_eq(7, p[7], "Data is kept after shrinking");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    lv_mem_free(blocker);
+    lv_mem_free(p);
+
+    lv_mem_defrag();
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after freeing all blocks");
+}
+
+static void realloc_zero_size(void)
+{
+    lv_test_print("");
+    lv_test_print("Reallocate a 0 byte allocation:");
+    lv_test_print("-------------------------------");
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor_t mon_end;
+    uint32_t i;
+
+    lv_mem_defrag();
+    lv_mem_monitor(&mon_start);
+
+    /*A block behind the reallocated one which would be overwritten by a bad resize*/
+    uint8_t * neighbour = lv_mem_alloc(32);
+    _lv_memset(neighbour, 0x5a, 32);
+
+    uint8_t * p = lv_mem_alloc(0);
+    lv_test_assert_ptr_eq(p, lv_mem_realloc(p, 0), "Reallocate to 0 byte");
+
+    p = lv_mem_realloc(p, 48);
+    lv_test_assert_true(p != NULL, "Block reallocated");
+    lv_test_assert_int_gt(47, _lv_mem_get_size(p), "Size of the new block");
+    for(i = 0; i < 48; i++) p[i] = i;
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+    lv_test_assert_int_eq(0x5a, neighbour[31], "Data of the other block");
+
+    lv_mem_free(p);
+    lv_mem_free(neighbour);
+
+    lv_mem_defrag();
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after freeing all blocks");
+}
+
+#if LV_MEM_LATENCY_HIST
+static void latency_hist(void)
+{
+    lv_test_print("");
+    lv_test_print("Allocation latency histogram:");
+    lv_test_print("-----------------------------");
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor_t mon_end;
+    void * p[BLOCK_CNT];
+    uint32_t i;
+
+    lv_mem_monitor(&mon_start);
+    for(i = 0; i < BLOCK_CNT; i++) p[i] = lv_mem_alloc(8 + i);
+    for(i = 0; i < BLOCK_CNT; i++) lv_mem_free(p[i]);
+    lv_mem_monitor(&mon_end);
+
+    lv_test_assert_int_eq(BLOCK_CNT, mon_end.alloc_cnt - mon_start.alloc_cnt, "Measured allocations");
+
+    uint32_t hist_cnt = 0;
+    for(i = 0; i < LV_MEM_LATENCY_HIST_CNT; i++) {
+        hist_cnt += mon_end.alloc_lat_hist[i] - mon_start.alloc_lat_hist[i];
+    }
+    lv_test_assert_int_eq(BLOCK_CNT, hist_cnt, "Allocations in the histogram");
+    lv_test_assert_true(mon_end.alloc_lat_max >= mon_start.alloc_lat_max, "The longest allocation is kept");
+}
+#endif
+
+#if BENCH_TEST
+static void alloc_bench(void)
+{
+    lv_test_print("");
+    lv_test_print("Random alloc/free/realloc:");
+    lv_test_print("--------------------------");
+
+    void * p[BLOCK_CNT] = {NULL};
+    uint32_t seed = 1;
+    uint32_t fail_cnt = 0;
+    uint32_t i;
+
+    clock_t start = clock();
+    for(i = 0; i < BENCH_OP_CNT; i++) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t slot = (seed >> 8) % BLOCK_CNT;
+        uint32_t size = 1 + (seed >> 16) % 128;
+        if(p[slot] == NULL) {
+            p[slot] = lv_mem_alloc(size);
+            if(p[slot] == NULL) fail_cnt++;
+        }
+        else if(seed & 0x80) {
+            void * new_p = lv_mem_realloc(p[slot], size);
+            if(new_p == NULL) fail_cnt++;
+            else p[slot] = new_p;
+        }
+        else {
+            lv_mem_free(p[slot]);
+            p[slot] = NULL;
+        }
+    }
+    uint32_t t = (uint32_t)((clock() - start) * 1000000 / CLOCKS_PER_SEC);
+
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+    lv_test_assert_int_eq(0, fail_cnt, "Failed allocations");
+    for(i = 0; i < BLOCK_CNT; i++) lv_mem_free(p[i]);
+
+    lv_test_print("%d operations: %d us (%d ns/operation)", BENCH_OP_CNT, t, (uint32_t)((uint64_t)t * 1000 / BENCH_OP_CNT));
+}
+#endif
+
+#if LV_MEM_BUF_POOL
+static void buf_pool_reuse(void)
+{
+    lv_test_print("");
+    lv_test_print("Reuse the temporary buffers:");
+    lv_test_print("----------------------------");
+
+    lv_mem_buf_monitor_t mon_start;
+    lv_mem_buf_monitor_t mon_end;
+
+    uint8_t * a = _lv_mem_buf_get(100);
+    uint8_t * b = _lv_mem_buf_get(100);
+    uint8_t * c = _lv_mem_buf_get(20);
+    _lv_memset(a, 0xaa, 100);
+    _lv_memset(b, 0xbb, 100);
+    _lv_memset(c, 0xcc, 20);
+    lv_mem_buf_monitor(&mon_start);
+
+    lv_test_print("Release a buffer and get one from the same size class");
+    _lv_mem_buf_release(b);
+    uint8_t * d = _lv_mem_buf_get(120);
+    _lv_memset(d, 0xdd, 120);
+    lv_mem_buf_monitor(&mon_end);
+    lv_test_assert_ptr_eq(b, d, "Buffer from the same size class");
+    lv_test_assert_int_eq(mon_start.alloc_cnt, mon_end.alloc_cnt, "Allocations after reuse");
+    lv_test_assert_int_eq(0xaa, a[99], "Data of the other buffer");
+    lv_test_assert_int_eq(0xcc, c[19], "Data of the small buffer");
+
+    lv_test_print("Release all buffers at the end of a refresh");
+    _lv_mem_buf_free_all();
+    lv_mem_buf_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.buf_cnt, mon_end.buf_cnt, "Buffers kept in the pool");
+
+    lv_test_print("Free the buffers not used in the recent refreshes");
+    uint32_t i;
+    for(i = 0; i < LV_MEM_BUF_POOL_KEEP; i++) _lv_mem_buf_free_all();
+    lv_mem_buf_monitor(&mon_end);
+    lv_test_assert_int_eq(0, mon_end.buf_cnt, "Buffers in the pool");
+    lv_test_assert_int_eq(0, mon_end.buf_size, "Size of the pool");
+
+    lv_test_print("Free the whole pool, e.g. before the thread exits");
+    a = _lv_mem_buf_get(100);
+    b = _lv_mem_buf_get(300);
+    _lv_mem_buf_release(a);
+    lv_mem_buf_flush();
+    lv_mem_buf_monitor(&mon_end);
+    lv_test_assert_int_eq(0, mon_end.buf_cnt, "Buffers in the pool after flush");
+    lv_test_assert_int_eq(0, mon_end.buf_size, "Size of the pool after flush");
+}
+#endif
+#endif
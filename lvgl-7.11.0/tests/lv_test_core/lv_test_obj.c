@@ -11,10 +11,20 @@
 #include "lv_test_obj.h"
 
 #if LV_BUILD_TEST
+#include <time.h>
 
 /*********************
  *      DEFINES
  *********************/
+#define BENCH_ROUND_CNT     100
+#define BENCH_OBJ_CNT       100
+
+/*The benchmark keeps BENCH_OBJ_CNT objects alive at once*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SIZE < 32 * 1024
+    #define BENCH_TEST      0
+#else
+    #define BENCH_TEST      (LV_USE_LABEL && LV_USE_BTN && LV_USE_IMG)
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -24,6 +34,14 @@
  *  STATIC PROTOTYPES
  **********************/
 static void create_delete_change_parent(void);
+static void update_transaction(void);
+#if LV_OBJ_SLAB
+static void slab_reuse(void);
+#endif
+#if BENCH_TEST
+static void create_delete_bench(void);
+static uint32_t create_delete_time(lv_obj_t * (*create_cb)(lv_obj_t *, const lv_obj_t *));
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -45,6 +63,13 @@ void lv_test_obj(void)
     lv_test_print("==================");
 
     create_delete_change_parent();
+    update_transaction();
+#if LV_OBJ_SLAB
+    slab_reuse();
+#endif
+#if BENCH_TEST
+    create_delete_bench();
+#endif
 }
 
 /**********************
@@ -85,4 +110,130 @@ static void create_delete_change_parent(void)
     lv_obj_del(obj_parent);
     lv_test_assert_int_eq(0, lv_obj_count_children(lv_scr_act()), "Screen's children count after delete");
 }
+
+static void update_transaction(void)
+{
+    lv_test_print("");
+    lv_test_print("Update objects in a transaction:");
+    lv_test_print("--------------------------------");
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_obj_t * parent = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_pos(parent, 0, 0);
+    lv_obj_set_size(parent, 40, 10);
+
+    lv_obj_t * child[4];
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        child[i] = lv_obj_create(parent, NULL);
+        lv_obj_set_pos(child[i], i * 10, 0);
+        lv_obj_set_size(child[i], 10, 10);
+    }
+    lv_obj_t * other = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_pos(other, 60, 40);
+    lv_obj_set_size(other, 10, 10);
+    lv_refr_now(NULL);
+
+    lv_test_print("Invalidate the children without transaction");
+    for(i = 0; i < 4; i++) lv_obj_invalidate(child[i]);
+    lv_test_assert_int_gt(1, disp->inv_p, "Every child is invalidated separately");
+    lv_refr_now(NULL);
+
+    lv_test_print("Invalidate the children in a transaction");
+    lv_obj_begin_update(parent);
+    lv_obj_begin_update(child[0]);
+    for(i = 0; i < 4; i++) lv_obj_invalidate(child[i]);
+    lv_obj_end_update(child[0]);
+    lv_test_assert_int_eq(0, disp->inv_p, "Nothing is invalidated in a nested transaction");
+    lv_obj_invalidate(other);
+    lv_test_assert_int_eq(1, disp->inv_p, "An object out of the transaction is invalidated");
+    lv_obj_end_update(parent);
+    lv_test_assert_int_eq(2, disp->inv_p, "The children are invalidated with one area");
+    lv_refr_now(NULL);
+
+    lv_obj_del(parent);
+    lv_obj_del(other);
+}
+
+#if LV_OBJ_SLAB
+static void slab_reuse(void)
+{
+    lv_test_print("");
+    lv_test_print("Reuse the blocks of deleted objects:");
+    lv_test_print("------------------------------------");
+
+    lv_obj_slab_monitor_t mon_start;
+    lv_obj_slab_monitor_t mon_end;
+    lv_obj_slab_flush();
+    lv_obj_slab_monitor(&mon_start);
+
+    lv_test_print("Create and delete a label");
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_label_set_text(label, "first");
+    lv_obj_del(label);
+
+    lv_test_print("Create a label again and add more styles than allocated with it");
+    static lv_style_t styles[LV_OBJ_SLAB_STYLE_CNT + 1];
+    uint32_t i;
+    for(i = 0; i < LV_OBJ_SLAB_STYLE_CNT + 1; i++) lv_style_init(&styles[i]);
+
+    label = lv_label_create(lv_scr_act(), NULL);
+    lv_label_set_text(label, "second");
+    for(i = 0; i < LV_OBJ_SLAB_STYLE_CNT + 1; i++) lv_obj_add_style(label, LV_LABEL_PART_MAIN, &styles[i]);
+    lv_obj_set_style_local_text_opa(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_50);
+
+    lv_obj_slab_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.alloc_cnt + 2, mon_end.alloc_cnt, "Objects allocated from the slabs");
+    lv_test_assert_int_eq(mon_start.reuse_cnt + 1, mon_end.reuse_cnt, "Objects allocated from a cached block");
+    lv_test_assert_str_eq("second", lv_label_get_text(label), "Text of the label in the reused block");
+    lv_test_assert_int_eq(LV_OPA_50, lv_obj_get_style_text_opa(label, LV_LABEL_PART_MAIN), "Local style property");
+
+    lv_test_print("Remove the styles and delete the label");
+    for(i = 0; i < LV_OBJ_SLAB_STYLE_CNT + 1; i++) lv_obj_remove_style(label, LV_LABEL_PART_MAIN, &styles[i]);
+    lv_obj_del(label);
+
+    lv_test_print("Free the cached blocks");
+    lv_obj_slab_flush();
+    lv_obj_slab_monitor(&mon_end);
+    lv_test_assert_int_eq(0, mon_end.cached_cnt, "Cached blocks after flush");
+}
+#endif
+
+#if BENCH_TEST
+static void create_delete_bench(void)
+{
+    lv_test_print("");
+    lv_test_print("Create and delete %d objects:", BENCH_ROUND_CNT * BENCH_OBJ_CNT);
+    lv_test_print("-------------------------------");
+
+    uint32_t cnt_start = lv_obj_count_children(lv_scr_act());
+
+    lv_test_print("Base objects: %d us", create_delete_time(lv_obj_create));
+    lv_test_print("Labels: %d us", create_delete_time(lv_label_create));
+    lv_test_print("Buttons: %d us", create_delete_time(lv_btn_create));
+    lv_test_print("Images: %d us", create_delete_time(lv_img_create));
+
+    lv_test_assert_int_eq(cnt_start, lv_obj_count_children(lv_scr_act()), "Every object is deleted");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+}
+
+/**
+ * Create and delete objects in rounds. The objects of a round are deleted in reverse order.
+ * @param create_cb the create function of the widget
+ * @return the elapsed time in microseconds
+ */
+static uint32_t create_delete_time(lv_obj_t * (*create_cb)(lv_obj_t *, const lv_obj_t *))
+{
+    static lv_obj_t * obj[BENCH_OBJ_CNT];
+    uint32_t r;
+    uint32_t i;
+
+    clock_t start = clock();
+    for(r = 0; r < BENCH_ROUND_CNT; r++) {
+        for(i = 0; i < BENCH_OBJ_CNT; i++) obj[i] = create_cb(lv_scr_act(), NULL);
+        for(i = BENCH_OBJ_CNT; i > 0; i--) lv_obj_del(obj[i - 1]);
+    }
+    return (uint32_t)((clock() - start) * 1000000 / CLOCKS_PER_SEC);
+}
+#endif
 #endif
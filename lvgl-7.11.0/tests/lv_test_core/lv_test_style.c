@@ -11,6 +11,7 @@
 #include "lv_test_style.h"
 
 #if LV_BUILD_TEST
+#include <time.h>
 
 /*********************
  *      DEFINES
@@ -29,10 +30,37 @@ static void cascade(void);
 static void copy(void);
 static void states(void);
 static void mem_leak(void);
+#if LV_STYLE_RES_CACHE
+static void res_cache(void);
+#endif
+#if LV_STYLE_INDEX
+static void frozen(void);
+static void frozen_fill(lv_style_t * style, uint32_t prop_cnt);
+static uint32_t frozen_compare(const lv_style_t * linear, const lv_style_t * indexed);
+static uint32_t frozen_bench(const lv_style_t * style);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_STYLE_INDEX
+static const lv_style_property_t frozen_props[] = {
+    LV_STYLE_RADIUS, LV_STYLE_SIZE, LV_STYLE_TRANSFORM_WIDTH, LV_STYLE_TRANSFORM_HEIGHT, LV_STYLE_TRANSFORM_ANGLE,
+    LV_STYLE_PAD_TOP, LV_STYLE_PAD_BOTTOM, LV_STYLE_PAD_LEFT, LV_STYLE_PAD_RIGHT, LV_STYLE_PAD_INNER,
+    LV_STYLE_MARGIN_TOP, LV_STYLE_MARGIN_BOTTOM, LV_STYLE_MARGIN_LEFT, LV_STYLE_MARGIN_RIGHT, LV_STYLE_BORDER_WIDTH,
+    LV_STYLE_OUTLINE_WIDTH, LV_STYLE_OUTLINE_PAD, LV_STYLE_SHADOW_WIDTH, LV_STYLE_SHADOW_OFS_X, LV_STYLE_SHADOW_OFS_Y,
+};
+
+static const lv_state_t frozen_set_states[] = {LV_STATE_DEFAULT, LV_STATE_PRESSED, LV_STATE_CHECKED};
+
+static const lv_state_t frozen_get_states[] = {LV_STATE_DEFAULT, LV_STATE_PRESSED, LV_STATE_CHECKED, LV_STATE_FOCUSED,
+                                               LV_STATE_PRESSED | LV_STATE_FOCUSED, LV_STATE_CHECKED | LV_STATE_PRESSED,
+                                              };
+
+#define FROZEN_PROP_CNT    (sizeof(frozen_props) / sizeof(frozen_props[0]))
+#define FROZEN_SET_STATE_CNT   (sizeof(frozen_set_states) / sizeof(frozen_set_states[0]))
+#define FROZEN_GET_STATE_CNT   (sizeof(frozen_get_states) / sizeof(frozen_get_states[0]))
+#endif
 
 /**********************
  *      MACROS
@@ -55,6 +83,12 @@ void lv_test_style(void)
     copy();
     states();
     mem_leak();
+#if LV_STYLE_RES_CACHE
+    res_cache();
+#endif
+#if LV_STYLE_INDEX
+    frozen();
+#endif
 }
 
 /**********************
@@ -621,4 +655,194 @@ static void mem_leak(void)
     lv_mem_monitor(&mon_end);
     lv_test_assert_int_lt(sizeof(void*) * 8, mon_start.free_size - mon_end.free_size, "Style memory leak");
 }
+
+#if LV_STYLE_RES_CACHE
+static void res_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("Cache the resolved properties:");
+    lv_test_print("------------------------------");
+
+    lv_style_res_monitor_t mon_start;
+    lv_style_res_monitor_t mon_act;
+
+    lv_obj_t * parent = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_t * child = lv_obj_create(parent, NULL);
+    lv_obj_set_style_local_bg_opa(child, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_50);
+    lv_obj_set_style_local_text_letter_space(parent, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 3);
+
+    lv_test_print("Read a property twice");
+    lv_style_res_monitor(&mon_start);
+    lv_test_assert_int_eq(LV_OPA_50, lv_obj_get_style_bg_opa(child, LV_OBJ_PART_MAIN), "Resolved value");
+    lv_test_assert_int_eq(LV_OPA_50, lv_obj_get_style_bg_opa(child, LV_OBJ_PART_MAIN), "Cached value");
+    lv_style_res_monitor(&mon_act);
+    lv_test_assert_int_eq(mon_start.resolve_cnt + 1, mon_act.resolve_cnt, "Resolved properties");
+    lv_test_assert_int_eq(mon_start.hit_cnt + 1, mon_act.hit_cnt, "Cache hits");
+
+    lv_test_print("Change the local style");
+    lv_obj_set_style_local_bg_opa(child, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_70);
+    lv_test_assert_int_eq(LV_OPA_70, lv_obj_get_style_bg_opa(child, LV_OBJ_PART_MAIN), "New local value");
+
+    lv_test_print("Change the state");
+    lv_obj_set_style_local_bg_opa(child, LV_OBJ_PART_MAIN, LV_STATE_PRESSED, LV_OPA_90);
+    lv_obj_add_state(child, LV_STATE_PRESSED);
+    lv_test_assert_int_eq(LV_OPA_90, lv_obj_get_style_bg_opa(child, LV_OBJ_PART_MAIN), "Pressed value");
+    lv_obj_clear_state(child, LV_STATE_PRESSED);
+    lv_test_assert_int_eq(LV_OPA_70, lv_obj_get_style_bg_opa(child, LV_OBJ_PART_MAIN), "Released value");
+
+    lv_test_print("Change an inherited property of the parent");
+    lv_test_assert_int_eq(3, lv_obj_get_style_text_letter_space(child, LV_OBJ_PART_MAIN), "Inherited value");
+    lv_obj_set_style_local_text_letter_space(parent, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 5);
+    lv_test_assert_int_eq(5, lv_obj_get_style_text_letter_space(child, LV_OBJ_PART_MAIN), "New inherited value");
+
+    lv_obj_set_style_local_text_letter_space(parent, LV_OBJ_PART_MAIN, LV_STATE_CHECKED, 7);
+    lv_obj_add_state(parent, LV_STATE_CHECKED);
+    lv_test_assert_int_eq(7, lv_obj_get_style_text_letter_space(child, LV_OBJ_PART_MAIN), "Parent's new state");
+    lv_obj_remove_style_local_prop(parent, LV_OBJ_PART_MAIN,
+                                   LV_STYLE_TEXT_LETTER_SPACE | (LV_STATE_CHECKED << LV_STYLE_STATE_POS));
+    lv_test_assert_int_eq(5, lv_obj_get_style_text_letter_space(child, LV_OBJ_PART_MAIN), "Removed local property");
+
+    lv_test_print("Change the parent");
+    lv_obj_t * parent2 = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_style_local_text_letter_space(parent2, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 9);
+    lv_obj_set_parent(child, parent2);
+    lv_test_assert_int_eq(9, lv_obj_get_style_text_letter_space(child, LV_OBJ_PART_MAIN), "New parent's value");
+
+    lv_obj_del(parent);
+    lv_obj_del(parent2);
+}
+#endif
+
+#if LV_STYLE_INDEX
+static void frozen(void)
+{
+    lv_test_print("");
+    lv_test_print("Index the properties of frozen styles:");
+    lv_test_print("--------------------------------------");
+
+    const uint32_t prop_cnts[] = {5, 20, 60};
+    uint32_t i;
+    for(i = 0; i < sizeof(prop_cnts) / sizeof(prop_cnts[0]); i++) {
+        lv_style_t linear;
+        lv_style_t indexed;
+        lv_style_init(&linear);
+        lv_style_init(&indexed);
+        frozen_fill(&linear, prop_cnts[i]);
+        lv_style_copy(&indexed, &linear);
+        lv_style_freeze(&indexed);
+
+        lv_test_print("Look up in a style with %d properties", prop_cnts[i]);
+        lv_test_assert_true(lv_style_is_frozen(&indexed), "Style is frozen");
+        lv_test_assert_int_eq(0, frozen_compare(&linear, &indexed), "Same results as the linear search");
+
+        uint32_t t_linear = frozen_bench(&linear);
+        uint32_t t_indexed = frozen_bench(&indexed);
+        lv_test_print("Linear: %d ns, indexed: %d ns per look up", t_linear, t_indexed);
+
+        lv_style_reset(&linear);
+        lv_style_reset(&indexed);
+    }
+
+    lv_test_print("Modify a frozen style");
+    lv_style_t style;
+    lv_style_init(&style);
+    frozen_fill(&style, 20);
+    lv_style_freeze(&style);
+
+    lv_style_int_t value;
+    lv_style_set_pad_top(&style, LV_STATE_FOCUSED, 123);
+    lv_test_assert_true(!lv_style_is_frozen(&style), "Adding a property thaws the style");
+    _lv_style_get_int(&style, LV_STYLE_PAD_TOP | (LV_STATE_FOCUSED << LV_STYLE_STATE_POS), &value);
+    lv_test_assert_int_eq(123, value, "Get the new property");
+
+    lv_style_freeze(&style);
+    lv_style_set_pad_top(&style, LV_STATE_FOCUSED, 45);
+    lv_test_assert_true(lv_style_is_frozen(&style), "Overwriting a property keeps the index");
+    _lv_style_get_int(&style, LV_STYLE_PAD_TOP | (LV_STATE_FOCUSED << LV_STYLE_STATE_POS), &value);
+    lv_test_assert_int_eq(45, value, "Get the overwritten property");
+
+    lv_style_remove_prop(&style, LV_STYLE_PAD_TOP | (LV_STATE_FOCUSED << LV_STYLE_STATE_POS));
+    lv_test_assert_true(!lv_style_is_frozen(&style), "Removing a property thaws the style");
+    _lv_style_get_int(&style, LV_STYLE_PAD_TOP | (LV_STATE_FOCUSED << LV_STYLE_STATE_POS), &value);
+    lv_test_assert_int_eq(5, value, "Fall back to the default state");
+
+    lv_style_reset(&style);
+    lv_test_assert_true(!lv_style_is_frozen(&style), "Reset thaws the style");
+}
+
+/**
+ * Add integer properties to a style. The properties are repeated with more states after `FROZEN_PROP_CNT`.
+ * The value is the index of the property.
+ * @param style pointer to an initialized style
+ * @param prop_cnt number of properties to add
+ */
+static void frozen_fill(lv_style_t * style, uint32_t prop_cnt)
+{
+    uint32_t i;
+    for(i = 0; i < prop_cnt; i++) {
+        lv_style_property_t prop = frozen_props[i % FROZEN_PROP_CNT];
+        lv_state_t state = frozen_set_states[(i / FROZEN_PROP_CNT) % FROZEN_SET_STATE_CNT];
+        _lv_style_set_int(style, prop | (state << LV_STYLE_STATE_POS), i);
+    }
+}
+
+/**
+ * Compare the results of the linear search and the hash table
+ * @param linear pointer to a style without index
+ * @param indexed pointer to the frozen copy of `linear`
+ * @return number of different results
+ */
+static uint32_t frozen_compare(const lv_style_t * linear, const lv_style_t * indexed)
+{
+    uint32_t error_cnt = 0;
+    uint32_t p;
+    uint32_t s;
+    for(p = 0; p < FROZEN_PROP_CNT; p++) {
+        for(s = 0; s < FROZEN_GET_STATE_CNT; s++) {
+            lv_style_property_t prop = frozen_props[p] | (frozen_get_states[s] << LV_STYLE_STATE_POS);
+            lv_style_int_t v1 = -1;
+            lv_style_int_t v2 = -1;
+            int16_t w1 = _lv_style_get_int(linear, prop, &v1);
+            int16_t w2 = _lv_style_get_int(indexed, prop, &v2);
+            if(w1 != w2 || v1 != v2) error_cnt++;
+        }
+    }
+
+    /*A property which is not in the style*/
+    lv_style_int_t v;
+    if(_lv_style_get_int(indexed, LV_STYLE_VALUE_OFS_X, &v) != -1) error_cnt++;
+
+    return error_cnt;
+}
+
+/**
+ * Measure the time of a property look up
+ * @param style pointer to a style
+ * @return average time of a look up in nanoseconds
+ */
+static uint32_t frozen_bench(const lv_style_t * style)
+{
+    const uint32_t round_cnt = 2000;
+    volatile lv_style_int_t sink;
+    lv_style_int_t v;
+    uint32_t r;
+    uint32_t p;
+    uint32_t s;
+
+    clock_t start = clock();
+    for(r = 0; r < round_cnt; r++) {
+        for(p = 0; p < FROZEN_PROP_CNT; p++) {
+            for(s = 0; s < FROZEN_GET_STATE_CNT; s++) {
+                _lv_style_get_int(style, frozen_props[p] | (frozen_get_states[s] << LV_STYLE_STATE_POS), &v);
+                sink = v;
+            }
+        }
+    }
+    clock_t end = clock();
+    LV_UNUSED(sink);
+
+    double ns = (double)(end - start) * 1000000000.0 / CLOCKS_PER_SEC;
+    return (uint32_t)(ns / (round_cnt * FROZEN_PROP_CNT * FROZEN_GET_STATE_CNT));
+}
+#endif
 #endif
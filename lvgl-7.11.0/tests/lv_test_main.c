@@ -3,6 +3,14 @@
 #include <stdlib.h>
 #include "lv_test_core/lv_test_core.h"
 #include "lv_test_widgets/lv_test_label.h"
+#include "lv_test_widgets/lv_test_cont.h"
+#include "lv_test_widgets/lv_test_rect.h"
+#include "lv_test_widgets/lv_test_list.h"
+#include "lv_test_widgets/lv_test_chart.h"
+#include "lv_test_widgets/lv_test_line.h"
+#include "lv_test_widgets/lv_test_arc.h"
+#include "lv_test_widgets/lv_test_canvas.h"
+#include "lv_test_widgets/lv_test_img.h"
 
 #if LV_BUILD_TEST
 #include <sys/time.h>
@@ -21,6 +29,14 @@ int main(void)
 
     lv_test_core();
     lv_test_label();
+    lv_test_cont();
+    lv_test_rect();
+    lv_test_list();
+    lv_test_chart();
+    lv_test_line();
+    lv_test_arc();
+    lv_test_canvas();
+    lv_test_img();
 
     printf("Exit with success!\n");
     return 0;
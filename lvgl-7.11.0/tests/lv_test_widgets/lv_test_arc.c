@@ -0,0 +1,210 @@
+/**
+ * @file lv_test_arc.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_arc.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define REGION_SIZE         64
+#define ARC_X               40
+#define ARC_Y               32
+#define ARC_R               28
+#define ARC_W               10
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void arcs(void);
+static uint32_t check_arc(uint16_t start_angle, uint16_t end_angle);
+static lv_design_res_t arc_design(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode);
+static lv_color_t get_px(lv_coord_t x, lv_coord_t y);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t region_ref[REGION_SIZE * REGION_SIZE];
+static lv_design_cb_t ancestor_design;
+static uint16_t arc_start;
+static uint16_t arc_end;
+static bool arc_masked;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_arc(void)
+{
+    lv_test_print("");
+    lv_test_print("=======================");
+    lv_test_print("Start lv_draw_arc tests");
+    lv_test_print("=======================");
+
+    arcs();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void arcs(void)
+{
+    lv_test_print("");
+    lv_test_print("Arcs:");
+    lv_test_print("-----");
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_size(obj, LV_HOR_RES, LV_VER_RES);
+    lv_obj_set_pos(obj, 0, 0);
+    lv_obj_set_style_local_bg_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+    lv_obj_set_style_local_bg_opa(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_COVER);
+    lv_obj_set_style_local_border_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+    ancestor_design = lv_obj_get_design_cb(obj);
+    lv_obj_set_design_cb(obj, arc_design);
+
+    static const uint16_t angles[][2] = {{0, 360}, {30, 300}, {200, 340}, {300, 60}, {90, 91}};
+    uint32_t i;
+    for(i = 0; i < sizeof(angles) / sizeof(angles[0]); i++) {
+        lv_test_print("Arc from %d to %d degree", angles[i][0], angles[i][1]);
+        arc_start = angles[i][0];
+        arc_end = angles[i][1];
+
+        /*Another mask makes the arc drawn with masks. The two ways should give the same result*/
+        arc_masked = true;
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+        lv_coord_t y;
+        for(y = 0; y < REGION_SIZE; y++) {
+            lv_coord_t x;
+            for(x = 0; x < REGION_SIZE; x++) region_ref[y * REGION_SIZE + x] = get_px(x, y);
+        }
+
+        arc_masked = false;
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+        lv_test_assert_int_eq(0, check_arc(arc_start, arc_end), "Inner and outer pixels");
+
+#if LV_ANTIALIAS
+        /*The anti-aliased edges can be slightly different.
+         *Without anti-aliasing the masks round a few pixels of the circles differently.*/
+        uint32_t diff_cnt = 0;
+        for(y = 0; y < REGION_SIZE; y++) {
+            lv_coord_t x;
+            for(x = 0; x < REGION_SIZE; x++) {
+                lv_color32_t c_ref;
+                lv_color32_t c_act;
+                c_ref.full = lv_color_to32(region_ref[y * REGION_SIZE + x]);
+                c_act.full = lv_color_to32(get_px(x, y));
+                if(LV_MATH_ABS(c_ref.ch.red - c_act.ch.red) > 0x30 ||
+                   LV_MATH_ABS(c_ref.ch.green - c_act.ch.green) > 0x30 ||
+                   LV_MATH_ABS(c_ref.ch.blue - c_act.ch.blue) > 0x30) {
+                    diff_cnt++;
+                }
+            }
+        }
+        lv_test_assert_int_eq(0, diff_cnt, "Same as the arc drawn with masks");
+#endif
+    }
+
+    lv_obj_del(obj);
+}
+
+/**
+ * Check the pixels of the last refreshed screen which are surely on or out of a red arc on white background
+ * @param start_angle the start angle of the arc
+ * @param end_angle the end angle of the arc
+ * @return number of wrong pixels
+ */
+static uint32_t check_arc(uint16_t start_angle, uint16_t end_angle)
+{
+    bool full = start_angle == 0 && end_angle == 360;
+    uint32_t sweep = (end_angle + 360 - start_angle) % 360;
+    uint32_t err = 0;
+    lv_coord_t y;
+    for(y = 0; y < REGION_SIZE; y++) {
+        lv_coord_t x;
+        for(x = 0; x < REGION_SIZE; x++) {
+            /*In half pixels from the top left corner of the center pixel*/
+            int32_t dx = 2 * (x - ARC_X) + 1;
+            int32_t dy = 2 * (y - ARC_Y) + 1;
+            int32_t d_sq = dx * dx + dy * dy;
+            int32_t r_out = 2 * ARC_R;
+            int32_t r_in = 2 * (ARC_R - ARC_W);
+            uint32_t a = (_lv_atan2(dy, dx) + 360 - start_angle) % 360;
+
+            /*`_lv_atan2()` is accurate only to about 1 degree*/
+            bool on = d_sq < (r_out - 3) * (r_out - 3) && d_sq > (r_in + 3) * (r_in + 3);
+            if(!full && (a < 4 || a + 4 > sweep)) on = false;
+            bool out = d_sq > (r_out + 3) * (r_out + 3) || d_sq < (r_in - 3) * (r_in - 3);
+            if(!full && d_sq > (r_in - 3) * (r_in - 3) && a > sweep + 4 && a + 4 < 360) out = true;
+
+            lv_color_t c = get_px(x, y);
+            if(on && c.full != LV_COLOR_RED.full) err++;
+            else if(out && c.full != LV_COLOR_WHITE.full) err++;
+        }
+    }
+
+    return err;
+}
+
+/**
+ * Design function which draws an arc onto the object
+ * @param obj pointer to an object
+ * @param clip_area the object can draw only in this area
+ * @param mode what to do
+ * @return an element of `lv_design_res_t`
+ */
+static lv_design_res_t arc_design(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode)
+{
+    lv_design_res_t res = ancestor_design(obj, clip_area, mode);
+    if(mode != LV_DESIGN_DRAW_MAIN) return res;
+
+    lv_draw_line_dsc_t dsc;
+    lv_draw_line_dsc_init(&dsc);
+    dsc.color = LV_COLOR_RED;
+    dsc.width = ARC_W;
+
+    lv_draw_mask_radius_param_t mask_param;
+    int16_t mask_id = LV_MASK_ID_INV;
+    if(arc_masked) {
+        lv_draw_mask_radius_init(&mask_param, &obj->coords, 0, false);
+        mask_id = lv_draw_mask_add(&mask_param, NULL);
+    }
+
+    lv_draw_arc(ARC_X, ARC_Y, ARC_R, arc_start, arc_end, clip_area, &dsc);
+
+    if(arc_masked) lv_draw_mask_remove_id(mask_id);
+
+    return res;
+}
+
+/**
+ * Get a pixel of the last refreshed screen
+ * @param x the x coordinate
+ * @param y the y coordinate
+ * @return the color of the pixel
+ */
+static lv_color_t get_px(lv_coord_t x, lv_coord_t y)
+{
+    extern lv_color_t test_fb[];
+    return test_fb[y * LV_HOR_RES + x];
+}
+#endif
@@ -0,0 +1,408 @@
+/**
+ * @file lv_test_canvas.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_canvas.h"
+
+#if LV_BUILD_TEST
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CANVAS_W        100
+#define CANVAS_H        80
+#define CANVAS_X        10
+#define CANVAS_Y        20
+#define BATCH_RECT_CNT  1000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_CANVAS && LV_CANVAS_DIRTY_AREA
+static void dirty_area(void);
+static void batch(void);
+static void direct_fill(void);
+static void assert_inv_area(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2, const char * msg);
+#endif
+#if LV_USE_CANVAS
+static void box_blur(void);
+static void gauss_blur(void);
+static lv_obj_t * canvas_create(lv_img_cf_t cf);
+static void fill_pattern(lv_obj_t * canvas);
+static uint32_t check_box_blur(lv_obj_t * canvas, const lv_area_t * area, uint16_t r, bool ver);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_CANVAS
+static uint8_t canvas_buf[LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(CANVAS_W, CANVAS_H)];
+static lv_color_t ref_buf[CANVAS_W * CANVAS_H];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_canvas(void)
+{
+    lv_test_print("");
+    lv_test_print("=====================");
+    lv_test_print("Start lv_canvas tests");
+    lv_test_print("=====================");
+
+#if LV_USE_CANVAS && LV_CANVAS_DIRTY_AREA
+    dirty_area();
+    batch();
+    direct_fill();
+#else
+    lv_test_print("Skip canvas dirty area test: LV_USE_CANVAS == 0 or LV_CANVAS_DIRTY_AREA == 0");
+#endif
+
+#if LV_USE_CANVAS
+    box_blur();
+    gauss_blur();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_CANVAS && LV_CANVAS_DIRTY_AREA
+static void dirty_area(void)
+{
+    lv_test_print("");
+    lv_test_print("Invalidate the drawn area:");
+    lv_test_print("--------------------------");
+
+    lv_obj_t * canvas = canvas_create(LV_IMG_CF_TRUE_COLOR);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = LV_COLOR_RED;
+    lv_canvas_draw_rect(canvas, 30, 40, 10, 5, &rect_dsc);
+    assert_inv_area(CANVAS_X + 30, CANVAS_Y + 40, CANVAS_X + 39, CANVAS_Y + 44, "Rectangle");
+    lv_test_assert_color_eq(LV_COLOR_RED, lv_canvas_get_px(canvas, 39, 44), "The rectangle is drawn");
+    lv_refr_now(NULL);
+
+    lv_test_print("Clip the area to the canvas");
+    lv_canvas_draw_rect(canvas, -5, CANVAS_H - 5, 10, 10, &rect_dsc);
+    assert_inv_area(CANVAS_X, CANVAS_Y + CANVAS_H - 5, CANVAS_X + 4, CANVAS_Y + CANVAS_H - 1, "Rectangle on the corner");
+    lv_refr_now(NULL);
+
+    lv_test_print("Include the shadow");
+    rect_dsc.shadow_width = 10;
+    rect_dsc.shadow_ofs_y = 5;
+    lv_canvas_draw_rect(canvas, 40, 30, 10, 10, &rect_dsc);
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_test_assert_int_eq(1, disp->inv_p, "One area is invalidated");
+    lv_test_assert_int_lt(CANVAS_X + 40 - 5 + 1, disp->inv_areas[0].x1, "Left side of the shadow");
+    lv_test_assert_int_gt(CANVAS_Y + 39 + 5 + 5 - 1, disp->inv_areas[0].y2, "Bottom side of the shadow");
+    lv_refr_now(NULL);
+
+    lv_test_print("Line and pixel");
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    line_dsc.width = 4;
+    lv_point_t points[] = {{20, 10}, {50, 30}, {35, 60}};
+    lv_canvas_draw_line(canvas, points, 3, &line_dsc);
+    assert_inv_area(CANVAS_X + 20 - 3, CANVAS_Y + 10 - 3, CANVAS_X + 50 + 3, CANVAS_Y + 60 + 3, "Line");
+    lv_refr_now(NULL);
+
+    lv_canvas_set_px(canvas, 5, 6, LV_COLOR_BLUE);
+    assert_inv_area(CANVAS_X + 5, CANVAS_Y + 6, CANVAS_X + 5, CANVAS_Y + 6, "Pixel");
+    lv_refr_now(NULL);
+
+    lv_test_print("Invalidate the whole zoomed canvas");
+    lv_img_set_zoom(canvas, 512);
+    lv_refr_now(NULL);
+    lv_canvas_set_px(canvas, 5, 6, LV_COLOR_BLUE);
+    lv_test_assert_int_eq(1, disp->inv_p, "One area is invalidated");
+    lv_test_assert_int_lt(canvas->coords.x1 + 1, disp->inv_areas[0].x1, "Left side of the canvas");
+    lv_test_assert_int_gt(canvas->coords.x2 - 1, disp->inv_areas[0].x2, "Right side of the canvas");
+
+    lv_obj_del(canvas);
+    lv_refr_now(NULL);
+}
+
+static void batch(void)
+{
+    lv_test_print("");
+    lv_test_print("Draw in a batch:");
+    lv_test_print("----------------");
+
+    lv_obj_t * canvas = canvas_create(LV_IMG_CF_TRUE_COLOR);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = LV_COLOR_GREEN;
+    rect_dsc.radius = 2;
+
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    line_dsc.width = 2;
+    lv_point_t points[] = {{50, 50}, {60, 70}};
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_canvas_draw_begin(canvas);
+    lv_canvas_draw_rect(canvas, 10, 5, 10, 10, &rect_dsc);
+    lv_canvas_draw_line(canvas, points, 2, &line_dsc);
+    lv_test_assert_int_eq(0, disp->inv_p, "Nothing is invalidated while drawing");
+    lv_canvas_draw_end(canvas);
+    assert_inv_area(CANVAS_X + 10, CANVAS_Y + 5, CANVAS_X + 60 + 2, CANVAS_Y + 70 + 2, "The joined area");
+    lv_test_assert_color_eq(LV_COLOR_GREEN, lv_canvas_get_px(canvas, 15, 10), "The rectangle is drawn");
+    lv_refr_now(NULL);
+
+    lv_test_print("Compare many rectangles with and without batch");
+    uint32_t i;
+    clock_t start = clock();
+    for(i = 0; i < BATCH_RECT_CNT; i++) {
+        lv_canvas_draw_rect(canvas, i % (CANVAS_W - 8), i % (CANVAS_H - 8), 8, 8, &rect_dsc);
+    }
+    clock_t end = clock();
+    lv_test_print("%d rectangles without batch: %d us", BATCH_RECT_CNT,
+                  (uint32_t)((end - start) * 1000000 / CLOCKS_PER_SEC));
+    lv_refr_now(NULL);
+
+    start = clock();
+    lv_canvas_draw_begin(canvas);
+    for(i = 0; i < BATCH_RECT_CNT; i++) {
+        lv_canvas_draw_rect(canvas, i % (CANVAS_W - 8), i % (CANVAS_H - 8), 8, 8, &rect_dsc);
+    }
+    lv_canvas_draw_end(canvas);
+    end = clock();
+    lv_test_print("%d rectangles in a batch: %d us", BATCH_RECT_CNT,
+                  (uint32_t)((end - start) * 1000000 / CLOCKS_PER_SEC));
+    lv_test_assert_int_eq(1, disp->inv_p, "One area is invalidated");
+
+    lv_obj_del(canvas);
+    lv_refr_now(NULL);
+}
+
+static void direct_fill(void)
+{
+    lv_test_print("");
+    lv_test_print("Fill rectangles directly:");
+    lv_test_print("-------------------------");
+
+    lv_obj_t * canvas = canvas_create(LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+
+    lv_canvas_fill_bg(canvas, LV_COLOR_BLUE, LV_OPA_50);
+    lv_test_assert_color_eq(LV_COLOR_BLUE, lv_canvas_get_px(canvas, CANVAS_W - 1, CANVAS_H - 1), "Color of the background");
+    lv_test_assert_int_eq(LV_OPA_50, lv_img_buf_get_px_alpha(dsc, CANVAS_W - 1, CANVAS_H - 1), "Opacity of the background");
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = LV_COLOR_RED;
+    lv_canvas_draw_rect(canvas, 10, 10, 20, 20, &rect_dsc);
+    lv_test_assert_color_eq(LV_COLOR_RED, lv_canvas_get_px(canvas, 10, 29), "Color of the rectangle");
+    lv_test_assert_int_eq(LV_OPA_COVER, lv_img_buf_get_px_alpha(dsc, 29, 10), "Opacity of the rectangle");
+    lv_test_assert_color_eq(LV_COLOR_BLUE, lv_canvas_get_px(canvas, 30, 10), "Right of the rectangle");
+    lv_test_assert_color_eq(LV_COLOR_BLUE, lv_canvas_get_px(canvas, 10, 30), "Below the rectangle");
+
+    lv_test_print("Blend transparent rectangles");
+    rect_dsc.bg_opa = LV_OPA_50;
+    lv_canvas_draw_rect(canvas, 50, 10, 20, 20, &rect_dsc);
+    lv_test_assert_int_gt(LV_OPA_50, lv_img_buf_get_px_alpha(dsc, 60, 20), "Opacity is mixed");
+
+    lv_obj_del(canvas);
+    lv_refr_now(NULL);
+}
+
+#endif
+
+#if LV_USE_CANVAS
+static void box_blur(void)
+{
+    lv_test_print("");
+    lv_test_print("Box blur:");
+    lv_test_print("---------");
+
+    lv_obj_t * canvas = canvas_create(LV_IMG_CF_TRUE_COLOR);
+    lv_area_t a = {10, 5, 60, 50};
+
+    fill_pattern(canvas);
+    lv_canvas_blur_hor(canvas, &a, 5);
+    lv_test_assert_int_eq(0, check_box_blur(canvas, &a, 5, false), "Horizontal blur");
+
+    fill_pattern(canvas);
+    lv_canvas_blur_ver(canvas, &a, 4);
+    lv_test_assert_int_eq(0, check_box_blur(canvas, &a, 4, true), "Vertical blur with even size");
+
+    a.x1 = -10;
+    a.y1 = -10;
+    a.x2 = CANVAS_W + 10;
+    a.y2 = CANVAS_H + 10;
+    fill_pattern(canvas);
+    lv_canvas_blur_ver(canvas, NULL, 9);
+    lv_test_assert_int_eq(0, check_box_blur(canvas, &a, 9, true), "Vertical blur of the whole canvas");
+
+    lv_obj_del(canvas);
+    lv_refr_now(NULL);
+}
+
+static void gauss_blur(void)
+{
+    lv_test_print("");
+    lv_test_print("Gaussian blur:");
+    lv_test_print("--------------");
+
+    lv_obj_t * canvas = canvas_create(LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+    lv_canvas_fill_bg(canvas, LV_COLOR_WHITE, LV_OPA_TRANSP);
+
+    /*Blur a small opaque square in the middle*/
+    lv_coord_t cx = CANVAS_W / 2;
+    lv_coord_t cy = CANVAS_H / 2;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = cy - 1; y <= cy + 1; y++) {
+        for(x = cx - 1; x <= cx + 1; x++) {
+            lv_img_buf_set_px_alpha(dsc, x, y, LV_OPA_COVER);
+        }
+    }
+
+    lv_canvas_blur_gauss(canvas, NULL, 3);
+
+    lv_opa_t center = lv_img_buf_get_px_alpha(dsc, cx, cy);
+    lv_test_assert_int_lt(LV_OPA_COVER, center, "Center is blurred");
+    lv_test_assert_int_gt(lv_img_buf_get_px_alpha(dsc, cx + 3, cy), center, "Center is the most opaque");
+
+    uint32_t asym = 0;
+    lv_coord_t d;
+    for(d = 1; d < 8; d++) {
+        int32_t opa_l = lv_img_buf_get_px_alpha(dsc, cx - d, cy);
+        int32_t opa_r = lv_img_buf_get_px_alpha(dsc, cx + d, cy);
+        int32_t opa_t = lv_img_buf_get_px_alpha(dsc, cx, cy - d);
+        int32_t opa_b = lv_img_buf_get_px_alpha(dsc, cx, cy + d);
+        if(LV_MATH_ABS(opa_l - opa_r) > 1 || LV_MATH_ABS(opa_t - opa_b) > 1 || LV_MATH_ABS(opa_l - opa_t) > 1) asym++;
+    }
+    lv_test_assert_int_eq(0, asym, "Symmetric");
+    lv_test_assert_int_gt(0, lv_img_buf_get_px_alpha(dsc, cx + 5, cy), "Reaches 5 px");
+    lv_test_assert_int_eq(0, lv_img_buf_get_px_alpha(dsc, cx + 15, cy), "Doesn't reach 15 px");
+
+    lv_obj_del(canvas);
+    lv_refr_now(NULL);
+}
+
+/**
+ * Create a canvas on the screen and refresh the screen
+ * @param cf color format of the canvas
+ * @return pointer to the canvas
+ */
+static lv_obj_t * canvas_create(lv_img_cf_t cf)
+{
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act(), NULL);
+    lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_H, cf);
+    lv_canvas_fill_bg(canvas, LV_COLOR_WHITE, LV_OPA_COVER);
+    lv_obj_set_pos(canvas, CANVAS_X, CANVAS_Y);
+    lv_refr_now(NULL);
+
+    return canvas;
+}
+
+/**
+ * Fill a canvas with a pattern to blur and save it to `ref_buf`
+ * @param canvas pointer to a canvas
+ */
+static void fill_pattern(lv_obj_t * canvas)
+{
+    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < CANVAS_H; y++) {
+        for(x = 0; x < CANVAS_W; x++) {
+            lv_color_t c = lv_color_make((x * 37 + y * 11) & 0xff, (x * x + y) & 0xff, (y * 23) & 0xff);
+            lv_img_buf_set_px_color(dsc, x, y, c);
+            ref_buf[y * CANVAS_W + x] = lv_img_buf_get_px_color(dsc, x, y, LV_COLOR_BLACK);
+        }
+    }
+}
+
+/**
+ * Compare a blurred canvas with the box blur of `ref_buf`
+ * @param canvas pointer to a canvas
+ * @param area the blurred area
+ * @param r size of the window
+ * @param ver false: horizontal blur; true: vertical blur
+ * @return number of pixels with different color
+ */
+static uint32_t check_box_blur(lv_obj_t * canvas, const lv_area_t * area, uint16_t r, bool ver)
+{
+    int32_t r_back = (r & 0x1) ? r / 2 : r / 2 - 1;
+    uint32_t err = 0;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < CANVAS_H; y++) {
+        for(x = 0; x < CANVAS_W; x++) {
+            lv_color_t exp = ref_buf[y * CANVAS_W + x];
+            if(x >= area->x1 && x <= area->x2 && y >= area->y1 && y <= area->y2) {
+                /*Average of the window with the edge pixels repeated*/
+                int32_t rsum = 0;
+                int32_t gsum = 0;
+                int32_t bsum = 0;
+                int32_t i;
+                for(i = -r_back; i < r - r_back; i++) {
+                    lv_coord_t xs = ver ? x : LV_MATH_MIN(LV_MATH_MAX(x + i, 0), CANVAS_W - 1);
+                    lv_coord_t ys = ver ? LV_MATH_MIN(LV_MATH_MAX(y + i, 0), CANVAS_H - 1) : y;
+                    lv_color_t c = ref_buf[ys * CANVAS_W + xs];
+                    rsum += LV_COLOR_GET_R(c);
+                    gsum += LV_COLOR_GET_G(c);
+                    bsum += LV_COLOR_GET_B(c);
+                }
+                LV_COLOR_SET_R(exp, (rsum + r / 2) / r);
+                LV_COLOR_SET_G(exp, (gsum + r / 2) / r);
+                LV_COLOR_SET_B(exp, (bsum + r / 2) / r);
+            }
+
+            lv_color_t act = lv_canvas_get_px(canvas, x, y);
+            if(LV_MATH_ABS(LV_COLOR_GET_R(act) - LV_COLOR_GET_R(exp)) > 1 ||
+               LV_MATH_ABS(LV_COLOR_GET_G(act) - LV_COLOR_GET_G(exp)) > 1 ||
+               LV_MATH_ABS(LV_COLOR_GET_B(act) - LV_COLOR_GET_B(exp)) > 1) {
+                err++;
+            }
+        }
+    }
+
+    return err;
+}
+#endif
+
+#if LV_USE_CANVAS && LV_CANVAS_DIRTY_AREA
+
+/**
+ * Check that only one area is invalidated on the display
+ * @param x1 expected left side
+ * @param y1 expected top side
+ * @param x2 expected right side
+ * @param y2 expected bottom side
+ * @param msg message to print
+ */
+static void assert_inv_area(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2, const char * msg)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_test_assert_int_eq(1, disp->inv_p, msg);
+    lv_test_assert_int_eq(x1, disp->inv_areas[0].x1, "Left side");
+    lv_test_assert_int_eq(y1, disp->inv_areas[0].y1, "Top side");
+    lv_test_assert_int_eq(x2, disp->inv_areas[0].x2, "Right side");
+    lv_test_assert_int_eq(y2, disp->inv_areas[0].y2, "Bottom side");
+}
+#endif
+#endif
@@ -0,0 +1,177 @@
+/**
+ * @file lv_test_chart.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_chart.h"
+
+#if LV_BUILD_TEST
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define RING_POINT_CNT      8
+#define STREAM_POINT_CNT    10000
+
+/*The tests with many objects don't fit into the smallest built-in heaps*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SIZE < 32 * 1024
+    #define MANY_OBJ_TEST   0
+#else
+    #define MANY_OBJ_TEST   1
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_CHART && LV_CHART_STREAM && MANY_OBJ_TEST
+static void next_array(void);
+static void shift_invalidation(void);
+static void decimation(void);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_chart(void)
+{
+    lv_test_print("");
+    lv_test_print("====================");
+    lv_test_print("Start lv_chart tests");
+    lv_test_print("====================");
+
+#if LV_USE_CHART && LV_CHART_STREAM
+#if MANY_OBJ_TEST
+    next_array();
+    shift_invalidation();
+    decimation();
+#else
+    lv_test_print("Skip the chart tests: LV_MEM_SIZE is too small");
+#endif
+#else
+    lv_test_print("Skip chart test: LV_USE_CHART == 0 or LV_CHART_STREAM == 0");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_CHART && LV_CHART_STREAM && MANY_OBJ_TEST
+static void next_array(void)
+{
+    lv_test_print("");
+    lv_test_print("Add an array of points:");
+    lv_test_print("-----------------------");
+
+    lv_obj_t * chart = lv_chart_create(lv_scr_act(), NULL);
+    lv_chart_set_point_count(chart, RING_POINT_CNT);
+    lv_chart_series_t * ser = lv_chart_add_series(chart, LV_COLOR_RED);
+
+    lv_coord_t values[20];
+    uint32_t i;
+    for(i = 0; i < 20; i++) values[i] = i;
+
+    lv_chart_set_next_array(chart, ser, values, 5);
+    lv_chart_set_next_array(chart, ser, &values[5], 6);
+    lv_test_assert_int_eq(11 % RING_POINT_CNT, lv_chart_get_x_start_point(ser), "Start point after wrapping around");
+    for(i = 0; i < RING_POINT_CNT; i++) {
+        lv_coord_t v = lv_chart_get_point_id(chart, ser, (ser->start_point + i) % RING_POINT_CNT);
+        if(v != (lv_coord_t)(3 + i)) break;
+    }
+    lv_test_assert_int_eq(RING_POINT_CNT, i, "The last values from left to right");
+
+    lv_test_print("Add more points than the point count");
+    lv_chart_set_next_array(chart, ser, values, 20);
+    lv_test_assert_int_eq((11 + 20) % RING_POINT_CNT, lv_chart_get_x_start_point(ser), "Start point");
+    for(i = 0; i < RING_POINT_CNT; i++) {
+        lv_coord_t v = lv_chart_get_point_id(chart, ser, (ser->start_point + i) % RING_POINT_CNT);
+        if(v != (lv_coord_t)(20 - RING_POINT_CNT + i)) break;
+    }
+    lv_test_assert_int_eq(RING_POINT_CNT, i, "Only the last values are kept");
+
+    lv_obj_del(chart);
+}
+
+static void shift_invalidation(void)
+{
+    lv_test_print("");
+    lv_test_print("Invalidate on shift:");
+    lv_test_print("--------------------");
+
+    lv_obj_t * chart = lv_chart_create(lv_scr_act(), NULL);
+    lv_obj_set_style_local_pad_left(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 40);
+    lv_obj_set_style_local_pad_bottom(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 30);
+    lv_chart_series_t * ser = lv_chart_add_series(chart, LV_COLOR_RED);
+    lv_refr_now(NULL);
+
+    lv_chart_set_next(chart, ser, 50);
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_area_t series_area;
+    lv_chart_get_series_area(chart, &series_area);
+    lv_test_assert_int_eq(1, disp->inv_p, "One area is invalidated");
+    lv_test_assert_int_gt(chart->coords.x1, disp->inv_areas[0].x1, "The left axis is not redrawn");
+    lv_test_assert_int_lt(chart->coords.y2, disp->inv_areas[0].y2, "The bottom axis is not redrawn");
+    lv_test_assert_int_lt(series_area.x1 + 1, disp->inv_areas[0].x1, "The series are redrawn");
+
+    lv_obj_del(chart);
+    lv_refr_now(NULL);
+}
+
+static void decimation(void)
+{
+    lv_test_print("");
+    lv_test_print("Draw many points:");
+    lv_test_print("-----------------");
+
+    lv_obj_t * chart = lv_chart_create(lv_scr_act(), NULL);
+    lv_obj_set_size(chart, LV_HOR_RES, LV_VER_RES);
+    lv_chart_set_point_count(chart, STREAM_POINT_CNT);
+    lv_chart_series_t * ser = lv_chart_add_series(chart, LV_COLOR_RED);
+
+    uint32_t i;
+    for(i = 0; i < STREAM_POINT_CNT; i++) {
+        lv_coord_t v = (lv_coord_t)(50 + _lv_trigo_sin((int16_t)(i % 360)) / (LV_TRIGO_SIN_MAX / 40) + (i % 7));
+        lv_chart_set_next_array(chart, ser, &v, 1);
+    }
+
+    clock_t start = clock();
+    lv_refr_now(NULL);
+    clock_t end = clock();
+    lv_test_print("%d points on %d pixel columns drawn in %d us", STREAM_POINT_CNT, lv_obj_get_width(chart),
+                  (uint32_t)((end - start) * 1000000 / CLOCKS_PER_SEC));
+
+    lv_test_print("Shift in new points");
+    lv_coord_t values[100];
+    for(i = 0; i < 100; i++) values[i] = (lv_coord_t)(i % 100);
+    start = clock();
+    lv_chart_set_next_array(chart, ser, values, 100);
+    lv_refr_now(NULL);
+    end = clock();
+    lv_test_assert_int_eq(100, lv_chart_get_x_start_point(ser), "Start point");
+    lv_test_print("100 new points drawn in %d us", (uint32_t)((end - start) * 1000000 / CLOCKS_PER_SEC));
+
+    lv_obj_del(chart);
+    lv_refr_now(NULL);
+}
+#endif
+#endif
@@ -0,0 +1,220 @@
+/**
+ * @file lv_test_cont.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_cont.h"
+
+#if LV_BUILD_TEST
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define NESTED_DEPTH    10
+#define NESTED_LEAF_CNT 30
+
+/*The tests with many objects don't fit into the smallest built-in heaps*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SIZE < 32 * 1024
+    #define MANY_OBJ_TEST   0
+#else
+    #define MANY_OBJ_TEST   1
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_CONT
+static void row_layout(void);
+#if MANY_OBJ_TEST
+static void deferred(void);
+static void nested_bench(void);
+#endif
+static lv_obj_t * cont_create(lv_obj_t * par, lv_layout_t layout);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_cont(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_cont tests");
+    lv_test_print("===================");
+
+#if LV_USE_CONT
+    row_layout();
+#if MANY_OBJ_TEST
+    deferred();
+    nested_bench();
+#else
+    lv_test_print("Skip the tests with many containers: LV_MEM_SIZE is too small");
+#endif
+#else
+    lv_test_print("Skip cont test: LV_USE_CONT == 0");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_CONT
+static void row_layout(void)
+{
+    lv_test_print("");
+    lv_test_print("Row layout with tight fit:");
+    lv_test_print("--------------------------");
+
+    lv_obj_t * cont = cont_create(lv_scr_act(), LV_LAYOUT_ROW_TOP);
+    uint32_t i;
+    lv_obj_t * child[3];
+    for(i = 0; i < 3; i++) {
+        child[i] = lv_obj_create(cont, NULL);
+        lv_obj_set_size(child[i], 20, 30);
+    }
+
+    lv_test_assert_int_eq(10 + 3 * 20 + 2 * 5 + 10, lv_obj_get_width(cont), "Width of the container");
+    lv_test_assert_int_eq(10 + 30 + 10, lv_obj_get_height(cont), "Height of the container");
+    lv_test_assert_int_eq(10, lv_obj_get_x(child[0]), "x of the first child");
+    lv_test_assert_int_eq(10 + 20 + 5, lv_obj_get_x(child[1]), "x of the second child");
+    lv_test_assert_int_eq(10 + 2 * (20 + 5), lv_obj_get_x(child[2]), "x of the third child");
+    lv_test_assert_int_eq(10, lv_obj_get_y(child[2]), "y of the third child");
+
+    lv_test_print("Resize a child");
+    lv_obj_set_width(child[0], 40);
+    lv_test_assert_int_eq(10 + 40 + 5, lv_obj_get_x(child[1]), "The next child moved");
+    lv_test_assert_int_eq(10 + 40 + 2 * 20 + 2 * 5 + 10, lv_obj_get_width(cont), "The container grew");
+
+    lv_obj_del(cont);
+}
+
+#if MANY_OBJ_TEST
+static void deferred(void)
+{
+#if LV_CONT_LAYOUT_DEFER
+    lv_test_print("");
+    lv_test_print("Defer the layout refresh:");
+    lv_test_print("-------------------------");
+
+    lv_cont_layout_monitor_t mon_start;
+    lv_cont_layout_monitor_t mon;
+
+    lv_obj_t * cont = cont_create(lv_scr_act(), LV_LAYOUT_ROW_TOP);
+    lv_refr_now(NULL);
+
+    lv_test_print("Add children without reading coordinates");
+    lv_cont_layout_monitor(&mon_start);
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_obj_t * child = lv_obj_create(cont, NULL);
+        lv_obj_set_size(child, 10, 10);
+    }
+    lv_cont_layout_monitor(&mon);
+    lv_test_assert_int_eq(0, mon.layout_cnt - mon_start.layout_cnt, "No layout pass yet");
+    lv_test_assert_int_eq(1, mon.pending_cnt, "The container is pending");
+
+    lv_test_print("Read the size of the container");
+    lv_test_assert_int_eq(10 + 20 * 10 + 19 * 5 + 10, lv_obj_get_width(cont), "Width is up to date");
+    lv_cont_layout_monitor(&mon);
+    lv_test_assert_int_eq(0, mon.pending_cnt, "Nothing is pending");
+    lv_test_assert_int_lt(4, mon.layout_cnt - mon_start.layout_cnt, "At most 3 layout passes");
+
+    lv_test_print("Refresh a frame");
+    lv_obj_set_hidden(lv_obj_get_child(cont, NULL), true);
+    lv_refr_now(NULL);
+    lv_cont_layout_monitor(&mon);
+    lv_test_assert_int_gt(0, mon.frame_layout_cnt, "Layout passes before the frame");
+    lv_test_assert_int_eq(0, mon.pending_cnt, "Nothing is pending after the frame");
+
+    lv_test_print("Delete a pending container");
+    lv_obj_create(cont, NULL);
+    lv_cont_layout_monitor(&mon);
+    lv_test_assert_int_eq(1, mon.pending_cnt, "The container is pending");
+    lv_obj_del(cont);
+    lv_refr_now(NULL);
+    lv_cont_layout_monitor(&mon);
+    lv_test_assert_int_eq(0, mon.pending_cnt, "The deleted container is dropped");
+#endif
+}
+
+static void nested_bench(void)
+{
+    lv_test_print("");
+    lv_test_print("Deeply nested containers:");
+    lv_test_print("-------------------------");
+
+    lv_cont_layout_monitor_t mon_start;
+    lv_cont_layout_monitor_t mon;
+
+    clock_t start = clock();
+    lv_cont_layout_monitor(&mon_start);
+
+    lv_obj_t * root = cont_create(lv_scr_act(), LV_LAYOUT_COLUMN_LEFT);
+    lv_obj_t * cont = root;
+    uint32_t i;
+    for(i = 1; i < NESTED_DEPTH; i++) {
+        cont = cont_create(cont, LV_LAYOUT_COLUMN_LEFT);
+    }
+
+    for(i = 0; i < NESTED_LEAF_CNT; i++) {
+        lv_obj_t * leaf = lv_obj_create(cont, NULL);
+        lv_obj_set_size(leaf, 10, 2);
+    }
+    lv_refr_now(NULL);
+
+    lv_cont_layout_monitor(&mon);
+    clock_t end = clock();
+
+    uint32_t exp_h = NESTED_DEPTH * 20 + NESTED_LEAF_CNT * 2 + (NESTED_LEAF_CNT - 1) * 5;
+    lv_test_assert_int_eq(exp_h, lv_obj_get_height(root), "Height of the outermost container");
+
+    lv_test_print("%d containers, %d leaves: %d layout and %d fit passes in %d us",
+                  NESTED_DEPTH, NESTED_LEAF_CNT,
+                  mon.layout_cnt - mon_start.layout_cnt, mon.fit_cnt - mon_start.fit_cnt,
+                  (uint32_t)((end - start) * 1000000 / CLOCKS_PER_SEC));
+
+    lv_obj_del(root);
+}
+#endif
+
+/**
+ * Create a container with tight fit and known padding
+ * @param par pointer to the parent
+ * @param layout the layout to use
+ * @return pointer to the new container
+ */
+static lv_obj_t * cont_create(lv_obj_t * par, lv_layout_t layout)
+{
+    lv_obj_t * cont = lv_cont_create(par, NULL);
+    lv_obj_set_style_local_pad_left(cont, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 10);
+    lv_obj_set_style_local_pad_right(cont, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 10);
+    lv_obj_set_style_local_pad_top(cont, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 10);
+    lv_obj_set_style_local_pad_bottom(cont, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 10);
+    lv_obj_set_style_local_pad_inner(cont, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, 5);
+    lv_cont_set_layout(cont, layout);
+    lv_cont_set_fit(cont, LV_FIT_TIGHT);
+
+    return cont;
+}
+#endif
+#endif
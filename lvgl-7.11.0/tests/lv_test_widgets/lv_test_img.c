@@ -0,0 +1,526 @@
+/**
+ * @file lv_test_img.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_img.h"
+#include "../../src/lv_misc/lv_gc.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define SRC_W       8
+#define SRC_H       8
+#define LINE_LEN    40
+#define LINE_OFS    (-16)
+#define IMG_X       20
+#define IMG_Y       30
+#define CMP_SIZE    24
+#define IDX_W       13
+#define IDX_H       3
+#define IDX_X       30
+#define IDX_Y       10
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_IMG_TRANSFORM
+static void transform_zoom_int(void);
+static void transform_rotate(void);
+static void transform_out(void);
+static void transform_init(lv_img_transform_dsc_t * dsc, int16_t angle, uint16_t zoom, bool antialias);
+static lv_color_t src_px(lv_coord_t x, lv_coord_t y);
+#endif
+#if LV_USE_IMG_TRANSFORM && LV_IMG_CACHE_TRANSFORM_SIZE
+static void transform_cache(void);
+static void refr_screen(void);
+static void copy_screen(lv_color_t * buf);
+#endif
+#if LV_IMG_CF_INDEXED || LV_IMG_CF_ALPHA
+static void decode_low_bpp(void);
+static uint32_t check_decode(lv_img_cf_t cf);
+static void idx_img_init(lv_img_cf_t cf);
+static uint8_t idx_px(lv_coord_t x, lv_coord_t y, uint8_t bpp);
+static lv_color_t idx_palette_color(uint32_t id);
+#endif
+#if LV_IMG_CF_INDEXED
+static void draw_indexed(void);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_IMG_TRANSFORM
+static lv_color_t src_buf[SRC_W * SRC_H];
+static lv_img_dsc_t src_dsc;
+#endif
+#if LV_IMG_CF_INDEXED || LV_IMG_CF_ALPHA
+static uint8_t idx_buf[256 * sizeof(lv_color32_t) + IDX_W * IDX_H];
+static lv_img_dsc_t idx_dsc;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_img(void)
+{
+    lv_test_print("");
+    lv_test_print("==================");
+    lv_test_print("Start lv_img tests");
+    lv_test_print("==================");
+
+#if LV_USE_IMG_TRANSFORM
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < SRC_H; y++) {
+        for(x = 0; x < SRC_W; x++) {
+            src_buf[y * SRC_W + x] = src_px(x, y);
+        }
+    }
+
+    src_dsc.header.always_zero = 0;
+    src_dsc.header.w = SRC_W;
+    src_dsc.header.h = SRC_H;
+    src_dsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+    src_dsc.data_size = sizeof(src_buf);
+    src_dsc.data = (const uint8_t *)src_buf;
+
+    transform_zoom_int();
+    transform_rotate();
+    transform_out();
+#if LV_IMG_CACHE_TRANSFORM_SIZE
+    transform_cache();
+#endif
+#else
+    lv_test_print("Skip img test: LV_USE_IMG_TRANSFORM == 0");
+#endif
+
+#if LV_IMG_CF_INDEXED || LV_IMG_CF_ALPHA
+    decode_low_bpp();
+#endif
+#if LV_IMG_CF_INDEXED
+    draw_indexed();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_IMG_TRANSFORM
+static void transform_zoom_int(void)
+{
+    lv_test_print("");
+    lv_test_print("Transform a line with integer zoom:");
+    lv_test_print("-----------------------------------");
+
+    lv_img_transform_dsc_t dsc;
+    transform_init(&dsc, 0, 2 * LV_IMG_ZOOM_NONE, true);
+
+    lv_color_t cbuf[LINE_LEN];
+    lv_opa_t abuf[LINE_LEN];
+    uint32_t opa_err = 0;
+    uint32_t color_err = 0;
+    lv_coord_t y;
+    for(y = -SRC_H / 2; y < SRC_H + SRC_H / 2; y++) {
+        _lv_img_buf_transform_line(&dsc, LINE_OFS, y, LINE_LEN, cbuf, abuf);
+
+        lv_coord_t i;
+        for(i = 0; i < LINE_LEN; i++) {
+            lv_coord_t x = LINE_OFS + i;
+            bool on_img = x >= -SRC_W / 2 && x < SRC_W + SRC_W / 2;
+            if(abuf[i] != (on_img ? LV_OPA_COVER : LV_OPA_TRANSP)) opa_err++;
+            /*Every source pixel is repeated twice around the pivot in the center*/
+            else if(on_img && cbuf[i].full != src_px((x + SRC_W / 2) / 2, (y + SRC_H / 2) / 2).full) color_err++;
+        }
+    }
+
+    lv_test_assert_int_eq(0, opa_err, "Opacity of the zoomed pixels");
+    lv_test_assert_int_eq(0, color_err, "Nearest colors of the zoomed pixels");
+}
+
+static void transform_rotate(void)
+{
+    lv_test_print("");
+    lv_test_print("Transform a rotated line like pixel by pixel:");
+    lv_test_print("---------------------------------------------");
+
+    lv_img_transform_dsc_t dsc_line;
+    lv_img_transform_dsc_t dsc_px;
+    transform_init(&dsc_line, 300, LV_IMG_ZOOM_NONE, true);
+    transform_init(&dsc_px, 300, LV_IMG_ZOOM_NONE, true);
+
+    lv_color_t cbuf[LINE_LEN];
+    lv_opa_t abuf[LINE_LEN];
+    uint32_t cnt = 0;
+    uint32_t opa_err = 0;
+    uint32_t color_err = 0;
+    lv_coord_t y;
+    for(y = 2; y < SRC_H - 2; y++) {
+        _lv_img_buf_transform_line(&dsc_line, LINE_OFS, y, LINE_LEN, cbuf, abuf);
+
+        lv_coord_t i;
+        for(i = 0; i < LINE_LEN; i++) {
+            lv_coord_t x = LINE_OFS + i;
+            /*Compare only the inner pixels where both ways sample the image fully*/
+            if(x < 2 || x >= SRC_W - 2) continue;
+            if(_lv_img_buf_transform(&dsc_px, x, y) == false) continue;
+            if(dsc_px.res.opa != LV_OPA_COVER) continue;
+
+            cnt++;
+            if(abuf[i] != LV_OPA_COVER) opa_err++;
+
+            lv_color32_t c_line;
+            lv_color32_t c_px;
+            c_line.full = lv_color_to32(cbuf[i]);
+            c_px.full = lv_color_to32(dsc_px.res.color);
+            if(LV_MATH_ABS(c_line.ch.red - c_px.ch.red) > 0x10 ||
+               LV_MATH_ABS(c_line.ch.green - c_px.ch.green) > 0x10 ||
+               LV_MATH_ABS(c_line.ch.blue - c_px.ch.blue) > 0x10) {
+                color_err++;
+            }
+        }
+    }
+
+    lv_test_assert_int_gt(0, cnt, "Compared pixels");
+    lv_test_assert_int_eq(0, opa_err, "Opacity of the rotated pixels");
+    lv_test_assert_int_eq(0, color_err, "Colors of the rotated pixels");
+}
+
+static void transform_out(void)
+{
+    lv_test_print("");
+    lv_test_print("Transform a line out of the image:");
+    lv_test_print("----------------------------------");
+
+    lv_img_transform_dsc_t dsc;
+    transform_init(&dsc, 450, 3 * LV_IMG_ZOOM_NONE / 2, true);
+
+    lv_color_t cbuf[LINE_LEN];
+    lv_opa_t abuf[LINE_LEN];
+    _lv_memset_ff(abuf, sizeof(abuf));
+    _lv_img_buf_transform_line(&dsc, LINE_OFS, -20, LINE_LEN, cbuf, abuf);
+
+    uint32_t opa_sum = 0;
+    lv_coord_t i;
+    for(i = 0; i < LINE_LEN; i++) opa_sum += abuf[i];
+
+    lv_test_assert_int_eq(0, opa_sum, "Opacity out of the image");
+}
+
+#if LV_IMG_CACHE_TRANSFORM_SIZE
+static void transform_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("Cache the transformed image:");
+    lv_test_print("----------------------------");
+
+    static lv_color_t ref_fb[CMP_SIZE * CMP_SIZE];
+    static lv_color_t act_fb[CMP_SIZE * CMP_SIZE];
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_cache_transform_ll);
+    lv_img_cache_transform_t * entry;
+
+    lv_obj_clean(lv_scr_act());
+    lv_obj_t * img = lv_img_create(lv_scr_act(), NULL);
+    lv_img_set_src(img, &src_dsc);
+    lv_obj_set_pos(img, IMG_X, IMG_Y);
+    lv_img_set_angle(img, 300);
+    lv_img_set_zoom(img, 384);
+
+    refr_screen();
+    copy_screen(ref_fb);
+    entry = _lv_ll_get_head(ll);
+    lv_test_assert_int_eq(1, _lv_ll_get_len(ll), "One image is seen");
+    lv_test_assert_true(entry && entry->buf == NULL, "Not cached in the first refresh");
+
+    /*Draw the image again in a later refresh*/
+    lv_tick_inc(LV_DISP_DEF_REFR_PERIOD);
+    refr_screen();
+    copy_screen(act_fb);
+    entry = _lv_ll_get_head(ll);
+    lv_test_assert_true(entry && entry->buf != NULL, "Cached after a refresh period");
+    lv_test_assert_array_eq((const uint8_t *)ref_fb, (const uint8_t *)act_fb, sizeof(ref_fb),
+                            "Same pixels from the cache");
+
+    /*Draw from the cache*/
+    refr_screen();
+    copy_screen(act_fb);
+    lv_test_assert_int_eq(1, _lv_ll_get_len(ll), "Still one image");
+    lv_test_assert_array_eq((const uint8_t *)ref_fb, (const uint8_t *)act_fb, sizeof(ref_fb),
+                            "Same pixels drawn from the cache");
+
+    lv_img_cache_invalidate_transform_src(&src_dsc);
+    lv_test_assert_int_eq(0, _lv_ll_get_len(ll), "Invalidated");
+
+    /*An animated image is drawn with a different angle in every refresh*/
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_tick_inc(LV_DISP_DEF_REFR_PERIOD);
+        lv_img_set_angle(img, 300 + i * 100);
+        refr_screen();
+    }
+
+    uint32_t cached_cnt = 0;
+    _LV_LL_READ(*ll, entry) {
+        if(entry->buf) cached_cnt++;
+    }
+    lv_test_assert_int_eq(0, cached_cnt, "Animated image is not cached");
+
+    lv_obj_del(img);
+    lv_img_cache_invalidate_transform_src(NULL);
+    lv_test_assert_int_eq(0, _lv_ll_get_len(ll), "Everything is invalidated");
+}
+
+/**
+ * Refresh the whole screen to have it in `test_fb`
+ */
+static void refr_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/**
+ * Copy the pixels around the test image from the last refreshed screen
+ * @param buf store the pixels here
+ */
+static void copy_screen(lv_color_t * buf)
+{
+    extern lv_color_t test_fb[];
+    lv_coord_t y;
+    for(y = 0; y < CMP_SIZE; y++) {
+        _lv_memcpy(&buf[y * CMP_SIZE], &test_fb[(IMG_Y - 8 + y) * LV_HOR_RES + IMG_X - 8], CMP_SIZE * sizeof(lv_color_t));
+    }
+}
+#endif
+
+/**
+ * Initialize a transformation of the test image around its center
+ * @param dsc the descriptor to initialize
+ * @param angle angle of rotation in 0.1 degree
+ * @param zoom zoom, `LV_IMG_ZOOM_NONE` for no zoom
+ * @param antialias true: bilinear filtering
+ */
+static void transform_init(lv_img_transform_dsc_t * dsc, int16_t angle, uint16_t zoom, bool antialias)
+{
+    _lv_memset_00(dsc, sizeof(lv_img_transform_dsc_t));
+    dsc->cfg.src = src_dsc.data;
+    dsc->cfg.src_w = SRC_W;
+    dsc->cfg.src_h = SRC_H;
+    dsc->cfg.pivot_x = SRC_W / 2;
+    dsc->cfg.pivot_y = SRC_H / 2;
+    dsc->cfg.angle = angle;
+    dsc->cfg.zoom = zoom;
+    dsc->cfg.color = LV_COLOR_BLACK;
+    dsc->cfg.cf = LV_IMG_CF_TRUE_COLOR;
+    dsc->cfg.antialias = antialias;
+    _lv_img_buf_transform_init(dsc);
+}
+
+/**
+ * Get the color of a pixel of the test image: a smooth gradient
+ * @param x x coordinate of the pixel
+ * @param y y coordinate of the pixel
+ * @return the color of the pixel
+ */
+static lv_color_t src_px(lv_coord_t x, lv_coord_t y)
+{
+    return lv_color_make(x * 255 / (SRC_W - 1), y * 255 / (SRC_H - 1), 0x80);
+}
+#endif
+
+#if LV_IMG_CF_INDEXED || LV_IMG_CF_ALPHA
+static void decode_low_bpp(void)
+{
+    lv_test_print("");
+    lv_test_print("Decode indexed and alpha images:");
+    lv_test_print("--------------------------------");
+
+#if LV_IMG_CF_INDEXED
+    lv_test_assert_int_eq(0, check_decode(LV_IMG_CF_INDEXED_1BIT), "Indexed 1 bit");
+    lv_test_assert_int_eq(0, check_decode(LV_IMG_CF_INDEXED_2BIT), "Indexed 2 bit");
+    lv_test_assert_int_eq(0, check_decode(LV_IMG_CF_INDEXED_4BIT), "Indexed 4 bit");
+    lv_test_assert_int_eq(0, check_decode(LV_IMG_CF_INDEXED_8BIT), "Indexed 8 bit");
+#endif
+#if LV_IMG_CF_ALPHA
+    lv_test_assert_int_eq(0, check_decode(LV_IMG_CF_ALPHA_1BIT), "Alpha 1 bit");
+    lv_test_assert_int_eq(0, check_decode(LV_IMG_CF_ALPHA_2BIT), "Alpha 2 bit");
+    lv_test_assert_int_eq(0, check_decode(LV_IMG_CF_ALPHA_4BIT), "Alpha 4 bit");
+    lv_test_assert_int_eq(0, check_decode(LV_IMG_CF_ALPHA_8BIT), "Alpha 8 bit");
+#endif
+}
+
+/**
+ * Decode parts of the rows of a test image and compare them to the expected pixels
+ * @param cf color format of the test image
+ * @return number of wrong pixels
+ */
+static uint32_t check_decode(lv_img_cf_t cf)
+{
+    idx_img_init(cf);
+
+    uint8_t bpp = lv_img_cf_get_px_size(cf);
+    bool alpha = cf >= LV_IMG_CF_ALPHA_1BIT && cf <= LV_IMG_CF_ALPHA_8BIT;
+    lv_color_t color = LV_COLOR_MAKE(0x10, 0x80, 0xF0);
+
+    lv_img_decoder_dsc_t dsc;
+    if(lv_img_decoder_open(&dsc, &idx_dsc, color) != LV_RES_OK) return IDX_W * IDX_H;
+
+    /*Start and end in the middle of the bytes too*/
+    static const lv_coord_t parts[][2] = {{0, IDX_W}, {1, 7}, {3, IDX_W - 3}, {5, 1}, {IDX_W - 1, 1}};
+    uint8_t buf[IDX_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    uint32_t err = 0;
+    lv_coord_t y;
+    for(y = 0; y < IDX_H; y++) {
+        uint32_t p;
+        for(p = 0; p < sizeof(parts) / sizeof(parts[0]); p++) {
+            lv_coord_t x1 = parts[p][0];
+            lv_coord_t len = parts[p][1];
+            if(lv_img_decoder_read_line(&dsc, x1, y, len, buf) != LV_RES_OK) {
+                err += len;
+                continue;
+            }
+
+            lv_coord_t i;
+            for(i = 0; i < len; i++) {
+                uint8_t id = idx_px(x1 + i, y, bpp);
+                lv_color_t c_exp = alpha ? color : idx_palette_color(id);
+                lv_opa_t opa_exp = alpha ? (id * LV_OPA_COVER) / ((1 << bpp) - 1) : 255 - id;
+
+                /*The last byte is the alpha, the ones before it are the color*/
+                const uint8_t * px = &buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE];
+                if(memcmp(px, &c_exp, LV_IMG_PX_SIZE_ALPHA_BYTE - 1) != 0) err++;
+                else if(px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] != opa_exp) err++;
+            }
+        }
+    }
+
+    lv_img_decoder_close(&dsc);
+    return err;
+}
+#endif
+
+#if LV_IMG_CF_INDEXED
+static void draw_indexed(void)
+{
+    lv_test_print("");
+    lv_test_print("Draw an indexed image:");
+    lv_test_print("----------------------");
+
+    idx_img_init(LV_IMG_CF_INDEXED_4BIT);
+
+    /*Make the palette opaque to see the colors on the screen*/
+    uint32_t i;
+    for(i = 0; i < 16; i++) idx_buf[i * sizeof(lv_color32_t) + 3] = LV_OPA_COVER;
+
+    lv_obj_clean(lv_scr_act());
+    lv_obj_t * img = lv_img_create(lv_scr_act(), NULL);
+    lv_img_set_src(img, &idx_dsc);
+    lv_obj_set_pos(img, IDX_X, IDX_Y);
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    extern lv_color_t test_fb[];
+    uint32_t err = 0;
+    lv_coord_t y;
+    for(y = 0; y < IDX_H; y++) {
+        lv_coord_t x;
+        for(x = 0; x < IDX_W; x++) {
+            lv_color_t c = test_fb[(IDX_Y + y) * LV_HOR_RES + IDX_X + x];
+            if(c.full != idx_palette_color(idx_px(x, y, 4)).full) err++;
+        }
+    }
+
+    lv_test_assert_int_eq(0, err, "Colors of the drawn pixels");
+
+    lv_obj_del(img);
+    lv_img_cache_invalidate_src(&idx_dsc);
+}
+#endif
+
+#if LV_IMG_CF_INDEXED || LV_IMG_CF_ALPHA
+/**
+ * Initialize the indexed or alpha test image. The palette's opacity is `255 - index`.
+ * @param cf color format of the image
+ */
+static void idx_img_init(lv_img_cf_t cf)
+{
+    uint8_t bpp = lv_img_cf_get_px_size(cf);
+    bool alpha = cf >= LV_IMG_CF_ALPHA_1BIT && cf <= LV_IMG_CF_ALPHA_8BIT;
+    uint32_t stride = (IDX_W * bpp + 7) >> 3;
+    uint8_t * px = idx_buf;
+
+    _lv_memset_00(idx_buf, sizeof(idx_buf));
+    if(!alpha) {
+        uint32_t i;
+        for(i = 0; i < (1U << bpp); i++) {
+            lv_color32_t c;
+            c.full = lv_color_to32(idx_palette_color(i));
+            c.ch.alpha = 255 - i;
+            _lv_memcpy_small(px, &c, sizeof(c));
+            px += sizeof(c);
+        }
+    }
+
+    lv_coord_t y;
+    for(y = 0; y < IDX_H; y++) {
+        lv_coord_t x;
+        for(x = 0; x < IDX_W; x++) {
+            uint32_t bit = x * bpp;
+            px[y * stride + (bit >> 3)] |= idx_px(x, y, bpp) << (8 - bpp - (bit & 0x7));
+        }
+    }
+
+    /*The image might be cached with the previous format*/
+    lv_img_cache_invalidate_src(&idx_dsc);
+
+    idx_dsc.header.always_zero = 0;
+    idx_dsc.header.w = IDX_W;
+    idx_dsc.header.h = IDX_H;
+    idx_dsc.header.cf = cf;
+    idx_dsc.data_size = (px - idx_buf) + stride * IDX_H;
+    idx_dsc.data = idx_buf;
+}
+
+/**
+ * Get the index of a pixel of the test image
+ * @param x x coordinate of the pixel
+ * @param y y coordinate of the pixel
+ * @param bpp bit per pixel
+ * @return the index
+ */
+static uint8_t idx_px(lv_coord_t x, lv_coord_t y, uint8_t bpp)
+{
+    return (x * 7 + y * 3) & ((1 << bpp) - 1);
+}
+
+/**
+ * Get a color of the palette of the test image. Indexed images are chroma keyed so it's never `LV_COLOR_TRANSP`.
+ * @param id index of the color
+ * @return the color
+ */
+static lv_color_t idx_palette_color(uint32_t id)
+{
+    return lv_color_make((id * 8) & 0x7F, 0x40, 0x7F - ((id * 4) & 0x7F));
+}
+#endif
+
+#endif
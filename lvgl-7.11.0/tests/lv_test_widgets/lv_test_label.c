@@ -11,6 +11,7 @@
 #include "lv_test_label.h"
 
 #if LV_BUILD_TEST
+#include <string.h>
 
 /*********************
  *      DEFINES
@@ -24,6 +25,7 @@
  *  STATIC PROTOTYPES
  **********************/
 static void create_copy(void);
+static void same_text(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -46,6 +48,7 @@ void lv_test_label(void)
 
 #if LV_USE_LABEL
     create_copy();
+    same_text();
 #else
     lv_test_print("Skip label test: LV_USE_LABEL == 0");
 #endif
@@ -66,4 +69,45 @@ static void create_copy(void)
     lv_test_assert_img_eq("lv_test_img32_label_1.png", "Create a label and leave the default settings");
 #endif
 }
+
+static void same_text(void)
+{
+    lv_test_print("");
+    lv_test_print("Set the same text again");
+    lv_test_print("---------------------------");
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_label_set_text(label, "12:34");
+    lv_refr_now(NULL);
+
+    char buf[8];
+    strcpy(buf, "12:34");
+    lv_label_set_text(label, buf);
+    lv_test_assert_int_eq(0, disp->inv_p, "Nothing is invalidated");
+
+    lv_label_set_text(label, "12:35");
+    lv_test_assert_int_eq(1, disp->inv_p, "A new text is invalidated");
+    lv_refr_now(NULL);
+
+#if LV_LABEL_CELL_MODE
+    lv_test_print("Change a digit in cell mode");
+    lv_label_set_cell_width(label, 10);
+    lv_test_assert_int_eq(5 * 10, lv_obj_get_width(label), "Width of the cells");
+    lv_refr_now(NULL);
+
+    lv_label_set_text(label, "12:36");
+    lv_test_assert_int_eq(1, disp->inv_p, "One area is invalidated");
+    lv_test_assert_int_lt(lv_obj_get_width(label), lv_area_get_width(&disp->inv_areas[0]),
+                          "Only the changed cell is invalidated");
+    lv_test_assert_str_eq("12:36", lv_label_get_text(label), "The text is updated");
+    lv_refr_now(NULL);
+
+    lv_label_set_text(label, "1:36");
+    lv_test_assert_int_eq(4 * 10, lv_obj_get_width(label), "A shorter text is resized");
+#endif
+
+    lv_obj_del(label);
+    lv_refr_now(NULL);
+}
 #endif
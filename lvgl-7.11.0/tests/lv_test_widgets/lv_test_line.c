@@ -0,0 +1,237 @@
+/**
+ * @file lv_test_line.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_line.h"
+
+#if LV_BUILD_TEST
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define STAIR_POINT_CNT     9
+#define REGION_SIZE         64
+#define MANY_POINT_CNT      2000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_LINE
+static void same_as_lines(void);
+static void joins(void);
+static void many_points(void);
+static void far_points(void);
+static lv_obj_t * line_create(const lv_point_t points[], uint16_t point_cnt, lv_style_int_t width, lv_opa_t opa);
+static lv_color_t get_px(lv_coord_t x, lv_coord_t y);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_LINE
+static lv_color_t region_ref[REGION_SIZE * REGION_SIZE];
+static lv_color_t region_act[REGION_SIZE * REGION_SIZE];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_line(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_line tests");
+    lv_test_print("===================");
+
+#if LV_USE_LINE
+    same_as_lines();
+    joins();
+    many_points();
+    far_points();
+#else
+    lv_test_print("Skip line test: LV_USE_LINE == 0");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_LINE
+static void same_as_lines(void)
+{
+    lv_test_print("");
+    lv_test_print("Polyline of thin lines:");
+    lv_test_print("-----------------------");
+
+    static const lv_point_t points[STAIR_POINT_CNT] = {
+        {2, 2}, {20, 2}, {20, 10}, {30, 10}, {30, 30}, {50, 30}, {50, 40}, {60, 40}, {60, 60}
+    };
+
+    lv_test_print("Draw the lines one by one");
+    uint32_t i;
+    lv_obj_t * lines[STAIR_POINT_CNT - 1];
+    for(i = 0; i < STAIR_POINT_CNT - 1; i++) {
+        lines[i] = line_create(&points[i], 2, 1, LV_OPA_COVER);
+    }
+
+    lv_refr_now(NULL);
+    lv_coord_t y;
+    for(y = 0; y < REGION_SIZE; y++) {
+        lv_coord_t x;
+        for(x = 0; x < REGION_SIZE; x++) region_ref[y * REGION_SIZE + x] = get_px(x, y);
+    }
+
+    for(i = 0; i < STAIR_POINT_CNT - 1; i++) lv_obj_del(lines[i]);
+
+    lv_test_print("Draw the same lines as one polyline");
+    lv_obj_t * line = line_create(points, STAIR_POINT_CNT, 1, LV_OPA_COVER);
+    lv_refr_now(NULL);
+    for(y = 0; y < REGION_SIZE; y++) {
+        lv_coord_t x;
+        for(x = 0; x < REGION_SIZE; x++) region_act[y * REGION_SIZE + x] = get_px(x, y);
+    }
+
+    lv_test_assert_array_eq((uint8_t *)region_ref, (uint8_t *)region_act, sizeof(region_ref), "Same pixels");
+
+    lv_obj_del(line);
+}
+
+static void joins(void)
+{
+    lv_test_print("");
+    lv_test_print("Joins of semi-transparent lines:");
+    lv_test_print("--------------------------------");
+
+    static const lv_point_t points[3] = {{10, 10}, {30, 50}, {50, 10}};
+    lv_obj_t * line = line_create(points, 3, 3, LV_OPA_50);
+    lv_refr_now(NULL);
+
+    lv_color_t mid = get_px(20, 30);
+    lv_color_t join = get_px(30, 50);
+    lv_test_assert_color_eq(mid, join, "The join is blended only once");
+
+    lv_obj_del(line);
+}
+
+static void many_points(void)
+{
+    lv_test_print("");
+    lv_test_print("Line with many points:");
+    lv_test_print("----------------------");
+
+    static lv_point_t points[MANY_POINT_CNT];
+    uint32_t i;
+    for(i = 0; i < MANY_POINT_CNT; i++) {
+        points[i].x = (lv_coord_t)((i * LV_HOR_RES) / MANY_POINT_CNT);
+        points[i].y = (lv_coord_t)(i & 1 ? 100 : 20 + (i % 50));
+    }
+
+    lv_obj_t * line = line_create(points, MANY_POINT_CNT, 2, LV_OPA_COVER);
+
+    clock_t start = clock();
+    lv_refr_now(NULL);
+    clock_t end = clock();
+    lv_test_print("%d points drawn in %d us", MANY_POINT_CNT, (uint32_t)((end - start) * 1000000 / CLOCKS_PER_SEC));
+
+    lv_test_assert_color_eq(LV_COLOR_RED, get_px(points[501].x, points[501].y), "A point is drawn");
+    lv_color_t bg_color = lv_obj_get_style_bg_color(lv_scr_act(), LV_OBJ_PART_MAIN);
+    lv_test_assert_color_eq(bg_color, get_px(LV_HOR_RES / 2, LV_VER_RES - 1), "Below the line is not drawn");
+
+    lv_obj_del(line);
+}
+
+static void far_points(void)
+{
+    lv_test_print("");
+    lv_test_print("Polyline from far off-screen points:");
+    lv_test_print("------------------------------------");
+
+    lv_color_t bg_color = lv_obj_get_style_bg_color(lv_scr_act(), LV_OBJ_PART_MAIN);
+
+    lv_test_print("Steep line with 45 deg slope");
+    static const lv_point_t steep[3] = {{-29900, -30000}, {40, 60}, {60, 60}};
+    lv_obj_t * line = line_create(steep, 3, 3, LV_OPA_COVER);
+    lv_refr_now(NULL);
+    lv_test_assert_color_eq(LV_COLOR_RED, get_px(20, 40), "On the line");
+    lv_test_assert_color_eq(bg_color, get_px(30, 40), "Right to the line");
+    lv_obj_del(line);
+
+    lv_test_print("Flat line with 45 deg slope");
+    static const lv_point_t flat[3] = {{-30000, -29900}, {60, 40}, {60, 60}};
+    line = line_create(flat, 3, 3, LV_OPA_COVER);
+    lv_refr_now(NULL);
+    lv_test_assert_color_eq(LV_COLOR_RED, get_px(40, 20), "On the line");
+    lv_test_assert_color_eq(bg_color, get_px(40, 30), "Below the line");
+    lv_obj_del(line);
+
+    lv_test_print("Line longer than 32767 px");
+    /*In the middle, the ending masks of the first and last lines are not involved*/
+    static const lv_point_t longest[4] = {{-31000, -31000}, {-31000, -30990}, {2000, 2000}, {2020, 2000}};
+    line = line_create(longest, 4, 3, LV_OPA_COVER);
+    lv_refr_now(NULL);
+    lv_test_assert_color_eq(LV_COLOR_RED, get_px(40, 40), "On the line");
+    lv_test_assert_color_eq(bg_color, get_px(40, 50), "Below the line");
+    lv_obj_del(line);
+
+    lv_test_print("Line longer than 32767 px with an ending");
+    line = line_create(&longest[1], 3, 3, LV_OPA_COVER);
+    lv_refr_now(NULL);
+    lv_test_assert_color_eq(LV_COLOR_RED, get_px(40, 40), "On the line");
+    lv_test_assert_color_eq(bg_color, get_px(40, 50), "Below the line");
+    lv_obj_del(line);
+}
+
+/**
+ * Create a red line on the top left corner of the screen
+ * @param points the points of the line
+ * @param point_cnt number of points
+ * @param width width of the line
+ * @param opa opacity of the line
+ * @return pointer to the new line
+ */
+static lv_obj_t * line_create(const lv_point_t points[], uint16_t point_cnt, lv_style_int_t width, lv_opa_t opa)
+{
+    lv_obj_t * line = lv_line_create(lv_scr_act(), NULL);
+    lv_obj_set_style_local_line_color(line, LV_LINE_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_RED);
+    lv_obj_set_style_local_line_width(line, LV_LINE_PART_MAIN, LV_STATE_DEFAULT, width);
+    lv_obj_set_style_local_line_opa(line, LV_LINE_PART_MAIN, LV_STATE_DEFAULT, opa);
+    lv_obj_set_style_local_line_rounded(line, LV_LINE_PART_MAIN, LV_STATE_DEFAULT, false);
+    lv_line_set_points(line, points, point_cnt);
+    lv_obj_set_pos(line, 0, 0);
+
+    /*Refresh the whole screen to have it in `test_fb`*/
+    lv_obj_invalidate(lv_scr_act());
+
+    return line;
+}
+
+/**
+ * Get a pixel of the last refreshed screen
+ * @param x the x coordinate
+ * @param y the y coordinate
+ * @return the color of the pixel
+ */
+static lv_color_t get_px(lv_coord_t x, lv_coord_t y)
+{
+    extern lv_color_t test_fb[];
+    return test_fb[y * LV_HOR_RES + x];
+}
+#endif
+#endif
@@ -0,0 +1,190 @@
+/**
+ * @file lv_test_list.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_list.h"
+
+#if LV_BUILD_TEST
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define VIRT_ITEM_CNT   10000
+#define VIRT_ITEM_H     30
+#define VIRT_LIST_H     300
+
+/*The tests with many objects don't fit into the smallest built-in heaps*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SIZE < 32 * 1024
+    #define MANY_OBJ_TEST   0
+#else
+    #define MANY_OBJ_TEST   1
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_LIST && LV_LIST_VIRTUAL && MANY_OBJ_TEST
+static void virtual_list(void);
+static void item_cb(lv_obj_t * list, lv_obj_t * btn, uint32_t index);
+static lv_obj_t * btn_of(lv_obj_t * list, uint32_t index);
+static void scroll(lv_obj_t * list, lv_coord_t step, uint32_t cnt);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_LIST && LV_LIST_VIRTUAL && MANY_OBJ_TEST
+static uint32_t item_cb_cnt;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_list(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_list tests");
+    lv_test_print("===================");
+
+#if LV_USE_LIST && LV_LIST_VIRTUAL
+#if MANY_OBJ_TEST
+    virtual_list();
+#else
+    lv_test_print("Skip the virtual list test: LV_MEM_SIZE is too small");
+#endif
+#else
+    lv_test_print("Skip list test: LV_USE_LIST == 0 or LV_LIST_VIRTUAL == 0");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_LIST && LV_LIST_VIRTUAL && MANY_OBJ_TEST
+static void virtual_list(void)
+{
+    lv_test_print("");
+    lv_test_print("Virtual list:");
+    lv_test_print("-------------");
+
+    lv_obj_t * list = lv_list_create(lv_scr_act(), NULL);
+    lv_obj_set_size(list, 200, VIRT_LIST_H);
+    lv_list_set_anim_time(list, 0);
+    lv_list_set_virtual(list, VIRT_ITEM_CNT, VIRT_ITEM_H, item_cb);
+
+    lv_obj_t * scrl = lv_page_get_scrollable(list);
+    uint32_t btn_max = VIRT_LIST_H / VIRT_ITEM_H + 2;
+    lv_test_assert_int_eq(VIRT_ITEM_CNT, lv_list_get_virtual_cnt(list), "Number of items");
+    lv_test_assert_int_lt(btn_max + 1, lv_obj_count_children(scrl), "Buttons only for the visible items");
+    lv_test_assert_int_eq(1, btn_of(list, 0) != NULL, "The first item is shown");
+
+    /*The item in the middle of the list is found from the total scrolled distance*/
+    lv_coord_t y0 = btn_of(list, 0)->coords.y1;
+    lv_coord_t mid = list->coords.y1 + VIRT_LIST_H / 2;
+    int32_t scrolled = 0;
+
+    lv_test_print("Scroll down");
+    item_cb_cnt = 0;
+    clock_t start = clock();
+    scroll(list, -100, 1000);
+    clock_t end = clock();
+    scrolled += 100 * 1000;
+    uint32_t index = (mid - y0 + scrolled) / VIRT_ITEM_H;
+    lv_obj_t * btn = btn_of(list, index);
+    lv_test_assert_int_eq(1, btn != NULL, "The item in the middle is shown");
+    lv_test_assert_int_eq(1, btn->coords.y1 <= mid && btn->coords.y2 >= mid, "The item is in the middle");
+    char txt[16];
+    lv_snprintf(txt, sizeof(txt), "%d", index);
+    lv_test_assert_str_eq(txt, lv_label_get_text(lv_list_get_btn_label(btn)), "Text of the item");
+    lv_test_assert_int_lt(btn_max + 1, lv_obj_count_children(scrl), "Still only the visible buttons");
+    lv_test_print("1000 scroll steps: %d items shown in %d us", item_cb_cnt,
+                  (uint32_t)((end - start) * 1000000 / CLOCKS_PER_SEC));
+
+    lv_test_print("Scroll up");
+    scroll(list, 100, 500);
+    scrolled -= 100 * 500;
+    btn = btn_of(list, (mid - y0 + scrolled) / VIRT_ITEM_H);
+    lv_test_assert_int_eq(1, btn != NULL, "The item in the middle is shown");
+    lv_test_assert_int_eq(1, btn->coords.y1 <= mid && btn->coords.y2 >= mid, "The item is in the middle");
+
+    lv_test_print("Scroll to the end");
+    scroll(list, -100, 3000);
+    btn = btn_of(list, VIRT_ITEM_CNT - 1);
+    lv_test_assert_int_eq(1, btn != NULL, "The last item is shown");
+    lv_test_assert_int_lt(list->coords.y2 + 1, btn->coords.y2, "The last item is on the list");
+    lv_test_assert_int_eq(VIRT_ITEM_CNT - 1, lv_list_get_virtual_index(list, btn), "Index of the last item");
+
+    lv_test_print("Decrease the number of items");
+    lv_list_set_virtual_cnt(list, 5);
+    lv_test_assert_int_eq(1, btn_of(list, 4) != NULL, "The last item is shown");
+    lv_test_assert_int_eq(1, btn_of(list, 5) == NULL, "No items after the last");
+    lv_test_assert_int_eq(1, btn_of(list, 0) != NULL, "The first item is shown");
+
+    lv_obj_del(list);
+}
+
+/**
+ * Show the index of an item on the button's label
+ * @param list pointer to a list
+ * @param btn pointer to a button of the list
+ * @param index the item to show
+ */
+static void item_cb(lv_obj_t * list, lv_obj_t * btn, uint32_t index)
+{
+    LV_UNUSED(list);
+
+    lv_label_set_text_fmt(lv_list_get_btn_label(btn), "%d", index);
+    item_cb_cnt++;
+}
+
+/**
+ * Find the visible button of an item
+ * @param list pointer to a virtual list
+ * @param index the item to find
+ * @return pointer to the button or NULL if the item is not shown
+ */
+static lv_obj_t * btn_of(lv_obj_t * list, uint32_t index)
+{
+    lv_obj_t * btn = lv_list_get_next_btn(list, NULL);
+    while(btn) {
+        if(lv_obj_get_hidden(btn) == false && lv_list_get_virtual_index(list, btn) == (int32_t)index) return btn;
+        btn = lv_list_get_next_btn(list, btn);
+    }
+
+    return NULL;
+}
+
+/**
+ * Scroll a list in steps like dragging does
+ * @param list pointer to a list
+ * @param step the distance of a step
+ * @param cnt number of steps
+ */
+static void scroll(lv_obj_t * list, lv_coord_t step, uint32_t cnt)
+{
+    lv_obj_t * scrl = lv_page_get_scrollable(list);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_set_y(scrl, lv_obj_get_y(scrl) + step);
+    }
+}
+#endif
+#endif
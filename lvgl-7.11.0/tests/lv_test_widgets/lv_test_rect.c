@@ -0,0 +1,140 @@
+/**
+ * @file lv_test_rect.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_rect.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define GRAD_X          10
+#define GRAD_Y          10
+#define GRAD_W          100
+#define GRAD_H          40     /*Fits into the smallest test display*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void gradient(void);
+static void grad_check(lv_obj_t * obj, lv_grad_dir_t dir);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_rect(void)
+{
+    lv_test_print("");
+    lv_test_print("========================");
+    lv_test_print("Start lv_draw_rect tests");
+    lv_test_print("========================");
+
+    gradient();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void gradient(void)
+{
+    lv_test_print("");
+    lv_test_print("Gradient backgrounds:");
+    lv_test_print("---------------------");
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_pos(obj, GRAD_X, GRAD_Y);
+    lv_obj_set_size(obj, GRAD_W, GRAD_H);
+    lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_border_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_shadow_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_outline_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_bg_opa(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_COVER);
+    lv_obj_set_style_local_bg_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_RED);
+    lv_obj_set_style_local_bg_grad_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLUE);
+
+    lv_test_print("Horizontal gradient");
+    grad_check(obj, LV_GRAD_DIR_HOR);
+    lv_test_print("Vertical gradient");
+    grad_check(obj, LV_GRAD_DIR_VER);
+
+    lv_obj_del(obj);
+}
+
+/**
+ * Draw a gradient twice and check its colors
+ * @param obj pointer to an object with a red to blue gradient
+ * @param dir direction of the gradient
+ */
+static void grad_check(lv_obj_t * obj, lv_grad_dir_t dir)
+{
+    extern lv_color_t test_fb[];
+    static lv_color_t first_fb[GRAD_W * GRAD_H];
+    lv_coord_t x;
+    lv_coord_t y;
+
+    lv_obj_set_style_local_bg_grad_dir(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, dir);
+
+    /*Draw twice to use the cached colors the second time (if the gradient cache is enabled)*/
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    for(y = 0; y < GRAD_H; y++) {
+        _lv_memcpy(&first_fb[y * GRAD_W], &test_fb[(GRAD_Y + y) * LV_HOR_RES + GRAD_X], GRAD_W * sizeof(lv_color_t));
+    }
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    uint32_t diff_cnt = 0;
+    uint32_t order_err = 0;
+    for(y = 0; y < GRAD_H; y++) {
+        lv_color_t * row = &test_fb[(GRAD_Y + y) * LV_HOR_RES + GRAD_X];
+        for(x = 0; x < GRAD_W; x++) {
+            if(row[x].full != first_fb[y * GRAD_W + x].full) diff_cnt++;
+
+            /*The same color along the gradient, red fades towards blue across it*/
+#if LV_DITHER_GRADIENT == 0 || LV_COLOR_DEPTH != 16
+            lv_color_t c = row[x];
+            lv_color_t c_prev;
+            lv_color_t c_side;
+            if(dir == LV_GRAD_DIR_HOR) {
+                c_prev = x > 0 ? row[x - 1] : c;
+                c_side = y > 0 ? test_fb[(GRAD_Y + y - 1) * LV_HOR_RES + GRAD_X + x] : c;
+            }
+            else {
+                c_prev = y > 0 ? test_fb[(GRAD_Y + y - 1) * LV_HOR_RES + GRAD_X + x] : c;
+                c_side = x > 0 ? row[x - 1] : c;
+            }
+            if(c_side.full != c.full) order_err++;
+            else if(LV_COLOR_GET_R(c) > LV_COLOR_GET_R(c_prev) || LV_COLOR_GET_B(c) < LV_COLOR_GET_B(c_prev)) order_err++;
+#endif
+        }
+    }
+
+    lv_color_t * last = &test_fb[(GRAD_Y + GRAD_H - 1) * LV_HOR_RES + GRAD_X + GRAD_W - 1];
+    lv_test_assert_color_eq(LV_COLOR_RED, test_fb[GRAD_Y * LV_HOR_RES + GRAD_X], "Main color at the start");
+    lv_test_assert_color_eq(LV_COLOR_BLUE, *last, "Gradient color at the end");
+    lv_test_assert_int_eq(0, order_err, "Colors of the gradient");
+    lv_test_assert_int_eq(0, diff_cnt, "The same colors in the next refresh");
+}
+#endif
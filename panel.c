@@ -1,8 +1,11 @@
+#include "lv_lib_png/lodepng.h"
 #include "lv_lib_png/lv_png.h"
 #include "lvgl/lvgl.h"
 #ifdef __linux__
 #include "lvgl/lv_drivers/display/fbdev.h"
 #include "lvgl/lv_drivers/indev/evdev.h"
+#include "lvgl/lv_drivers/fs/posix_fs.h"
+#include <sys/inotify.h>
 #else /* __linux__ */
 #include "lvgl/lv_drivers/display/monitor.h"
 #include "lvgl/lv_drivers/indev/keyboard.h"
@@ -14,12 +17,16 @@
 #include <confuse.h>
 #include <curl/curl.h>
 #include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <libgen.h>
+#include <poll.h>
 #include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <time.h>
 #include <unistd.h>
@@ -31,6 +38,51 @@
 
 LV_FONT_DECLARE(digital_clock)
 
+// Gallery images are memory mapped, the PNG decoder reads them in place
+#if USE_MMAP_FS
+#define GALLERY_SRC "M:gallery/"
+#else
+#define GALLERY_SRC "gallery/"
+#endif
+
+// Gallery image index, kept up to date by the indexer thread
+#define GALLERY_DIR "gallery"
+#define GALLERY_INDEX_FILE "gallery.idx"
+#define GALLERY_INDEX_MAGIC 0x58444947 // "GIDX"
+#define GALLERY_INDEX_VERSION 3
+#define GALLERY_WORKERS_MAX 4 // threads decoding new images
+#define GALLERY_BATCH 64 // images decoded between two progress checks
+#define GALLERY_PUBLISH_MS 1000 // show the progress of a long indexing this often
+#define GALLERY_SETTLE_MS 500 // wait this long for more file events before indexing
+#define GALLERY_RESCAN_S 60 // rescan period when the directory can't be watched
+
+#define GALLERY_IMG_CNT 4 // images on the gallery panel
+#define GALLERY_PREFETCH_CNT 8 // upcoming images of the rotation decoded ahead
+#define GALLERY_PREFETCH_BUDGET (16 * 1024 * 1024) // bytes of decoded images, the shown ones included
+#define GALLERY_STAT_PERIOD 20 // report the prefetch hit rate after this many rotations
+#define GALLERY_IMG_MAX 2047 // largest width and height of an lv_img_dsc_t
+
+#define GALLERY_ENTRY_VALID 0x01 // the image could be decoded
+
+// One image of the index file (native byte order, the index is a local cache)
+typedef struct {
+	int64_t mtime;
+	uint32_t size; // file size
+	uint32_t name; // offset in the name table
+	uint16_t w, h; // image size
+	uint16_t scaled_w, scaled_h; // size fitted into the gallery height
+	uint32_t color; // average color, 0xRRGGBB
+	uint32_t flags;
+} gallery_entry_t;
+
+// The index file: the header, the entries sorted by name, then the name table
+typedef struct {
+	uint32_t magic, version;
+	uint32_t slot_h; // gallery height the scaled sizes were fitted into
+	uint32_t count, names_size;
+	gallery_entry_t entry[];
+} gallery_index_t;
+
 // Config options
 static char *openweather_apikey = NULL;
 static char *openweather_label = NULL;
@@ -58,9 +110,37 @@ static lv_obj_t *clock_label[8];
 static lv_obj_t *date_label, *weather_label;
 
 static lv_obj_t *led1;
-static lv_obj_t *controls_panel, *gallery_panel;
+static lv_obj_t *controls_panel, *gallery_panel, *gallery_list;
+
+// Gallery index of the UI thread, replaced when the indexer thread posts a new one
+static gallery_index_t *gallery_index;
+static uint32_t gallery_valid; // number of decodable images
+static lv_coord_t gallery_slot_h; // height of the gallery images
+
+// An image of the rotation, decoded by the prefetch thread before it's shown
+struct _gallery_prefetch {
+	struct _gallery_prefetch *next; // in the queue of the prefetch thread
+	char *name;
+	int64_t mtime;
+	uint32_t size; // bytes taken from the budget
+	lv_img_dsc_t *dsc; // NULL until decoded or if decoding failed
+	bool requested, done, dropped;
+};
 
-static char weatherString[64] = { 0 };
+// Upcoming images in the order they will be shown, and the shown ones
+static struct _gallery_prefetch *gallery_plan[GALLERY_PREFETCH_CNT];
+static uint32_t gallery_plan_cnt;
+static struct _gallery_prefetch *gallery_shown[GALLERY_IMG_CNT];
+static lv_obj_t *gallery_img[GALLERY_IMG_CNT];
+static uint32_t gallery_budget_used;
+static uint32_t gallery_hit, gallery_miss;
+
+// Queue of the prefetch thread
+static pthread_mutex_t prefetch_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t prefetch_cond = PTHREAD_COND_INITIALIZER;
+static struct _gallery_prefetch *prefetch_head, **prefetch_tail = &prefetch_head;
+
+static int wakeup_pipe[2] = { -1, -1 };
 
 // Utilities functions
 
@@ -70,6 +150,13 @@ static char weatherString[64] = { 0 };
     snprintf(_ss_ret, _ss_size+1, ##__VA_ARGS__);       \
     _ss_ret; })
 
+// Milliseconds of a clock which isn't set back, usable on any thread unlike lv_tick_get()
+static uint32_t monotonic_ms(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
 static void time_timer_cb(lv_task_t *timer) {
 	char timeString[16] = { 0 };
 	char dateString[128] = { 0 };
@@ -78,12 +165,16 @@ static void time_timer_cb(lv_task_t *timer) {
 	struct tm *local = localtime(&t);
 
 	snprintf(timeString, 16, "%02d:%02d:%02d", local->tm_hour, local->tm_min, local->tm_sec);
+
+	// Invalidate the changed labels of the panel together at the end
+	lv_obj_begin_update(controls_panel);
 	for (int c = 0; c < 8; c++) {
 		const char str[2] = { timeString[c], 0 };
 		lv_label_set_text(clock_label[c], str);
 	}
 
-	if (strlen(weatherString) > 0)
+	// The weather text is posted by the download thread through the LVGL command queue
+	if (strlen(lv_label_get_text(weather_label)) > 0)
 		snprintf(dateString, 128, "%s | %s %02d %04d | ", DAY[local->tm_wday], MONTH[local->tm_mon], local->tm_mday, local->tm_year + 1900);
 	else
 		snprintf(dateString, 128, "%s | %s %02d %04d", DAY[local->tm_wday], MONTH[local->tm_mon], local->tm_mday, local->tm_year + 1900);
@@ -91,7 +182,7 @@ static void time_timer_cb(lv_task_t *timer) {
 
 	lv_obj_set_x(weather_label, lv_obj_get_width(date_label));
 	lv_obj_set_width(weather_label, lv_obj_get_width(controls_panel) - lv_obj_get_width(date_label));
-	lv_label_set_text(weather_label, weatherString);
+	lv_obj_end_update(controls_panel);
 }
 
 static int get_current_network_speed_cb() {
@@ -132,73 +223,799 @@ static void net_timer_cb(lv_task_t *timer) {
 		lv_led_off(led1);
 }
 
-static void gallery_fill(lv_obj_t *panel) {
-	static time_t _last_mtime = 0;
-	static char **_cache = NULL;
-	static int _index = 0;
+// Gallery index
+
+struct _gallery_item {
+	char *name;
+	gallery_entry_t entry;
+	bool pending; // waiting to be decoded
+};
+
+// Images of the indexer thread, sorted by name
+struct _gallery_items {
+	struct _gallery_item *item;
+	uint32_t count, alloc;
+};
+
+// Images shared by the decoding threads
+struct _gallery_job {
+	struct _gallery_item **item;
+	uint32_t count;
+	uint32_t next;
+};
+
+static inline const char *gallery_name(const gallery_index_t *index, uint32_t i) {
+	return (const char *)&index->entry[index->count] + index->entry[i].name;
+}
+
+static size_t gallery_index_size(const gallery_index_t *index) {
+	return sizeof(gallery_index_t) + index->count * sizeof(gallery_entry_t) + index->names_size;
+}
 
-	if (_cache) {
-		// check for reloading
-		struct stat attr;
-		if (stat("gallery", &attr) == 0) {
-			if (_last_mtime && _last_mtime < attr.st_mtime) {
-				printf("%s[INFO]%s Gallery changed\n", GREEN, NORMAL_COLOR);
-				exit(1);
+static gallery_index_t *gallery_index_load(void) {
+	gallery_index_t *index = NULL;
+	bool resized = false;
+	struct stat st;
+	int fd = open(GALLERY_INDEX_FILE, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return NULL;
+	if (fstat(fd, &st) == 0 && st.st_size >= sizeof(gallery_index_t)) {
+		index = malloc(st.st_size);
+		if (index && read(fd, index, st.st_size) == st.st_size &&
+				index->magic == GALLERY_INDEX_MAGIC && index->version == GALLERY_INDEX_VERSION &&
+				index->count <= (st.st_size - sizeof(gallery_index_t)) / sizeof(gallery_entry_t) &&
+				gallery_index_size(index) == st.st_size && index->names_size > 0 &&
+				((char *)index)[st.st_size - 1] == 0) {
+			// every name has to be inside the name table
+			uint32_t i;
+			for (i = 0; i < index->count && index->entry[i].name < index->names_size; i++)
+				;
+			if (i == index->count) {
+				if (index->slot_h == gallery_slot_h) {
+					close(fd);
+					return index;
+				}
+				// the scaled sizes don't fit the gallery any more
+				resized = true;
 			}
-			_last_mtime = attr.st_mtime;
 		}
 	}
+	if (resized)
+		printf("%s[INFO]%s The gallery height changed, the index is created again\n", GREEN, NORMAL_COLOR);
+	else
+		printf("%s[ERROR]%s Invalid gallery index, it's created again\n", RED, NORMAL_COLOR);
+	free(index);
+	close(fd);
+	return NULL;
+}
 
-	if (!_cache) {
-		printf("%s[INFO]%s Reload gallery cache\n", GREEN, NORMAL_COLOR);
-		DIR *d = opendir("gallery");
-		if (d) {
-			int count = 0, index = 0, alloc = 2048, cache_alloc = 512;
-			_cache = malloc(cache_alloc * sizeof(char *));
-			char *ptr = malloc(alloc);
-			struct dirent *dir;
-			while ((dir = readdir(d)) != NULL) {
-				if (dir->d_type == DT_REG) {
-					if (strstr(dir->d_name, ".png") != NULL) {
-						if (index + strlen(dir->d_name) + 1 >= alloc) {
-							alloc += 2048;
-							ptr = realloc(ptr, alloc);
-						}
-						strcpy(ptr + index, dir->d_name);
-						_cache[count] = ptr + index;
-						index += strlen(dir->d_name) + 1;
-						count++;
-						if (count == cache_alloc) {
-							cache_alloc += 128;
-							_cache = realloc(_cache, cache_alloc * sizeof(char *));
-						}
-					}
-				}
+static void gallery_index_save(const gallery_index_t *index) {
+	// write a new file and rename it, a crash never leaves a partial index behind
+	FILE *fp = fopen(GALLERY_INDEX_FILE ".tmp", "wb");
+	if (!fp) {
+		printf("%s[ERROR]%s Couldn't write the gallery index\n", RED, NORMAL_COLOR);
+		return;
+	}
+	size_t size = gallery_index_size(index);
+	bool ok = fwrite(index, 1, size, fp) == size;
+	if (fclose(fp) || !ok || rename(GALLERY_INDEX_FILE ".tmp", GALLERY_INDEX_FILE)) {
+		printf("%s[ERROR]%s Couldn't write the gallery index\n", RED, NORMAL_COLOR);
+		unlink(GALLERY_INDEX_FILE ".tmp");
+	}
+}
+
+// Build an index of the decoded images
+static gallery_index_t *gallery_snapshot(const struct _gallery_items *items) {
+	uint32_t count = 0, names_size = 0;
+	for (uint32_t i = 0; i < items->count; i++) {
+		if (!items->item[i].pending) {
+			count++;
+			names_size += strlen(items->item[i].name) + 1;
+		}
+	}
+
+	gallery_index_t *index = malloc(sizeof(gallery_index_t) + count * sizeof(gallery_entry_t) + names_size);
+	if (!index)
+		return NULL;
+	index->magic = GALLERY_INDEX_MAGIC;
+	index->version = GALLERY_INDEX_VERSION;
+	index->slot_h = gallery_slot_h;
+	index->count = count;
+	index->names_size = names_size;
+
+	char *names = (char *)&index->entry[count];
+	uint32_t n = 0, ofs = 0;
+	for (uint32_t i = 0; i < items->count; i++) {
+		if (!items->item[i].pending) {
+			size_t len = strlen(items->item[i].name) + 1;
+			index->entry[n] = items->item[i].entry;
+			index->entry[n].name = ofs;
+			memcpy(names + ofs, items->item[i].name, len);
+			ofs += len;
+			n++;
+		}
+	}
+	return index;
+}
+
+static bool gallery_is_image(const char *name) {
+	// skip the hidden temporary files of copy tools
+	return name[0] != '.' && strstr(name, ".png") != NULL;
+}
+
+static int gallery_item_cmp(const void *a, const void *b) {
+	return strcmp(((const struct _gallery_item *)a)->name, ((const struct _gallery_item *)b)->name);
+}
+
+// Find an image or the position to insert it
+static bool gallery_find(const struct _gallery_items *items, const char *name, uint32_t *pos) {
+	uint32_t lo = 0, hi = items->count;
+	while (lo < hi) {
+		uint32_t mid = (lo + hi) / 2;
+		int c = strcmp(items->item[mid].name, name);
+		if (c == 0) {
+			*pos = mid;
+			return true;
+		}
+		if (c < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	*pos = lo;
+	return false;
+}
+
+static void gallery_plan_check(void);
+
+// Called on the UI thread with the index posted by the indexer thread
+static void gallery_index_swap_cb(void *data) {
+	free(gallery_index);
+	gallery_index = (gallery_index_t *)data;
+	gallery_valid = 0;
+	for (uint32_t i = 0; i < gallery_index->count; i++) {
+		if (gallery_index->entry[i].flags & GALLERY_ENTRY_VALID)
+			gallery_valid++;
+	}
+	// the names may have moved, show the visible ones again
+	if (gallery_list)
+		lv_list_set_virtual_cnt(gallery_list, gallery_index->count);
+	printf("%s[INFO]%s Gallery index: %u images\n", GREEN, NORMAL_COLOR, gallery_valid);
+	gallery_plan_check();
+}
+
+static void gallery_publish(const struct _gallery_items *items, bool save) {
+	gallery_index_t *index = gallery_snapshot(items);
+	if (!index)
+		return;
+	if (save)
+		gallery_index_save(index);
+	// the UI thread takes over the index
+	while (!lv_cmdq_call(gallery_index_swap_cb, index))
+		usleep(10000);
+}
+
+// Read a gallery file, not through lv_fs which is only used by the UI thread.
+// Not mapped: a file overwritten in place would kill the decoding threads with SIGBUS.
+static void *gallery_read(const char *name, size_t *size) {
+	int fd = open(_ssprintf(GALLERY_DIR "/%s", name), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return NULL;
+	struct stat st;
+	unsigned char *data = NULL;
+	size_t len = 0;
+	if (fstat(fd, &st) == 0 && st.st_size > 0)
+		data = malloc(st.st_size);
+	while (data && len < st.st_size) {
+		// a file being written may be shorter, the decoder rejects it
+		ssize_t n = read(fd, data + len, st.st_size - len);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			break;
+		len += n;
+	}
+	close(fd);
+	if (data && !len) {
+		free(data);
+		data = NULL;
+	}
+	*size = len;
+	return data;
+}
+
+// Read the size and the average color of an image
+static void gallery_inspect(struct _gallery_item *item) {
+	gallery_entry_t *e = &item->entry;
+	e->w = e->h = e->scaled_w = e->scaled_h = 0;
+	e->color = 0;
+	e->flags = 0;
+
+	size_t size;
+	void *file = gallery_read(item->name, &size);
+	if (!file)
+		return;
+
+	unsigned char *rgb = NULL;
+	unsigned w, h;
+	if (lodepng_decode24(&rgb, &w, &h, file, size) == 0 && w <= UINT16_MAX && h <= UINT16_MAX) {
+		uint64_t sum[3] = { 0, 0, 0 };
+		size_t px = (size_t)w * h;
+		for (size_t i = 0; i < px; i++) {
+			sum[0] += rgb[i * 3];
+			sum[1] += rgb[i * 3 + 1];
+			sum[2] += rgb[i * 3 + 2];
+		}
+		if (px)
+			e->color = (uint32_t)(sum[0] / px) << 16 | (uint32_t)(sum[1] / px) << 8 | (uint32_t)(sum[2] / px);
+		e->w = w;
+		e->h = h;
+		// shrink to the gallery height, never enlarge
+		e->scaled_w = w;
+		e->scaled_h = h;
+		if (h > gallery_slot_h && gallery_slot_h > 0) {
+			e->scaled_h = gallery_slot_h;
+			e->scaled_w = LV_MATH_MAX((uint32_t)w * gallery_slot_h / h, 1);
+		}
+		e->flags = GALLERY_ENTRY_VALID;
+	} else
+		printf("%s[ERROR]%s Couldn't decode %s\n", RED, NORMAL_COLOR, item->name);
+	free(rgb);
+	free(file);
+}
+
+static void *gallery_worker(void *data) {
+	struct _gallery_job *job = (struct _gallery_job *)data;
+	uint32_t i;
+	while ((i = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED)) < job->count)
+		gallery_inspect(job->item[i]);
+	return NULL;
+}
+
+// Decode the pending images in parallel and hand the index to the UI thread
+static void gallery_commit(struct _gallery_items *items) {
+	struct _gallery_job job = { NULL, 0, 0 };
+	uint32_t pending = 0;
+	for (uint32_t i = 0; i < items->count; i++)
+		pending += items->item[i].pending;
+	if (pending) {
+		job.item = malloc(pending * sizeof(struct _gallery_item *));
+		if (!job.item)
+			return;
+		for (uint32_t i = 0; i < items->count; i++) {
+			if (items->item[i].pending)
+				job.item[job.count++] = &items->item[i];
+		}
+	}
+
+	long workers = sysconf(_SC_NPROCESSORS_ONLN);
+	workers = LV_MATH_MIN(LV_MATH_MAX(workers, 1), GALLERY_WORKERS_MAX);
+	uint32_t start_ms = monotonic_ms(), publish_ms = start_ms;
+	uint32_t done = 0;
+	while (done < job.count) {
+		// a batch at once, the finished ones are shown during a long indexing
+		struct _gallery_job batch = { job.item + done, LV_MATH_MIN(job.count - done, GALLERY_BATCH * workers), 0 };
+		pthread_t thread[GALLERY_WORKERS_MAX];
+		int started = 0;
+		while (started < workers - 1 && pthread_create(&thread[started], NULL, gallery_worker, &batch) == 0)
+			started++;
+		gallery_worker(&batch);
+		while (started > 0)
+			pthread_join(thread[--started], NULL);
+
+		for (uint32_t i = 0; i < batch.count; i++)
+			batch.item[i]->pending = false;
+		done += batch.count;
+		if (done < job.count && monotonic_ms() - publish_ms >= GALLERY_PUBLISH_MS) {
+			gallery_publish(items, false);
+			publish_ms = monotonic_ms();
+		}
+	}
+	if (job.count)
+		printf("%s[INFO]%s Indexed %u images in %u ms\n", GREEN, NORMAL_COLOR, job.count, monotonic_ms() - start_ms);
+	free(job.item);
+
+	gallery_publish(items, true);
+}
+
+// Index a created, changed or removed image
+static bool gallery_update(struct _gallery_items *items, const char *name) {
+	struct stat st;
+	uint32_t pos;
+	bool found = gallery_find(items, name, &pos);
+
+	if (stat(_ssprintf(GALLERY_DIR "/%s", name), &st) == 0 && S_ISREG(st.st_mode)) {
+		if (found && items->item[pos].entry.mtime == st.st_mtime && items->item[pos].entry.size == (uint32_t)st.st_size)
+			return false;
+		if (!found) {
+			if (items->count == items->alloc) {
+				uint32_t alloc = items->alloc ? items->alloc * 2 : 256;
+				struct _gallery_item *item = realloc(items->item, alloc * sizeof(struct _gallery_item));
+				if (!item)
+					return false;
+				items->item = item;
+				items->alloc = alloc;
 			}
-			_cache[count] = 0; // last entry
-			closedir(d);
-			printf("%s[INFO]%s Cached %d entries\n", GREEN, NORMAL_COLOR, count);
+			char *copy = strdup(name);
+			if (!copy)
+				return false;
+			memmove(&items->item[pos + 1], &items->item[pos], (items->count - pos) * sizeof(struct _gallery_item));
+			memset(&items->item[pos], 0, sizeof(struct _gallery_item));
+			items->item[pos].name = copy;
+			items->count++;
 		}
+		items->item[pos].entry.mtime = st.st_mtime;
+		items->item[pos].entry.size = st.st_size;
+		items->item[pos].pending = true;
+		return true;
 	}
 
-	if (_cache) {
+	if (!found)
+		return false;
+	free(items->item[pos].name);
+	items->count--;
+	memmove(&items->item[pos], &items->item[pos + 1], (items->count - pos) * sizeof(struct _gallery_item));
+	return true;
+}
+
+// Compare the whole directory with the index, only the new and changed images are decoded
+static void gallery_scan(struct _gallery_items *items) {
+	struct _gallery_items found = { NULL, 0, 0 };
+	DIR *d = opendir(GALLERY_DIR);
+	if (!d && errno != ENOENT) {
+		printf("%s[ERROR]%s Couldn't open the gallery\n", RED, NORMAL_COLOR);
+		return;
+	}
+	if (d) {
+		struct dirent *dir;
+		while ((dir = readdir(d)) != NULL) {
+			struct stat st;
+			if ((dir->d_type != DT_REG && dir->d_type != DT_UNKNOWN) || !gallery_is_image(dir->d_name))
+				continue;
+			if (fstatat(dirfd(d), dir->d_name, &st, 0) || !S_ISREG(st.st_mode))
+				continue;
+			// out of memory: the image is left out until the next scan
+			if (found.count == found.alloc) {
+				uint32_t alloc = found.alloc ? found.alloc * 2 : 256;
+				struct _gallery_item *grown = realloc(found.item, alloc * sizeof(struct _gallery_item));
+				if (!grown)
+					continue;
+				found.item = grown;
+				found.alloc = alloc;
+			}
+			char *name = strdup(dir->d_name);
+			if (!name)
+				continue;
+			struct _gallery_item *item = &found.item[found.count++];
+			memset(item, 0, sizeof(struct _gallery_item));
+			item->name = name;
+			item->entry.mtime = st.st_mtime;
+			item->entry.size = st.st_size;
+			item->pending = true;
+		}
+		closedir(d);
+	}
+	if (found.count)
+		qsort(found.item, found.count, sizeof(struct _gallery_item), gallery_item_cmp);
+
+	// keep what's already known about the unchanged images
+	bool changed = found.count != items->count;
+	uint32_t j = 0;
+	for (uint32_t i = 0; i < found.count; i++) {
+		struct _gallery_item *item = &found.item[i];
+		while (j < items->count && strcmp(items->item[j].name, item->name) < 0)
+			j++;
+		if (j < items->count && strcmp(items->item[j].name, item->name) == 0 && !items->item[j].pending &&
+				items->item[j].entry.mtime == item->entry.mtime && items->item[j].entry.size == item->entry.size) {
+			item->entry = items->item[j].entry;
+			item->pending = false;
+		} else
+			changed = true;
+	}
+	for (uint32_t i = 0; i < items->count; i++)
+		free(items->item[i].name);
+	free(items->item);
+	*items = found;
+
+	if (changed)
+		gallery_commit(items);
+}
+
+#ifdef __linux__
+// Wait for file events and index the changed images
+static void gallery_watch(int fd, int *wd, struct _gallery_items *items) {
+	char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+	struct pollfd pfd = { fd, POLLIN, 0 };
+	bool changed = false, rescan = false;
+	int timeout = -1; // block until the first event
+
+	// collect the events of a burst (e.g. copying many files) before decoding anything
+	while (poll(&pfd, 1, timeout) > 0) {
+		ssize_t len = read(fd, buf, sizeof(buf));
+		if (len <= 0)
+			break;
+		const struct inotify_event *ev;
+		for (char *p = buf; p < buf + len; p += sizeof(struct inotify_event) + ev->len) {
+			ev = (const struct inotify_event *)p;
+			if (ev->mask & IN_Q_OVERFLOW)
+				rescan = true;
+			else if (ev->mask & IN_IGNORED) {
+				// the directory is gone
+				*wd = -1;
+				rescan = true;
+			} else if (ev->len && gallery_is_image(ev->name))
+				changed |= gallery_update(items, ev->name);
+		}
+		timeout = GALLERY_SETTLE_MS;
+	}
+
+	if (rescan)
+		gallery_scan(items);
+	else if (changed)
+		gallery_commit(items);
+}
+#endif
+
+static void *gallery_indexer(void *data) {
+	const gallery_index_t *index = (const gallery_index_t *)data;
+	struct _gallery_items items = { NULL, 0, 0 };
+
+	// start from the loaded index, the UI thread keeps it until a new one is posted
+	if (index->count) {
+		items.item = malloc(index->count * sizeof(struct _gallery_item));
+		if (items.item)
+			items.alloc = index->count;
+		for (uint32_t i = 0; items.item && i < index->count; i++) {
+			// an image left out is decoded again by the scan
+			char *name = strdup(gallery_name(index, i));
+			if (!name)
+				continue;
+			struct _gallery_item *item = &items.item[items.count++];
+			item->name = name;
+			item->entry = index->entry[i];
+			item->pending = false;
+		}
+	}
+
+	int wd = -1;
+#ifdef __linux__
+	// watch before scanning, no change is lost in between
+	const uint32_t mask = IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE | IN_DELETE_SELF;
+	int fd = inotify_init1(IN_CLOEXEC);
+	if (fd >= 0)
+		wd = inotify_add_watch(fd, GALLERY_DIR, mask);
+#endif
+	gallery_scan(&items);
+
+	while (1) {
+#ifdef __linux__
+		if (wd >= 0) {
+			gallery_watch(fd, &wd, &items);
+			continue;
+		}
+#endif
+		sleep(GALLERY_RESCAN_S);
+#ifdef __linux__
+		// the gallery may be created later
+		if (fd >= 0)
+			wd = inotify_add_watch(fd, GALLERY_DIR, mask);
+#endif
+		gallery_scan(&items);
+	}
+	return NULL;
+}
+
+static void gallery_index_start(void) {
+	gallery_index_t *index = gallery_index_load();
+	if (!index) {
+		index = calloc(1, sizeof(gallery_index_t));
+		if (!index) {
+			printf("%s[ERROR]%s Couldn't allocate the gallery index\n", RED, NORMAL_COLOR);
+			return;
+		}
+		index->magic = GALLERY_INDEX_MAGIC;
+		index->version = GALLERY_INDEX_VERSION;
+		index->slot_h = gallery_slot_h;
+	}
+	gallery_index_swap_cb(index);
+
+	pthread_t thread;
+	if (pthread_create(&thread, NULL, gallery_indexer, gallery_index)) {
+		printf("%s[ERROR]%s Couldn't create a thread.\n", RED, NORMAL_COLOR);
+		return;
+	}
+	pthread_detach(thread);
+}
+
+// Gallery rotation, the upcoming images are decoded ahead by the prefetch thread
+
+// Decode an image to the display's color format
+static lv_img_dsc_t *gallery_decode(const char *name) {
+	size_t size;
+	void *file = gallery_read(name, &size);
+	if (!file)
+		return NULL;
+
+	unsigned char *px = NULL;
+	unsigned w, h;
+	unsigned error = lodepng_decode32(&px, &w, &h, file, size);
+	free(file);
+	if (error || w > GALLERY_IMG_MAX || h > GALLERY_IMG_MAX) {
+		free(px);
+		return NULL;
+	}
+
+	// convert RGBA in place, the alpha byte is dropped from opaque images
+	uint32_t px_cnt = w * h;
+	bool opaque = true;
+	for (uint32_t i = 0; i < px_cnt && opaque; i++)
+		opaque = px[i * 4 + 3] == LV_OPA_COVER;
+	uint32_t px_size = opaque ? sizeof(lv_color_t) : LV_IMG_PX_SIZE_ALPHA_BYTE;
+	for (uint32_t i = 0; i < px_cnt; i++) {
+		lv_color_t c = LV_COLOR_MAKE(px[i * 4], px[i * 4 + 1], px[i * 4 + 2]);
+		uint8_t a = px[i * 4 + 3];
+		memcpy(&px[i * px_size], &c, sizeof(lv_color_t));
+		if (!opaque)
+			px[i * px_size + px_size - 1] = a;
+	}
+	unsigned char *data = realloc(px, px_cnt * px_size);
+	if (data)
+		px = data;
+
+	lv_img_dsc_t *dsc = calloc(1, sizeof(lv_img_dsc_t));
+	if (!dsc) {
+		free(px);
+		return NULL;
+	}
+	dsc->header.cf = opaque ? LV_IMG_CF_TRUE_COLOR : LV_IMG_CF_TRUE_COLOR_ALPHA;
+	dsc->header.w = w;
+	dsc->header.h = h;
+	dsc->data_size = px_cnt * px_size;
+	dsc->data = px;
+	return dsc;
+}
+
+static void gallery_prefetch_free(struct _gallery_prefetch *p) {
+	if (p->requested && !p->done) {
+		// take it out of the queue, or drop the image when the thread is done with it
+		bool queued = false;
+		pthread_mutex_lock(&prefetch_mutex);
+		for (struct _gallery_prefetch **q = &prefetch_head; *q; q = &(*q)->next) {
+			if (*q == p) {
+				*q = p->next;
+				if (prefetch_tail == &p->next)
+					prefetch_tail = q;
+				queued = true;
+				break;
+			}
+		}
+		pthread_mutex_unlock(&prefetch_mutex);
+		if (!queued) {
+			p->dropped = true;
+			return;
+		}
+	}
+	if (p->dsc) {
+		lv_img_cache_invalidate_src(p->dsc);
+		free((void *)p->dsc->data);
+		free(p->dsc);
+	}
+	if (p->requested)
+		gallery_budget_used -= p->size;
+	free(p->name);
+	free(p);
+}
+
+// Called on the UI thread with an image decoded by the prefetch thread
+static void gallery_prefetch_done_cb(void *data) {
+	struct _gallery_prefetch *p = (struct _gallery_prefetch *)data;
+	p->done = true;
+	if (p->dropped) {
+		gallery_prefetch_free(p);
+		return;
+	}
+	// the size was reserved for the worst case
+	uint32_t size = p->dsc ? p->dsc->data_size : 0;
+	gallery_budget_used = gallery_budget_used - p->size + size;
+	p->size = size;
+}
+
+static void *gallery_prefetcher(void *data) {
+	while (1) {
+		pthread_mutex_lock(&prefetch_mutex);
+		while (!prefetch_head)
+			pthread_cond_wait(&prefetch_cond, &prefetch_mutex);
+		struct _gallery_prefetch *p = prefetch_head;
+		prefetch_head = p->next;
+		if (!prefetch_head)
+			prefetch_tail = &prefetch_head;
+		pthread_mutex_unlock(&prefetch_mutex);
+
+		p->dsc = gallery_decode(p->name);
+		while (!lv_cmdq_call(gallery_prefetch_done_cb, p))
+			usleep(10000);
+	}
+	return NULL;
+}
+
+static void gallery_prefetch_start(void) {
+	pthread_t thread;
+	if (pthread_create(&thread, NULL, gallery_prefetcher, NULL)) {
+		printf("%s[ERROR]%s Couldn't create a thread.\n", RED, NORMAL_COLOR);
+		return;
+	}
+	pthread_detach(thread);
+}
+
+// Pick the upcoming images of the rotation
+static void gallery_plan_fill(void) {
+	static uint32_t _index = 0;
+	static bool _seeded = false;
+
+	if (!gallery_valid)
+		return;
+	if (!_seeded) {
 		srand(time(NULL));
-		lv_obj_t *img = lv_obj_get_child(panel, NULL);
-		while (img) {
-			if ((rand() % 10) > 6) {
-				if (_cache[_index])
-					lv_img_set_src(img, _ssprintf("gallery/%s", _cache[_index]));
-				img = lv_obj_get_child(panel, img);
+		_seeded = true;
+	}
+
+	while (gallery_plan_cnt < GALLERY_PREFETCH_CNT) {
+		if (_index >= gallery_index->count)
+			_index = 0; // restart
+		const gallery_entry_t *e = &gallery_index->entry[_index];
+		if ((e->flags & GALLERY_ENTRY_VALID) && (rand() % 10) > 6) {
+			struct _gallery_prefetch *p = calloc(1, sizeof(struct _gallery_prefetch));
+			if (!p)
+				return;
+			p->name = strdup(gallery_name(gallery_index, _index));
+			if (!p->name) {
+				free(p);
+				return;
+			}
+			p->mtime = e->mtime;
+			p->size = (uint32_t)e->w * e->h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+			if (e->w > GALLERY_IMG_MAX || e->h > GALLERY_IMG_MAX) {
+				// too large to decode ahead, it's shown from the file
+				p->size = 0;
+				p->requested = p->done = true;
 			}
-			_index++;
-			if (!_cache[_index])
-				_index = 0; // restart
+			gallery_plan[gallery_plan_cnt++] = p;
 		}
+		_index++;
 	}
 }
 
+// Queue the upcoming images for decoding while they fit into the budget
+static void gallery_prefetch(void) {
+	gallery_plan_fill();
+	for (uint32_t i = 0; i < gallery_plan_cnt; i++) {
+		struct _gallery_prefetch *p = gallery_plan[i];
+		if (p->requested)
+			continue;
+		// in the order they are shown, a later image never takes the place of an earlier one
+		if (gallery_budget_used + p->size > GALLERY_PREFETCH_BUDGET)
+			break;
+		gallery_budget_used += p->size;
+		p->requested = true;
+
+		pthread_mutex_lock(&prefetch_mutex);
+		*prefetch_tail = p;
+		prefetch_tail = &p->next;
+		pthread_cond_signal(&prefetch_cond);
+		pthread_mutex_unlock(&prefetch_mutex);
+	}
+}
+
+// Forget the upcoming images which were changed or removed
+static void gallery_plan_check(void) {
+	uint32_t n = 0;
+	for (uint32_t i = 0; i < gallery_plan_cnt; i++) {
+		struct _gallery_prefetch *p = gallery_plan[i];
+		uint32_t lo = 0, hi = gallery_index->count;
+		bool keep = false;
+		while (lo < hi) {
+			uint32_t mid = (lo + hi) / 2;
+			int c = strcmp(gallery_name(gallery_index, mid), p->name);
+			if (c == 0) {
+				const gallery_entry_t *e = &gallery_index->entry[mid];
+				keep = e->mtime == p->mtime && (e->flags & GALLERY_ENTRY_VALID);
+				break;
+			}
+			if (c < 0)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		if (keep)
+			gallery_plan[n++] = p;
+		else
+			gallery_prefetch_free(p);
+	}
+	gallery_plan_cnt = n;
+	gallery_prefetch();
+}
+
+// Show a decoded image or a file on an image of the gallery
+static void gallery_show(int i, struct _gallery_prefetch *p, const char *name) {
+	struct _gallery_prefetch *old = gallery_shown[i];
+	gallery_shown[i] = NULL;
+	if (p && p->dsc) {
+		lv_img_set_src(gallery_img[i], p->dsc);
+		gallery_shown[i] = p;
+	} else
+		lv_img_set_src(gallery_img[i], _ssprintf(GALLERY_SRC "%s", name));
+	// the old image isn't used any more
+	if (old)
+		gallery_prefetch_free(old);
+}
+
+static void gallery_fill(void) {
+	static uint32_t _fills = 0;
+
+	// nothing to show until the indexer found an image
+	gallery_plan_fill();
+	if (!gallery_plan_cnt)
+		return;
+
+	for (int i = 0; i < GALLERY_IMG_CNT && gallery_plan_cnt; i++) {
+		struct _gallery_prefetch *p = gallery_plan[0];
+		gallery_plan_cnt--;
+		memmove(&gallery_plan[0], &gallery_plan[1], gallery_plan_cnt * sizeof(gallery_plan[0]));
+
+		// a hit is shown without decoding on the UI thread. `dsc` is written by the prefetch
+		// thread, it's only read after `done` was set on this thread by the lv_cmdq handoff
+		bool hit = p->done && p->dsc;
+		gallery_show(i, hit ? p : NULL, p->name);
+		if (hit)
+			gallery_hit++;
+		else {
+			gallery_miss++;
+			gallery_prefetch_free(p);
+		}
+	}
+	// decode the next images while these are shown
+	gallery_prefetch();
+
+	if (++_fills % GALLERY_STAT_PERIOD == 0)
+		printf("%s[INFO]%s Gallery prefetch: %u%% hit rate (%u of %u), %u KB decoded\n", GREEN, NORMAL_COLOR,
+				gallery_hit * 100 / (gallery_hit + gallery_miss), gallery_hit, gallery_hit + gallery_miss, gallery_budget_used / 1024);
+}
+
 static void gallery_timer_cb(lv_task_t *timer) {
-	gallery_fill(gallery_panel);
+	gallery_fill();
+}
+
+static void gallery_list_event_cb(lv_obj_t *btn, lv_event_t event) {
+	if (event != LV_EVENT_CLICKED)
+		return;
+
+	// show the clicked file and close the list
+	int32_t index = lv_list_get_virtual_index(gallery_list, btn);
+	if (index >= 0 && (gallery_index->entry[index].flags & GALLERY_ENTRY_VALID))
+		gallery_show(0, NULL, gallery_name(gallery_index, index));
+	lv_obj_del_async(gallery_list);
+	gallery_list = NULL;
+}
+
+static void gallery_list_item_cb(lv_obj_t *list, lv_obj_t *btn, uint32_t index) {
+	// the buttons are recycled while scrolling, only the visible names have one
+	const gallery_entry_t *e = &gallery_index->entry[index];
+	if (e->flags & GALLERY_ENTRY_VALID)
+		lv_label_set_text(lv_list_get_btn_label(btn), _ssprintf("%s  %ux%u", gallery_name(gallery_index, index), e->w, e->h));
+	else
+		lv_label_set_text(lv_list_get_btn_label(btn), _ssprintf("%s  (invalid)", gallery_name(gallery_index, index)));
+	lv_obj_set_event_cb(btn, gallery_list_event_cb);
+}
+
+static void gallery_event_cb(lv_obj_t *panel, lv_event_t event) {
+	// long press on the gallery to browse the file names
+	if (event != LV_EVENT_LONG_PRESSED || gallery_list || !gallery_index || !gallery_index->count)
+		return;
+
+	gallery_list = lv_list_create(lv_layer_top(), NULL);
+	lv_obj_set_size(gallery_list, lv_obj_get_width(panel) / 2, lv_obj_get_height(panel));
+	lv_obj_align(gallery_list, panel, LV_ALIGN_CENTER, 0, 0);
+	lv_list_set_virtual(gallery_list, gallery_index->count, 40, gallery_list_item_cb);
 }
 
 static size_t round_up(size_t v) {
@@ -229,7 +1046,7 @@ static size_t _curl_write_callback(void *contents, size_t size, size_t nmemb, vo
 	struct _mem_chunk *chunk = (struct _mem_chunk *)userp;
 
 	/* realloc can be slow, therefore increase buffer to nearest 2^n */
-	chunk->buf = realloc(chunk->buf, round_up(chunk->size + contents_size));
+	chunk->buf = realloc(chunk->buf, round_up(chunk->size + contents_size + 1));
 	if (!chunk->buf)
 		return 0;
 	/* append data and increment size */
@@ -239,12 +1056,17 @@ static size_t _curl_write_callback(void *contents, size_t size, size_t nmemb, vo
 	return contents_size;
 }
 
+static void weather_done_cb(void *data) {
+	struct _mem_chunk *chunk = (struct _mem_chunk *)data;
+	chunk->busy = false;
+}
+
 static void *fetch_weather_api(void *thread_data) {
 	// https://openweathermap.org/one-call-transfer
 	const char *URL_BASE = "https://api.openweathermap.org/data/3.0/onecall?lat=%g&lon=%g&units=metric&appid=%s";
 
 	struct _mem_chunk *chunk = (struct _mem_chunk *)thread_data;
-	chunk->busy = true;
+	char weatherString[64] = { 0 };
 	chunk->size = 0;
 	chunk->res = CURLE_OK;
 	CURL *curl = curl_easy_init();
@@ -253,6 +1075,7 @@ static void *fetch_weather_api(void *thread_data) {
 		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, _curl_write_callback);
 		curl_easy_setopt(curl, CURLOPT_WRITEDATA, chunk);
 		curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0/picture-frame");
+		curl_easy_setopt(curl, CURLOPT_TIMEOUT, 60L); // never leave the download thread hanging
 		chunk->res = curl_easy_perform(curl);
 		curl_easy_cleanup(curl);
 		if (chunk->buf) {
@@ -273,7 +1096,6 @@ static void *fetch_weather_api(void *thread_data) {
 						}
 					}
 				} else {
-					strcpy(weatherString, "");
 					cJSON *current = cJSON_GetObjectItemCaseSensitive(json, "current");
 					if (current) {
 						cJSON *temp = cJSON_GetObjectItemCaseSensitive(current, "temp");
@@ -289,6 +1111,9 @@ static void *fetch_weather_api(void *thread_data) {
 						cJSON *clouds = cJSON_GetObjectItemCaseSensitive(current, "clouds");
 						if (clouds && cJSON_IsNumber(clouds))
 							strcat(weatherString, _ssprintf(" / Clouds %d%%", clouds->valueint));
+						// Hand the text over to the UI thread
+						if (!lv_cmdq_set_text(weather_label, weatherString))
+							printf("%s[ERROR]%s Command queue is full\n", RED, NORMAL_COLOR);
 					} else
 						printf("%s[ERROR]%s Unknown JSON data: %s\n", RED, NORMAL_COLOR, chunk->buf);
 				}
@@ -296,29 +1121,27 @@ static void *fetch_weather_api(void *thread_data) {
 				printf("%s[ERROR]%s Failed to parse JSON data: %s\n", RED, NORMAL_COLOR, chunk->buf);
 		}
 	}
-	chunk->busy = false;
+	// `busy` is owned by the UI thread, clear it from there
+	while (!lv_cmdq_call(weather_done_cb, chunk))
+		usleep(10000);
 	return NULL;
 }
 
 struct _mem_chunk weather_info = { NULL, 0, 0, false };
 
 static void weather_timer_cb(lv_task_t *timer) {
-	static int _lock_count = 0;
 	if (weather_info.busy) {
 		printf("%s[INFO]%s Download already in progress\n", GREEN, NORMAL_COLOR);
-		_lock_count++;
-		if (_lock_count > 3) {
-			printf("%s[INFO]%s Download locked. Restarting.\n", GREEN, NORMAL_COLOR);
-			exit(1);
-		}
 		return;
 	}
 	static pthread_t thread;
-	if (pthread_create(&thread, NULL, fetch_weather_api, &weather_info))
+	weather_info.busy = true;
+	if (pthread_create(&thread, NULL, fetch_weather_api, &weather_info)) {
 		printf("%s[ERROR]%s Couldn't create a thread.\n", RED, NORMAL_COLOR);
+		weather_info.busy = false;
+		return;
+	}
 	pthread_detach(thread);
-
-	_lock_count = 0;
 }
 
 //  Main entry
@@ -375,17 +1198,22 @@ static void panel_init(char *prog_name) {
 	lv_style_set_pad_inner(&style_gallery, LV_STATE_DEFAULT, 0);
 
 	lv_obj_add_style(gallery_panel, LV_CONT_PART_MAIN, &style_gallery);
+	lv_obj_set_event_cb(gallery_panel, gallery_event_cb);
 
 	printf("%s[INFO]%s Gallery panel is: %d x %d\n",
 			GREEN, NORMAL_COLOR,
 			lv_obj_get_width(gallery_panel), lv_obj_get_height(gallery_panel));
 
-	for (int i = 0; i < 4; i++) {
+	for (int i = 0; i < GALLERY_IMG_CNT; i++) {
 		// image placeholders
-		lv_img_create(gallery_panel, NULL);
+		gallery_img[i] = lv_img_create(gallery_panel, NULL);
 	}
 
-	gallery_fill(gallery_panel);
+	// show the images of the last run at once, the indexer thread looks for changes
+	gallery_slot_h = lv_obj_get_height(gallery_panel);
+	gallery_prefetch_start();
+	gallery_index_start();
+	gallery_fill();
 	weather_timer_cb(NULL);
 
 	// Time/date controls
@@ -516,20 +1344,56 @@ static void hal_init() {
 }
 #endif /* __linux__ */
 
+// Called by the worker threads after posting to the LVGL command queue
+static void cmdq_wakeup_cb(void) {
+	const char c = 0;
+	if (write(wakeup_pipe[1], &c, 1) < 0) {
+		// The pipe is full, the main loop will wake up anyway
+	}
+}
+
 int main(int argc, char *argv[]) {
 	lv_init(); // LittlevGL init
 	lv_png_init(); // Png file support
+#if USE_POSIX_FS
+	posix_fs_init(); // Plain files on "P:"
+#endif
+#if USE_MMAP_FS
+	mmap_fs_init(); // Memory mapped, read only files on "M:"
+#endif
 
 	hal_init();
 
 	// Panel initialization
 	panel_init(argv[0]);
 
+	// Wake up the main loop as soon as a worker thread posts a UI update
+	if (pipe(wakeup_pipe) == 0) {
+		fcntl(wakeup_pipe[0], F_SETFL, O_NONBLOCK);
+		fcntl(wakeup_pipe[1], F_SETFL, O_NONBLOCK);
+		lv_cmdq_set_wakeup_cb(cmdq_wakeup_cb);
+	} else
+		printf("%s[ERROR]%s Couldn't create the wakeup pipe.\n", RED, NORMAL_COLOR);
+
 	// Handle LitlevGL tasks (tickless mode)
+#ifdef __linux__
+	uint32_t last_ms = monotonic_ms();
+#endif
 	while (1) {
-		lv_tick_inc(5);
+#ifdef __linux__
+		// Count the real elapsed time, the handler and the wakeups make the period vary
+		uint32_t now_ms = monotonic_ms();
+		lv_tick_inc(now_ms - last_ms);
+		last_ms = now_ms;
+#endif
 		lv_task_handler();
-		usleep(5000);
+
+		struct pollfd pfd = { wakeup_pipe[0], POLLIN, 0 };
+		if (poll(&pfd, 1, 5) > 0) {
+			char buf[64];
+			while (read(wakeup_pipe[0], buf, sizeof(buf)) > 0)
+				;
+		}
 	}
 	return 0;
 }